@@ -28,6 +28,7 @@ extern "C" {
 
 #define KEY_BITS_3DES       192  /**< 3DES cipher key length in bits */
 #define KEY_BITS_MD5_96     128  /**< MD5_96 auth key length in bits */
+#define KEY_BITS_SHA1_96    160  /**< SHA1_96 auth key length in bits */
 #define KEY_BITS_SHA256_128 256  /**< SHA256_128 auth key length in bits */
 
 /**< Number of bits represnted by a string of hexadecimal characters */
@@ -101,6 +102,9 @@ int parse_key_string(char *keystring,
 		if ((alg->u.auth == ODP_AUTH_ALG_MD5_96) &&
 		    (KEY_BITS_MD5_96 == key_bits_in))
 			key->length = key_bits_in / 8;
+		else if ((alg->u.auth == ODP_AUTH_ALG_SHA1_HMAC) &&
+			 (KEY_BITS_SHA1_96 == key_bits_in))
+			key->length = key_bits_in / 8;
 		else if ((alg->u.auth == ODP_AUTH_ALG_SHA256_128) &&
 			 (KEY_BITS_SHA256_128 == key_bits_in))
 			key->length = key_bits_in / 8;
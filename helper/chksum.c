@@ -26,68 +26,55 @@ typedef union {
 
 static uint8_t ZEROS[2] = { 0, 0 };
 
-/* Note that for data_seg_sum byte_len MUST be >= 1.  This function Returns the
- * sum of the data (as described by data8_ptr and data_len) as 16-bit
- * integers. */
-
-static uint32_t data_seg_sum(uint8_t   *data8_ptr,
-			     uint32_t   data_len,   /* length in bytes */
-			     odp_bool_t is_last,
-			     odp_bool_t has_odd_byte_in,
-			     uint8_t   *odd_byte_in_out)
+/* Fold a 64-bit sum into a 16-bit one's complement sum */
+static inline uint32_t sum_fold(uint64_t sum)
 {
-	swap_buf_t swap_buf;
-	uint32_t   sum, len_in_16_byte_chunks, idx, data0, data1, data2, data3;
-	uint32_t   data4, data5, data6, data7;
-	uint16_t  *data16_ptr;
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
 
-	sum = 0;
-	if (has_odd_byte_in) {
-		swap_buf.bytes[0] = *odd_byte_in_out;
-		swap_buf.bytes[1] = *data8_ptr++;
-		sum              += (uint32_t)swap_buf.words16[0];
-		data_len--;
-	}
+	return (uint32_t)sum;
+}
 
-	data16_ptr = (uint16_t *)(void *)data8_ptr;
-
-	/* The following code tries to gain a modest performance enhancement by
-	 * unrolling the normal 16 bits at a time loop eight times.  Even
-	 * better would be to add some data prefetching instructions here. */
-	len_in_16_byte_chunks = data_len / 16;
-	for (idx = 0; idx < len_in_16_byte_chunks; idx++) {
-		data0 = (uint32_t)*data16_ptr++;
-		data1 = (uint32_t)*data16_ptr++;
-		data2 = (uint32_t)*data16_ptr++;
-		data3 = (uint32_t)*data16_ptr++;
-		data4 = (uint32_t)*data16_ptr++;
-		data5 = (uint32_t)*data16_ptr++;
-		data6 = (uint32_t)*data16_ptr++;
-		data7 = (uint32_t)*data16_ptr++;
-
-		data_len -= 16;
-		sum      += data0 + data1;
-		sum      += data2 + data3;
-		sum      += data4 + data5;
-		sum      += data6 + data7;
-	}
+uint32_t odph_chksum_partial(const void *buffer, uint32_t len, uint32_t sum)
+{
+	return sum_fold((uint64_t)sum + odp_chksum_ones_comp16(buffer, len));
+}
 
-	for (idx = 0; idx < data_len / 2; idx++)
-		sum += (uint32_t)*data16_ptr++;
+int odph_chksum_pkt_partial(odp_packet_t pkt, uint32_t offset, uint32_t len,
+			    uint32_t *sum_ptr)
+{
+	uint64_t sum = *sum_ptr;
+	uint32_t seg_len, data_len, seg_sum;
+	odp_bool_t odd = false;
+	uint8_t *data;
 
-	if ((data_len & 1) == 0)
-		return sum;
+	while (len) {
+		data = odp_packet_offset(pkt, offset, &seg_len, NULL);
+		if (data == NULL)
+			return -1;
 
-	/* Now handle the case of a single odd byte. */
-	if (is_last) {
-		swap_buf.bytes[0] = *(uint8_t *)data16_ptr;
-		swap_buf.bytes[1] = 0;
-		sum              += (uint32_t)swap_buf.words16[0];
-	} else {
-		*odd_byte_in_out = *(uint8_t *)data16_ptr;
+		data_len = len < seg_len ? len : seg_len;
+		seg_sum  = odp_chksum_ones_comp16(data, data_len);
+
+		/* Data starting from an odd offset is summed in the other
+		 * byte order. One's complement sum is byte order independent,
+		 * so just swap it back. */
+		if (odd)
+			seg_sum = ((seg_sum & 0xff) << 8) | (seg_sum >> 8);
+
+		sum    += seg_sum;
+		offset += data_len;
+		len    -= data_len;
+
+		if (data_len & 1)
+			odd = !odd;
 	}
 
-	return sum;
+	*sum_ptr = sum_fold(sum);
+	return 0;
 }
 
 static inline int odph_process_l4_hdr(odp_packet_t      odp_pkt,
@@ -266,12 +253,9 @@ int odph_udp_tcp_chksum(odp_packet_t     odp_pkt,
 			uint16_t        *chksum_ptr)
 {
 	odph_l4_hdr_t    udp_tcp_hdr;
-	odp_bool_t       split_l4_hdr, is_tcp, is_last;
-	odp_bool_t       has_odd_byte_in;
-	uint32_t         l4_len, sum, ones_compl_sum, remaining_seg_len;
-	uint32_t         data_len, pkt_chksum_offset, offset;
+	odp_bool_t       split_l4_hdr, is_tcp;
+	uint32_t         l4_len, sum, pkt_chksum_offset;
 	uint16_t        *pkt_chksum_ptr, chksum;
-	uint8_t         *data_ptr, odd_byte_in_out;
 	int              rc, ret_code;
 
 	/* First parse and process the l4 header */
@@ -287,46 +271,16 @@ int odph_udp_tcp_chksum(odp_packet_t     odp_pkt,
 	if (rc != 0)
 		return rc;
 
-	/* The following code handles all of the different cases where the
-	 * data to be checksummed might be split among an arbitrary number of
-	 * segments, each of an arbitrary length (include odd alignments!). */
-	data_ptr        = odp_packet_l4_ptr(odp_pkt, &remaining_seg_len);
-	offset          = odp_packet_l4_offset(odp_pkt);
-	has_odd_byte_in = false;
-	odd_byte_in_out = 0;
-
-	while (true) {
-		data_len = remaining_seg_len;
-		is_last  = false;
-		if (l4_len < remaining_seg_len)
-			data_len = l4_len;
-		else if (l4_len == remaining_seg_len)
-			is_last = true;
-
-		sum += data_seg_sum(data_ptr, data_len, is_last,
-				    has_odd_byte_in, &odd_byte_in_out);
-		l4_len  -= data_len;
-		if (l4_len == 0)
-			break;
-
-		if (data_len & 1)
-			has_odd_byte_in = !has_odd_byte_in;
-
-		offset  += data_len;
-		data_ptr = odp_packet_offset(odp_pkt, offset,
-					     &remaining_seg_len, NULL);
-	}
+	/* The data to be checksummed might be split among an arbitrary
+	 * number of segments, each of an arbitrary length (including odd
+	 * alignments!). The result is already folded into a 16-bit one's
+	 * complement sum. */
+	rc = odph_chksum_pkt_partial(odp_pkt, odp_packet_l4_offset(odp_pkt),
+				     l4_len, &sum);
+	if (rc != 0)
+		return rc;
 
-	/* Now do the one's complement "carry" algorithm.  Up until now this
-	 * has just been regular two's complement addition.  Note that it is
-	 * important that this regular sum of 16-bit quantities be done with
-	 * at least 32-bit arithmetic to prevent the loss of the carries.
-	 * Note that it can be proven that only two rounds of the carry
-	 * wrap around logic are necessary (assuming 32-bit arithmetic and
-	 * a data length of < 64K). */
-	ones_compl_sum = (sum              & 0xFFFF) + (sum            >> 16);
-	ones_compl_sum = (ones_compl_sum   & 0xFFFF) + (ones_compl_sum >> 16);
-	chksum         = (~ones_compl_sum) & 0xFFFF;
+	chksum         = (~sum) & 0xFFFF;
 	ret_code       = 0;
 
 	/* Now based upon the given op, the calculated chksum and the incoming
@@ -34,6 +34,62 @@ typedef enum {
 	ODPH_CHKSUM_RETURN    /**< Don't generate or verify chksum */
 } odph_chksum_op_t;
 
+/**
+ * Partial one's complement sum of data
+ *
+ * Adds the data as 16-bit words into a one's complement sum. An odd last
+ * byte is summed as if it was followed by a zero byte. Use the returned
+ * value as 'sum' to continue the sum over another buffer. Buffers other
+ * than the last one must have an even length. Use odph_chksum_finish() to
+ * convert the final sum into a checksum.
+ *
+ * The data is summed with odp_chksum_ones_comp16(), which may use vector
+ * instructions of the CPU.
+ *
+ * @param buffer Pointer to data (no alignment requirement)
+ * @param len    Data length in bytes
+ * @param sum    Sum to continue from (0 for a new sum)
+ *
+ * @return Partial sum, folded into 16 bits in host cpu order
+ */
+uint32_t odph_chksum_partial(const void *buffer, uint32_t len, uint32_t sum);
+
+/**
+ * Partial one's complement sum of packet data
+ *
+ * Like odph_chksum_partial(), but sums packet data which may be spread
+ * over multiple segments of any length. The range starts at an even offset
+ * of the summed data stream.
+ *
+ * @param         pkt     Packet handle
+ * @param         offset  Byte offset into the packet
+ * @param         len     Number of bytes to sum
+ * @param[in,out] sum     Sum to continue from (0 for a new sum). Outputs
+ *                        the partial sum folded into 16 bits.
+ *
+ * @retval 0 on success
+ * @retval <0 on failure (range out of packet data)
+ */
+int odph_chksum_pkt_partial(odp_packet_t pkt, uint32_t offset, uint32_t len,
+			    uint32_t *sum);
+
+/**
+ * Finish a checksum
+ *
+ * Folds a partial one's complement sum into 16 bits and complements it.
+ *
+ * @param sum    Partial sum
+ *
+ * @return Checksum value to be stored into the packet as is
+ */
+static inline odp_u16sum_t odph_chksum_finish(uint32_t sum)
+{
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return (__odp_force odp_u16sum_t)(uint16_t)~sum;
+}
+
 /**
  * Checksum
  *
@@ -44,21 +100,89 @@ typedef enum {
  */
 static inline odp_u16sum_t odph_chksum(void *buffer, int len)
 {
-	uint16_t *buf = (uint16_t *)buffer;
-	uint32_t sum = 0;
-	uint16_t result;
+	return odph_chksum_finish(odph_chksum_partial(buffer, len, 0));
+}
+
+/**
+ * Incremental checksum update of a 16-bit field
+ *
+ * Updates a checksum after a 16-bit word of the covered data has been
+ * changed, as specified in RFC 1624 (eqn. 3). Old and new values are given
+ * as stored in the packet, so the checksum stays byte order independent.
+ *
+ * @param chksum   Checksum value as stored in the packet
+ * @param old_val  Old field value
+ * @param new_val  New field value
+ *
+ * @return Updated checksum value
+ */
+static inline odp_u16sum_t odph_chksum_update16(odp_u16sum_t chksum,
+						odp_u16be_t old_val,
+						odp_u16be_t new_val)
+{
+	uint32_t sum;
+
+	/* HC' = ~(~HC + ~m + m') */
+	sum  = (uint16_t)~(__odp_force uint16_t)chksum;
+	sum += (uint16_t)~(__odp_force uint16_t)old_val;
+	sum += (__odp_force uint16_t)new_val;
+
+	return odph_chksum_finish(sum);
+}
+
+/**
+ * Incremental checksum update of a 32-bit field
+ *
+ * Like odph_chksum_update16(), but for a 32-bit field (e.g. an IPv4
+ * address) aligned to 16 bits within the covered data.
+ *
+ * @param chksum   Checksum value as stored in the packet
+ * @param old_val  Old field value
+ * @param new_val  New field value
+ *
+ * @return Updated checksum value
+ */
+static inline odp_u16sum_t odph_chksum_update32(odp_u16sum_t chksum,
+						odp_u32be_t old_val,
+						odp_u32be_t new_val)
+{
+	uint32_t old32 = (__odp_force uint32_t)old_val;
+	uint32_t new32 = (__odp_force uint32_t)new_val;
+	uint32_t sum;
+
+	sum  = (uint16_t)~(__odp_force uint16_t)chksum;
+	sum += (uint16_t)~old32 + (uint16_t)~(old32 >> 16);
+	sum += (new32 & 0xffff) + (new32 >> 16);
 
-	for (sum = 0; len > 1; len -= 2)
-		sum += *buf++;
+	return odph_chksum_finish(sum);
+}
 
-	if (len == 1)
-		sum += *(unsigned char *)buf;
+/**
+ * Incremental checksum update of a data block
+ *
+ * Like odph_chksum_update16(), but for a block of data (e.g. an IPv6
+ * address) aligned to 16 bits within the covered data.
+ *
+ * @param chksum   Checksum value as stored in the packet
+ * @param old_data Old field data
+ * @param new_data New field data
+ * @param len      Field length in bytes. Must be even.
+ *
+ * @return Updated checksum value
+ */
+static inline odp_u16sum_t odph_chksum_update(odp_u16sum_t chksum,
+					      const void *old_data,
+					      const void *new_data,
+					      uint32_t len)
+{
+	uint32_t sum;
 
-	sum = (sum >> 16) + (sum & 0xFFFF);
-	sum += (sum >> 16);
-	result = ~sum;
+	/* ~m is summed as the one's complement of the sum of m */
+	sum  = (uint16_t)~(__odp_force uint16_t)chksum;
+	sum += (uint16_t)~odph_chksum_partial(old_data, len, 0);
+	sum  = odph_chksum_partial(new_data, len, sum);
 
-	return  (__odp_force odp_u16sum_t) result;
+	return odph_chksum_finish(sum);
 }
 
 /**
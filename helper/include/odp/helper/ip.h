@@ -19,6 +19,8 @@ extern "C" {
 
 #include <odp_api.h>
 #include <odp/helper/chksum.h>
+#include <odp/helper/tcp.h>
+#include <odp/helper/udp.h>
 
 #include <string.h>
 
@@ -201,6 +203,29 @@ typedef struct ODP_PACKED {
 	uint8_t    filler[6];    /**< Fill out first 8 byte segment */
 } odph_ipv6hdr_ext_t;
 
+/** IPv6 fragment header length */
+#define ODPH_IPV6HDR_FRAG_LEN 8
+
+/** @internal Returns IPv6 fragment offset in bytes */
+#define ODPH_IPV6HDR_FRAG_OFFSET(frag_offset) ((frag_offset) & 0xfff8)
+
+/** @internal Returns IPv6 more fragments */
+#define ODPH_IPV6HDR_FRAG_MORE(frag_offset) ((frag_offset) & 0x0001)
+
+/**
+ * IPv6 fragment header
+ */
+typedef struct ODP_PACKED {
+	uint8_t    next_hdr;     /**< Protocol of next header */
+	uint8_t    reserved;     /**< Reserved */
+	odp_u16be_t frag_offset; /**< Fragment offset / More fragments */
+	odp_u32be_t id;          /**< Identification */
+} odph_ipv6hdr_frag_t;
+
+/** @internal Compile time assert */
+ODP_STATIC_ASSERT(sizeof(odph_ipv6hdr_frag_t) == ODPH_IPV6HDR_FRAG_LEN,
+		  "ODPH_IPV6HDR_FRAG_T__SIZE_ERROR");
+
 /** @name
  * IP protocol values (IPv4:'proto' or IPv6:'next_hdr')
  * @{*/
@@ -212,10 +237,105 @@ typedef struct ODP_PACKED {
 #define ODPH_IPPROTO_FRAG    0x2C /**< IPv6 Fragment (44) */
 #define ODPH_IPPROTO_AH      0x33 /**< Authentication Header (51) */
 #define ODPH_IPPROTO_ESP     0x32 /**< Encapsulating Security Payload (50) */
+#define ODPH_IPPROTO_DEST    0x3C /**< IPv6 Destination options (60) */
 #define ODPH_IPPROTO_INVALID 0xFF /**< Reserved invalid by IANA */
 
 /**@}*/
 
+/**
+ * Decrement IPv4 time to live
+ *
+ * Decrements TTL and updates the header checksum incrementally (RFC 1624).
+ * The caller checks that TTL is not already zero.
+ *
+ * @param ip   IPv4 header
+ */
+static inline void odph_ipv4_ttl_dec(odph_ipv4hdr_t *ip)
+{
+	odp_u16be_t old_val, new_val;
+
+	/* TTL and protocol form a 16-bit word of the header */
+	old_val = odp_cpu_to_be_16((uint16_t)(ip->ttl << 8) | ip->proto);
+	ip->ttl--;
+	new_val = odp_cpu_to_be_16((uint16_t)(ip->ttl << 8) | ip->proto);
+
+	ip->chksum = odph_chksum_update16(ip->chksum, old_val, new_val);
+}
+
+/**
+ * Rewrite IPv4 address and TCP/UDP port
+ *
+ * Rewrites the source or destination address of an IPv4 header, and
+ * optionally the matching port of the following TCP or UDP header (NAT).
+ * The IPv4 header checksum and the TCP/UDP checksum, which covers the
+ * addresses through the pseudo header, are updated incrementally
+ * (RFC 1624). A zero (disabled) UDP checksum is left as is.
+ *
+ * @param ip    IPv4 header
+ * @param l4    TCP or UDP header as indicated by ip->proto, or NULL when
+ *              only the IPv4 header is rewritten
+ * @param dst   0: rewrite source address and port, 1: destination
+ * @param addr  New address
+ * @param port  New port. Ignored when 'l4' is NULL.
+ */
+static inline void odph_ipv4_nat(odph_ipv4hdr_t *ip, void *l4, int dst,
+				 odp_u32be_t addr, odp_u16be_t port)
+{
+	odph_tcphdr_t *tcp;
+	odph_udphdr_t *udp;
+	odp_u32be_t old_addr;
+	odp_u16be_t old_port;
+	odp_u16sum_t chksum;
+
+	old_addr = dst ? ip->dst_addr : ip->src_addr;
+
+	if (dst)
+		ip->dst_addr = addr;
+	else
+		ip->src_addr = addr;
+
+	ip->chksum = odph_chksum_update32(ip->chksum, old_addr, addr);
+
+	if (l4 == NULL)
+		return;
+
+	if (ip->proto == ODPH_IPPROTO_TCP) {
+		tcp = (odph_tcphdr_t *)l4;
+		old_port = dst ? tcp->dst_port : tcp->src_port;
+
+		if (dst)
+			tcp->dst_port = port;
+		else
+			tcp->src_port = port;
+
+		chksum = (__odp_force odp_u16sum_t)tcp->cksm;
+		chksum = odph_chksum_update32(chksum, old_addr, addr);
+		chksum = odph_chksum_update16(chksum, old_port, port);
+		tcp->cksm = (__odp_force odp_u16be_t)chksum;
+	} else if (ip->proto == ODPH_IPPROTO_UDP) {
+		udp = (odph_udphdr_t *)l4;
+		old_port = dst ? udp->dst_port : udp->src_port;
+
+		if (dst)
+			udp->dst_port = port;
+		else
+			udp->src_port = port;
+
+		if (udp->chksum == 0)
+			return;
+
+		chksum = (__odp_force odp_u16sum_t)udp->chksum;
+		chksum = odph_chksum_update32(chksum, old_addr, addr);
+		chksum = odph_chksum_update16(chksum, old_port, port);
+
+		/* Zero is transmitted as all ones (RFC 768) */
+		if (chksum == 0)
+			chksum = (__odp_force odp_u16sum_t)0xffff;
+
+		udp->chksum = (__odp_force odp_u16be_t)chksum;
+	}
+}
+
 /**
  * Parse IPv4 address from a string
  *
@@ -0,0 +1,230 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:    BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP IP fragmentation and reassembly
+ *
+ * Reassembly table stores fragments of IPv4 and IPv6 datagrams until all
+ * fragments of a datagram have been received. The table is located in
+ * shared memory and divided into partitions. Each partition is used by
+ * a single thread at a time, so that no locks are needed. All fragments
+ * of a datagram must be passed to the same partition, e.g. by selecting
+ * the partition by the packet input queue and hashing packets into input
+ * queues by IP addresses only (see odp_pktin_hash_proto_t).
+ *
+ * Datagrams that are not completed within a timeout are dropped. Timeouts
+ * are driven by an ODP timer per partition.
+ *
+ * A reassembled datagram is built by concatenating fragment packets,
+ * which links packet segments without copying when the implementation
+ * supports it.
+ */
+
+#ifndef ODPH_IPFRAG_H_
+#define ODPH_IPFRAG_H_
+
+#include <odp_api.h>
+#include <odp/helper/strong_types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup odph_ipfrag ODPH IP FRAGMENTATION
+ * @{
+ */
+
+/** Maximum number of fragments per datagram */
+#define ODPH_IPFRAG_MAX_FRAGS 64
+
+/** Reassembly table handle */
+typedef ODPH_HANDLE_T(odph_ipfrag_t);
+
+/**
+ * Reassembly table parameters
+ */
+typedef struct {
+	/** Number of partitions. The default value is 1. */
+	uint32_t num_part;
+
+	/** Maximum number of datagrams under reassembly per partition.
+	 *  The default value is 1024. */
+	uint32_t num_flows;
+
+	/** Maximum number of fragments per datagram. The value must not
+	 *  exceed ODPH_IPFRAG_MAX_FRAGS. The default value is 8. */
+	uint32_t max_frags;
+
+	/** Reassembly timeout in nanoseconds. The default value is one
+	 *  second. */
+	uint64_t timeout_ns;
+
+	/** Timer pool used for timeouts. The pool must have a free timer
+	 *  for each partition, and it must have been started before
+	 *  odph_ipfrag_create() is called. There is no default value. */
+	odp_timer_pool_t timer_pool;
+
+} odph_ipfrag_param_t;
+
+/**
+ * Reassembly table statistics
+ */
+typedef struct {
+	/** Number of fragments received */
+	uint64_t frags;
+
+	/** Number of datagrams reassembled */
+	uint64_t reass;
+
+	/** Number of datagrams dropped due to timeout */
+	uint64_t timeouts;
+
+	/** Number of fragments dropped due to errors. Errors are: bad
+	 *  header, overlapping fragments, too many fragments and full
+	 *  table. */
+	uint64_t errors;
+
+	/** Number of datagrams currently under reassembly */
+	uint64_t held_flows;
+
+	/** Number of fragments currently held */
+	uint64_t held_frags;
+
+} odph_ipfrag_stats_t;
+
+/**
+ * Initialize reassembly table parameters
+ *
+ * Initialize an odph_ipfrag_param_t to its default values for all fields.
+ *
+ * @param param   Address of the odph_ipfrag_param_t to be initialized
+ */
+void odph_ipfrag_param_init(odph_ipfrag_param_t *param);
+
+/**
+ * Create a reassembly table
+ *
+ * @param name    Name of the table to be created
+ * @param param   Table parameters
+ *
+ * @return Handle of the created table
+ * @retval NULL If table create failed
+ */
+odph_ipfrag_t odph_ipfrag_create(const char *name,
+				 const odph_ipfrag_param_t *param);
+
+/**
+ * Lookup a reassembly table by name
+ *
+ * @param name    Name of the table to be located
+ *
+ * @return Handle of the located table
+ * @retval NULL No table matching supplied name found
+ */
+odph_ipfrag_t odph_ipfrag_lookup(const char *name);
+
+/**
+ * Destroy a reassembly table
+ *
+ * Frees all held fragments. The table must not be in use by any thread.
+ *
+ * @param tbl     Handle of the table to be destroyed
+ *
+ * @retval 0 Success
+ * @retval < 0 Failure
+ */
+int odph_ipfrag_destroy(odph_ipfrag_t tbl);
+
+/**
+ * Reassemble IP datagram
+ *
+ * Stores an IPv4 or IPv6 fragment into a partition of the table. When all
+ * fragments of the datagram have been received, the reassembled datagram
+ * is output. The reassembled packet has the same L2 and L3 offsets as the
+ * first fragment, and the fragment flag cleared. Packets that are not
+ * fragments are output as is. The packet must have a valid L3 offset and
+ * IP header within the first segment.
+ *
+ * Expired datagrams of the partition are dropped first.
+ *
+ * @param      tbl    Reassembly table
+ * @param      part   Partition index
+ * @param      pkt    Packet
+ * @param[out] out    Reassembled datagram on return value 1
+ *
+ * @retval 1 Datagram is complete and output
+ * @retval 0 Fragment was stored
+ * @retval <0 Fragment was dropped due to an error
+ */
+int odph_ipfrag_reass(odph_ipfrag_t tbl, uint32_t part, odp_packet_t pkt,
+		      odp_packet_t *out);
+
+/**
+ * Drop expired datagrams
+ *
+ * Drops datagrams of the partition whose timeout has expired. Threads that
+ * may not call odph_ipfrag_reass() for a long time call this periodically
+ * to release held packets.
+ *
+ * @param tbl     Reassembly table
+ * @param part    Partition index
+ *
+ * @return Number of datagrams dropped
+ */
+int odph_ipfrag_expire(odph_ipfrag_t tbl, uint32_t part);
+
+/**
+ * Read reassembly table statistics
+ *
+ * Sums statistics of all partitions.
+ *
+ * @param      tbl    Reassembly table
+ * @param[out] stats  Statistics for output
+ */
+void odph_ipfrag_stats(odph_ipfrag_t tbl, odph_ipfrag_stats_t *stats);
+
+/**
+ * Fragment IP datagram
+ *
+ * Fragments an IPv4 or IPv6 datagram so that no fragment exceeds 'mtu'
+ * bytes of IP header and payload. The first fragment reuses the original
+ * packet and its payload, other fragments are allocated from the same pool
+ * and copy their share of the payload. IPv4 options are copied into other
+ * fragments as specified by RFC 791. An IPv4 datagram that is already a
+ * fragment is fragmented further. All fragments have the fragment flag set,
+ * so that L4 checksums are not inserted on packet output. L4 checksum must
+ * be complete before calling this function.
+ *
+ * A datagram that fits into 'mtu' is output as is.
+ *
+ * @param      pkt    Packet with a valid L3 offset and IP header within
+ *                    the first segment
+ * @param      mtu    Maximum IP length of a fragment
+ * @param      id     IPv6 fragment identification. IPv4 fragments use the
+ *                    identification of the datagram.
+ * @param[out] frag   Fragments for output
+ * @param      num    Maximum number of fragments to output
+ *
+ * @return Number of fragments output. The packet is consumed.
+ * @retval <0 Failure. Packet is not modified. The datagram has the
+ *            don't fragment flag set, is an IPv6 fragment, needs more than
+ *            'num' fragments, or packet allocation failed.
+ */
+int odph_ipfrag_frag(odp_packet_t pkt, uint32_t mtu, uint32_t id,
+		     odp_packet_t frag[], int num);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
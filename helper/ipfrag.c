@@ -0,0 +1,1108 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include <odp/helper/odph_ipfrag.h>
+#include <odp/helper/ip.h>
+#include "odph_debug.h"
+#include <odp_api.h>
+
+/** @magic word, write to the first byte of the memory block
+ *   to indicate this block is used by a reassembly table
+ */
+#define ODPH_IPFRAG_MAGIC_WORD 0xEFEFFEFE
+
+/* Invalid flow index */
+#define IPFRAG_NONE UINT32_MAX
+
+/* Maximum length of IP headers built by the fragmenter */
+#define IPFRAG_HDR_MAX 256
+
+/* IPv4 option is copied into all fragments */
+#define IPV4_OPT_COPIED 0x80
+
+/* Reassembly key. IPv4 addresses use the first word. */
+typedef struct {
+	uint32_t src[4];
+	uint32_t dst[4];
+	uint32_t id;
+	uint8_t  ver;
+	uint8_t  proto;
+	uint16_t pad;
+} ipfrag_key_t;
+
+/* Datagram under reassembly */
+typedef struct {
+	ipfrag_key_t key;
+	odp_time_t   start;
+	uint32_t     hash;
+	/* Hash chain, or free list when not used */
+	uint32_t     next;
+	/* Flows in arrival order for timeouts */
+	uint32_t     lru_prev;
+	uint32_t     lru_next;
+	/* Payload length. Zero until the last fragment has been received. */
+	uint32_t     total;
+	/* Payload bytes received */
+	uint32_t     recv;
+	/* Number of fragments */
+	uint32_t     num;
+} ipfrag_flow_t;
+
+/* Fragment. Fragments of a flow are stored in offset order. */
+typedef struct {
+	odp_packet_t pkt;
+	/* Offset and length of payload in the datagram */
+	uint32_t     offset;
+	uint32_t     len;
+	/* Payload offset in the packet */
+	uint32_t     hdr_len;
+} ipfrag_frag_t;
+
+/* Parsed fragment */
+typedef struct {
+	ipfrag_key_t key;
+	uint32_t     offset;
+	uint32_t     len;
+	uint32_t     hdr_len;
+	uint32_t     pad;
+	int          more;
+} ipfrag_info_t;
+
+/* Partition of the table. Used by one thread at a time. */
+typedef struct ODP_ALIGNED_CACHE {
+	ipfrag_flow_t *flow;
+	ipfrag_frag_t *frag;
+	uint32_t      *bucket;
+	uint32_t       free;
+	uint32_t       lru_head;
+	uint32_t       lru_tail;
+	odp_timer_t    timer;
+	odp_queue_t    queue;
+	/* Timeout event when the timer is not armed */
+	odp_event_t    tmo_ev;
+	odph_ipfrag_stats_t stats;
+} ipfrag_part_t;
+
+/** A reassembly table structure. */
+typedef struct {
+	/**< for check */
+	uint32_t magicword;
+	/**< Name of the table. */
+	char name[ODP_SHM_NAME_LEN];
+	/**< Maximum number of fragments per flow. */
+	uint32_t max_frags;
+	/**< Bitmask for getting bucket index from hash. */
+	uint32_t bucket_mask;
+	/**< Timeout in nanoseconds. */
+	uint64_t timeout_ns;
+	/**< Timer period in ticks. */
+	uint64_t period;
+	/**< Pool of timeout events. */
+	odp_pool_t tmo_pool;
+	/**< Number of partitions. */
+	uint32_t num_part;
+	/**< Partitions */
+	ipfrag_part_t part[];
+} odph_ipfrag_impl ODP_ALIGNED_CACHE;
+
+static inline uint32_t align32pow2(uint32_t x)
+{
+	x--;
+	x |= x >> 1;
+	x |= x >> 2;
+	x |= x >> 4;
+	x |= x >> 8;
+	x |= x >> 16;
+
+	return x + 1;
+}
+
+void odph_ipfrag_param_init(odph_ipfrag_param_t *param)
+{
+	memset(param, 0, sizeof(odph_ipfrag_param_t));
+	param->num_part   = 1;
+	param->num_flows  = 1024;
+	param->max_frags  = 8;
+	param->timeout_ns = ODP_TIME_SEC_IN_NS;
+	param->timer_pool = ODP_TIMER_POOL_INVALID;
+}
+
+odph_ipfrag_t odph_ipfrag_lookup(const char *name)
+{
+	odph_ipfrag_impl *tbl;
+	odp_shm_t shm;
+
+	if (name == NULL || strlen(name) >= ODP_SHM_NAME_LEN)
+		return NULL;
+
+	shm = odp_shm_lookup(name);
+	if (shm == ODP_SHM_INVALID)
+		return NULL;
+
+	tbl = (odph_ipfrag_impl *)odp_shm_addr(shm);
+	if (tbl == NULL || tbl->magicword != ODPH_IPFRAG_MAGIC_WORD)
+		return NULL;
+
+	return (odph_ipfrag_t)tbl;
+}
+
+static void part_term(odph_ipfrag_impl *tbl, ipfrag_part_t *part)
+{
+	odp_event_t ev;
+	uint32_t idx, i;
+
+	/* Free held fragments */
+	for (idx = part->lru_head; idx != IPFRAG_NONE;
+	     idx = part->flow[idx].lru_next) {
+		for (i = 0; i < part->flow[idx].num; i++)
+			odp_packet_free(part->frag[idx * tbl->max_frags +
+						   i].pkt);
+	}
+
+	if (part->timer != ODP_TIMER_INVALID) {
+		ev = odp_timer_free(part->timer);
+		if (ev != ODP_EVENT_INVALID)
+			odp_event_free(ev);
+	}
+
+	if (part->tmo_ev != ODP_EVENT_INVALID)
+		odp_event_free(part->tmo_ev);
+
+	if (part->queue != ODP_QUEUE_INVALID) {
+		while ((ev = odp_queue_deq(part->queue)) != ODP_EVENT_INVALID)
+			odp_event_free(ev);
+
+		if (odp_queue_destroy(part->queue))
+			ODPH_DBG("failed to destroy queue\n");
+	}
+}
+
+odph_ipfrag_t odph_ipfrag_create(const char *name,
+				 const odph_ipfrag_param_t *param)
+{
+	odph_ipfrag_impl *tbl;
+	odp_timer_pool_info_t tp_info;
+	odp_pool_param_t pool_param;
+	char pool_name[ODP_POOL_NAME_LEN];
+	odp_shm_t shm;
+	uint32_t num_buckets, i, j;
+	uint64_t part_size, size;
+	uint64_t period_ns;
+	uint8_t *mem;
+
+	if (name == NULL || strlen(name) >= ODP_SHM_NAME_LEN ||
+	    param->num_part == 0 || param->num_flows == 0 ||
+	    param->max_frags == 0 ||
+	    param->max_frags > ODPH_IPFRAG_MAX_FRAGS ||
+	    param->timeout_ns == 0 ||
+	    param->timer_pool == ODP_TIMER_POOL_INVALID) {
+		ODPH_DBG("invalid parameters\n");
+		return NULL;
+	}
+
+	if (odph_ipfrag_lookup(name) != NULL) {
+		ODPH_DBG("reassembly table %s already exists\n", name);
+		return NULL;
+	}
+
+	if (odp_timer_pool_info(param->timer_pool, &tp_info)) {
+		ODPH_DBG("bad timer pool\n");
+		return NULL;
+	}
+
+	/* Timer expires datagrams at half timeout intervals */
+	period_ns = param->timeout_ns / 2;
+	if (period_ns < tp_info.param.min_tmo)
+		period_ns = tp_info.param.min_tmo;
+
+	num_buckets = align32pow2(param->num_flows);
+
+	part_size = sizeof(ipfrag_flow_t) * param->num_flows +
+		    sizeof(ipfrag_frag_t) * param->num_flows *
+		    param->max_frags +
+		    sizeof(uint32_t) * num_buckets;
+	part_size = (part_size + ODP_CACHE_LINE_SIZE - 1) &
+		    ~((uint64_t)ODP_CACHE_LINE_SIZE - 1);
+
+	size = sizeof(odph_ipfrag_impl) +
+	       sizeof(ipfrag_part_t) * param->num_part +
+	       part_size * param->num_part;
+
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_DBG("shm allocation failed for reassembly table %s\n",
+			 name);
+		return NULL;
+	}
+
+	tbl = (odph_ipfrag_impl *)odp_shm_addr(shm);
+	memset(tbl, 0, sizeof(odph_ipfrag_impl) +
+	       sizeof(ipfrag_part_t) * param->num_part);
+
+	strncpy(tbl->name, name, ODP_SHM_NAME_LEN - 1);
+	tbl->max_frags   = param->max_frags;
+	tbl->bucket_mask = num_buckets - 1;
+	tbl->timeout_ns  = param->timeout_ns;
+	tbl->period      = odp_timer_ns_to_tick(param->timer_pool, period_ns);
+	tbl->num_part    = param->num_part;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type    = ODP_POOL_TIMEOUT;
+	pool_param.tmo.num = param->num_part;
+
+	/* Pool memory must not be found with the table name */
+	snprintf(pool_name, sizeof(pool_name), "tmo_%s", name);
+
+	tbl->tmo_pool = odp_pool_create(pool_name, &pool_param);
+	if (tbl->tmo_pool == ODP_POOL_INVALID) {
+		ODPH_DBG("failed to create timeout pool\n");
+		odp_shm_free(shm);
+		return NULL;
+	}
+
+	mem = (uint8_t *)&tbl->part[param->num_part];
+
+	for (i = 0; i < param->num_part; i++) {
+		ipfrag_part_t *part = &tbl->part[i];
+		odp_timeout_t tmo;
+
+		part->flow   = (ipfrag_flow_t *)(void *)mem;
+		part->frag   = (ipfrag_frag_t *)(void *)
+			       &part->flow[param->num_flows];
+		part->bucket = (uint32_t *)(void *)
+			       &part->frag[param->num_flows *
+					   param->max_frags];
+		mem += part_size;
+
+		for (j = 0; j < param->num_flows; j++)
+			part->flow[j].next = j + 1;
+
+		part->flow[param->num_flows - 1].next = IPFRAG_NONE;
+
+		for (j = 0; j < num_buckets; j++)
+			part->bucket[j] = IPFRAG_NONE;
+
+		part->free     = 0;
+		part->lru_head = IPFRAG_NONE;
+		part->lru_tail = IPFRAG_NONE;
+		part->timer    = ODP_TIMER_INVALID;
+		part->tmo_ev   = ODP_EVENT_INVALID;
+
+		/* Timeouts are polled by the partition user */
+		part->queue = odp_queue_create(name, NULL);
+		if (part->queue == ODP_QUEUE_INVALID) {
+			ODPH_DBG("failed to create queue\n");
+			goto error;
+		}
+
+		part->timer = odp_timer_alloc(param->timer_pool, part->queue,
+					      part);
+		if (part->timer == ODP_TIMER_INVALID) {
+			ODPH_DBG("failed to allocate timer\n");
+			goto error;
+		}
+
+		tmo = odp_timeout_alloc(tbl->tmo_pool);
+		if (tmo == ODP_TIMEOUT_INVALID) {
+			ODPH_DBG("failed to allocate timeout\n");
+			goto error;
+		}
+
+		part->tmo_ev = odp_timeout_to_event(tmo);
+		(void)odp_timer_set_rel(part->timer, tbl->period,
+					&part->tmo_ev);
+	}
+
+	tbl->magicword = ODPH_IPFRAG_MAGIC_WORD;
+
+	return (odph_ipfrag_t)tbl;
+
+error:
+	for (j = 0; j <= i; j++)
+		part_term(tbl, &tbl->part[j]);
+
+	(void)odp_pool_destroy(tbl->tmo_pool);
+	odp_shm_free(shm);
+	return NULL;
+}
+
+int odph_ipfrag_destroy(odph_ipfrag_t ipfrag)
+{
+	odph_ipfrag_impl *tbl = (odph_ipfrag_impl *)(void *)ipfrag;
+	odp_shm_t shm;
+	uint32_t i;
+
+	if (tbl == NULL || tbl->magicword != ODPH_IPFRAG_MAGIC_WORD) {
+		ODPH_DBG("wrong magicword for reassembly table\n");
+		return -1;
+	}
+
+	for (i = 0; i < tbl->num_part; i++)
+		part_term(tbl, &tbl->part[i]);
+
+	if (odp_pool_destroy(tbl->tmo_pool)) {
+		ODPH_DBG("failed to destroy timeout pool\n");
+		return -1;
+	}
+
+	tbl->magicword = 0;
+
+	shm = odp_shm_lookup(tbl->name);
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_DBG("unable look up shm\n");
+		return -1;
+	}
+
+	return odp_shm_free(shm);
+}
+
+static uint32_t flow_find(odph_ipfrag_impl *tbl, ipfrag_part_t *part,
+			  const ipfrag_key_t *key, uint32_t hash)
+{
+	uint32_t idx = part->bucket[hash & tbl->bucket_mask];
+
+	while (idx != IPFRAG_NONE) {
+		ipfrag_flow_t *flow = &part->flow[idx];
+
+		if (flow->hash == hash &&
+		    memcmp(&flow->key, key, sizeof(ipfrag_key_t)) == 0)
+			return idx;
+
+		idx = flow->next;
+	}
+
+	return IPFRAG_NONE;
+}
+
+static uint32_t flow_alloc(odph_ipfrag_impl *tbl, ipfrag_part_t *part,
+			   const ipfrag_key_t *key, uint32_t hash)
+{
+	uint32_t idx = part->free;
+	uint32_t *bucket = &part->bucket[hash & tbl->bucket_mask];
+	ipfrag_flow_t *flow;
+
+	if (idx == IPFRAG_NONE)
+		return IPFRAG_NONE;
+
+	flow = &part->flow[idx];
+	part->free = flow->next;
+
+	flow->key   = *key;
+	flow->hash  = hash;
+	flow->start = odp_time_local();
+	flow->total = 0;
+	flow->recv  = 0;
+	flow->num   = 0;
+
+	flow->next = *bucket;
+	*bucket    = idx;
+
+	/* New flows expire last */
+	flow->lru_prev = part->lru_tail;
+	flow->lru_next = IPFRAG_NONE;
+
+	if (part->lru_tail == IPFRAG_NONE)
+		part->lru_head = idx;
+	else
+		part->flow[part->lru_tail].lru_next = idx;
+
+	part->lru_tail = idx;
+	part->stats.held_flows++;
+
+	return idx;
+}
+
+/* Remove flow from the table. Fragments are not freed. */
+static void flow_free(odph_ipfrag_impl *tbl, ipfrag_part_t *part,
+		      uint32_t idx)
+{
+	ipfrag_flow_t *flow = &part->flow[idx];
+	uint32_t *prev = &part->bucket[flow->hash & tbl->bucket_mask];
+
+	while (*prev != idx)
+		prev = &part->flow[*prev].next;
+
+	*prev = flow->next;
+
+	if (flow->lru_prev == IPFRAG_NONE)
+		part->lru_head = flow->lru_next;
+	else
+		part->flow[flow->lru_prev].lru_next = flow->lru_next;
+
+	if (flow->lru_next == IPFRAG_NONE)
+		part->lru_tail = flow->lru_prev;
+	else
+		part->flow[flow->lru_next].lru_prev = flow->lru_prev;
+
+	part->stats.held_flows--;
+	part->stats.held_frags -= flow->num;
+
+	flow->next = part->free;
+	part->free = idx;
+}
+
+static void flow_drop(odph_ipfrag_impl *tbl, ipfrag_part_t *part,
+		      uint32_t idx)
+{
+	ipfrag_frag_t *frag = &part->frag[idx * tbl->max_frags];
+	uint32_t i;
+
+	for (i = 0; i < part->flow[idx].num; i++)
+		odp_packet_free(frag[i].pkt);
+
+	flow_free(tbl, part, idx);
+}
+
+static int part_expire(odph_ipfrag_impl *tbl, ipfrag_part_t *part)
+{
+	odp_time_t now = odp_time_local();
+	int num = 0;
+
+	while (part->lru_head != IPFRAG_NONE) {
+		ipfrag_flow_t *flow = &part->flow[part->lru_head];
+
+		if (odp_time_to_ns(odp_time_diff(now, flow->start)) <
+		    tbl->timeout_ns)
+			break;
+
+		flow_drop(tbl, part, part->lru_head);
+		num++;
+	}
+
+	part->stats.timeouts += num;
+
+	return num;
+}
+
+static inline void part_poll(odph_ipfrag_impl *tbl, ipfrag_part_t *part)
+{
+	odp_event_t ev;
+
+	/* Only held fragments expire. A timeout received meanwhile waits in
+	 * the queue until fragments are held again. */
+	if (part->lru_head == IPFRAG_NONE)
+		return;
+
+	/* Retry a failed timer set */
+	if (odp_unlikely(part->tmo_ev != ODP_EVENT_INVALID))
+		(void)odp_timer_set_rel(part->timer, tbl->period,
+					&part->tmo_ev);
+
+	ev = odp_queue_deq(part->queue);
+
+	if (odp_likely(ev == ODP_EVENT_INVALID))
+		return;
+
+	part_expire(tbl, part);
+
+	part->tmo_ev = ev;
+	(void)odp_timer_set_rel(part->timer, tbl->period, &part->tmo_ev);
+}
+
+int odph_ipfrag_expire(odph_ipfrag_t ipfrag, uint32_t part)
+{
+	odph_ipfrag_impl *tbl = (odph_ipfrag_impl *)(void *)ipfrag;
+
+	return part_expire(tbl, &tbl->part[part]);
+}
+
+/* Find IPv6 fragment header. Returns its offset, zero when not found, or
+ * <0 on a bad header. The offset of the next header field that points to
+ * the fragment header is written into 'nh_off'. */
+static int ipv6_frag_find(const uint8_t *l3, uint32_t len, uint32_t *nh_off)
+{
+	uint32_t off = ODPH_IPV6HDR_LEN;
+	uint32_t nh_field = offsetof(odph_ipv6hdr_t, next_hdr);
+	uint8_t nh = l3[nh_field];
+
+	while (nh == ODPH_IPPROTO_HOPOPTS || nh == ODPH_IPPROTO_ROUTE ||
+	       nh == ODPH_IPPROTO_DEST) {
+		if (off + sizeof(odph_ipv6hdr_ext_t) > len)
+			return -1;
+
+		nh_field = off;
+		nh   = l3[off];
+		off += 8 + 8 * l3[off + 1];
+	}
+
+	if (nh != ODPH_IPPROTO_FRAG)
+		return 0;
+
+	if (off + ODPH_IPV6HDR_FRAG_LEN > len)
+		return -1;
+
+	*nh_off = nh_field;
+	return off;
+}
+
+/* Returns 0 for a fragment, 1 for other packets, or <0 on a bad header */
+static int frag_parse(odp_packet_t pkt, ipfrag_info_t *info)
+{
+	uint32_t l3_off = odp_packet_l3_offset(pkt);
+	uint32_t pkt_len = odp_packet_len(pkt);
+	uint32_t seg_len, ip_len, hdr_len;
+	const uint8_t *l3;
+	uint16_t frag;
+
+	if (l3_off == ODP_PACKET_OFFSET_INVALID)
+		return 1;
+
+	l3 = odp_packet_l3_ptr(pkt, &seg_len);
+	if (l3 == NULL)
+		return 1;
+
+	memset(&info->key, 0, sizeof(ipfrag_key_t));
+
+	if ((l3[0] >> 4) == ODPH_IPV4) {
+		const odph_ipv4hdr_t *ip = (const void *)l3;
+
+		if (seg_len < ODPH_IPV4HDR_LEN)
+			return -1;
+
+		frag = odp_be_to_cpu_16(ip->frag_offset);
+		if (!ODPH_IPV4HDR_IS_FRAGMENT(frag))
+			return 1;
+
+		hdr_len = ODPH_IPV4HDR_IHL(ip->ver_ihl) * 4;
+		ip_len  = odp_be_to_cpu_16(ip->tot_len);
+
+		if (hdr_len < ODPH_IPV4HDR_LEN || hdr_len > seg_len ||
+		    ip_len < hdr_len)
+			return -1;
+
+		info->key.ver    = ODPH_IPV4;
+		info->key.proto  = ip->proto;
+		info->key.src[0] = ip->src_addr;
+		info->key.dst[0] = ip->dst_addr;
+		info->key.id     = ip->id;
+		info->offset     = ODPH_IPV4HDR_FRAG_OFFSET(frag) * 8;
+		info->more       = !!ODPH_IPV4HDR_FLAGS_MORE_FRAGS(frag);
+	} else if ((l3[0] >> 4) == ODPH_IPV6) {
+		const odph_ipv6hdr_t *ip = (const void *)l3;
+		const odph_ipv6hdr_frag_t *fh;
+		uint32_t nh_off;
+		int frag_off;
+
+		if (seg_len < ODPH_IPV6HDR_LEN)
+			return -1;
+
+		ip_len = odp_be_to_cpu_16(ip->payload_len) + ODPH_IPV6HDR_LEN;
+
+		frag_off = ipv6_frag_find(l3, ip_len < seg_len ? ip_len :
+					  seg_len, &nh_off);
+		if (frag_off <= 0)
+			return frag_off < 0 ? -1 : 1;
+
+		fh      = (const void *)&l3[frag_off];
+		frag    = odp_be_to_cpu_16(fh->frag_offset);
+		hdr_len = frag_off + ODPH_IPV6HDR_FRAG_LEN;
+
+		info->key.ver = ODPH_IPV6;
+		memcpy(info->key.src, ip->src_addr, ODPH_IPV6ADDR_LEN);
+		memcpy(info->key.dst, ip->dst_addr, ODPH_IPV6ADDR_LEN);
+		info->key.id  = fh->id;
+		info->offset  = ODPH_IPV6HDR_FRAG_OFFSET(frag);
+		info->more    = !!ODPH_IPV6HDR_FRAG_MORE(frag);
+	} else {
+		return 1;
+	}
+
+	if (l3_off + ip_len > pkt_len)
+		return -1;
+
+	info->len     = ip_len - hdr_len;
+	info->hdr_len = l3_off + hdr_len;
+	info->pad     = pkt_len - l3_off - ip_len;
+
+	/* Other than the last fragment carry multiples of 8 bytes */
+	if (info->more && (info->len == 0 || (info->len & 7)))
+		return -1;
+
+	if (info->offset + ip_len > UINT16_MAX)
+		return -1;
+
+	return 0;
+}
+
+/* Build the datagram from fragments, which are freed */
+static odp_packet_t flow_reass(odph_ipfrag_impl *tbl, ipfrag_part_t *part,
+			       uint32_t idx)
+{
+	ipfrag_flow_t *flow = &part->flow[idx];
+	ipfrag_frag_t *frag = &part->frag[idx * tbl->max_frags];
+	odp_packet_t pkt = frag[0].pkt;
+	uint32_t num = flow->num;
+	uint32_t total = flow->total;
+	uint8_t ver = flow->key.ver;
+	uint32_t l3_off, l4_off, i;
+	uint8_t *l3;
+	uint8_t proto;
+
+	flow_free(tbl, part, idx);
+
+	/* Payload of other fragments is appended to the first fragment */
+	for (i = 1; i < num; i++) {
+		odp_packet_t p = frag[i].pkt;
+
+		if (odp_packet_pull_head(p, frag[i].hdr_len) == NULL ||
+		    odp_packet_concat(&pkt, p) < 0)
+			break;
+	}
+
+	if (odp_unlikely(i < num)) {
+		for (; i < num; i++)
+			odp_packet_free(frag[i].pkt);
+
+		odp_packet_free(pkt);
+		return ODP_PACKET_INVALID;
+	}
+
+	l3_off = odp_packet_l3_offset(pkt);
+	l3     = odp_packet_l3_ptr(pkt, NULL);
+
+	if (ver == ODPH_IPV4) {
+		odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)(void *)l3;
+		uint32_t hdr_len = ODPH_IPV4HDR_IHL(ip->ver_ihl) * 4;
+
+		ip->tot_len      = odp_cpu_to_be_16(hdr_len + total);
+		ip->frag_offset &= odp_cpu_to_be_16(~0x3fff);
+		ip->chksum       = 0;
+		ip->chksum       = odph_chksum(ip, hdr_len);
+
+		proto  = ip->proto;
+		l4_off = l3_off + hdr_len;
+	} else {
+		odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(void *)l3;
+		odph_ipv6hdr_frag_t *fh;
+		uint32_t nh_off;
+		int frag_off;
+
+		frag_off = ipv6_frag_find(l3, frag[0].hdr_len - l3_off,
+					  &nh_off);
+		fh = (odph_ipv6hdr_frag_t *)(void *)&l3[frag_off];
+
+		proto        = fh->next_hdr;
+		l3[nh_off]   = proto;
+		ip->payload_len = odp_cpu_to_be_16(frag_off - ODPH_IPV6HDR_LEN +
+						   total);
+
+		/* Remove fragment header */
+		if (odp_packet_move_data(pkt, ODPH_IPV6HDR_FRAG_LEN, 0,
+					 l3_off + frag_off) ||
+		    odp_packet_pull_head(pkt, ODPH_IPV6HDR_FRAG_LEN) == NULL) {
+			odp_packet_free(pkt);
+			return ODP_PACKET_INVALID;
+		}
+
+		l4_off = l3_off + frag_off;
+	}
+
+	odp_packet_has_ipfrag_set(pkt, 0);
+	odp_packet_l4_offset_set(pkt, l4_off);
+	odp_packet_has_udp_set(pkt, proto == ODPH_IPPROTO_UDP);
+	odp_packet_has_tcp_set(pkt, proto == ODPH_IPPROTO_TCP);
+
+	return pkt;
+}
+
+int odph_ipfrag_reass(odph_ipfrag_t ipfrag, uint32_t part_idx,
+		      odp_packet_t pkt, odp_packet_t *out)
+{
+	odph_ipfrag_impl *tbl = (odph_ipfrag_impl *)(void *)ipfrag;
+	ipfrag_part_t *part = &tbl->part[part_idx];
+	ipfrag_info_t info;
+	ipfrag_flow_t *flow;
+	ipfrag_frag_t *frag;
+	uint32_t idx, hash, end, i;
+	int ret;
+
+	part_poll(tbl, part);
+
+	ret = frag_parse(pkt, &info);
+
+	if (ret > 0) {
+		*out = pkt;
+		return 1;
+	}
+
+	part->stats.frags++;
+
+	if (odp_unlikely(ret < 0))
+		goto error;
+
+	hash = odp_hash_crc32c(&info.key, sizeof(ipfrag_key_t), 0);
+	idx  = flow_find(tbl, part, &info.key, hash);
+
+	if (idx == IPFRAG_NONE) {
+		idx = flow_alloc(tbl, part, &info.key, hash);
+
+		if (odp_unlikely(idx == IPFRAG_NONE))
+			goto error;
+	}
+
+	flow = &part->flow[idx];
+	frag = &part->frag[idx * tbl->max_frags];
+	end  = info.offset + info.len;
+
+	for (i = flow->num; i > 0 && frag[i - 1].offset > info.offset; i--)
+		;
+
+	/* Datagrams with overlapping or too many fragments are dropped
+	 * (RFC 5722) */
+	if (odp_unlikely(flow->num == tbl->max_frags ||
+			 (i > 0 && frag[i - 1].offset + frag[i - 1].len >
+			  info.offset) ||
+			 (i < flow->num && (end > frag[i].offset ||
+					    !info.more)) ||
+			 (flow->total && (!info.more || end > flow->total)))) {
+		flow_drop(tbl, part, idx);
+		goto error;
+	}
+
+	/* Remove L2 padding */
+	if (info.pad && odp_packet_trunc_tail(&pkt, info.pad, NULL, NULL) < 0) {
+		if (flow->num == 0)
+			flow_free(tbl, part, idx);
+		goto error;
+	}
+
+	memmove(&frag[i + 1], &frag[i], (flow->num - i) * sizeof(*frag));
+	frag[i].pkt     = pkt;
+	frag[i].offset  = info.offset;
+	frag[i].len     = info.len;
+	frag[i].hdr_len = info.hdr_len;
+
+	flow->num++;
+	flow->recv += info.len;
+	part->stats.held_frags++;
+
+	if (!info.more)
+		flow->total = end;
+
+	if (flow->total == 0 || flow->recv != flow->total)
+		return 0;
+
+	*out = flow_reass(tbl, part, idx);
+
+	if (odp_unlikely(*out == ODP_PACKET_INVALID)) {
+		part->stats.errors++;
+		return -1;
+	}
+
+	part->stats.reass++;
+	return 1;
+
+error:
+	part->stats.errors++;
+	odp_packet_free(pkt);
+	return -1;
+}
+
+void odph_ipfrag_stats(odph_ipfrag_t ipfrag, odph_ipfrag_stats_t *stats)
+{
+	odph_ipfrag_impl *tbl = (odph_ipfrag_impl *)(void *)ipfrag;
+	uint32_t i;
+
+	memset(stats, 0, sizeof(odph_ipfrag_stats_t));
+
+	for (i = 0; i < tbl->num_part; i++) {
+		odph_ipfrag_stats_t *s = &tbl->part[i].stats;
+
+		stats->frags      += s->frags;
+		stats->reass      += s->reass;
+		stats->timeouts   += s->timeouts;
+		stats->errors     += s->errors;
+		stats->held_flows += s->held_flows;
+		stats->held_frags += s->held_frags;
+	}
+}
+
+/* Copy IPv4 header with the options that are copied into all fragments
+ * (RFC 791). Returns the header length. */
+static uint32_t ipv4_hdr_copy(uint8_t *dst, const uint8_t *src,
+			      uint32_t hdr_len)
+{
+	uint32_t i = ODPH_IPV4HDR_LEN;
+	uint32_t len = ODPH_IPV4HDR_LEN;
+	uint32_t opt_len;
+
+	memcpy(dst, src, ODPH_IPV4HDR_LEN);
+
+	while (i < hdr_len && src[i] != 0) {
+		/* No operation */
+		if (src[i] == 1) {
+			i++;
+			continue;
+		}
+
+		if (i + 1 >= hdr_len)
+			break;
+
+		opt_len = src[i + 1];
+		if (opt_len < 2 || i + opt_len > hdr_len)
+			break;
+
+		if (src[i] & IPV4_OPT_COPIED) {
+			memcpy(&dst[len], &src[i], opt_len);
+			len += opt_len;
+		}
+
+		i += opt_len;
+	}
+
+	/* Pad with end of options */
+	while (len & 3)
+		dst[len++] = 0;
+
+	dst[0] = (ODPH_IPV4 << 4) | (len / 4);
+
+	return len;
+}
+
+/* Find the end of the IPv6 unfragmentable part: hop-by-hop and routing
+ * headers, and destination options before a routing header. Returns its
+ * length, or <0 when the datagram cannot be fragmented. The offset of the
+ * next header field of the last unfragmentable header is written into
+ * 'nh_off'. */
+static int ipv6_unfrag_len(const uint8_t *l3, uint32_t len, uint32_t *nh_off)
+{
+	uint32_t off = ODPH_IPV6HDR_LEN;
+	uint32_t nh_field = offsetof(odph_ipv6hdr_t, next_hdr);
+	uint32_t end = off;
+	uint32_t end_nh = nh_field;
+	uint8_t nh = l3[nh_field];
+
+	while (nh == ODPH_IPPROTO_HOPOPTS || nh == ODPH_IPPROTO_ROUTE ||
+	       nh == ODPH_IPPROTO_DEST) {
+		uint8_t type = nh;
+
+		if (off + sizeof(odph_ipv6hdr_ext_t) > len)
+			return -1;
+
+		nh_field = off;
+		nh   = l3[off];
+		off += 8 + 8 * l3[off + 1];
+
+		if (type != ODPH_IPPROTO_DEST) {
+			end    = off;
+			end_nh = nh_field;
+		}
+	}
+
+	if (nh == ODPH_IPPROTO_FRAG || end > len)
+		return -1;
+
+	*nh_off = end_nh;
+	return end;
+}
+
+int odph_ipfrag_frag(odp_packet_t pkt, uint32_t mtu, uint32_t id,
+		     odp_packet_t frag[], int num)
+{
+	uint8_t hdr[IPFRAG_HDR_MAX + ODPH_IPV6HDR_FRAG_LEN];
+	uint32_t l3_off, l2_off, seg_len, pkt_len;
+	uint32_t ip_len, hdr_len, frag_hdr_len;
+	uint32_t payload, first, chunk, off, len;
+	uint32_t base = 0;
+	uint32_t nh_off = 0;
+	uint16_t flags = 0;
+	odp_u32be_t id_be;
+	odp_u16be_t frag_be;
+	odp_pool_t pool;
+	uint8_t *l3;
+	int ipv4, n, i;
+
+	l3_off = odp_packet_l3_offset(pkt);
+	l3     = odp_packet_l3_ptr(pkt, &seg_len);
+
+	if (l3_off == ODP_PACKET_OFFSET_INVALID || l3 == NULL || num < 1)
+		return -1;
+
+	ipv4    = (l3[0] >> 4) == ODPH_IPV4;
+	pkt_len = odp_packet_len(pkt);
+
+	if (ipv4) {
+		odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)(void *)l3;
+		uint16_t frag_offset;
+
+		if (seg_len < ODPH_IPV4HDR_LEN)
+			return -1;
+
+		ip_len  = odp_be_to_cpu_16(ip->tot_len);
+		hdr_len = ODPH_IPV4HDR_IHL(ip->ver_ihl) * 4;
+
+		if (hdr_len < ODPH_IPV4HDR_LEN || hdr_len > seg_len ||
+		    ip_len < hdr_len || l3_off + ip_len > pkt_len)
+			return -1;
+
+		if (ip_len <= mtu)
+			goto no_frag;
+
+		frag_offset = odp_be_to_cpu_16(ip->frag_offset);
+		if (ODPH_IPV4HDR_FLAGS_DONT_FRAG(frag_offset))
+			return -1;
+
+		/* A fragment may be fragmented further */
+		base  = ODPH_IPV4HDR_FRAG_OFFSET(frag_offset) * 8;
+		flags = frag_offset & 0x2000;
+
+		frag_hdr_len = ipv4_hdr_copy(hdr, l3, hdr_len);
+		payload = ip_len - hdr_len;
+		first   = mtu > hdr_len ? (mtu - hdr_len) & ~7 : 0;
+	} else if ((l3[0] >> 4) == ODPH_IPV6) {
+		odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(void *)l3;
+		int unfrag;
+
+		if (seg_len < ODPH_IPV6HDR_LEN)
+			return -1;
+
+		ip_len = odp_be_to_cpu_16(ip->payload_len) + ODPH_IPV6HDR_LEN;
+
+		if (l3_off + ip_len > pkt_len)
+			return -1;
+
+		if (ip_len <= mtu)
+			goto no_frag;
+
+		unfrag = ipv6_unfrag_len(l3, ip_len < seg_len ? ip_len :
+					 seg_len, &nh_off);
+		if (unfrag < 0 || unfrag > IPFRAG_HDR_MAX)
+			return -1;
+
+		/* Fragment header is inserted after the unfragmentable part */
+		hdr_len = unfrag;
+		memcpy(hdr, l3, hdr_len);
+		hdr[hdr_len] = hdr[nh_off];
+		hdr[hdr_len + 1] = 0;
+		hdr[nh_off] = ODPH_IPPROTO_FRAG;
+		id_be = odp_cpu_to_be_32(id);
+		memcpy(&hdr[hdr_len + 4], &id_be, sizeof(id_be));
+
+		frag_hdr_len = hdr_len + ODPH_IPV6HDR_FRAG_LEN;
+		payload = ip_len - hdr_len;
+		first   = mtu > frag_hdr_len ? (mtu - frag_hdr_len) & ~7 : 0;
+	} else {
+		return -1;
+	}
+
+	chunk = mtu > frag_hdr_len ? (mtu - frag_hdr_len) & ~7 : 0;
+
+	if (first == 0 || chunk == 0)
+		return -1;
+
+	n = 1 + (payload - first + chunk - 1) / chunk;
+	if (n > num)
+		return -1;
+
+	pool   = odp_packet_pool(pkt);
+	l2_off = odp_packet_l2_offset(pkt);
+
+	/* Fragments other than the first copy their payload */
+	for (i = 1, off = first; i < n; i++, off += len) {
+		odp_packet_t f;
+		uint16_t frag_offset;
+		int more = i < n - 1;
+
+		len = payload - off < chunk ? payload - off : chunk;
+
+		if (ipv4) {
+			odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)(void *)hdr;
+
+			frag_offset = (base + off) / 8;
+			if (more || flags)
+				frag_offset |= 0x2000;
+
+			ip->tot_len     = odp_cpu_to_be_16(frag_hdr_len + len);
+			ip->frag_offset = odp_cpu_to_be_16(frag_offset);
+			ip->chksum      = 0;
+			ip->chksum      = odph_chksum(ip, frag_hdr_len);
+		} else {
+			odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(void *)hdr;
+
+			ip->payload_len = odp_cpu_to_be_16(frag_hdr_len + len -
+							   ODPH_IPV6HDR_LEN);
+			frag_be = odp_cpu_to_be_16(off | more);
+			memcpy(&hdr[hdr_len + 2], &frag_be, sizeof(frag_be));
+		}
+
+		f = odp_packet_alloc(pool, l3_off + frag_hdr_len + len);
+		if (f == ODP_PACKET_INVALID)
+			goto error;
+
+		frag[i] = f;
+
+		if ((l3_off &&
+		     odp_packet_copy_from_pkt(f, 0, pkt, 0, l3_off)) ||
+		    odp_packet_copy_from_mem(f, l3_off, frag_hdr_len, hdr) ||
+		    odp_packet_copy_from_pkt(f, l3_off + frag_hdr_len, pkt,
+					     l3_off + hdr_len + off, len)) {
+			i++;
+			goto error;
+		}
+
+		if (l2_off != ODP_PACKET_OFFSET_INVALID)
+			odp_packet_l2_offset_set(f, l2_off);
+
+		odp_packet_l3_offset_set(f, l3_off);
+		odp_packet_has_l2_set(f, odp_packet_has_l2(pkt));
+		odp_packet_has_eth_set(f, odp_packet_has_eth(pkt));
+		odp_packet_has_ipv4_set(f, ipv4);
+		odp_packet_has_ipv6_set(f, !ipv4);
+		odp_packet_has_ipfrag_set(f, 1);
+	}
+
+	/* First fragment reuses the packet */
+	if (ipv4) {
+		odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)(void *)l3;
+
+		ip->tot_len      = odp_cpu_to_be_16(hdr_len + first);
+		ip->frag_offset |= odp_cpu_to_be_16(0x2000);
+		ip->chksum       = 0;
+		ip->chksum       = odph_chksum(ip, hdr_len);
+	} else {
+		odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(void *)hdr;
+
+		ip->payload_len = odp_cpu_to_be_16(frag_hdr_len + first -
+						   ODPH_IPV6HDR_LEN);
+		frag_be = odp_cpu_to_be_16(1);
+		memcpy(&hdr[hdr_len + 2], &frag_be, sizeof(frag_be));
+
+		if (odp_packet_extend_head(&pkt, ODPH_IPV6HDR_FRAG_LEN,
+					   NULL, NULL) < 0)
+			goto error;
+
+		if (l3_off)
+			(void)odp_packet_move_data(pkt, 0,
+						   ODPH_IPV6HDR_FRAG_LEN,
+						   l3_off);
+
+		(void)odp_packet_copy_from_mem(pkt, l3_off, frag_hdr_len, hdr);
+		hdr_len = frag_hdr_len;
+	}
+
+	(void)odp_packet_trunc_tail(&pkt, odp_packet_len(pkt) -
+				    (l3_off + hdr_len + first), NULL, NULL);
+
+	odp_packet_has_ipfrag_set(pkt, 1);
+	frag[0] = pkt;
+
+	return n;
+
+no_frag:
+	frag[0] = pkt;
+	return 1;
+
+error:
+	while (--i > 0)
+		odp_packet_free(frag[i]);
+
+	return -1;
+}
@@ -18,6 +18,72 @@ struct udata_struct {
 	"abcdefg",
 };
 
+#define TEST_DATA_LEN 9018
+
+static uint8_t test_data[TEST_DATA_LEN + 8];
+
+/* Reference one's complement sum: 16-bit words, one at a time */
+static uint32_t ref_sum(const uint8_t *data, uint32_t len)
+{
+	uint32_t sum = 0;
+	uint16_t word;
+	uint8_t last[2];
+
+	for (; len > 1; len -= 2, data += 2) {
+		memcpy(&word, data, 2);
+		sum += word;
+	}
+
+	if (len) {
+		last[0] = *data;
+		last[1] = 0;
+		memcpy(&word, last, 2);
+		sum += word;
+	}
+
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+
+	return sum;
+}
+
+/* Compare the vector sum kernels against the reference over various
+ * lengths and alignments */
+static int test_chksum_partial(void)
+{
+	uint32_t len, off, i, sum;
+	uint32_t seed = 1;
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		seed = seed * 1103515245 + 12345;
+		test_data[i] = seed >> 16;
+	}
+
+	for (off = 0; off < 8; off++) {
+		for (len = 0; len <= TEST_DATA_LEN;
+		     len += (len < 300) ? 1 : 97) {
+			sum = odph_chksum_partial(&test_data[off], len, 0);
+
+			if (sum != ref_sum(&test_data[off], len)) {
+				ODPH_ERR("Bad sum: offset %u, len %u\n",
+					 off, len);
+				return -1;
+			}
+		}
+	}
+
+	/* Continued sum equals the sum over the concatenated data */
+	sum = odph_chksum_partial(test_data, 1000, 0);
+	sum = odph_chksum_partial(&test_data[1000], 501, sum);
+
+	if (sum != ref_sum(test_data, 1501)) {
+		ODPH_ERR("Bad continued sum\n");
+		return -1;
+	}
+
+	return 0;
+}
+
 /* Create additional dataplane threads */
 int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
 {
@@ -132,6 +198,31 @@ int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
 	if (odp_be_to_cpu_16(udp->chksum) != 0x7e5a)
 		status = -1;
 
+	if (test_chksum_partial())
+		status = -1;
+
+	/* Incremental updates keep the checksums valid */
+	ip->ttl = 64;
+	ip->chksum = 0;
+	odph_ipv4_csum_update(test_packet);
+	odph_ipv4_ttl_dec(ip);
+
+	if (ip->ttl != 63 || !odph_ipv4_csum_valid(test_packet)) {
+		ODPH_ERR("Bad checksum after TTL decrement\n");
+		status = -1;
+	}
+
+	udp->chksum = 0;
+	udp->chksum = odph_ipv4_udp_chksum(test_packet);
+	odph_ipv4_nat(ip, udp, 0, odp_cpu_to_be_32(0x0a000001),
+		      odp_cpu_to_be_16(40000));
+
+	if (!odph_ipv4_csum_valid(test_packet) ||
+	    odph_udp_chksum_verify(test_packet) != 0) {
+		ODPH_ERR("Bad checksum after NAT\n");
+		status = -1;
+	}
+
 	odp_packet_free(test_packet);
 	if (odp_pool_destroy(packet_pool) != 0)
 		return -1;
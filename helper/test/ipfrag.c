@@ -0,0 +1,379 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "odph_debug.h"
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TEST_MAX_LEN  9000
+#define TEST_MAX_FRAG 32
+#define TEST_TMO_NS   (100 * ODP_TIME_MSEC_IN_NS)
+
+static uint8_t data_ref[TEST_MAX_LEN];
+static uint8_t data_out[TEST_MAX_LEN];
+
+static odp_pool_t pool;
+static odph_ipfrag_t tbl;
+
+/* Header checksum including options */
+static int ipv4_csum_valid(odp_packet_t pkt)
+{
+	odph_ipv4hdr_t *ip = odp_packet_l3_ptr(pkt, NULL);
+
+	return odph_chksum(ip, ODPH_IPV4HDR_IHL(ip->ver_ihl) * 4) == 0;
+}
+
+/* IPv4 UDP datagram with a router alert option, which is copied into all
+ * fragments */
+static odp_packet_t create_ipv4(uint32_t len, uint16_t id)
+{
+	uint32_t hdr_len = ODPH_IPV4HDR_LEN + 4;
+	uint32_t l4_off = ODPH_ETHHDR_LEN + hdr_len;
+	odp_packet_t pkt;
+	odph_ethhdr_t *eth;
+	odph_ipv4hdr_t *ip;
+	odph_udphdr_t *udp;
+	uint8_t *data;
+	uint32_t i;
+
+	pkt = odp_packet_alloc(pool, l4_off + ODPH_UDPHDR_LEN + len);
+	if (pkt == ODP_PACKET_INVALID)
+		return pkt;
+
+	data = odp_packet_data(pkt);
+	memset(data, 0, l4_off + ODPH_UDPHDR_LEN);
+
+	eth = (odph_ethhdr_t *)data;
+	eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+
+	ip = (odph_ipv4hdr_t *)(data + ODPH_ETHHDR_LEN);
+	ip->ver_ihl  = ODPH_IPV4 << 4 | (hdr_len / 4);
+	ip->tot_len  = odp_cpu_to_be_16(hdr_len + ODPH_UDPHDR_LEN + len);
+	ip->id       = odp_cpu_to_be_16(id);
+	ip->ttl      = 64;
+	ip->proto    = ODPH_IPPROTO_UDP;
+	ip->src_addr = odp_cpu_to_be_32(0x0a000001);
+	ip->dst_addr = odp_cpu_to_be_32(0x0a000002);
+	data[ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN]     = 0x94;
+	data[ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN + 1] = 4;
+
+	udp = (odph_udphdr_t *)(data + l4_off);
+	udp->src_port = odp_cpu_to_be_16(1000);
+	udp->dst_port = odp_cpu_to_be_16(id);
+	udp->length   = odp_cpu_to_be_16(ODPH_UDPHDR_LEN + len);
+
+	for (i = 0; i < len; i++)
+		data_ref[i] = i + id;
+
+	odp_packet_copy_from_mem(pkt, l4_off + ODPH_UDPHDR_LEN, len, data_ref);
+
+	odp_packet_l2_offset_set(pkt, 0);
+	odp_packet_l3_offset_set(pkt, ODPH_ETHHDR_LEN);
+	odp_packet_l4_offset_set(pkt, l4_off);
+	odp_packet_has_eth_set(pkt, 1);
+	odp_packet_has_ipv4_set(pkt, 1);
+	odp_packet_has_udp_set(pkt, 1);
+	ip->chksum = odph_chksum(ip, hdr_len);
+
+	return pkt;
+}
+
+/* IPv6 UDP datagram with a hop-by-hop options header */
+static odp_packet_t create_ipv6(uint32_t len, uint8_t id)
+{
+	uint32_t l4_off = ODPH_ETHHDR_LEN + ODPH_IPV6HDR_LEN + 8;
+	odp_packet_t pkt;
+	odph_ethhdr_t *eth;
+	odph_ipv6hdr_t *ip;
+	odph_udphdr_t *udp;
+	uint8_t *data;
+	uint32_t i;
+
+	pkt = odp_packet_alloc(pool, l4_off + ODPH_UDPHDR_LEN + len);
+	if (pkt == ODP_PACKET_INVALID)
+		return pkt;
+
+	data = odp_packet_data(pkt);
+	memset(data, 0, l4_off + ODPH_UDPHDR_LEN);
+
+	eth = (odph_ethhdr_t *)data;
+	eth->type = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV6);
+
+	ip = (odph_ipv6hdr_t *)(data + ODPH_ETHHDR_LEN);
+	ip->ver_tc_flow = odp_cpu_to_be_32(ODPH_IPV6 <<
+					   ODPH_IPV6HDR_VERSION_SHIFT);
+	ip->payload_len = odp_cpu_to_be_16(8 + ODPH_UDPHDR_LEN + len);
+	ip->next_hdr    = ODPH_IPPROTO_HOPOPTS;
+	ip->hop_limit   = 64;
+	ip->src_addr[15] = 1;
+	ip->dst_addr[15] = id;
+	data[ODPH_ETHHDR_LEN + ODPH_IPV6HDR_LEN] = ODPH_IPPROTO_UDP;
+
+	udp = (odph_udphdr_t *)(data + l4_off);
+	udp->src_port = odp_cpu_to_be_16(1000);
+	udp->dst_port = odp_cpu_to_be_16(id);
+	udp->length   = odp_cpu_to_be_16(ODPH_UDPHDR_LEN + len);
+
+	for (i = 0; i < len; i++)
+		data_ref[i] = i * id;
+
+	odp_packet_copy_from_mem(pkt, l4_off + ODPH_UDPHDR_LEN, len, data_ref);
+
+	odp_packet_l2_offset_set(pkt, 0);
+	odp_packet_l3_offset_set(pkt, ODPH_ETHHDR_LEN);
+	odp_packet_l4_offset_set(pkt, l4_off);
+	odp_packet_has_eth_set(pkt, 1);
+	odp_packet_has_ipv6_set(pkt, 1);
+	odp_packet_has_udp_set(pkt, 1);
+
+	return pkt;
+}
+
+/* Fragment a copy of the packet, reassemble fragments in reverse order and
+ * compare the result against the original */
+static int test_roundtrip(odp_packet_t pkt, uint32_t mtu, int ipv4)
+{
+	odp_packet_t frag[TEST_MAX_FRAG];
+	odp_packet_t ref, out = ODP_PACKET_INVALID;
+	uint32_t len = odp_packet_len(pkt);
+	int num, i, ret;
+
+	ref = odp_packet_copy(pkt, pool);
+	if (ref == ODP_PACKET_INVALID)
+		return -1;
+
+	odp_packet_copy_to_mem(ref, 0, len, data_ref);
+
+	num = odph_ipfrag_frag(pkt, mtu, 1234, frag, TEST_MAX_FRAG);
+	if (num < 2) {
+		ODPH_ERR("Fragmentation failed: %i\n", num);
+		return -1;
+	}
+
+	for (i = 0; i < num; i++) {
+		uint32_t ip_len = odp_packet_len(frag[i]) - ODPH_ETHHDR_LEN;
+
+		if (ip_len > mtu || !odp_packet_has_ipfrag(frag[i])) {
+			ODPH_ERR("Bad fragment %i, len %u\n", i, ip_len);
+			return -1;
+		}
+
+		if (ipv4 && !ipv4_csum_valid(frag[i])) {
+			ODPH_ERR("Bad fragment %i checksum\n", i);
+			return -1;
+		}
+	}
+
+	if (ipv4) {
+		/* Copied option is included in all fragments */
+		odph_ipv4hdr_t *ip = odp_packet_l3_ptr(frag[num - 1], NULL);
+
+		if (ODPH_IPV4HDR_IHL(ip->ver_ihl) != 6) {
+			ODPH_ERR("Option not copied\n");
+			return -1;
+		}
+	}
+
+	for (i = num - 1; i >= 0; i--) {
+		ret = odph_ipfrag_reass(tbl, 0, frag[i], &out);
+
+		if (ret != (i ? 0 : 1)) {
+			ODPH_ERR("Reassembly failed at %i: %i\n", i, ret);
+			return -1;
+		}
+	}
+
+	if (odp_packet_len(out) != len) {
+		ODPH_ERR("Bad length %u, expected %u\n", odp_packet_len(out),
+			 len);
+		return -1;
+	}
+
+	odp_packet_copy_to_mem(out, 0, len, data_out);
+
+	if (memcmp(data_out, data_ref, len) ||
+	    odp_packet_has_ipfrag(out) || !odp_packet_has_udp(out) ||
+	    (ipv4 && !ipv4_csum_valid(out))) {
+		ODPH_ERR("Bad datagram\n");
+		return -1;
+	}
+
+	odp_packet_free(out);
+	odp_packet_free(ref);
+
+	return 0;
+}
+
+static int test_errors(void)
+{
+	odp_packet_t frag[TEST_MAX_FRAG];
+	odp_packet_t dup, out;
+	odph_ipfrag_stats_t stats;
+	int num, i;
+
+	/* Not a fragment */
+	frag[0] = create_ipv4(100, 3);
+	if (odph_ipfrag_reass(tbl, 1, frag[0], &out) != 1 || out != frag[0]) {
+		ODPH_ERR("Datagram not passed through\n");
+		return -1;
+	}
+
+	odp_packet_free(out);
+
+	/* Don't fragment */
+	frag[0] = create_ipv4(2000, 4);
+	((odph_ipv4hdr_t *)odp_packet_l3_ptr(frag[0], NULL))->frag_offset =
+		odp_cpu_to_be_16(0x4000);
+
+	if (odph_ipfrag_frag(frag[0], 1500, 0, &frag[1], 4) >= 0) {
+		ODPH_ERR("Fragmented with DF set\n");
+		return -1;
+	}
+
+	odp_packet_free(frag[0]);
+
+	/* Overlapping fragment drops the datagram */
+	num = odph_ipfrag_frag(create_ipv4(3000, 5), 1500, 0, frag,
+			       TEST_MAX_FRAG);
+	dup = odp_packet_copy(frag[1], pool);
+
+	if (num != 3 || dup == ODP_PACKET_INVALID ||
+	    odph_ipfrag_reass(tbl, 1, frag[0], &out) != 0 ||
+	    odph_ipfrag_reass(tbl, 1, frag[1], &out) != 0 ||
+	    odph_ipfrag_reass(tbl, 1, dup, &out) >= 0) {
+		ODPH_ERR("Overlap not detected\n");
+		return -1;
+	}
+
+	odp_packet_free(frag[2]);
+
+	/* Incomplete datagram times out */
+	num = odph_ipfrag_frag(create_ipv6(3000, 6), 1280, 7, frag,
+			       TEST_MAX_FRAG);
+
+	if (num != 3 || odph_ipfrag_reass(tbl, 1, frag[0], &out) != 0) {
+		ODPH_ERR("Reassembly failed\n");
+		return -1;
+	}
+
+	for (i = 1; i < num; i++)
+		odp_packet_free(frag[i]);
+
+	odph_ipfrag_stats(tbl, &stats);
+	if (stats.held_flows != 1 || stats.held_frags != 1) {
+		ODPH_ERR("Bad held counts\n");
+		return -1;
+	}
+
+	odp_time_wait_ns(3 * TEST_TMO_NS);
+	out = create_ipv4(100, 8);
+	if (odph_ipfrag_reass(tbl, 1, out, &out) != 1)
+		return -1;
+
+	odp_packet_free(out);
+
+	odph_ipfrag_stats(tbl, &stats);
+	printf("frags %" PRIu64 ", reass %" PRIu64 ", timeouts %" PRIu64
+	       ", errors %" PRIu64 "\n", stats.frags, stats.reass,
+	       stats.timeouts, stats.errors);
+
+	if (stats.timeouts != 1 || stats.errors != 1 ||
+	    stats.held_flows != 0 || stats.held_frags != 0) {
+		ODPH_ERR("Bad statistics\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(int argc ODPH_UNUSED, char *argv[] ODPH_UNUSED)
+{
+	odp_instance_t instance;
+	odp_pool_param_t params;
+	odp_timer_pool_param_t tparams;
+	odp_timer_pool_t timer_pool;
+	odph_ipfrag_param_t param;
+	int status = 0;
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		ODPH_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_WORKER)) {
+		ODPH_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_PACKET;
+	params.pkt.len = TEST_MAX_LEN;
+	params.pkt.num = 64;
+
+	pool = odp_pool_create("packet_pool", &params);
+	if (pool == ODP_POOL_INVALID)
+		return -1;
+
+	tparams.res_ns     = 10 * ODP_TIME_MSEC_IN_NS;
+	tparams.min_tmo    = 10 * ODP_TIME_MSEC_IN_NS;
+	tparams.max_tmo    = ODP_TIME_SEC_IN_NS;
+	tparams.num_timers = 2;
+	tparams.priv       = 0;
+	tparams.clk_src    = ODP_CLOCK_CPU;
+
+	timer_pool = odp_timer_pool_create("timer_pool", &tparams);
+	if (timer_pool == ODP_TIMER_POOL_INVALID)
+		return -1;
+
+	odp_timer_pool_start();
+
+	odph_ipfrag_param_init(&param);
+	param.num_part   = 2;
+	param.num_flows  = 16;
+	param.max_frags  = TEST_MAX_FRAG;
+	param.timeout_ns = TEST_TMO_NS;
+	param.timer_pool = timer_pool;
+
+	tbl = odph_ipfrag_create("ipfrag_test", &param);
+	if (tbl == NULL || odph_ipfrag_lookup("ipfrag_test") != tbl) {
+		ODPH_ERR("Error: table create failed.\n");
+		return -1;
+	}
+
+	if (test_roundtrip(create_ipv4(4000, 1), 1500, 1) ||
+	    test_roundtrip(create_ipv4(TEST_MAX_LEN - 100, 2), 576, 1) ||
+	    test_roundtrip(create_ipv6(5000, 1), 1280, 0) ||
+	    test_roundtrip(create_ipv6(1300, 2), 1280, 0))
+		status = -1;
+
+	if (test_errors())
+		status = -1;
+
+	if (odph_ipfrag_destroy(tbl))
+		status = -1;
+
+	odp_timer_pool_destroy(timer_pool);
+
+	if (odp_pool_destroy(pool) != 0)
+		status = -1;
+
+	if (odp_term_local()) {
+		ODPH_ERR("Error: ODP local term failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		ODPH_ERR("Error: ODP global term failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return status;
+}
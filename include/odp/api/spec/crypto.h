@@ -75,12 +75,26 @@ typedef enum {
 	/** AES with cipher block chaining */
 	ODP_CIPHER_ALG_AES_CBC,
 
+	/** AES in Counter Mode
+	 *
+	 *  The IV is the initial 128 bit counter block.
+	 */
+	ODP_CIPHER_ALG_AES_CTR,
+
 	/** AES in Galois/Counter Mode
 	 *
 	 *  @note Must be paired with cipher ODP_AUTH_ALG_AES_GCM
 	 */
 	ODP_CIPHER_ALG_AES_GCM,
 
+	/** ChaCha20-Poly1305
+	 *
+	 *  The IV is the 96 bit nonce.
+	 *
+	 *  @note Must be paired with auth ODP_AUTH_ALG_CHACHA20_POLY1305
+	 */
+	ODP_CIPHER_ALG_CHACHA20_POLY1305,
+
 	/** @deprecated  Use ODP_CIPHER_ALG_AES_CBC instead */
 	ODP_CIPHER_ALG_AES128_CBC,
 
@@ -102,18 +116,50 @@ typedef enum {
 	 */
 	ODP_AUTH_ALG_MD5_HMAC,
 
+	/** HMAC-SHA-1
+	 *
+	 *  SHA-1 algorithm in HMAC mode
+	 */
+	ODP_AUTH_ALG_SHA1_HMAC,
+
 	/** HMAC-SHA-256
 	 *
 	 *  SHA-256 algorithm in HMAC mode
 	 */
 	ODP_AUTH_ALG_SHA256_HMAC,
 
+	/** HMAC-SHA-384
+	 *
+	 *  SHA-384 algorithm in HMAC mode
+	 */
+	ODP_AUTH_ALG_SHA384_HMAC,
+
+	/** HMAC-SHA-512
+	 *
+	 *  SHA-512 algorithm in HMAC mode
+	 */
+	ODP_AUTH_ALG_SHA512_HMAC,
+
 	/** AES in Galois/Counter Mode
 	 *
 	 *  @note Must be paired with cipher ODP_CIPHER_ALG_AES_GCM
 	 */
 	ODP_AUTH_ALG_AES_GCM,
 
+	/** AES Galois Message Authentication Code (GMAC)
+	 *
+	 *  AES-GCM authentication without encryption. Used with cipher
+	 *  ODP_CIPHER_ALG_NULL. The key is the auth key. The IV is the 96 bit
+	 *  session IV, or the override IV of an operation.
+	 */
+	ODP_AUTH_ALG_AES_GMAC,
+
+	/** ChaCha20-Poly1305
+	 *
+	 *  @note Must be paired with cipher ODP_CIPHER_ALG_CHACHA20_POLY1305
+	 */
+	ODP_AUTH_ALG_CHACHA20_POLY1305,
+
 	/** @deprecated  Use ODP_AUTH_ALG_MD5_HMAC instead */
 	ODP_AUTH_ALG_MD5_96,
 
@@ -142,9 +188,15 @@ typedef union odp_crypto_cipher_algos_t {
 		/** ODP_CIPHER_ALG_AES_CBC */
 		uint32_t aes_cbc     : 1;
 
+		/** ODP_CIPHER_ALG_AES_CTR */
+		uint32_t aes_ctr     : 1;
+
 		/** ODP_CIPHER_ALG_AES_GCM */
 		uint32_t aes_gcm     : 1;
 
+		/** ODP_CIPHER_ALG_CHACHA20_POLY1305 */
+		uint32_t chacha20_poly1305 : 1;
+
 		/** @deprecated  Use aes_cbc instead */
 		uint32_t aes128_cbc  : 1;
 
@@ -171,12 +223,27 @@ typedef union odp_crypto_auth_algos_t {
 		/** ODP_AUTH_ALG_MD5_HMAC */
 		uint32_t md5_hmac    : 1;
 
+		/** ODP_AUTH_ALG_SHA1_HMAC */
+		uint32_t sha1_hmac   : 1;
+
 		/** ODP_AUTH_ALG_SHA256_HMAC */
 		uint32_t sha256_hmac : 1;
 
+		/** ODP_AUTH_ALG_SHA384_HMAC */
+		uint32_t sha384_hmac : 1;
+
+		/** ODP_AUTH_ALG_SHA512_HMAC */
+		uint32_t sha512_hmac : 1;
+
 		/** ODP_AUTH_ALG_AES_GCM */
 		uint32_t aes_gcm     : 1;
 
+		/** ODP_AUTH_ALG_AES_GMAC */
+		uint32_t aes_gmac    : 1;
+
+		/** ODP_AUTH_ALG_CHACHA20_POLY1305 */
+		uint32_t chacha20_poly1305 : 1;
+
 		/** @deprecated  Use md5_hmac instead */
 		uint32_t md5_96      : 1;
 
@@ -620,6 +687,36 @@ int odp_crypto_operation(odp_crypto_op_param_t *param,
 			 odp_bool_t *posted,
 			 odp_crypto_op_result_t *result);
 
+/**
+ * Crypto multi packet operation
+ *
+ * Otherwise like odp_crypto_operation(), but performs operations on
+ * multiple packets. Operations may refer to different sessions. An
+ * implementation may process operations of the same session together, but
+ * keeps the order of operations within a session. Results of synchronous
+ * operations (posted[i] returns FALSE) are written into result[i]. Results
+ * of asynchronous operations are delivered via completion queues of
+ * the sessions.
+ *
+ * Operations are started in array order. The return value 'ret' indicates
+ * that operations param[0] ... param[ret - 1] were started. Operations
+ * param[ret] ... param[num - 1] failed. As with odp_crypto_operation(), a
+ * failed operation may have consumed its packets.
+ *
+ * @param param             Array of operation parameters
+ * @param[out] posted       Array for returning posted, TRUE for async
+ *                          operation
+ * @param[out] result       Array for results of synchronous operations.
+ *                          May be NULL when all sessions are asynchronous.
+ * @param num               Number of operations
+ *
+ * @return Number of operations started (0 ... num)
+ * @retval <0 on failure
+ */
+int odp_crypto_operation_multi(odp_crypto_op_param_t param[],
+			       odp_bool_t posted[],
+			       odp_crypto_op_result_t result[], int num);
+
 /**
  * Crypto per packet operation query result from completion event
  *
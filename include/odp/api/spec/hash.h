@@ -53,6 +53,76 @@ uint32_t odp_hash_crc32(const void *data, uint32_t data_len, uint32_t init_val);
 uint32_t odp_hash_crc32c(const void *data, uint32_t data_len,
 			 uint32_t init_val);
 
+/**
+* Calculate CRC-32C of multiple keys
+*
+* Calculates CRC-32C over each of 'num' keys of equal length, with the same
+* result as calling odp_hash_crc32c() for each key. Implementations may
+* process several keys in parallel, which is faster than separate calls
+* especially for short keys.
+*
+* @param      data      Array of pointers to keys
+* @param      data_len  Key length in bytes
+* @param      init_val  CRC generator initialization value
+* @param[out] hash      Array for 'num' CRC32C values
+* @param      num       Number of keys
+*/
+void odp_hash_crc32c_multi(const void *const data[], uint32_t data_len,
+			   uint32_t init_val, uint32_t hash[], int num);
+
+/**
+* Calculate 64-bit xxHash
+*
+* Calculates the 64-bit xxHash (XXH64) over the data. XXH64 is a
+* non-cryptographic hash function, which is faster than CRC on long keys
+* and distributes values well for hash tables.
+*
+* @param data       Pointer to data
+* @param data_len   Data length in bytes
+* @param seed       Seed value
+*
+* @return XXH64 value
+*/
+uint64_t odp_hash_xxh64(const void *data, uint32_t data_len, uint64_t seed);
+
+/**
+* Calculate 64-bit xxHash of multiple keys
+*
+* Calculates XXH64 over each of 'num' keys of equal length, with the same
+* result as calling odp_hash_xxh64() for each key.
+*
+* @param      data      Array of pointers to keys
+* @param      data_len  Key length in bytes
+* @param      seed      Seed value
+* @param[out] hash      Array for 'num' XXH64 values
+* @param      num       Number of keys
+*/
+void odp_hash_xxh64_multi(const void *const data[], uint32_t data_len,
+			  uint64_t seed, uint64_t hash[], int num);
+
+/**
+* Calculate Toeplitz hash
+*
+* Calculates the Toeplitz hash, which NICs use for receive side scaling
+* (RSS), over the data with a secret key. Each set bit of the data (in
+* network bit order) selects the 32 key bits starting at the same bit offset.
+* Key bits beyond 'key_len' bytes are zero. The whole data is covered, when
+* 'key_len' is at least 'data_len' + 4 bytes.
+*
+* With the same key and the same data (e.g. IPv4 source and destination
+* addresses followed by source and destination ports), the result equals the
+* RSS hash calculated by NICs.
+*
+* @param data       Pointer to data
+* @param data_len   Data length in bytes
+* @param key        Pointer to the key
+* @param key_len    Key length in bytes
+*
+* @return Toeplitz hash value
+*/
+uint32_t odp_hash_toeplitz(const void *data, uint32_t data_len,
+			   const uint8_t *key, uint32_t key_len);
+
 /**
 * CRC parameters
 *
@@ -0,0 +1,482 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP IPSEC API
+ */
+
+#ifndef ODP_API_IPSEC_H_
+#define ODP_API_IPSEC_H_
+#include <odp/visibility_begin.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/crypto.h>
+
+/** @defgroup odp_ipsec ODP IPSEC
+ *  Lookaside IPSEC protocol processing.
+ *
+ *  The IPSEC API processes ESP packets of IPSEC security associations (SA).
+ *  The implementation owns the SA database: inbound SAs are found by SPI,
+ *  and ESP sequence numbers, IVs, padding and anti-replay windows are
+ *  handled by the implementation. Packets are processed in bursts either
+ *  synchronously (odp_ipsec_in(), odp_ipsec_out()), or asynchronously
+ *  (odp_ipsec_in_enq(), odp_ipsec_out_enq()) with results delivered as
+ *  ODP_EVENT_IPSEC_RESULT events into SA destination queues.
+ *
+ *  Packets are processed starting from their L3 offset (or the packet start,
+ *  when the L3 offset is not set). Data before the L3 offset (e.g. an L2
+ *  header) is kept in front of the resulting IP packet.
+ *  @{
+ */
+
+/**
+ * @typedef odp_ipsec_sa_t
+ * IPSEC Security Association (SA)
+ */
+
+/**
+ * @def ODP_IPSEC_SA_INVALID
+ * Invalid IPSEC SA
+ */
+
+/**
+ * IPSEC SA direction
+ */
+typedef enum odp_ipsec_dir_t {
+	/** Inbound IPSEC SA: decapsulates ESP packets */
+	ODP_IPSEC_DIR_INBOUND = 0,
+
+	/** Outbound IPSEC SA: encapsulates IP packets into ESP */
+	ODP_IPSEC_DIR_OUTBOUND
+
+} odp_ipsec_dir_t;
+
+/**
+ * IPSEC protocol mode
+ */
+typedef enum odp_ipsec_mode_t {
+	/** IPSEC tunnel mode. Whole IP packets are encapsulated into ESP and
+	 *  an outer IPv4 header is added. */
+	ODP_IPSEC_MODE_TUNNEL = 0,
+
+	/** IPSEC transport mode. ESP is inserted between the IPv4 header and
+	 *  its payload. */
+	ODP_IPSEC_MODE_TRANSPORT
+
+} odp_ipsec_mode_t;
+
+/**
+ * IPSEC protocol
+ */
+typedef enum odp_ipsec_protocol_t {
+	/** ESP protocol */
+	ODP_IPSEC_ESP = 0
+
+} odp_ipsec_protocol_t;
+
+/**
+ * IPSEC capability
+ */
+typedef struct odp_ipsec_capability_t {
+	/** Maximum number of IPSEC SAs */
+	uint32_t max_num_sa;
+
+	/** Maximum anti-replay window size in packets */
+	uint32_t max_antireplay_ws;
+
+	/** Supported cipher algorithms */
+	odp_crypto_cipher_algos_t ciphers;
+
+	/** Supported authentication algorithms */
+	odp_crypto_auth_algos_t auths;
+
+} odp_ipsec_capability_t;
+
+/**
+ * IPSEC configuration
+ */
+typedef struct odp_ipsec_config_t {
+	/** Default queue for inbound packets of odp_ipsec_in_enq(), which do
+	 *  not match any SA. When ODP_QUEUE_INVALID (the default), those
+	 *  packets are freed. */
+	odp_queue_t inbound_default_queue;
+
+} odp_ipsec_config_t;
+
+/**
+ * IPSEC SA crypto parameters
+ *
+ * Cipher algorithms that use a nonce salt (AES-CTR, AES-GCM,
+ * ChaCha20-Poly1305), and AES-GMAC authentication, take the 4 byte salt as
+ * the last bytes of the key, as specified by the RFC of the algorithm for
+ * IKE (RFC 3686, RFC 4106, RFC 7634, RFC 4543). AES-GCM and
+ * ChaCha20-Poly1305 are selected as both the cipher and authentication
+ * algorithm, with an empty authentication key. AES-GMAC is used with the
+ * NULL cipher.
+ */
+typedef struct odp_ipsec_crypto_param_t {
+	/** Cipher algorithm */
+	odp_cipher_alg_t cipher_alg;
+
+	/** Cipher key */
+	odp_crypto_key_t cipher_key;
+
+	/** Authentication algorithm */
+	odp_auth_alg_t auth_alg;
+
+	/** Authentication key */
+	odp_crypto_key_t auth_key;
+
+} odp_ipsec_crypto_param_t;
+
+/**
+ * IPSEC tunnel parameters of outbound SAs
+ */
+typedef struct odp_ipsec_tunnel_param_t {
+	/** Outer IPv4 source address in network byte order */
+	uint32_t src_addr;
+
+	/** Outer IPv4 destination address in network byte order */
+	uint32_t dst_addr;
+
+	/** Outer header DSCP. ECN is copied from the inner header. */
+	uint8_t dscp;
+
+	/** Outer header time to live. The default value is 64. */
+	uint8_t ttl;
+
+} odp_ipsec_tunnel_param_t;
+
+/**
+ * IPSEC SA parameters
+ */
+typedef struct odp_ipsec_sa_param_t {
+	/** SA direction */
+	odp_ipsec_dir_t dir;
+
+	/** IPSEC protocol */
+	odp_ipsec_protocol_t proto;
+
+	/** IPSEC protocol mode */
+	odp_ipsec_mode_t mode;
+
+	/** Crypto parameters */
+	odp_ipsec_crypto_param_t crypto;
+
+	/** Security Parameter Index (SPI) in CPU byte order */
+	uint32_t spi;
+
+	/** Tunnel parameters of an outbound tunnel mode SA */
+	odp_ipsec_tunnel_param_t tunnel;
+
+	/** Inbound SA is found by SPI for packets that are processed without
+	 *  an SA. SPIs of these SAs must be unique. The default value is
+	 *  true. */
+	odp_bool_t lookup;
+
+	/** Anti-replay window size in packets of an inbound SA. Zero disables
+	 *  replay protection. The default value is 64. */
+	uint32_t antireplay_ws;
+
+	/** Destination queue of ODP_EVENT_IPSEC_RESULT events of
+	 *  odp_ipsec_in_enq() and odp_ipsec_out_enq() */
+	odp_queue_t dest_queue;
+
+	/** User defined SA context pointer */
+	void *context;
+
+} odp_ipsec_sa_param_t;
+
+/**
+ * IPSEC operation errors
+ */
+typedef union odp_ipsec_error_t {
+	/** Error bits */
+	struct {
+		/** Packet is not a valid IP packet for the SA, or a decrypted
+		 *  ESP packet has a bad trailer */
+		uint32_t proto      : 1;
+
+		/** No inbound SA matched the SPI of the packet */
+		uint32_t sa_lookup  : 1;
+
+		/** Packet was replayed or is too old for the anti-replay
+		 *  window */
+		uint32_t antireplay : 1;
+
+		/** Outbound sequence numbers of the SA are exhausted */
+		uint32_t seq        : 1;
+
+		/** Crypto operation failed */
+		uint32_t alg        : 1;
+
+		/** Integrity check failed */
+		uint32_t auth       : 1;
+
+		/** Packet could not be extended for ESP headers */
+		uint32_t alloc      : 1;
+
+	} bit;
+
+	/** All error bits
+	 *
+	 *  This field can be used to check whether any error occurred
+	 *  (all != 0), or to clear all bits (all = 0).
+	 */
+	uint32_t all;
+
+} odp_ipsec_error_t;
+
+/**
+ * IPSEC operation result of a packet
+ */
+typedef struct odp_ipsec_packet_result_t {
+	/** Errors. A packet with errors is returned unmodified, partially
+	 *  processed or with its ESP payload still encrypted, depending on
+	 *  the processing step that failed. */
+	odp_ipsec_error_t error;
+
+	/** SA that processed the packet, or ODP_IPSEC_SA_INVALID when SA
+	 *  lookup failed */
+	odp_ipsec_sa_t sa;
+
+	/** ESP sequence number of the packet */
+	uint32_t seq;
+
+} odp_ipsec_packet_result_t;
+
+/**
+ * Inbound operation parameters
+ */
+typedef struct odp_ipsec_in_param_t {
+	/** Number of SAs
+	 *
+	 *  0:      SAs are looked up by SPI
+	 *  1:      All packets use sa[0]
+	 *  num_in: Packet i uses sa[i]
+	 */
+	int num_sa;
+
+	/** Table of SAs */
+	const odp_ipsec_sa_t *sa;
+
+} odp_ipsec_in_param_t;
+
+/**
+ * Outbound operation parameters
+ */
+typedef struct odp_ipsec_out_param_t {
+	/** Number of SAs
+	 *
+	 *  1:      All packets use sa[0]
+	 *  num_in: Packet i uses sa[i]
+	 */
+	int num_sa;
+
+	/** Table of SAs */
+	const odp_ipsec_sa_t *sa;
+
+} odp_ipsec_out_param_t;
+
+/**
+ * Query IPSEC capabilities
+ *
+ * @param[out] capa   Pointer to capability structure for output
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_ipsec_capability(odp_ipsec_capability_t *capa);
+
+/**
+ * Initialize IPSEC configuration options
+ *
+ * @param[out] config  Pointer to IPSEC configuration structure
+ */
+void odp_ipsec_config_init(odp_ipsec_config_t *config);
+
+/**
+ * Global IPSEC configuration
+ *
+ * Configures IPSEC options common to all SAs. Call before creating SAs.
+ *
+ * @param config   Pointer to IPSEC configuration structure
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_ipsec_config(const odp_ipsec_config_t *config);
+
+/**
+ * Initialize IPSEC SA parameters
+ *
+ * @param[out] param   Pointer to IPSEC SA parameter structure
+ */
+void odp_ipsec_sa_param_init(odp_ipsec_sa_param_t *param);
+
+/**
+ * Create IPSEC SA
+ *
+ * Outbound SAs start from sequence number 1.
+ *
+ * @param param   IPSEC SA parameters
+ *
+ * @return IPSEC SA handle
+ * @retval ODP_IPSEC_SA_INVALID on failure
+ */
+odp_ipsec_sa_t odp_ipsec_sa_create(const odp_ipsec_sa_param_t *param);
+
+/**
+ * Destroy IPSEC SA
+ *
+ * The SA is removed from SPI lookup. The application must not process
+ * packets with the SA anymore, and packets of the SA must not be in
+ * processing in other threads.
+ *
+ * @param sa      IPSEC SA to be destroyed
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_ipsec_sa_destroy(odp_ipsec_sa_t sa);
+
+/**
+ * User context of an IPSEC SA
+ *
+ * @param sa      IPSEC SA
+ *
+ * @return Context pointer of SA parameters
+ */
+void *odp_ipsec_sa_context(odp_ipsec_sa_t sa);
+
+/**
+ * Printable format of odp_ipsec_sa_t
+ *
+ * @param sa      IPSEC SA handle
+ *
+ * @return uint64_t value that can be used to print/display this handle
+ */
+uint64_t odp_ipsec_sa_to_u64(odp_ipsec_sa_t sa);
+
+/**
+ * Inbound synchronous IPSEC operation
+ *
+ * Decapsulates ESP packets of inbound SAs. The anti-replay window of an SA
+ * is updated after the integrity check of a packet has passed. An output
+ * packet is returned for each input packet, also for packets that failed
+ * processing. Use odp_ipsec_result() to check the result of each output
+ * packet. Output packet handles may differ from input packet handles.
+ *
+ * @param      pkt_in   Packets to be processed
+ * @param      num_in   Number of packets to be processed
+ * @param[out] pkt_out  Packet handle array for resulting packets
+ * @param[in, out] num_out Number of resulting packets. Input value is the
+ *                      size of 'pkt_out' array.
+ * @param      param    Inbound operation parameters
+ *
+ * @return Number of input packets consumed (0 ... num_in)
+ * @retval <0 on failure
+ */
+int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in,
+		 odp_packet_t pkt_out[], int *num_out,
+		 const odp_ipsec_in_param_t *param);
+
+/**
+ * Outbound synchronous IPSEC operation
+ *
+ * Encapsulates IP packets into ESP of outbound SAs. Sequence numbers and IVs
+ * are generated by the implementation. Otherwise like odp_ipsec_in().
+ *
+ * @param      pkt_in   Packets to be processed
+ * @param      num_in   Number of packets to be processed
+ * @param[out] pkt_out  Packet handle array for resulting packets
+ * @param[in, out] num_out Number of resulting packets. Input value is the
+ *                      size of 'pkt_out' array.
+ * @param      param    Outbound operation parameters
+ *
+ * @return Number of input packets consumed (0 ... num_in)
+ * @retval <0 on failure
+ */
+int odp_ipsec_out(const odp_packet_t pkt_in[], int num_in,
+		  odp_packet_t pkt_out[], int *num_out,
+		  const odp_ipsec_out_param_t *param);
+
+/**
+ * Inbound asynchronous IPSEC operation
+ *
+ * Like odp_ipsec_in(), but resulting packets are delivered as
+ * ODP_EVENT_IPSEC_RESULT events into destination queues of the SAs. Packets
+ * that do not match any SA are delivered into the inbound default queue.
+ * Events of the same destination queue are enqueued in packet order.
+ *
+ * @param pkt     Packets to be processed
+ * @param num     Number of packets to be processed
+ * @param param   Inbound operation parameters
+ *
+ * @return Number of input packets consumed (0 ... num)
+ * @retval <0 on failure
+ */
+int odp_ipsec_in_enq(const odp_packet_t pkt[], int num,
+		     const odp_ipsec_in_param_t *param);
+
+/**
+ * Outbound asynchronous IPSEC operation
+ *
+ * Like odp_ipsec_out(), but resulting packets are delivered as
+ * ODP_EVENT_IPSEC_RESULT events into destination queues of the SAs.
+ *
+ * @param pkt     Packets to be processed
+ * @param num     Number of packets to be processed
+ * @param param   Outbound operation parameters
+ *
+ * @return Number of input packets consumed (0 ... num)
+ * @retval <0 on failure
+ */
+int odp_ipsec_out_enq(const odp_packet_t pkt[], int num,
+		      const odp_ipsec_out_param_t *param);
+
+/**
+ * Get IPSEC operation result of a packet
+ *
+ * Outputs the result of the last IPSEC operation of a packet returned by
+ * odp_ipsec_in(), odp_ipsec_out() or odp_ipsec_packet_from_event().
+ *
+ * @param[out] result  Pointer to result structure for output
+ * @param      pkt     Packet
+ *
+ * @retval 0 on success
+ * @retval <0 on failure (the packet was not processed by IPSEC)
+ */
+int odp_ipsec_result(odp_ipsec_packet_result_t *result, odp_packet_t pkt);
+
+/**
+ * Convert IPSEC result event to packet handle
+ *
+ * Converts an ODP_EVENT_IPSEC_RESULT event to the resulting packet. After
+ * the conversion, the packet is a normal packet (its event type is
+ * ODP_EVENT_PACKET), and the result is available with odp_ipsec_result().
+ *
+ * @param ev      IPSEC result event
+ *
+ * @return Packet handle
+ */
+odp_packet_t odp_ipsec_packet_from_event(odp_event_t ev);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#include <odp/visibility_end.h>
+#endif
@@ -71,6 +71,16 @@ extern "C" {
   * Packet is red
   */
 
+/**
+ * @typedef odp_packet_vector_t
+ * ODP packet vector
+ */
+
+/**
+ * @def ODP_PACKET_VECTOR_INVALID
+ * Invalid packet vector
+ */
+
 /*
  *
  * Alloc and free
@@ -1227,6 +1237,88 @@ uint32_t odp_packet_l4_offset(odp_packet_t pkt);
  */
 int odp_packet_l4_offset_set(odp_packet_t pkt, uint32_t offset);
 
+/**
+ * Layer 3 checksum insertion override
+ *
+ * Override checksum insertion configuration per packet. This per packet
+ * setting overrides a higher level configuration for checksum insertion into
+ * a L3 header during packet output processing.
+ *
+ * Calling this function is always allowed but the checksum will not be
+ * inserted if the packet is output through a pktio that does not have
+ * the relevant pktout chksum bit set in the pktio configuration.
+ *
+ * @param pkt     Packet handle
+ * @param insert  0: do not insert L3 checksum
+ *                1: insert L3 checksum
+ *
+ * @see odp_pktout_config_opt_t
+ */
+void odp_packet_l3_chksum_insert(odp_packet_t pkt, int insert);
+
+/**
+ * Layer 4 checksum insertion override
+ *
+ * Override checksum insertion configuration per packet. This per packet
+ * setting overrides a higher level configuration for checksum insertion into
+ * a L4 header during packet output processing.
+ *
+ * Calling this function is always allowed but the checksum will not be
+ * inserted if the packet is output through a pktio that does not have
+ * the relevant pktout chksum bit set in the pktio configuration.
+ *
+ * @param pkt     Packet handle
+ * @param insert  0: do not insert L4 checksum
+ *                1: insert L4 checksum
+ *
+ * @see odp_pktout_config_opt_t
+ */
+void odp_packet_l4_chksum_insert(odp_packet_t pkt, int insert);
+
+/**
+ * Set segmentation size
+ *
+ * Request segmentation of the packet on packet output. The packet data after
+ * the L4 header (TCP or UDP) is split into segments of at most 'size'
+ * bytes, and each segment is sent in a separate packet with a copy of the
+ * L2, L3 and L4 headers. IPv4 ID, IP length, TCP sequence number, UDP length
+ * and header checksums are updated for each output packet. Only packets
+ * with more data than 'size' bytes are segmented. For correct operation,
+ * packet metadata must provide valid L3 and L4 offsets and protocol flags.
+ *
+ * Segmentation is done only when the packet is output through a pktio that
+ * has the relevant pktout segmentation bit set in the pktio configuration.
+ * Size is cleared on packet output.
+ *
+ * A segmented packet is reported as sent by odp_pktout_send() as a whole.
+ * Segments that cannot be transmitted (e.g. due to a transmit error, or
+ * a full output queue that is not retried before the pktio is closed) are
+ * dropped and counted in the 'out_discards' statistics counter
+ * (see odp_pktio_stats_t).
+ *
+ * @param pkt   Packet handle
+ * @param size  Maximum number of L4 payload bytes per segment (e.g. TCP
+ *              MSS), or 0 to disable segmentation
+ *
+ * @see odp_pktout_config_opt_t, odp_packet_gso_size()
+ */
+void odp_packet_gso_size_set(odp_packet_t pkt, uint32_t size);
+
+/**
+ * Segmentation size
+ *
+ * Packets coalesced on packet input (see odp_pktin_config_opt_t) have
+ * the size set to the payload length of the original segments.
+ *
+ * @param pkt   Packet handle
+ *
+ * @return Segmentation size of the packet
+ * @retval 0 Packet is not segmented on output
+ *
+ * @see odp_packet_gso_size_set()
+ */
+uint32_t odp_packet_gso_size(odp_packet_t pkt);
+
 /**
  * Packet flow hash value
  *
@@ -1344,6 +1436,116 @@ int8_t odp_packet_shaper_len_adjust(odp_packet_t pkt);
  */
 void odp_packet_shaper_len_adjust_set(odp_packet_t pkt, int8_t adj);
 
+/*
+ *
+ * Packet vectors
+ * ********************************************************
+ *
+ */
+
+/**
+ * Get packet vector handle from event
+ *
+ * Converts an ODP_EVENT_PACKET_VECTOR type event to a packet vector.
+ *
+ * @param ev   Event handle
+ *
+ * @return Packet vector handle
+ *
+ * @see odp_event_type()
+ */
+odp_packet_vector_t odp_packet_vector_from_event(odp_event_t ev);
+
+/**
+ * Convert packet vector handle to event
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @return Event handle
+ */
+odp_event_t odp_packet_vector_to_event(odp_packet_vector_t pktv);
+
+/**
+ * Allocate a packet vector
+ *
+ * Allocates a packet vector from an ODP_POOL_PACKET_VECTOR type pool.
+ * A newly allocated vector contains no packets.
+ *
+ * @param pool  Packet vector pool handle
+ *
+ * @return Handle of allocated packet vector
+ * @retval ODP_PACKET_VECTOR_INVALID  Packet vector could not be allocated
+ */
+odp_packet_vector_t odp_packet_vector_alloc(odp_pool_t pool);
+
+/**
+ * Free a packet vector
+ *
+ * Frees the packet vector into the pool it was allocated from. Packets
+ * stored in the vector are not freed, application must have taken
+ * ownership of those before the call.
+ *
+ * @param pktv  Packet vector handle
+ */
+void odp_packet_vector_free(odp_packet_vector_t pktv);
+
+/**
+ * Packet vector table
+ *
+ * Outputs a pointer to the table of packet handles stored in the vector.
+ * The table has room for the pool 'vector.max_size' number of handles,
+ * of which the first odp_packet_vector_size() are valid. Application
+ * may read and modify the table directly and must update the vector size
+ * with odp_packet_vector_size_set() when the number of packets changes.
+ *
+ * @param      pktv     Packet vector handle
+ * @param[out] pkt_tbl  Pointer to the packet handle table for output
+ *
+ * @return Number of packets in the vector
+ */
+uint32_t odp_packet_vector_tbl(odp_packet_vector_t pktv,
+			       odp_packet_t **pkt_tbl);
+
+/**
+ * Number of packets in a vector
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @return Number of packets in the vector
+ */
+uint32_t odp_packet_vector_size(odp_packet_vector_t pktv);
+
+/**
+ * Set the number of packets in a vector
+ *
+ * @param pktv  Packet vector handle
+ * @param size  Number of valid packet handles in the vector table. The
+ *              value must not exceed the pool 'vector.max_size'.
+ */
+void odp_packet_vector_size_set(odp_packet_vector_t pktv, uint32_t size);
+
+/**
+ * Packet vector pool
+ *
+ * @param pktv  Packet vector handle
+ *
+ * @return Handle of the pool the vector was allocated from
+ */
+odp_pool_t odp_packet_vector_pool(odp_packet_vector_t pktv);
+
+/**
+ * Get printable value for an odp_packet_vector_t
+ *
+ * @param hdl  odp_packet_vector_t handle to be printed
+ * @return     uint64_t value that can be used to print/display this
+ *             handle
+ *
+ * @note This routine is intended to be used for diagnostic purposes
+ * to enable applications to generate a printable value that represents
+ * an odp_packet_vector_t handle.
+ */
+uint64_t odp_packet_vector_to_u64(odp_packet_vector_t hdl);
+
 /*
  *
  * Debugging
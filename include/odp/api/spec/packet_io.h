@@ -151,6 +151,35 @@ typedef enum odp_pktio_op_mode_t {
 
 } odp_pktio_op_mode_t;
 
+/**
+ * Packet input vector configuration
+ */
+typedef struct odp_pktin_vector_config_t {
+	/** Enable packet vectors
+	  *
+	  * * 0: Packets are delivered as individual events (default)
+	  * * 1: Packets received in a burst are combined into
+	  *      ODP_EVENT_PACKET_VECTOR events before those are delivered into
+	  *      pktin event queues. Vectors can be enabled only in
+	  *      ODP_PKTIN_MODE_SCHED mode. Packets directed to a queue by
+	  *      the classifier may still be delivered as individual events. */
+	odp_bool_t enable;
+
+	/** Packet vector pool
+	  *
+	  * Pool of type ODP_POOL_PACKET_VECTOR from which the vectors are
+	  * allocated. Packets are delivered as individual events when the
+	  * pool is empty. */
+	odp_pool_t pool;
+
+	/** Maximum number of packets in a vector
+	  *
+	  * The value must not exceed 'vector.max_size' of the pool. Use 0 for
+	  * the pool maximum (the default). */
+	uint32_t max_size;
+
+} odp_pktin_vector_config_t;
+
 /**
  * Packet input queue parameters
  */
@@ -206,6 +235,11 @@ typedef struct odp_pktin_queue_param_t {
 	  * value is ignored. */
 	odp_queue_param_t queue_param;
 
+	/** Packet vector configuration
+	  *
+	  * Packet vectors are disabled by default. */
+	odp_pktin_vector_config_t vector;
+
 } odp_pktin_queue_param_t;
 
 /**
@@ -298,6 +332,25 @@ typedef union odp_pktin_config_opt_t {
 		/** Drop packets with a SCTP error on packet input */
 		uint64_t drop_sctp_err : 1;
 
+		/** Coalesce TCP segments on packet input
+		  *
+		  * Consecutive, in order TCP segments of the same flow are
+		  * merged into a single packet. The merged packet has
+		  * the headers of the first segment, with lengths and
+		  * checksums updated, and its segmentation size is set to
+		  * the segment payload length. See odp_packet_gso_size().
+		  * Packets with IP options, fragments, TCP flags other than
+		  * ACK and PSH, or with errors are not coalesced. */
+		uint64_t tcp_gro       : 1;
+
+		/** Coalesce UDP datagrams on packet input
+		  *
+		  * Consecutive UDP datagrams of the same flow and of equal
+		  * payload length (the last one may be shorter) are merged
+		  * into a single packet, as if the datagrams were segments
+		  * of a UDP packet sent with a segmentation size. */
+		uint64_t udp_gro       : 1;
+
 	} bit;
 
 	/** All bits of the bit field structure
@@ -336,6 +389,28 @@ typedef union odp_pktout_config_opt_t {
 		/** Insert SCTP checksum on packet output */
 		uint64_t sctp_chksum  : 1;
 
+		/** Segment TCP packets on packet output
+		  *
+		  * TCP packets with a segmentation size set are split into
+		  * segments that fit into the size. See
+		  * odp_packet_gso_size_set().
+		  *
+		  * A packet may be consumed by odp_pktout_send() before all
+		  * of its segments have been output. Remaining segments are
+		  * sent first on the following send calls to the same output
+		  * queue. A call returns zero without sending any new
+		  * packets when the remaining segments still do not fit into
+		  * the queue. */
+		uint64_t tcp_gso      : 1;
+
+		/** Segment UDP packets on packet output
+		  *
+		  * UDP packets with a segmentation size set are split into
+		  * separate UDP datagrams that fit into the size. See
+		  * odp_packet_gso_size_set(). Segments are output as with
+		  * 'tcp_gso'. */
+		uint64_t udp_gso      : 1;
+
 	} bit;
 
 	/** All bits of the bit field structure
@@ -371,6 +446,24 @@ typedef struct odp_pktio_config_t {
 	 * interface capability before enabling the same. */
 	odp_bool_t enable_loop;
 
+	/** Packet input coalescing options
+	 *
+	 *  Used when TCP or UDP packet input coalescing is enabled. */
+	struct {
+		/** Maximum time in nanoseconds to hold received packets for
+		 *  coalescing with packets of the next receive calls
+		 *
+		 *  When zero, packets are coalesced only within the packets
+		 *  received by a single receive call (or scheduler poll of
+		 *  the interface). Otherwise, packets that may be merged with
+		 *  the next packets of their flow are held in the input queue
+		 *  for at most this time. Held packets are checked on
+		 *  the next receive call from the same input queue, not from
+		 *  a timer. The default value is zero. */
+		uint64_t flush_ns;
+
+	} gro;
+
 } odp_pktio_config_t;
 
 /**
@@ -414,6 +507,15 @@ typedef struct odp_pktio_capability_t {
 	 * A boolean to denote whether loop back mode is supported on this
 	 * specific interface. */
 	odp_bool_t loop_supported;
+
+	/** Packet vector capabilities */
+	struct {
+		/** Packet input vectors are supported */
+		odp_bool_t supported;
+
+		/** Maximum number of packets in a packet input vector */
+		uint32_t max_size;
+	} vector;
 } odp_pktio_capability_t;
 
 /**
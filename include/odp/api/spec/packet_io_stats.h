@@ -104,6 +104,19 @@ typedef struct odp_pktio_stats_t {
 	 * CarrierSenseErrors. See ifOutErrors in RFC 3635.
 	 */
 	uint64_t out_errors;
+
+	/**
+	 * The number of packets delivered to the application, which were
+	 * coalesced from multiple received packets. See tcp_gro and udp_gro
+	 * packet input configuration options.
+	 */
+	uint64_t in_gro_pkts;
+
+	/**
+	 * The number of received packets (segments or datagrams), which were
+	 * coalesced into in_gro_pkts packets.
+	 */
+	uint64_t in_gro_segs;
 } odp_pktio_stats_t;
 
 /**
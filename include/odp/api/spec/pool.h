@@ -141,6 +141,21 @@ typedef struct odp_pool_capability_t {
 		uint32_t max_num;
 	} tmo;
 
+	/** Packet vector pool capabilities */
+	struct {
+		/** Maximum number of packet vector pools */
+		unsigned max_pools;
+
+		/** Maximum number of packet vectors in a pool
+		 *
+		 * The value of zero means that limited only by the available
+		 * memory size for the pool. */
+		uint32_t max_num;
+
+		/** Maximum number of packet handles in a vector */
+		uint32_t max_size;
+	} vector;
+
 } odp_pool_capability_t;
 
 /**
@@ -215,6 +230,15 @@ typedef struct odp_pool_param_t {
 			/** Number of timeouts in the pool */
 			uint32_t num;
 		} tmo;
+		struct {
+			/** Number of packet vectors in the pool */
+			uint32_t num;
+
+			/** Maximum number of packet handles in a vector.
+			    The maximum value is defined by pool capability
+			    vector.max_size. */
+			uint32_t max_size;
+		} vector;
 	};
 } odp_pool_param_t;
 
@@ -224,6 +248,8 @@ typedef struct odp_pool_param_t {
 #define ODP_POOL_BUFFER       ODP_EVENT_BUFFER
 /** Timeout pool */
 #define ODP_POOL_TIMEOUT      ODP_EVENT_TIMEOUT
+/** Packet vector pool */
+#define ODP_POOL_PACKET_VECTOR ODP_EVENT_PACKET_VECTOR
 
 /**
  * Create a pool
@@ -293,6 +293,120 @@ int odp_timer_set_rel(odp_timer_t tim,
  */
 int odp_timer_cancel(odp_timer_t tim, odp_event_t *tmo_ev);
 
+/**
+ * Set multiple timers (absolute time)
+ *
+ * Otherwise like odp_timer_set_abs(), but sets multiple timers. Timers are set
+ * in array order. A successful call returns the actual number of timers set.
+ * If return value is less than 'num', setting stopped at timer 'tim[ret]'
+ * and the remaining timers were not touched. Call odp_timer_set_abs() on that
+ * timer to find out the reason of the failure.
+ *
+ * @param tim      Array of timers
+ * @param abs_tck  Array of expiration times in absolute timer ticks
+ * @param[in,out] tmo_ev  Array of event variables that point to timeout events
+ * or ODP_EVENT_INVALID to reuse the existing timeout event of the timer. Any
+ * existing timeout event that is replaced by a successful set operation will be
+ * returned here. Set to NULL to reuse the existing timeout events of all
+ * timers.
+ * @param num      Number of timers to set
+ *
+ * @return Number of timers actually set (0 ... num)
+ * @retval <0 on failure
+ */
+int odp_timer_set_abs_multi(const odp_timer_t tim[], const uint64_t abs_tck[],
+			    odp_event_t tmo_ev[], int num);
+
+/**
+ * Set multiple timers (relative time)
+ *
+ * Otherwise like odp_timer_set_abs_multi(), but expiration times are in timer
+ * ticks relative to current time of the timer pool each timer belongs to.
+ *
+ * @param tim      Array of timers
+ * @param rel_tck  Array of expiration times in timer ticks relative to current
+ *		   time of the timer pool
+ * @param[in,out] tmo_ev  Array of event variables or NULL, see
+ * odp_timer_set_abs_multi()
+ * @param num      Number of timers to set
+ *
+ * @return Number of timers actually set (0 ... num)
+ * @retval <0 on failure
+ */
+int odp_timer_set_rel_multi(const odp_timer_t tim[], const uint64_t rel_tck[],
+			    odp_event_t tmo_ev[], int num);
+
+/**
+ * Cancel multiple timers
+ *
+ * Otherwise like odp_timer_cancel(), but cancels multiple timers. The timeout
+ * event of each cancelled timer is returned in the corresponding 'tmo_ev'
+ * element. Timers that are inactive or already expired are skipped and their
+ * 'tmo_ev' element is set to ODP_EVENT_INVALID.
+ *
+ * @param tim      Array of timers
+ * @param[out] tmo_ev  Array of event variables for output
+ * @param num      Number of timers to cancel
+ *
+ * @return Number of timers actually cancelled (0 ... num)
+ * @retval <0 on failure
+ */
+int odp_timer_cancel_multi(const odp_timer_t tim[], odp_event_t tmo_ev[],
+			   int num);
+
+/**
+ * Start a periodic timer
+ *
+ * Set (arm) the timer to expire first at 'first_tck' and after that every
+ * 'period' ticks. The timer is re-armed for the next period when it expires,
+ * without application involvement. The timeout event is enqueued on every
+ * expiration and must be handed back to the timer with
+ * odp_timer_periodic_ack() before the next period expires. When the event has
+ * not been returned by then, the expiration is missed and the timer continues
+ * with the following period. odp_timeout_tick() returns the expiration tick of
+ * the period that the timeout was delivered for. odp_timeout_fresh() does not
+ * apply to periodic timeouts.
+ *
+ * A periodic timer is stopped with odp_timer_cancel(). It succeeds only while
+ * the timer holds the timeout event. Otherwise the event is delivered or
+ * already owned by the application, and odp_timer_periodic_ack() indicates
+ * that the timer has been stopped. Setting the timer with odp_timer_set_abs(),
+ * odp_timer_set_rel() or their multi variants turns it into a one-shot timer.
+ *
+ * @param tim      Timer
+ * @param first_tck  First expiration time in absolute timer ticks
+ * @param period   Period in timer ticks
+ * @param[in,out] tmo_ev  Reference to an event variable that points to
+ * timeout event. Any existing timeout event that is replaced by a successful
+ * start operation will be returned here.
+ *
+ * @retval ODP_TIMER_SUCCESS Operation succeeded
+ * @retval ODP_TIMER_TOOEARLY Operation failed because first expiration tick
+ * or period too early
+ * @retval ODP_TIMER_TOOLATE Operation failed because first expiration tick
+ * or period too late
+ * @retval ODP_TIMER_NOEVENT Operation failed because timeout event not
+ * specified
+ */
+int odp_timer_periodic_start(odp_timer_t tim, uint64_t first_tck,
+			     uint64_t period, odp_event_t *tmo_ev);
+
+/**
+ * Return timeout event to a periodic timer
+ *
+ * Hand a timeout event received from a periodic timer back to the timer, so
+ * that it can be delivered again on the next expiration.
+ *
+ * @param tim      Periodic timer
+ * @param tmo_ev   Timeout event received from the timer
+ *
+ * @retval 0  Success, the timer owns the event
+ * @retval 1  Timer has been stopped, the application owns the event and
+ *            should free it
+ * @retval <0 on failure
+ */
+int odp_timer_periodic_ack(odp_timer_t tim, odp_event_t tmo_ev);
+
 /**
  * Return timeout handle that is associated with timeout event
  *
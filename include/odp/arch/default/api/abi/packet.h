@@ -16,16 +16,22 @@ extern "C" {
 /** @internal Dummy type for strong typing */
 typedef struct { char dummy; /**< @internal Dummy */ } _odp_abi_packet_t;
 
+/** @internal Dummy type for strong typing */
+typedef struct { char dummy; /**< @internal Dummy */ }
+	_odp_abi_packet_vector_t;
+
 /** @ingroup odp_packet
  *  @{
  */
 
 typedef _odp_abi_packet_t *odp_packet_t;
 typedef uint8_t            odp_packet_seg_t;
+typedef _odp_abi_packet_vector_t *odp_packet_vector_t;
 
 #define ODP_PACKET_INVALID        ((odp_packet_t)0xffffffff)
 #define ODP_PACKET_SEG_INVALID    ((odp_packet_seg_t)-1)
 #define ODP_PACKET_OFFSET_INVALID (0x0fffffff)
+#define ODP_PACKET_VECTOR_INVALID ((odp_packet_vector_t)0xffffffff)
 
 typedef enum {
 	ODP_PACKET_GREEN = 0,
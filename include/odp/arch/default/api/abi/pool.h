@@ -29,7 +29,8 @@ typedef _odp_abi_pool_t *odp_pool_t;
 typedef enum odp_pool_type_t {
 	ODP_POOL_BUFFER  = ODP_EVENT_BUFFER,
 	ODP_POOL_PACKET  = ODP_EVENT_PACKET,
-	ODP_POOL_TIMEOUT = ODP_EVENT_TIMEOUT
+	ODP_POOL_TIMEOUT = ODP_EVENT_TIMEOUT,
+	ODP_POOL_PACKET_VECTOR = ODP_EVENT_PACKET_VECTOR
 } odp_pool_type_t;
 
 /**
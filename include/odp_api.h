@@ -26,6 +26,7 @@ extern "C" {
 #include <odp/api/hints.h>
 #include <odp/api/debug.h>
 #include <odp/api/byteorder.h>
+#include <odp/api/chksum.h>
 #include <odp/api/cpu.h>
 #include <odp/api/cpumask.h>
 #include <odp/api/barrier.h>
@@ -47,6 +48,7 @@ extern "C" {
 #include <odp/api/packet_flags.h>
 #include <odp/api/packet_io.h>
 #include <odp/api/crypto.h>
+#include <odp/api/ipsec.h>
 #include <odp/api/classification.h>
 #include <odp/api/rwlock.h>
 #include <odp/api/event.h>
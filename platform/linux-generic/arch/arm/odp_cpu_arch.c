@@ -12,6 +12,7 @@
 #include <odp/api/cpu.h>
 #include <odp/api/hints.h>
 #include <odp/api/system_info.h>
+#include <odp_time_internal.h>
 #include <odp_debug_internal.h>
 
 #define GIGA 1000000000
@@ -46,3 +47,47 @@ uint64_t odp_cpu_cycles_resolution(void)
 {
 	return 1;
 }
+
+#if defined(__aarch64__)
+/* ARMv8 generic timer virtual counter */
+int cpu_has_global_time(void)
+{
+	return 1;
+}
+
+uint64_t cpu_global_time(void)
+{
+	uint64_t cntvct;
+
+	/* Do not read the counter before preceding instructions */
+	__asm__ __volatile__ ("isb\n\t"
+			      "mrs %0, cntvct_el0"
+			      : "=r" (cntvct) : : "memory");
+
+	return cntvct;
+}
+
+uint64_t cpu_global_time_freq(void)
+{
+	uint64_t cntfrq;
+
+	__asm__ __volatile__ ("mrs %0, cntfrq_el0" : "=r" (cntfrq) : : );
+
+	return cntfrq;
+}
+#else
+int cpu_has_global_time(void)
+{
+	return 0;
+}
+
+uint64_t cpu_global_time(void)
+{
+	return 0;
+}
+
+uint64_t cpu_global_time_freq(void)
+{
+	return 0;
+}
+#endif
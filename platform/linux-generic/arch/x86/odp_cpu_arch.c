@@ -3,7 +3,11 @@
  *
  * SPDX-License-Identifier:     BSD-3-Clause
  */
+#include <stddef.h>
+#include <cpuid.h>
+
 #include <odp/api/cpu.h>
+#include <odp_time_internal.h>
 
 uint64_t odp_cpu_cycles(void)
 {
@@ -31,3 +35,39 @@ uint64_t odp_cpu_cycles_resolution(void)
 {
 	return 1;
 }
+
+/* Invariant TSC runs at a constant rate in all ACPI P-, C- and T-states */
+int cpu_has_global_time(void)
+{
+	uint32_t eax, ebx, ecx, edx;
+
+	if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) == 0 ||
+	    eax < 0x80000007)
+		return 0;
+
+	__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+
+	return (edx >> 8) & 0x1;
+}
+
+uint64_t cpu_global_time(void)
+{
+	return odp_cpu_cycles();
+}
+
+/* TSC frequency from the TSC/core crystal clock ratio. Not all CPUs (or
+ * hypervisors) report the crystal clock frequency. */
+uint64_t cpu_global_time_freq(void)
+{
+	uint32_t eax, ebx, ecx, edx;
+
+	if (__get_cpuid_max(0, NULL) < 0x15)
+		return 0;
+
+	__cpuid(0x15, eax, ebx, ecx, edx);
+
+	if (eax == 0 || ebx == 0 || ecx == 0)
+		return 0;
+
+	return (uint64_t)ecx * ebx / eax;
+}
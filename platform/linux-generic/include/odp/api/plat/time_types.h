@@ -22,15 +22,17 @@ extern "C" {
  **/
 
 /**
- * @internal Time structure used to isolate odp-linux implementation from
- * the linux timespec structure, which is dependent on POSIX extension level.
+ * @internal Time is a single 64-bit count since ODP global init. The unit is
+ * the period of the HW time counter, or a nanosecond when the implementation
+ * falls back to the system clock.
  */
-typedef struct odp_time_t {
-	int64_t tv_sec;      /**< @internal Seconds */
-	int64_t tv_nsec;     /**< @internal Nanoseconds */
+typedef union odp_time_t {
+	uint64_t u64;        /**< @internal Time for generic operations */
+	uint64_t count;      /**< @internal HW time counter ticks */
+	uint64_t nsec;       /**< @internal Nanoseconds */
 } odp_time_t;
 
-#define ODP_TIME_NULL ((odp_time_t){0, 0})
+#define ODP_TIME_NULL ((odp_time_t){.u64 = 0})
 
 /**
  * @}
@@ -0,0 +1,70 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:	BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP internal Internet checksum (RFC 1071) calculation
+ */
+
+#ifndef ODP_CHKSUM_INTERNAL_H_
+#define ODP_CHKSUM_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/byteorder.h>
+#include <stdint.h>
+
+/*
+ * Sum of data as 32 bit words, without folding. Uses the widest vector
+ * kernel supported by the CPU. Implemented in odp_chksum.c together with
+ * odp_chksum_ones_comp16().
+ */
+uint64_t _odp_chksum_sum(const void *data, uint32_t len);
+
+/*
+ * One's complement sum of data, accumulated into a 64 bit sum without
+ * folding. Data is summed as 16 bit words in memory order, so the folded
+ * result can be stored into a header as is, without byte order conversion.
+ * Data does not need to be aligned.
+ */
+static inline uint64_t chksum_partial(const void *addr, uint32_t len,
+				      uint64_t sum)
+{
+	return sum + _odp_chksum_sum(addr, len);
+}
+
+/* Fold a partial sum into 16 bits */
+static inline uint16_t chksum_fold(uint64_t sum)
+{
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffffffff) + (sum >> 32);
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return sum;
+}
+
+/* Swap bytes of a folded sum. Needed when a partial sum starts from an odd
+ * offset of the checksummed data. */
+static inline uint16_t chksum_swap(uint16_t sum)
+{
+	return (sum << 8) | (sum >> 8);
+}
+
+/* Partial sum of a 16 bit value in CPU byte order */
+static inline uint64_t chksum_u16(uint16_t val)
+{
+	return (uint16_t)odp_cpu_to_be_16(val);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -114,6 +114,20 @@ extern "C" {
  */
 #define CONFIG_BURST_SIZE 16
 
+/*
+ * Packet data prefetch distance
+ *
+ * When events are returned one by one from a burst (e.g. by the scheduler or
+ * pktin queues), the first data cache line of the packet this many events
+ * ahead is prefetched. Zero disables data prefetching.
+ */
+#define CONFIG_PACKET_PREFETCH_DIST 4
+
+/*
+ * Maximum number of packets in a packet vector
+ */
+#define CONFIG_PACKET_VECTOR_MAX_SIZE 256
+
 /*
  * Maximum number of events in a pool
  */
@@ -124,6 +138,53 @@ extern "C" {
  */
 #define CONFIG_POOL_CACHE_SIZE 256
 
+/*
+ * Maximum number of ticks an inline timer pool is advanced per call
+ *
+ * Limits the time a thread polling for events spends in expiring timers of a
+ * timer pool processed inline (ODP_TIMER_INLINE). A pool that has fallen
+ * further behind is caught up by subsequent calls.
+ */
+#define CONFIG_TIMER_INLINE_MAX_TICKS 64
+
+/*
+ * Maximum number of shards per timer pool
+ *
+ * Timer pools can be partitioned into shards (ODP_TIMER_SHARDS), which have
+ * separate free lists and timer wheels. Each shard adds a timer wheel to the
+ * shared memory of the pool.
+ */
+#define CONFIG_TIMER_MAX_SHARDS 64
+
+/*
+ * Maximum number of outstanding operations of crypto worker threads
+ *
+ * When crypto worker threads are enabled (ODP_CRYPTO_WORKERS), asynchronous
+ * crypto operations wait in request rings of the workers. This is the number
+ * of request slots shared by all workers. Must be a power of two.
+ */
+#define CONFIG_CRYPTO_ASYNC_REQS 1024
+
+/*
+ * Maximum number of crypto worker threads
+ */
+#define CONFIG_CRYPTO_MAX_WORKERS 16
+
+/*
+ * Default maximum number of crypto sessions
+ *
+ * Session table size can be changed at run time (ODP_CRYPTO_MAX_SESSIONS).
+ * Each ODP thread allocates a cipher context table of this size.
+ */
+#define CONFIG_CRYPTO_MAX_SESSIONS 1024
+
+/*
+ * Maximum number of IPSEC SAs
+ *
+ * Each SA uses a crypto session. Must be a power of two.
+ */
+#define CONFIG_IPSEC_MAX_NUM_SA 1024
+
 /*
  * Size of the virtual address space pre-reserver for ISHM
  *
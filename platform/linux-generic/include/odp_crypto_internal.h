@@ -11,10 +11,13 @@
 extern "C" {
 #endif
 
+#include <odp/api/atomic.h>
+
 #include <openssl/des.h>
-#include <openssl/aes.h>
+#include <openssl/evp.h>
 
 #define MAX_IV_LEN      64
+#define MAX_KEY_LEN     64
 #define OP_RESULT_MAGIC 0x91919191
 
 /** Forward declaration of session structure */
@@ -31,17 +34,30 @@ odp_crypto_alg_err_t (*crypto_func_t)(odp_crypto_op_param_t *param,
  * Per crypto session data structure
  */
 struct odp_crypto_generic_session {
-	struct odp_crypto_generic_session *next;
+	/* Index of the session in the session table */
+	uint32_t index;
+
+	/* References from the application and from asynchronous operations
+	 * in flight. The session is freed when the last one is dropped. */
+	odp_atomic_u32_t ref;
 
 	/* Session creation parameters */
 	odp_crypto_session_param_t p;
 
 	odp_bool_t do_cipher_first;
 
+	/* Asynchronous operations are processed by crypto worker thread
+	 * 'worker' */
+	odp_bool_t use_worker;
+	uint32_t worker;
+
 	struct {
 		/* Copy of session IV data */
 		uint8_t iv_data[MAX_IV_LEN];
 
+		/* Copy of session cipher key data */
+		uint8_t key_data[MAX_KEY_LEN];
+
 		union {
 			struct {
 				DES_key_schedule ks1;
@@ -49,25 +65,28 @@ struct odp_crypto_generic_session {
 				DES_key_schedule ks3;
 			} des;
 			struct {
-				AES_KEY key;
-			} aes;
-			struct {
-				EVP_CIPHER_CTX *ctx;
-			} aes_gcm;
+				/* Thread local contexts are created and
+				 * keyed from session parameters */
+				const EVP_CIPHER *cipher;
+			} evp;
 		} data;
+
+		/* Generation number of the session for thread local
+		 * cipher contexts */
+		uint32_t gen;
+
 		crypto_func_t func;
 	} cipher;
 
 	struct {
 		union {
 			struct {
-				uint8_t  key[16];
-				uint32_t bytes;
-			} md5;
-			struct {
-				uint8_t  key[32];
-				uint32_t bytes;
-			} sha256;
+				/* Hash states after the inner and outer key
+				 * pad blocks */
+				EVP_MD_CTX *ictx;
+				EVP_MD_CTX *octx;
+				uint32_t    bytes;
+			} hmac;
 		} data;
 		crypto_func_t func;
 	} auth;
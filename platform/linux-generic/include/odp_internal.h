@@ -56,6 +56,7 @@ enum init_stage {
 	NO_INIT = 0,    /* No init stages completed */
 	CPUMASK_INIT,
 	TIME_INIT,
+	HASH_INIT,
 	SYSINFO_INIT,
 	FDSERVER_INIT,
 	ISHM_INIT,
@@ -66,6 +67,7 @@ enum init_stage {
 	PKTIO_INIT,
 	TIMER_INIT,
 	CRYPTO_INIT,
+	IPSEC_INIT,
 	CLASSIFICATION_INIT,
 	TRAFFIC_MNGR_INIT,
 	NAME_TABLE_INIT,
@@ -105,6 +107,11 @@ int odp_queue_term_global(void);
 
 int odp_crypto_init_global(void);
 int odp_crypto_term_global(void);
+int odp_crypto_init_local(void);
+int odp_crypto_term_local(void);
+
+int odp_ipsec_init_global(void);
+int odp_ipsec_term_global(void);
 
 int odp_timer_init_global(void);
 int odp_timer_term_global(void);
@@ -113,6 +120,9 @@ int odp_timer_disarm_all(void);
 int odp_time_init_global(void);
 int odp_time_term_global(void);
 
+int _odp_hash_init_global(void);
+int _odp_hash_term_global(void);
+
 int odp_tm_init_global(void);
 int odp_tm_term_global(void);
 
@@ -0,0 +1,30 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#ifndef ODP_IPSEC_INTERNAL_H_
+#define ODP_IPSEC_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/ipsec.h>
+
+#define IPSEC_RESULT_MAGIC 0x49505345
+
+/**
+ * Per packet IPSEC operation result
+ */
+typedef struct odp_ipsec_generic_result {
+	uint32_t magic;
+	odp_ipsec_packet_result_t result;
+} odp_ipsec_generic_result_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
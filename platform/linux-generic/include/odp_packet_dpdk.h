@@ -61,6 +61,9 @@ typedef struct {
 	odp_pktin_hash_proto_t hash;	  /**< Packet input hash protocol */
 	odp_bool_t lockless_rx;		  /**< no locking for rx */
 	odp_bool_t lockless_tx;		  /**< no locking for tx */
+	/** Checksums (PKTIO_CHKSUM_XXX) the device inserts on tx */
+	uint8_t hw_chksum_tx;
+	odp_bool_t hw_chksum_rx;	  /**< device checks rx checksums */
 	odp_ticketlock_t rx_lock[PKTIO_MAX_QUEUES];  /**< RX queue locks */
 	odp_ticketlock_t tx_lock[PKTIO_MAX_QUEUES];  /**< TX queue locks */
 	/** cache for storing extra RX packets */
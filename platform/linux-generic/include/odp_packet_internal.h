@@ -19,6 +19,8 @@ extern "C" {
 
 #include <odp/api/align.h>
 #include <odp/api/debug.h>
+#include <odp/api/hints.h>
+#include <odp_config_internal.h>
 #include <odp_buffer_internal.h>
 #include <odp_pool_internal.h>
 #include <odp_buffer_inlines.h>
@@ -26,6 +28,7 @@ extern "C" {
 #include <odp/api/packet_io.h>
 #include <odp/api/crypto.h>
 #include <odp_crypto_internal.h>
+#include <odp_ipsec_internal.h>
 
 /** Minimum segment length expected by packet_parse_common() */
 #define PACKET_PARSE_SEG_LEN 96
@@ -122,6 +125,7 @@ typedef union {
 		uint32_t l3_chksum:1;     /**< L3 chksum override */
 		uint32_t l4_chksum_set:1; /**< L3 chksum bit is valid */
 		uint32_t l4_chksum:1;     /**< L4 chksum override  */
+		uint32_t gso_size:16;     /**< Segmentation size */
 	};
 } output_flags_t;
 
@@ -200,10 +204,29 @@ typedef struct {
 	/* Result for crypto */
 	odp_crypto_generic_op_result_t op_result;
 
+	/* Result for IPSEC */
+	odp_ipsec_generic_result_t ipsec_result;
+
 	/* Packet data storage */
 	uint8_t data[0];
 } odp_packet_hdr_t;
 
+/**
+ * Internal packet vector header
+ *
+ * Packet handle table is stored into the buffer data area.
+ */
+typedef struct {
+	/* common buffer header */
+	odp_buffer_hdr_t buf_hdr;
+
+	/* Number of valid packet handles in the table */
+	uint32_t size;
+
+	/* Packet handle table storage */
+	uint8_t data[0];
+} odp_packet_vector_hdr_t;
+
 /**
  * Return the packet header
  */
@@ -212,6 +235,23 @@ static inline odp_packet_hdr_t *odp_packet_hdr(odp_packet_t pkt)
 	return (odp_packet_hdr_t *)buf_hdl_to_hdr((odp_buffer_t)pkt);
 }
 
+/**
+ * Return the packet vector header
+ */
+static inline odp_packet_vector_hdr_t *
+odp_packet_vector_hdr(odp_packet_vector_t pktv)
+{
+	return (odp_packet_vector_hdr_t *)buf_hdl_to_hdr((odp_buffer_t)pktv);
+}
+
+/**
+ * Return the packet handle table of a vector
+ */
+static inline odp_packet_t *packet_vector_tbl(odp_packet_vector_hdr_t *hdr)
+{
+	return (odp_packet_t *)(uintptr_t)hdr->buf_hdr.base_data;
+}
+
 static inline void copy_packet_parser_metadata(odp_packet_hdr_t *src_hdr,
 					       odp_packet_hdr_t *dst_hdr)
 {
@@ -226,6 +266,7 @@ static inline void copy_packet_cls_metadata(odp_packet_hdr_t *src_hdr,
 	dst_hdr->flow_hash = src_hdr->flow_hash;
 	dst_hdr->timestamp = src_hdr->timestamp;
 	dst_hdr->op_result = src_hdr->op_result;
+	dst_hdr->ipsec_result = src_hdr->ipsec_result;
 }
 
 static inline void pull_tail(odp_packet_hdr_t *pkt_hdr, uint32_t len)
@@ -299,6 +340,13 @@ static inline int packet_hdr_has_ipv6(odp_packet_hdr_t *pkt_hdr)
 	return pkt_hdr->p.input_flags.ipv6;
 }
 
+/* Prefetch first cache line of packet data. Other event types are ignored. */
+static inline void packet_prefetch_data(odp_buffer_hdr_t *buf_hdr)
+{
+	if (CONFIG_PACKET_PREFETCH_DIST && buf_hdr->type == ODP_POOL_PACKET)
+		odp_prefetch(buf_hdr->seg[0].data);
+}
+
 static inline void packet_set_ts(odp_packet_hdr_t *pkt_hdr, odp_time_t *ts)
 {
 	if (ts != NULL) {
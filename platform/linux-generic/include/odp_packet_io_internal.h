@@ -18,12 +18,15 @@
 extern "C" {
 #endif
 
+#include <odp/api/atomic.h>
 #include <odp/api/spinlock.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/time.h>
 #include <odp_classification_datamodel.h>
 #include <odp_align_internal.h>
 #include <odp_debug_internal.h>
 #include <odp_packet_io_ring_internal.h>
+#include <odp_packet_internal.h>
 
 #include <odp_config_internal.h>
 #include <odp/api/hints.h>
@@ -37,6 +40,17 @@ extern "C" {
 
 #define PKTIO_NAME_LEN 256
 
+/* Maximum number of packets a packet is segmented into in software */
+#define PKTIO_GSO_MAX_SEGS 128
+
+/* Number of retries when output queue is full while sending segments.
+ * Segments left unsent are sent first on the next send call. */
+#define PKTIO_GSO_SEND_RETRY 16
+
+/* Maximum number of packets held per input queue for coalescing with
+ * packets of the next receive calls */
+#define PKTIO_GRO_MAX_HELD 8
+
 #define PKTIN_INVALID  ((odp_pktin_queue_t) {ODP_PKTIO_INVALID, 0})
 #define PKTOUT_INVALID ((odp_pktout_queue_t) {ODP_PKTIO_INVALID, 0})
 
@@ -106,6 +120,73 @@ typedef	struct {
 					_ipc_map_remote_pool() */
 } _ipc_pktio_t;
 
+/** Software flow hash algorithms */
+typedef enum {
+	PKTIO_HASH_TOEPLITZ = 0, /**< Toeplitz, as calculated by NIC RSS */
+	PKTIO_HASH_CRC32C        /**< CRC32C over the flow tuple */
+} pktio_hash_alg_t;
+
+/** Toeplitz key length. Covers IPv6 addresses and port numbers. */
+#define PKTIO_HASH_KEY_LEN 40
+
+typedef struct {
+	odp_pktin_hash_proto_t proto;	/**< hashed protocols, all zero when
+					     software hashing is disabled */
+	pktio_hash_alg_t alg;		/**< hash algorithm */
+	unsigned num_queues;		/**< number of event queues packets
+					     are spread into in software,
+					     zero when driver spreads */
+	uint8_t key[PKTIO_HASH_KEY_LEN]; /**< Toeplitz key */
+} pktio_sw_hash_t;
+
+/** Coalescing state of a received packet */
+typedef struct {
+	uint32_t flow;		/**< flow hash, zero for other packets */
+	uint32_t hdr_len;	/**< length of L2, L3 and L4 headers */
+	uint32_t payload;	/**< L4 payload length */
+	uint32_t seg_size;	/**< payload length of coalesced segments */
+	uint32_t pad;		/**< L2 padding after the IP packet */
+	uint32_t segs;		/**< number of coalesced segments */
+	uint64_t sum;		/**< partial sum of L4 payload */
+	int merge;		/**< packet may be merged into an earlier one */
+	int open;		/**< later packets may be merged into packet */
+} pktio_gro_pkt_t;
+
+/** Packets held for coalescing in a packet input queue. Headers of held
+ * packets are updated only when the packets are output. */
+typedef struct {
+	odp_spinlock_t lock;		/**< protects held packets */
+	int num;			/**< number of held packets */
+	odp_time_t time;		/**< when the oldest packet was held */
+	odp_packet_t pkt[PKTIO_GRO_MAX_HELD]; /**< held packets */
+	pktio_gro_pkt_t g[PKTIO_GRO_MAX_HELD]; /**< their coalescing state */
+} pktio_gro_queue_t;
+
+/** Segments left unsent in a packet output queue */
+typedef struct {
+	odp_spinlock_t lock;		/**< protects unsent segments */
+	int first;			/**< index of the first unsent segment */
+	int num;			/**< number of unsent segments */
+	odp_packet_t seg[PKTIO_GSO_MAX_SEGS]; /**< unsent segments */
+} pktio_gso_queue_t;
+
+/** Software segmentation state */
+typedef struct {
+	odp_atomic_u64_t discards;	/**< segments dropped on output */
+	odp_bool_t lockless;		/**< queues are not used concurrently */
+	pktio_gso_queue_t queue[PKTIO_MAX_QUEUES];
+} pktio_gso_t;
+
+/** Packet input coalescing state */
+typedef struct {
+	odp_pktin_config_opt_t sw;	/**< coalescing done in software */
+	uint64_t flush_ns;		/**< hold time across receive calls,
+					     zero when packets are not held */
+	odp_atomic_u64_t pkts;		/**< coalesced packets */
+	odp_atomic_u64_t segs;		/**< packets coalesced into those */
+	pktio_gro_queue_t queue[PKTIO_MAX_QUEUES];
+} pktio_gro_t;
+
 struct pktio_entry {
 	const struct pktio_if_ops *ops; /**< Implementation specific methods */
 	/* These two locks together lock the whole pktio device */
@@ -145,6 +226,13 @@ struct pktio_entry {
 		PKTIO_STATE_STOPPED
 	} state;
 	odp_pktio_config_t config;	/**< Device configuration */
+	odp_pktout_config_opt_t gso_sw;	/**< segmentation done in software */
+	pktio_gso_t gso;		/**< software segmentation state */
+	pktio_gro_t gro;		/**< packet input coalescing */
+	pktio_sw_hash_t sw_hash;	/**< software flow hashing */
+	odp_ticketlock_t sw_hash_lock;	/**< serializes receive of packets
+					     spread in software */
+	odp_pktin_vector_config_t in_vector; /**< packet input vectors */
 	classifier_t cls;		/**< classifier linked with this pktio*/
 	odp_pktio_stats_t stats;	/**< statistic counters for pktio */
 	enum {
@@ -249,6 +337,144 @@ static inline void pktio_cls_enabled_set(pktio_entry_t *entry, int ena)
 	entry->s.cls_enabled = ena;
 }
 
+/* Software flow hashing of an input queue configuration */
+void pktio_sw_hash_config(pktio_sw_hash_t *sw_hash,
+			  const odp_pktin_queue_param_t *param,
+			  unsigned num_drv_queues);
+
+void _pktio_sw_hash(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr);
+
+/* Calculate flow hash of a received packet when driver has no hashing */
+static inline void pktio_sw_hash(pktio_entry_t *entry,
+				 odp_packet_hdr_t *pkt_hdr)
+{
+	if (odp_unlikely(entry->s.sw_hash.proto.all_bits))
+		_pktio_sw_hash(entry, pkt_hdr);
+}
+
+/* Checksums to insert on packet output */
+#define PKTIO_CHKSUM_L3 0x1 /**< IPv4 header checksum */
+#define PKTIO_CHKSUM_L4 0x2 /**< UDP or TCP checksum */
+
+/* Advertise checksum options, which are implemented in software when
+ * the driver does not offload them */
+static inline void pktio_chksum_capa(odp_pktio_config_t *config)
+{
+	config->pktin.bit.ipv4_chksum  = 1;
+	config->pktin.bit.udp_chksum   = 1;
+	config->pktin.bit.tcp_chksum   = 1;
+	config->pktout.bit.ipv4_chksum = 1;
+	config->pktout.bit.udp_chksum  = 1;
+	config->pktout.bit.tcp_chksum  = 1;
+}
+
+void _pktio_chksum_check(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+			 int l4);
+
+/* Check checksums of a received packet and set error flags accordingly */
+static inline void pktio_chksum_check(pktio_entry_t *entry,
+				      odp_packet_hdr_t *pkt_hdr)
+{
+	odp_pktin_config_opt_t pktin = entry->s.config.pktin;
+
+	if (odp_unlikely(pktin.bit.ipv4_chksum || pktin.bit.udp_chksum ||
+			 pktin.bit.tcp_chksum))
+		_pktio_chksum_check(entry, pkt_hdr, 1);
+}
+
+/* Check checksums of a packet received from a packet socket. The L4
+ * checksum is not checked when the kernel has already validated it
+ * (TP_STATUS_CSUM_VALID), or when it has not been calculated yet for a
+ * locally generated packet (TP_STATUS_CSUMNOTREADY). */
+static inline void sock_chksum_check(pktio_entry_t *entry,
+				     odp_packet_hdr_t *pkt_hdr,
+				     uint32_t tp_status)
+{
+	odp_pktin_config_opt_t pktin = entry->s.config.pktin;
+
+	if (odp_likely(!(tp_status & (TP_STATUS_CSUM_VALID |
+				      TP_STATUS_CSUMNOTREADY)))) {
+		pktio_chksum_check(entry, pkt_hdr);
+		return;
+	}
+
+	if (odp_unlikely(pktin.bit.ipv4_chksum))
+		_pktio_chksum_check(entry, pkt_hdr, 0);
+}
+
+/* Checksums (PKTIO_CHKSUM_XXX) to insert into an output packet, according
+ * to pktio configuration and packet overrides */
+int pktio_chksum_out_flags(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr);
+
+/* Calculate and insert checksums into a packet in software */
+void pktio_chksum_insert_sw(odp_packet_hdr_t *pkt_hdr, int flags);
+
+void _pktio_chksum_insert(pktio_entry_t *entry, const odp_packet_t pkt_tbl[],
+			  int num);
+
+/* Insert checksums into packets right before transmission, when driver
+ * does not offload checksum calculation. Called with the driver TX lock held
+ * (if any), so that pktout configuration cannot change during the call. */
+static inline void pktio_chksum_insert(pktio_entry_t *entry,
+				       const odp_packet_t pkt_tbl[], int num)
+{
+	odp_pktout_config_opt_t pktout = entry->s.config.pktout;
+
+	if (odp_unlikely(pktout.bit.ipv4_chksum || pktout.bit.udp_chksum ||
+			 pktout.bit.tcp_chksum))
+		_pktio_chksum_insert(entry, pkt_tbl, num);
+}
+
+/* Segment a packet in software. The packet itself is the first output
+ * packet. Returns the number of output packets in 'seg_tbl', 0 when the
+ * packet is sent as is, or <0 on failure. */
+int pktio_gso_segment(pktio_entry_t *entry, odp_packet_t pkt,
+		      odp_packet_t seg_tbl[], int max_num);
+
+/* Drop segments left unsent in output queues */
+void pktio_gso_term(pktio_entry_t *entry);
+
+struct virtio_net_hdr;
+
+/* Prepare a packet for TCP segmentation offload through a virtio net header
+ * (tap IFF_VNET_HDR or packet socket PACKET_VNET_HDR). Returns 1 when the
+ * kernel segments the packet, or 0 when the packet is sent as is with
+ * an all zero header. */
+int pktio_gso_vnet_hdr(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+		       struct virtio_net_hdr *vnet);
+
+/* Complete checksum and segmentation size of a received packet from its
+ * virtio net header (tap IFF_VNET_HDR) */
+void pktio_vnet_hdr_recv(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+			 const struct virtio_net_hdr *vnet);
+
+/* Configure packet input coalescing. Frees held packets. */
+void pktio_gro_config(pktio_entry_t *entry, const odp_pktio_config_t *config);
+
+/* Free packets held for coalescing */
+void pktio_gro_term(pktio_entry_t *entry);
+
+int _pktio_gro_recv(pktio_entry_t *entry, int index, odp_packet_t packets[],
+		    int num);
+
+/* Receive packets from a driver input queue and coalesce them in software
+ * when enabled */
+static inline int pktio_recv(pktio_entry_t *entry, int index,
+			     odp_packet_t packets[], int num)
+{
+	if (odp_likely(!entry->s.gro.sw.all_bits))
+		return entry->s.ops->recv(entry, index, packets, num);
+
+	return _pktio_gro_recv(entry, index, packets, num);
+}
+
+/* Count packets coalesced outside of software coalescing (by the kernel) */
+static inline void pktio_gro_stats(pktio_entry_t *entry, uint32_t segs)
+{
+	odp_atomic_inc_u64(&entry->s.gro.pkts);
+	odp_atomic_add_u64(&entry->s.gro.segs, segs);
+}
+
 /*
  * Dummy single queue implementations of multi-queue API
  */
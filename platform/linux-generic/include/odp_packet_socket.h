@@ -42,6 +42,11 @@
 #define PACKET_FANOUT_HASH	0
 #endif /* PACKET_FANOUT */
 
+/* Kernels older than 3.16 do not report validated checksums */
+#ifndef TP_STATUS_CSUM_VALID
+#define TP_STATUS_CSUM_VALID	(1 << 7)
+#endif /* TP_STATUS_CSUM_VALID */
+
 typedef struct {
 	int sockfd; /**< socket descriptor */
 	odp_pool_t pool; /**< pool to alloc packets from */
@@ -49,6 +54,8 @@ typedef struct {
 	unsigned char if_mac[ETH_ALEN];	/**< IF eth mac addr */
 	uint8_t *cache_ptr[ODP_PACKET_SOCKET_MAX_BURST_RX];
 	odp_shm_t shm;
+	unsigned int if_idx; /**< interface index */
+	int gso_fd;      /**< socket for packets with virtio net header */
 } pkt_sock_t;
 
 /** packet mmap ring */
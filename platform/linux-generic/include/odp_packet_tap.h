@@ -16,6 +16,10 @@ typedef struct {
 	unsigned char if_mac[ETH_ALEN];	/**< MAC address of pktio side (not a
 					     MAC address of kernel interface)*/
 	odp_pool_t pool;		/**< pool to alloc packets from */
+	odp_bool_t vnet_hdr;		/**< virtio net header in front of
+					     packets */
+	odp_bool_t offload;		/**< kernel coalesces packets and
+					     leaves checksums to pktio */
 } pkt_tap_t;
 
 #endif
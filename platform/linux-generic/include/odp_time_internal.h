@@ -0,0 +1,39 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * ODP time service - implementation internal
+ */
+
+#ifndef ODP_TIME_INTERNAL_H_
+#define ODP_TIME_INTERNAL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <odp/api/std_types.h>
+
+/* Architecture specific time counter, which runs at a constant rate and is
+ * synchronized between all CPUs (e.g. invariant TSC on x86, generic timer
+ * virtual counter on ARMv8). Implemented in arch/<arch>/odp_cpu_arch.c. */
+
+/* Non-zero when the architecture provides a usable time counter */
+int cpu_has_global_time(void);
+
+/* Current time counter value */
+uint64_t cpu_global_time(void);
+
+/* Time counter frequency in Hz, or 0 when it needs to be calibrated */
+uint64_t cpu_global_time_freq(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
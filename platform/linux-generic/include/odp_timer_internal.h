@@ -19,6 +19,8 @@
 #include <odp_buffer_internal.h>
 #include <odp_pool_internal.h>
 #include <odp/api/timer.h>
+#include <odp/api/atomic.h>
+#include <odp/api/hints.h>
 
 /**
  * Internal Timeout header
@@ -35,4 +37,17 @@ typedef struct {
 	odp_timer_t timer;
 } odp_timeout_hdr_t;
 
+/* Number of timer pools expired inline by threads polling for events */
+extern odp_atomic_u32_t _timer_num_inline;
+
+void _timer_run(void);
+
+/* Advance and expire inline timer pools. Called by the scheduler and queue
+ * dequeue before looking for events. */
+static inline void timer_run(void)
+{
+	if (odp_unlikely(odp_atomic_load_u32(&_timer_num_inline)))
+		_timer_run();
+}
+
 #endif
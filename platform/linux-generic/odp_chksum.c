@@ -0,0 +1,161 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:	BSD-3-Clause
+ */
+
+#include <odp/api/chksum.h>
+#include <odp_chksum_internal.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+/* All sum kernels below add the data as 32-bit words into a 64-bit
+ * accumulator. Folding the result down to 16 bits gives the same one's
+ * complement sum as adding the data as 16-bit words, so the vector kernels
+ * are free to use the widest additions available. */
+
+/* Scalar sum of the bytes not consumed by a vector kernel. An odd last
+ * byte is summed as if it was followed by a zero byte. */
+static inline uint64_t sum_tail(const uint8_t *data, uint32_t len)
+{
+	uint64_t sum = 0;
+	uint32_t w32;
+	uint16_t w16;
+	uint8_t  last[2];
+
+	while (len >= 4) {
+		memcpy(&w32, data, 4);
+		sum  += w32;
+		data += 4;
+		len  -= 4;
+	}
+
+	if (len >= 2) {
+		memcpy(&w16, data, 2);
+		sum  += w16;
+		data += 2;
+		len  -= 2;
+	}
+
+	if (len) {
+		last[0] = *data;
+		last[1] = 0;
+		memcpy(&w16, last, 2);
+		sum += w16;
+	}
+
+	return sum;
+}
+
+#if defined(__SSE2__)
+static uint64_t sum_sse2(const uint8_t *data, uint32_t len)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i acc0 = _mm_setzero_si128();
+	__m128i acc1 = _mm_setzero_si128();
+	__m128i v0, v1;
+	uint64_t tmp[2];
+
+	while (len >= 32) {
+		v0 = _mm_loadu_si128((const __m128i *)(const void *)data);
+		v1 = _mm_loadu_si128((const __m128i *)(const void *)
+				     (data + 16));
+
+		/* Zero extend 32-bit words to 64-bit lanes */
+		acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(v0, zero));
+		acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(v0, zero));
+		acc0 = _mm_add_epi64(acc0, _mm_unpacklo_epi32(v1, zero));
+		acc1 = _mm_add_epi64(acc1, _mm_unpackhi_epi32(v1, zero));
+
+		data += 32;
+		len  -= 32;
+	}
+
+	_mm_storeu_si128((__m128i *)(void *)tmp, _mm_add_epi64(acc0, acc1));
+
+	/* Each lane sums at most 2^31 words, there is no overflow */
+	return tmp[0] + tmp[1] + sum_tail(data, len);
+}
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && \
+	(defined(__clang__) || __GNUC__ >= 5)
+#define CHKSUM_AVX2 1
+
+__attribute__((target("avx2")))
+static uint64_t sum_avx2(const uint8_t *data, uint32_t len)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i acc0 = _mm256_setzero_si256();
+	__m256i acc1 = _mm256_setzero_si256();
+	__m256i v0, v1;
+	uint64_t tmp[4];
+
+	while (len >= 64) {
+		v0 = _mm256_loadu_si256((const __m256i *)(const void *)data);
+		v1 = _mm256_loadu_si256((const __m256i *)(const void *)
+					(data + 32));
+
+		acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(v0, zero));
+		acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(v0, zero));
+		acc0 = _mm256_add_epi64(acc0, _mm256_unpacklo_epi32(v1, zero));
+		acc1 = _mm256_add_epi64(acc1, _mm256_unpackhi_epi32(v1, zero));
+
+		data += 64;
+		len  -= 64;
+	}
+
+	_mm256_storeu_si256((__m256i *)(void *)tmp,
+			    _mm256_add_epi64(acc0, acc1));
+
+	return tmp[0] + tmp[1] + tmp[2] + tmp[3] + sum_tail(data, len);
+}
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+static uint64_t sum_neon(const uint8_t *data, uint32_t len)
+{
+	uint64x2_t acc0 = vdupq_n_u64(0);
+	uint64x2_t acc1 = vdupq_n_u64(0);
+
+	while (len >= 32) {
+		/* Pairwise add 32-bit words into 64-bit lanes */
+		acc0 = vpadalq_u32(acc0, vreinterpretq_u32_u8(vld1q_u8(data)));
+		acc1 = vpadalq_u32(acc1,
+				   vreinterpretq_u32_u8(vld1q_u8(data + 16)));
+
+		data += 32;
+		len  -= 32;
+	}
+
+	acc0 = vaddq_u64(acc0, acc1);
+
+	return vgetq_lane_u64(acc0, 0) + vgetq_lane_u64(acc0, 1) +
+	       sum_tail(data, len);
+}
+#endif
+
+uint64_t _odp_chksum_sum(const void *data, uint32_t len)
+{
+#ifdef CHKSUM_AVX2
+	if (len >= 128 && __builtin_cpu_supports("avx2"))
+		return sum_avx2(data, len);
+#endif
+#if defined(__SSE2__)
+	return sum_sse2(data, len);
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	return sum_neon(data, len);
+#else
+	return sum_tail(data, len);
+#endif
+}
+
+uint16_t odp_chksum_ones_comp16(const void *data, uint32_t data_len)
+{
+	return chksum_fold(_odp_chksum_sum(data, data_len));
+}
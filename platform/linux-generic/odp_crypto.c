@@ -18,16 +18,71 @@
 #include <odp/api/hints.h>
 #include <odp/api/random.h>
 #include <odp_packet_internal.h>
+#include <odp_ring_internal.h>
+#include <odp_config_internal.h>
+#include <odp_align_internal.h>
+#include <odp/api/cpumask.h>
+#include <odp/api/init.h>
 
 #include <string.h>
 #include <stdlib.h>
+#include <pthread.h>
+#include <sched.h>
+#include <inttypes.h>
 
 #include <openssl/des.h>
 #include <openssl/rand.h>
 #include <openssl/hmac.h>
 #include <openssl/evp.h>
 
-#define MAX_SESSIONS 32
+/* Free session indexes are moved between the global free ring and thread
+ * local caches in bursts */
+#define SESSION_CACHE_BURST 8
+#define SESSION_CACHE_SIZE  (2 * SESSION_CACHE_BURST)
+
+/* Maximum number of operations per odp_crypto_operation_multi() call */
+#define MAX_BURST 32
+
+/* Request rings hold indexes of all request slots */
+#define REQ_RING_SIZE (2 * CONFIG_CRYPTO_ASYNC_REQS)
+#define REQ_RING_MASK (REQ_RING_SIZE - 1)
+
+/* Empty request ring polls before an idle worker yields the CPU */
+#define WORKER_IDLE_POLLS 64
+
+/* Crypto worker thread status */
+#define WORKER_STARTING 0
+#define WORKER_RUNNING  1
+#define WORKER_FAILED   2
+
+/* Largest block size of supported HMAC hash functions (SHA-512) */
+#define MAX_HMAC_BLOCK 128
+
+/* Largest block size of supported block ciphers (AES) */
+#define MAX_CIPHER_BLOCK 16
+
+/* Tag length of AES-GCM, AES-GMAC and ChaCha20-Poly1305 */
+#define AEAD_TAG_LEN 16
+
+/* Basic random data is reseeded after this many bytes */
+#define RAND_RESEED_LEN (1024 * 1024)
+
+/* Seed length: AES-128 key and counter block */
+#define RAND_SEED_LEN 32
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#define EVP_MD_CTX_new  EVP_MD_CTX_create
+#define EVP_MD_CTX_free EVP_MD_CTX_destroy
+#define EVP_CTRL_AEAD_SET_IVLEN EVP_CTRL_GCM_SET_IVLEN
+#define EVP_CTRL_AEAD_GET_TAG   EVP_CTRL_GCM_GET_TAG
+#define EVP_CTRL_AEAD_SET_TAG   EVP_CTRL_GCM_SET_TAG
+#endif
+
+/* ChaCha20-Poly1305 is available since OpenSSL 1.1.0 */
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L && !defined(OPENSSL_NO_CHACHA) && \
+	!defined(OPENSSL_NO_POLY1305)
+#define HAVE_CHACHA20_POLY1305 1
+#endif
 
 /*
  * Cipher algorithm capabilities
@@ -41,10 +96,24 @@ static const odp_crypto_cipher_capability_t cipher_capa_trides_cbc[] = {
 {.key_len = 24, .iv_len = 8} };
 
 static const odp_crypto_cipher_capability_t cipher_capa_aes_cbc[] = {
-{.key_len = 16, .iv_len = 16} };
+{.key_len = 16, .iv_len = 16},
+{.key_len = 24, .iv_len = 16},
+{.key_len = 32, .iv_len = 16} };
+
+static const odp_crypto_cipher_capability_t cipher_capa_aes_ctr[] = {
+{.key_len = 16, .iv_len = 16},
+{.key_len = 24, .iv_len = 16},
+{.key_len = 32, .iv_len = 16} };
 
 static const odp_crypto_cipher_capability_t cipher_capa_aes_gcm[] = {
-{.key_len = 16, .iv_len = 12} };
+{.key_len = 16, .iv_len = 12},
+{.key_len = 24, .iv_len = 12},
+{.key_len = 32, .iv_len = 12} };
+
+#ifdef HAVE_CHACHA20_POLY1305
+static const odp_crypto_cipher_capability_t cipher_capa_chacha20_poly1305[] = {
+{.key_len = 32, .iv_len = 12} };
+#endif
 
 /*
  * Authentication algorithm capabilities
@@ -54,22 +123,109 @@ static const odp_crypto_cipher_capability_t cipher_capa_aes_gcm[] = {
 static const odp_crypto_auth_capability_t auth_capa_md5_hmac[] = {
 {.digest_len = 12, .key_len = 16, .aad_len = {.min = 0, .max = 0, .inc = 0} } };
 
+static const odp_crypto_auth_capability_t auth_capa_sha1_hmac[] = {
+{.digest_len = 12, .key_len = 20, .aad_len = {.min = 0, .max = 0, .inc = 0} } };
+
 static const odp_crypto_auth_capability_t auth_capa_sha256_hmac[] = {
 {.digest_len = 16, .key_len = 32, .aad_len = {.min = 0, .max = 0, .inc = 0} } };
 
+static const odp_crypto_auth_capability_t auth_capa_sha384_hmac[] = {
+{.digest_len = 24, .key_len = 48, .aad_len = {.min = 0, .max = 0, .inc = 0} } };
+
+static const odp_crypto_auth_capability_t auth_capa_sha512_hmac[] = {
+{.digest_len = 32, .key_len = 64, .aad_len = {.min = 0, .max = 0, .inc = 0} } };
+
 static const odp_crypto_auth_capability_t auth_capa_aes_gcm[] = {
 {.digest_len = 16, .key_len = 0, .aad_len = {.min = 8, .max = 12, .inc = 4} } };
 
+static const odp_crypto_auth_capability_t auth_capa_aes_gmac[] = {
+{.digest_len = 16, .key_len = 16, .aad_len = {.min = 0, .max = 0, .inc = 0} },
+{.digest_len = 16, .key_len = 24, .aad_len = {.min = 0, .max = 0, .inc = 0} },
+{.digest_len = 16, .key_len = 32, .aad_len = {.min = 0, .max = 0, .inc = 0} } };
+
+#ifdef HAVE_CHACHA20_POLY1305
+static const odp_crypto_auth_capability_t auth_capa_chacha20_poly1305[] = {
+{.digest_len = 16, .key_len = 0, .aad_len = {.min = 8, .max = 12, .inc = 4} } };
+#endif
+
+/* Ring of request slot indexes */
+typedef struct {
+	ring_t   hdr;
+	uint32_t data[REQ_RING_SIZE];
+} crypto_ring_t ODP_ALIGNED_CACHE;
+
+/* Asynchronous operation waiting for a crypto worker */
+typedef struct {
+	odp_crypto_op_param_t param;
+	odp_crypto_generic_session_t *session;
+} crypto_req_t;
+
+typedef struct {
+	/* Requests of the sessions of this worker */
+	crypto_ring_t ring;
+	pthread_t thread;
+	/* WORKER_STARTING, WORKER_RUNNING or WORKER_FAILED */
+	odp_atomic_u32_t status;
+} crypto_worker_t;
+
 typedef struct odp_crypto_global_s odp_crypto_global_t;
 
 struct odp_crypto_global_s {
+	/* Protects crypto worker start and stop */
 	odp_spinlock_t                lock;
-	odp_ticketlock_t **openssl_lock;
-	odp_crypto_generic_session_t *free;
+	/* Generation counter of sessions using cipher contexts */
+	odp_atomic_u32_t              cipher_gen;
+	/* Number of crypto worker threads, zero when async operations are
+	 * processed by the caller */
+	uint32_t                      num_workers;
+	/* Workers run while there are sessions using them */
+	uint32_t                      num_worker_sessions;
+	odp_atomic_u32_t              worker_exit;
+	/* Worker threads have been started and not joined yet */
+	int                           workers_created;
+	/* CPUs of worker threads, empty when not pinned */
+	odp_cpumask_t                 worker_mask;
+	/* Free request slots */
+	crypto_ring_t                 free_ring;
+	crypto_req_t                  req[CONFIG_CRYPTO_ASYNC_REQS];
+	crypto_worker_t               worker[CONFIG_CRYPTO_MAX_WORKERS];
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+	odp_ticketlock_t             *openssl_lock;
+#endif
+	/* Number of sessions reported in capability */
+	uint32_t                      max_sessions;
+	/* Size of the session table */
+	uint32_t                      num_sessions;
+	/* Free session indexes */
+	ring_t                       *session_ring;
+	uint32_t                      session_mask;
 	odp_crypto_generic_session_t  sessions[0];
 };
 
+/* Thread local variables */
+typedef struct crypto_local_t {
+	/* Work context for HMAC operations */
+	EVP_MD_CTX *md_ctx;
+
+	/* Cipher contexts per session, and the session generation they were
+	 * keyed for. Tables are indexed by session index. */
+	EVP_CIPHER_CTX **cipher_ctx;
+	uint32_t *cipher_gen;
+
+	/* AES-CTR keystream generator of ODP_RANDOM_BASIC data, and bytes
+	 * left until it is reseeded */
+	EVP_CIPHER_CTX *rand_ctx;
+	uint32_t rand_left;
+
+	/* Cache of free session indexes. Crypto workers do not allocate
+	 * sessions and free them directly into the ring. */
+	odp_bool_t no_cache;
+	uint32_t num_free;
+	uint32_t free_idx[SESSION_CACHE_SIZE];
+} crypto_local_t;
+
 static odp_crypto_global_t *global;
+static __thread crypto_local_t local;
 
 static
 odp_crypto_generic_op_result_t *get_op_result_from_event(odp_event_t ev)
@@ -82,13 +238,22 @@ odp_crypto_generic_op_result_t *get_op_result_from_event(odp_event_t ev)
 static
 odp_crypto_generic_session_t *alloc_session(void)
 {
-	odp_crypto_generic_session_t *session = NULL;
+	odp_crypto_generic_session_t *session;
+	uint32_t num = local.num_free;
+
+	/* Refill the local cache from the free ring */
+	if (odp_unlikely(num == 0)) {
+		num = ring_deq_multi(global->session_ring, global->session_mask,
+				     local.free_idx, SESSION_CACHE_BURST);
+		if (num == 0)
+			return NULL;
+	}
 
-	odp_spinlock_lock(&global->lock);
-	session = global->free;
-	if (session)
-		global->free = session->next;
-	odp_spinlock_unlock(&global->lock);
+	num--;
+	local.num_free = num;
+
+	session = &global->sessions[local.free_idx[num]];
+	odp_atomic_init_u32(&session->ref, 1);
 
 	return session;
 }
@@ -96,10 +261,71 @@ odp_crypto_generic_session_t *alloc_session(void)
 static
 void free_session(odp_crypto_generic_session_t *session)
 {
-	odp_spinlock_lock(&global->lock);
-	session->next = global->free;
-	global->free = session;
-	odp_spinlock_unlock(&global->lock);
+	uint32_t num = local.num_free;
+
+	if (odp_unlikely(local.no_cache)) {
+		ring_enq(global->session_ring, global->session_mask,
+			 session->index);
+		return;
+	}
+
+	/* Return a burst of indexes to the free ring, when the local cache
+	 * is full */
+	if (odp_unlikely(num == SESSION_CACHE_SIZE)) {
+		num -= SESSION_CACHE_BURST;
+		ring_enq_multi(global->session_ring, global->session_mask,
+			       &local.free_idx[num], SESSION_CACHE_BURST);
+	}
+
+	local.free_idx[num] = session->index;
+	local.num_free = num + 1;
+}
+
+/* Packet data processing function. Processes 'len' bytes of data in place. */
+typedef void (*packet_data_fn_t)(void *arg, uint8_t *data, uint32_t len);
+
+/* 3DES CBC state of an operation */
+typedef struct {
+	odp_crypto_generic_session_t *session;
+	DES_cblock iv;
+	int enc;
+} des_op_t;
+
+/* Pass a data range of the packet to 'fn' one contiguous piece at a time,
+ * so that segmented packets are processed without linearizing them. Range
+ * length must be a multiple of 'block' (a power of two). A block that
+ * straddles a segment boundary is gathered into a bounce buffer and written
+ * back after processing. */
+static int packet_data_walk(odp_packet_t pkt, uint32_t offset, uint32_t len,
+			    uint32_t block, packet_data_fn_t fn, void *arg)
+{
+	uint8_t buf[MAX_CIPHER_BLOCK];
+	uint32_t seg_len, num;
+	uint8_t *data;
+
+	if (odp_unlikely((uint64_t)offset + len > odp_packet_len(pkt) ||
+			 block > MAX_CIPHER_BLOCK || (len & (block - 1))))
+		return -1;
+
+	while (len) {
+		data = odp_packet_offset(pkt, offset, &seg_len, NULL);
+		num  = seg_len < len ? seg_len : len;
+		num &= ~(block - 1);
+
+		if (odp_likely(num)) {
+			fn(arg, data, num);
+		} else {
+			num = block;
+			odp_packet_copy_to_mem(pkt, offset, num, buf);
+			fn(arg, buf, num);
+			odp_packet_copy_from_mem(pkt, offset, num, buf);
+		}
+
+		offset += num;
+		len    -= num;
+	}
+
+	return 0;
 }
 
 static odp_crypto_alg_err_t
@@ -109,129 +335,94 @@ null_crypto_routine(odp_crypto_op_param_t *param ODP_UNUSED,
 	return ODP_CRYPTO_ALG_ERR_NONE;
 }
 
-static
-odp_crypto_alg_err_t md5_gen(odp_crypto_op_param_t *param,
-			     odp_crypto_generic_session_t *session)
+static void digest_update(void *arg, uint8_t *data, uint32_t len)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint8_t *icv   = data;
-	uint32_t len   = param->auth_range.length;
-	uint8_t  hash[EVP_MAX_MD_SIZE];
+	EVP_DigestUpdate(arg, data, len);
+}
 
-	/* Adjust pointer for beginning of area to auth */
-	data += param->auth_range.offset;
-	icv  += param->hash_result_offset;
+static void cipher_update(void *arg, uint8_t *data, uint32_t len)
+{
+	int out_len;
 
-	/* Hash it */
-	HMAC(EVP_md5(),
-	     session->auth.data.md5.key,
-	     16,
-	     data,
-	     len,
-	     hash,
-	     NULL);
+	EVP_CipherUpdate(arg, data, &out_len, data, len);
+}
 
-	/* Copy to the output location */
-	memcpy(icv, hash, session->auth.data.md5.bytes);
+/* Additional authenticated data is not encrypted */
+static void aad_update(void *arg, uint8_t *data, uint32_t len)
+{
+	int out_len;
 
-	return ODP_CRYPTO_ALG_ERR_NONE;
+	EVP_CipherUpdate(arg, NULL, &out_len, data, len);
 }
 
-static
-odp_crypto_alg_err_t md5_check(odp_crypto_op_param_t *param,
-			       odp_crypto_generic_session_t *session)
+/* Finish HMAC from the precomputed inner and outer hash states */
+static int hmac_digest(odp_crypto_op_param_t *param,
+		       odp_crypto_generic_session_t *session,
+		       uint8_t *hash)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint8_t *icv   = data;
-	uint32_t len   = param->auth_range.length;
-	uint32_t bytes = session->auth.data.md5.bytes;
-	uint8_t  hash_in[EVP_MAX_MD_SIZE];
-	uint8_t  hash_out[EVP_MAX_MD_SIZE];
+	EVP_MD_CTX *ctx = local.md_ctx;
+	unsigned int len;
 
-	/* Adjust pointer for beginning of area to auth */
-	data += param->auth_range.offset;
-	icv  += param->hash_result_offset;
-
-	/* Copy current value out and clear it before authentication */
-	memset(hash_in, 0, sizeof(hash_in));
-	memcpy(hash_in, icv, bytes);
-	memset(icv, 0, bytes);
-	memset(hash_out, 0, sizeof(hash_out));
+	if (odp_unlikely(!EVP_MD_CTX_copy_ex(ctx,
+					     session->auth.data.hmac.ictx)))
+		return -1;
 
-	/* Hash it */
-	HMAC(EVP_md5(),
-	     session->auth.data.md5.key,
-	     16,
-	     data,
-	     len,
-	     hash_out,
-	     NULL);
+	if (odp_unlikely(packet_data_walk(param->out_pkt,
+					  param->auth_range.offset,
+					  param->auth_range.length, 1,
+					  digest_update, ctx)))
+		return -1;
 
-	/* Verify match */
-	if (0 != memcmp(hash_in, hash_out, bytes))
-		return ODP_CRYPTO_ALG_ERR_ICV_CHECK;
+	if (odp_unlikely(!EVP_DigestFinal_ex(ctx, hash, &len) ||
+			 !EVP_MD_CTX_copy_ex(ctx,
+					     session->auth.data.hmac.octx) ||
+			 !EVP_DigestUpdate(ctx, hash, len) ||
+			 !EVP_DigestFinal_ex(ctx, hash, NULL)))
+		return -1;
 
-	/* Matched */
-	return ODP_CRYPTO_ALG_ERR_NONE;
+	return 0;
 }
 
 static
-odp_crypto_alg_err_t sha256_gen(odp_crypto_op_param_t *param,
-				odp_crypto_generic_session_t *session)
+odp_crypto_alg_err_t hmac_gen(odp_crypto_op_param_t *param,
+			      odp_crypto_generic_session_t *session)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint8_t *icv   = data;
-	uint32_t len   = param->auth_range.length;
 	uint8_t  hash[EVP_MAX_MD_SIZE];
 
-	/* Adjust pointer for beginning of area to auth */
-	data += param->auth_range.offset;
-	icv  += param->hash_result_offset;
-
 	/* Hash it */
-	HMAC(EVP_sha256(),
-	     session->auth.data.sha256.key,
-	     32,
-	     data,
-	     len,
-	     hash,
-	     NULL);
+	if (odp_unlikely(hmac_digest(param, session, hash)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
 	/* Copy to the output location */
-	memcpy(icv, hash, session->auth.data.sha256.bytes);
+	if (odp_unlikely(odp_packet_copy_from_mem(param->out_pkt,
+						  param->hash_result_offset,
+						  session->auth.data.hmac.bytes,
+						  hash)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
 	return ODP_CRYPTO_ALG_ERR_NONE;
 }
 
 static
-odp_crypto_alg_err_t sha256_check(odp_crypto_op_param_t *param,
-				  odp_crypto_generic_session_t *session)
+odp_crypto_alg_err_t hmac_check(odp_crypto_op_param_t *param,
+				odp_crypto_generic_session_t *session)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint8_t *icv   = data;
-	uint32_t len   = param->auth_range.length;
-	uint32_t bytes = session->auth.data.sha256.bytes;
+	odp_packet_t pkt = param->out_pkt;
+	uint32_t offset  = param->hash_result_offset;
+	uint32_t bytes   = session->auth.data.hmac.bytes;
 	uint8_t  hash_in[EVP_MAX_MD_SIZE];
 	uint8_t  hash_out[EVP_MAX_MD_SIZE];
 
-	/* Adjust pointer for beginning of area to auth */
-	data += param->auth_range.offset;
-	icv  += param->hash_result_offset;
-
 	/* Copy current value out and clear it before authentication */
-	memset(hash_in, 0, sizeof(hash_in));
-	memcpy(hash_in, icv, bytes);
-	memset(icv, 0, bytes);
-	memset(hash_out, 0, sizeof(hash_out));
+	if (odp_unlikely(odp_packet_copy_to_mem(pkt, offset, bytes, hash_in)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
+
+	memset(hash_out, 0, bytes);
+	odp_packet_copy_from_mem(pkt, offset, bytes, hash_out);
 
 	/* Hash it */
-	HMAC(EVP_sha256(),
-	     session->auth.data.sha256.key,
-	     32,
-	     data,
-	     len,
-	     hash_out,
-	     NULL);
+	if (odp_unlikely(hmac_digest(param, session, hash_out)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
 	/* Verify match */
 	if (0 != memcmp(hash_in, hash_out, bytes))
@@ -241,45 +432,49 @@ odp_crypto_alg_err_t sha256_check(odp_crypto_op_param_t *param,
 	return ODP_CRYPTO_ALG_ERR_NONE;
 }
 
-static
-odp_crypto_alg_err_t aes_encrypt(odp_crypto_op_param_t *param,
-				 odp_crypto_generic_session_t *session)
+/* Cipher context of the session for this thread. Contexts are created and
+ * keyed on first use, so that threads do not share any cipher state. */
+static EVP_CIPHER_CTX *cipher_ctx(odp_crypto_generic_session_t *session)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint32_t len   = param->cipher_range.length;
-	unsigned char iv_enc[AES_BLOCK_SIZE];
-	void *iv_ptr;
+	uint32_t idx = session->index;
+	EVP_CIPHER_CTX *ctx = local.cipher_ctx[idx];
+	const EVP_CIPHER *cipher = session->cipher.data.evp.cipher;
+	int enc = ODP_CRYPTO_OP_ENCODE == session->p.op;
 
-	if (param->override_iv_ptr)
-		iv_ptr = param->override_iv_ptr;
-	else if (session->p.iv.data)
-		iv_ptr = session->cipher.iv_data;
-	else
-		return ODP_CRYPTO_ALG_ERR_IV_INVALID;
+	if (odp_likely(local.cipher_gen[idx] == session->cipher.gen))
+		return ctx;
 
-	/*
-	 * Create a copy of the IV.  The DES library modifies IV
-	 * and if we are processing packets on parallel threads
-	 * we could get corruption.
-	 */
-	memcpy(iv_enc, iv_ptr, AES_BLOCK_SIZE);
+	if (ctx == NULL) {
+		ctx = EVP_CIPHER_CTX_new();
+		if (ctx == NULL)
+			return NULL;
 
-	/* Adjust pointer for beginning of area to cipher */
-	data += param->cipher_range.offset;
-	/* Encrypt it */
-	AES_cbc_encrypt(data, data, len, &session->cipher.data.aes.key,
-			iv_enc, AES_ENCRYPT);
+		local.cipher_ctx[idx] = ctx;
+	}
 
-	return ODP_CRYPTO_ALG_ERR_NONE;
+	if (!EVP_CipherInit_ex(ctx, cipher, NULL, NULL, NULL, enc))
+		return NULL;
+
+	EVP_CIPHER_CTX_set_padding(ctx, 0);
+
+	if (EVP_CIPHER_flags(cipher) & EVP_CIPH_FLAG_AEAD_CIPHER)
+		EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN,
+				    session->p.iv.length, NULL);
+
+	if (!EVP_CipherInit_ex(ctx, NULL, NULL, session->cipher.key_data,
+			       NULL, enc))
+		return NULL;
+
+	local.cipher_gen[idx] = session->cipher.gen;
+
+	return ctx;
 }
 
 static
-odp_crypto_alg_err_t aes_decrypt(odp_crypto_op_param_t *param,
-				 odp_crypto_generic_session_t *session)
+odp_crypto_alg_err_t aes_crypt(odp_crypto_op_param_t *param,
+			       odp_crypto_generic_session_t *session)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint32_t len   = param->cipher_range.length;
-	unsigned char iv_enc[AES_BLOCK_SIZE];
+	EVP_CIPHER_CTX *ctx;
 	void *iv_ptr;
 
 	if (param->override_iv_ptr)
@@ -289,55 +484,96 @@ odp_crypto_alg_err_t aes_decrypt(odp_crypto_op_param_t *param,
 	else
 		return ODP_CRYPTO_ALG_ERR_IV_INVALID;
 
-	/*
-	 * Create a copy of the IV.  The DES library modifies IV
-	 * and if we are processing packets on parallel threads
-	 * we could get corruption.
-	 */
-	memcpy(iv_enc, iv_ptr, AES_BLOCK_SIZE);
+	ctx = cipher_ctx(session);
+	if (odp_unlikely(ctx == NULL))
+		return ODP_CRYPTO_ALG_ERR_KEY_SIZE;
 
-	/* Adjust pointer for beginning of area to cipher */
-	data += param->cipher_range.offset;
-	/* Encrypt it */
-	AES_cbc_encrypt(data, data, len, &session->cipher.data.aes.key,
-			iv_enc, AES_DECRYPT);
+	/* The context keeps the key, only IV is set per operation */
+	EVP_CipherInit_ex(ctx, NULL, NULL, NULL, iv_ptr, -1);
+
+	/* CBC mode is not padded, data must be whole blocks */
+	if (odp_unlikely(packet_data_walk(param->out_pkt,
+					  param->cipher_range.offset,
+					  param->cipher_range.length,
+					  EVP_CIPHER_CTX_block_size(ctx),
+					  cipher_update, ctx)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
 	return ODP_CRYPTO_ALG_ERR_NONE;
 }
 
-static int process_aes_param(odp_crypto_generic_session_t *session)
+static int process_aes_param(odp_crypto_generic_session_t *session,
+			     int mode)
 {
+	const EVP_CIPHER *cipher = NULL;
+
 	/* Verify IV len is either 0 or 16 */
 	if (!((0 == session->p.iv.length) || (16 == session->p.iv.length)))
 		return -1;
 
-	/* Set function */
-	if (ODP_CRYPTO_OP_ENCODE == session->p.op) {
-		session->cipher.func = aes_encrypt;
-		AES_set_encrypt_key(session->p.cipher_key.data, 128,
-				    &session->cipher.data.aes.key);
-	} else {
-		session->cipher.func = aes_decrypt;
-		AES_set_decrypt_key(session->p.cipher_key.data, 128,
-				    &session->cipher.data.aes.key);
+	switch (session->p.cipher_key.length) {
+	case 16:
+		cipher = mode == EVP_CIPH_CBC_MODE ? EVP_aes_128_cbc() :
+						     EVP_aes_128_ctr();
+		break;
+	case 24:
+		cipher = mode == EVP_CIPH_CBC_MODE ? EVP_aes_192_cbc() :
+						     EVP_aes_192_ctr();
+		break;
+	case 32:
+		cipher = mode == EVP_CIPH_CBC_MODE ? EVP_aes_256_cbc() :
+						     EVP_aes_256_ctr();
+		break;
+	default:
+		return -1;
 	}
 
+	/* Set function */
+	session->cipher.data.evp.cipher = cipher;
+	session->cipher.func = aes_crypt;
+
 	return 0;
 }
 
-static
-odp_crypto_alg_err_t aes_gcm_encrypt(odp_crypto_op_param_t *param,
-				     odp_crypto_generic_session_t *session)
-{
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint32_t plain_len   = param->cipher_range.length;
-	uint8_t *aad_head = data + param->auth_range.offset;
-	uint8_t *aad_tail = data + param->cipher_range.offset +
-		param->cipher_range.length;
-	uint32_t auth_len = param->auth_range.length;
-	unsigned char iv_enc[AES_BLOCK_SIZE];
+/* Authenticate header data (if any) without encrypting them, cipher data and
+ * then footer data (if any) without encrypting them */
+static int aead_update(odp_crypto_op_param_t *param,
+		       const odp_crypto_data_range_t *cipher_range,
+		       EVP_CIPHER_CTX *ctx)
+{
+	odp_packet_t pkt  = param->out_pkt;
+	uint32_t auth_off = param->auth_range.offset;
+	uint32_t auth_end = auth_off + param->auth_range.length;
+	uint32_t data_off = cipher_range->offset;
+	uint32_t data_end = data_off + cipher_range->length;
+
+	/* All cipher data must be part of the authentication */
+	if (auth_off > data_off || auth_end < data_end)
+		return -1;
+
+	if (packet_data_walk(pkt, auth_off, data_off - auth_off, 1,
+			     aad_update, ctx) ||
+	    packet_data_walk(pkt, data_off, data_end - data_off, 1,
+			     cipher_update, ctx) ||
+	    packet_data_walk(pkt, data_end, auth_end - data_end, 1,
+			     aad_update, ctx))
+		return -1;
+
+	return 0;
+}
+
+/* Encrypt and authenticate with an AEAD cipher (AES-GCM, ChaCha20-Poly1305).
+ * Tag is written to the hash result offset. */
+static odp_crypto_alg_err_t
+aead_encrypt_range(odp_crypto_op_param_t *param,
+		   odp_crypto_generic_session_t *session,
+		   const odp_crypto_data_range_t *cipher_range)
+{
+	EVP_CIPHER_CTX *ctx;
+	uint8_t block[MAX_CIPHER_BLOCK];
+	uint8_t tag[AEAD_TAG_LEN];
 	void *iv_ptr;
-	uint8_t *tag = data + param->hash_result_offset;
+	int out_len;
 
 	if (param->override_iv_ptr)
 		iv_ptr = param->override_iv_ptr;
@@ -346,63 +582,38 @@ odp_crypto_alg_err_t aes_gcm_encrypt(odp_crypto_op_param_t *param,
 	else
 		return ODP_CRYPTO_ALG_ERR_IV_INVALID;
 
-	/* All cipher data must be part of the authentication */
-	if (param->auth_range.offset > param->cipher_range.offset ||
-	    param->auth_range.offset + auth_len <
-	    param->cipher_range.offset + plain_len)
-		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
-
-	/*
-	 * Create a copy of the IV.  The DES library modifies IV
-	 * and if we are processing packets on parallel threads
-	 * we could get corruption.
-	 */
-	memcpy(iv_enc, iv_ptr, AES_BLOCK_SIZE);
-
-	/* Adjust pointer for beginning of area to cipher/auth */
-	uint8_t *plaindata = data + param->cipher_range.offset;
-
 	/* Encrypt it */
-	EVP_CIPHER_CTX *ctx = session->cipher.data.aes_gcm.ctx;
-	int cipher_len = 0;
-
-	EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv_enc);
+	ctx = cipher_ctx(session);
+	if (odp_unlikely(ctx == NULL))
+		return ODP_CRYPTO_ALG_ERR_KEY_SIZE;
 
-	/* Authenticate header data (if any) without encrypting them */
-	if (aad_head < plaindata) {
-		EVP_EncryptUpdate(ctx, NULL, &cipher_len,
-				  aad_head, plaindata - aad_head);
-	}
+	EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv_ptr);
 
-	EVP_EncryptUpdate(ctx, plaindata, &cipher_len,
-			  plaindata, plain_len);
-	cipher_len = plain_len;
+	if (odp_unlikely(aead_update(param, cipher_range, ctx)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
-	/* Authenticate footer data (if any) without encrypting them */
-	if (aad_head + auth_len > plaindata + plain_len) {
-		EVP_EncryptUpdate(ctx, NULL, NULL, aad_tail,
-				  auth_len - (aad_tail - aad_head));
-	}
+	EVP_EncryptFinal_ex(ctx, block, &out_len);
+	EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, sizeof(tag), tag);
 
-	EVP_EncryptFinal_ex(ctx, plaindata + cipher_len, &cipher_len);
-	EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16, tag);
+	if (odp_unlikely(odp_packet_copy_from_mem(param->out_pkt,
+						  param->hash_result_offset,
+						  sizeof(tag), tag)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
 	return ODP_CRYPTO_ALG_ERR_NONE;
 }
 
-static
-odp_crypto_alg_err_t aes_gcm_decrypt(odp_crypto_op_param_t *param,
-				     odp_crypto_generic_session_t *session)
-{
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint32_t cipher_len   = param->cipher_range.length;
-	uint8_t *aad_head = data + param->auth_range.offset;
-	uint8_t *aad_tail = data + param->cipher_range.offset +
-		param->cipher_range.length;
-	uint32_t auth_len = param->auth_range.length;
-	unsigned char iv_enc[AES_BLOCK_SIZE];
+/* Decrypt and verify the tag at the hash result offset */
+static odp_crypto_alg_err_t
+aead_decrypt_range(odp_crypto_op_param_t *param,
+		   odp_crypto_generic_session_t *session,
+		   const odp_crypto_data_range_t *cipher_range)
+{
+	EVP_CIPHER_CTX *ctx;
+	uint8_t block[MAX_CIPHER_BLOCK];
+	uint8_t tag[AEAD_TAG_LEN];
 	void *iv_ptr;
-	uint8_t *tag   = data + param->hash_result_offset;
+	int out_len;
 
 	if (param->override_iv_ptr)
 		iv_ptr = param->override_iv_ptr;
@@ -411,127 +622,160 @@ odp_crypto_alg_err_t aes_gcm_decrypt(odp_crypto_op_param_t *param,
 	else
 		return ODP_CRYPTO_ALG_ERR_IV_INVALID;
 
-	/* All cipher data must be part of the authentication */
-	if (param->auth_range.offset > param->cipher_range.offset ||
-	    param->auth_range.offset + auth_len <
-	    param->cipher_range.offset + cipher_len)
+	if (odp_unlikely(odp_packet_copy_to_mem(param->out_pkt,
+						param->hash_result_offset,
+						sizeof(tag), tag)))
 		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
-	/*
-	 * Create a copy of the IV.  The DES library modifies IV
-	 * and if we are processing packets on parallel threads
-	 * we could get corruption.
-	 */
-	memcpy(iv_enc, iv_ptr, AES_BLOCK_SIZE);
+	/* Decrypt it */
+	ctx = cipher_ctx(session);
+	if (odp_unlikely(ctx == NULL))
+		return ODP_CRYPTO_ALG_ERR_KEY_SIZE;
 
-	/* Adjust pointer for beginning of area to cipher/auth */
-	uint8_t *cipherdata = data + param->cipher_range.offset;
-	/* Encrypt it */
-	EVP_CIPHER_CTX *ctx = session->cipher.data.aes_gcm.ctx;
-	int plain_len = 0;
+	EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv_ptr);
 
-	EVP_DecryptInit_ex(ctx, NULL, NULL, NULL, iv_enc);
+	EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, sizeof(tag), tag);
 
-	EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_TAG, 16, tag);
+	if (odp_unlikely(aead_update(param, cipher_range, ctx)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
-	/* Authenticate header data (if any) without encrypting them */
-	if (aad_head < cipherdata) {
-		EVP_DecryptUpdate(ctx, NULL, &plain_len,
-				  aad_head, cipherdata - aad_head);
-	}
+	if (EVP_DecryptFinal_ex(ctx, block, &out_len) <= 0)
+		return ODP_CRYPTO_ALG_ERR_ICV_CHECK;
 
-	EVP_DecryptUpdate(ctx, cipherdata, &plain_len,
-			  cipherdata, cipher_len);
-	plain_len = cipher_len;
+	return ODP_CRYPTO_ALG_ERR_NONE;
+}
 
-	/* Authenticate footer data (if any) without encrypting them */
-	if (aad_head + auth_len > cipherdata + cipher_len) {
-		EVP_DecryptUpdate(ctx, NULL, NULL, aad_tail,
-				  auth_len - (aad_tail - aad_head));
-	}
+static
+odp_crypto_alg_err_t aead_encrypt(odp_crypto_op_param_t *param,
+				  odp_crypto_generic_session_t *session)
+{
+	return aead_encrypt_range(param, session, &param->cipher_range);
+}
 
-	if (EVP_DecryptFinal_ex(ctx, cipherdata + cipher_len, &plain_len) < 0)
-		return ODP_CRYPTO_ALG_ERR_ICV_CHECK;
+static
+odp_crypto_alg_err_t aead_decrypt(odp_crypto_op_param_t *param,
+				  odp_crypto_generic_session_t *session)
+{
+	return aead_decrypt_range(param, session, &param->cipher_range);
+}
 
-	return ODP_CRYPTO_ALG_ERR_NONE;
+/* GMAC is AES-GCM with an empty cipher range at the end of auth range */
+static
+odp_crypto_alg_err_t aes_gmac_gen(odp_crypto_op_param_t *param,
+				  odp_crypto_generic_session_t *session)
+{
+	odp_crypto_data_range_t none;
+
+	none.offset = param->auth_range.offset + param->auth_range.length;
+	none.length = 0;
+
+	return aead_encrypt_range(param, session, &none);
+}
+
+static
+odp_crypto_alg_err_t aes_gmac_check(odp_crypto_op_param_t *param,
+				    odp_crypto_generic_session_t *session)
+{
+	odp_crypto_data_range_t none;
+
+	none.offset = param->auth_range.offset + param->auth_range.length;
+	none.length = 0;
+
+	return aead_decrypt_range(param, session, &none);
+}
+
+static const EVP_CIPHER *aes_gcm_cipher(uint32_t key_len)
+{
+	switch (key_len) {
+	case 16:
+		return EVP_aes_128_gcm();
+	case 24:
+		return EVP_aes_192_gcm();
+	case 32:
+		return EVP_aes_256_gcm();
+	default:
+		return NULL;
+	}
 }
 
 static int process_aes_gcm_param(odp_crypto_generic_session_t *session)
 {
-	/* Verify Key len is 16 */
-	if (session->p.cipher_key.length != 16)
+	session->cipher.data.evp.cipher =
+		aes_gcm_cipher(session->p.cipher_key.length);
+	if (session->cipher.data.evp.cipher == NULL)
 		return -1;
 
 	/* Set function */
-	EVP_CIPHER_CTX *ctx =
-		session->cipher.data.aes_gcm.ctx = EVP_CIPHER_CTX_new();
+	if (ODP_CRYPTO_OP_ENCODE == session->p.op)
+		session->cipher.func = aead_encrypt;
+	else
+		session->cipher.func = aead_decrypt;
 
-	if (ODP_CRYPTO_OP_ENCODE == session->p.op) {
-		session->cipher.func = aes_gcm_encrypt;
-		EVP_EncryptInit_ex(ctx, EVP_aes_128_gcm(), NULL, NULL, NULL);
-	} else {
-		session->cipher.func = aes_gcm_decrypt;
-		EVP_DecryptInit_ex(ctx, EVP_aes_128_gcm(), NULL, NULL, NULL);
-	}
+	return 0;
+}
 
-	EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_SET_IVLEN,
-			    session->p.iv.length, NULL);
-	if (ODP_CRYPTO_OP_ENCODE == session->p.op) {
-		EVP_EncryptInit_ex(ctx, NULL, NULL,
-				   session->p.cipher_key.data, NULL);
-	} else {
-		EVP_DecryptInit_ex(ctx, NULL, NULL,
-				   session->p.cipher_key.data, NULL);
-	}
+#ifdef HAVE_CHACHA20_POLY1305
+static int
+process_chacha20_poly1305_param(odp_crypto_generic_session_t *session)
+{
+	if (session->p.cipher_key.length != 32 || session->p.iv.length != 12)
+		return -1;
+
+	session->cipher.data.evp.cipher = EVP_chacha20_poly1305();
+
+	/* Set function */
+	if (ODP_CRYPTO_OP_ENCODE == session->p.op)
+		session->cipher.func = aead_encrypt;
+	else
+		session->cipher.func = aead_decrypt;
 
 	return 0;
 }
+#endif
 
-static
-odp_crypto_alg_err_t des_encrypt(odp_crypto_op_param_t *param,
-				 odp_crypto_generic_session_t *session)
+/* GMAC does not encrypt, so it uses the cipher context of the session keyed
+ * with the auth key */
+static int process_aes_gmac_param(odp_crypto_generic_session_t *session)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint32_t len   = param->cipher_range.length;
-	DES_cblock iv;
-	void *iv_ptr;
+	uint32_t key_len = session->p.auth_key.length;
 
-	if (param->override_iv_ptr)
-		iv_ptr = param->override_iv_ptr;
-	else if (session->p.iv.data)
-		iv_ptr = session->cipher.iv_data;
+	if (session->p.iv.length != 12 || key_len > MAX_KEY_LEN)
+		return -1;
+
+	session->cipher.data.evp.cipher = aes_gcm_cipher(key_len);
+	if (session->cipher.data.evp.cipher == NULL)
+		return -1;
+
+	memcpy(session->cipher.key_data, session->p.auth_key.data, key_len);
+
+	/* Set function */
+	if (ODP_CRYPTO_OP_ENCODE == session->p.op)
+		session->auth.func = aes_gmac_gen;
 	else
-		return ODP_CRYPTO_ALG_ERR_IV_INVALID;
+		session->auth.func = aes_gmac_check;
 
-	/*
-	 * Create a copy of the IV.  The DES library modifies IV
-	 * and if we are processing packets on parallel threads
-	 * we could get corruption.
-	 */
-	memcpy(iv, iv_ptr, sizeof(iv));
+	return 0;
+}
+
+static void des_update(void *arg, uint8_t *data, uint32_t len)
+{
+	des_op_t *op = arg;
 
-	/* Adjust pointer for beginning of area to cipher */
-	data += param->cipher_range.offset;
-	/* Encrypt it */
 	DES_ede3_cbc_encrypt(data,
 			     data,
 			     len,
-			     &session->cipher.data.des.ks1,
-			     &session->cipher.data.des.ks2,
-			     &session->cipher.data.des.ks3,
-			     &iv,
-			     1);
-
-	return ODP_CRYPTO_ALG_ERR_NONE;
+			     &op->session->cipher.data.des.ks1,
+			     &op->session->cipher.data.des.ks2,
+			     &op->session->cipher.data.des.ks3,
+			     &op->iv,
+			     op->enc);
 }
 
 static
-odp_crypto_alg_err_t des_decrypt(odp_crypto_op_param_t *param,
-				 odp_crypto_generic_session_t *session)
+odp_crypto_alg_err_t des_crypt(odp_crypto_op_param_t *param,
+			       odp_crypto_generic_session_t *session)
 {
-	uint8_t *data  = odp_packet_data(param->out_pkt);
-	uint32_t len   = param->cipher_range.length;
-	DES_cblock iv;
+	des_op_t op;
 	void *iv_ptr;
 
 	if (param->override_iv_ptr)
@@ -546,20 +790,16 @@ odp_crypto_alg_err_t des_decrypt(odp_crypto_op_param_t *param,
 	 * and if we are processing packets on parallel threads
 	 * we could get corruption.
 	 */
-	memcpy(iv, iv_ptr, sizeof(iv));
-
-	/* Adjust pointer for beginning of area to cipher */
-	data += param->cipher_range.offset;
-
-	/* Decrypt it */
-	DES_ede3_cbc_encrypt(data,
-			     data,
-			     len,
-			     &session->cipher.data.des.ks1,
-			     &session->cipher.data.des.ks2,
-			     &session->cipher.data.des.ks3,
-			     &iv,
-			     0);
+	memcpy(op.iv, iv_ptr, sizeof(op.iv));
+	op.session = session;
+	op.enc = ODP_CRYPTO_OP_ENCODE == session->p.op;
+
+	/* IV is chained from segment to segment */
+	if (odp_unlikely(packet_data_walk(param->out_pkt,
+					  param->cipher_range.offset,
+					  param->cipher_range.length,
+					  sizeof(DES_cblock), des_update, &op)))
+		return ODP_CRYPTO_ALG_ERR_DATA_SIZE;
 
 	return ODP_CRYPTO_ALG_ERR_NONE;
 }
@@ -571,10 +811,7 @@ static int process_des_param(odp_crypto_generic_session_t *session)
 		return -1;
 
 	/* Set function */
-	if (ODP_CRYPTO_OP_ENCODE == session->p.op)
-		session->cipher.func = des_encrypt;
-	else
-		session->cipher.func = des_decrypt;
+	session->cipher.func = des_crypt;
 
 	/* Convert keys */
 	DES_set_key((DES_cblock *)&session->p.cipher_key.data[0],
@@ -587,148 +824,596 @@ static int process_des_param(odp_crypto_generic_session_t *session)
 	return 0;
 }
 
-static int process_md5_param(odp_crypto_generic_session_t *session,
-			     uint32_t bits)
+/* Hash state after a key block, padded with 'pad' bytes */
+static EVP_MD_CTX *hmac_pad_ctx(const EVP_MD *md, const uint8_t *key,
+				uint32_t key_len, uint8_t pad)
 {
+	uint8_t block[MAX_HMAC_BLOCK];
+	int block_size = EVP_MD_block_size(md);
+	EVP_MD_CTX *ctx;
+	int i;
+
+	if (block_size > MAX_HMAC_BLOCK)
+		return NULL;
+
+	memset(block, pad, block_size);
+	for (i = 0; i < (int)key_len; i++)
+		block[i] ^= key[i];
+
+	ctx = EVP_MD_CTX_new();
+	if (ctx == NULL)
+		return NULL;
+
+	if (!EVP_DigestInit_ex(ctx, md, NULL) ||
+	    !EVP_DigestUpdate(ctx, block, block_size)) {
+		EVP_MD_CTX_free(ctx);
+		ctx = NULL;
+	}
+
+	OPENSSL_cleanse(block, sizeof(block));
+
+	return ctx;
+}
+
+/* Key pad blocks are hashed once per session instead of per packet */
+static int process_hmac_param(odp_crypto_generic_session_t *session,
+			      const EVP_MD *md, uint32_t bits)
+{
+	const uint8_t *key = session->p.auth_key.data;
+	uint32_t key_len = session->p.auth_key.length;
+	uint8_t key_hash[EVP_MAX_MD_SIZE];
+	unsigned int len;
+
+	/* Keys longer than a block are hashed first */
+	if (key_len > (uint32_t)EVP_MD_block_size(md)) {
+		if (!EVP_Digest(key, key_len, key_hash, &len, md, NULL))
+			return -1;
+
+		key = key_hash;
+		key_len = len;
+	}
+
+	session->auth.data.hmac.ictx = hmac_pad_ctx(md, key, key_len, 0x36);
+	session->auth.data.hmac.octx = hmac_pad_ctx(md, key, key_len, 0x5c);
+
+	OPENSSL_cleanse(key_hash, sizeof(key_hash));
+
+	if (session->auth.data.hmac.ictx == NULL ||
+	    session->auth.data.hmac.octx == NULL) {
+		if (session->auth.data.hmac.ictx != NULL)
+			EVP_MD_CTX_free(session->auth.data.hmac.ictx);
+		if (session->auth.data.hmac.octx != NULL)
+			EVP_MD_CTX_free(session->auth.data.hmac.octx);
+
+		session->auth.data.hmac.ictx = NULL;
+		session->auth.data.hmac.octx = NULL;
+		return -1;
+	}
+
 	/* Set function */
 	if (ODP_CRYPTO_OP_ENCODE == session->p.op)
-		session->auth.func = md5_gen;
+		session->auth.func = hmac_gen;
 	else
-		session->auth.func = md5_check;
+		session->auth.func = hmac_check;
 
 	/* Number of valid bytes */
-	session->auth.data.md5.bytes = bits / 8;
+	session->auth.data.hmac.bytes = bits / 8;
 
-	/* Convert keys */
-	memcpy(session->auth.data.md5.key, session->p.auth_key.data, 16);
+	return 0;
+}
+
+int odp_crypto_capability(odp_crypto_capability_t *capa)
+{
+	if (NULL == capa)
+		return -1;
+
+	/* Initialize crypto capability structure */
+	memset(capa, 0, sizeof(odp_crypto_capability_t));
+
+	capa->ciphers.bit.null       = 1;
+	capa->ciphers.bit.des        = 1;
+	capa->ciphers.bit.trides_cbc = 1;
+	capa->ciphers.bit.aes_cbc    = 1;
+	capa->ciphers.bit.aes_ctr    = 1;
+	capa->ciphers.bit.aes_gcm    = 1;
+#ifdef HAVE_CHACHA20_POLY1305
+	capa->ciphers.bit.chacha20_poly1305 = 1;
+#endif
+
+	capa->auths.bit.null         = 1;
+	capa->auths.bit.md5_hmac     = 1;
+	capa->auths.bit.sha1_hmac    = 1;
+	capa->auths.bit.sha256_hmac  = 1;
+	capa->auths.bit.sha384_hmac  = 1;
+	capa->auths.bit.sha512_hmac  = 1;
+	capa->auths.bit.aes_gcm      = 1;
+	capa->auths.bit.aes_gmac     = 1;
+#ifdef HAVE_CHACHA20_POLY1305
+	capa->auths.bit.chacha20_poly1305 = 1;
+#endif
+
+	/* Deprecated */
+	capa->ciphers.bit.aes128_cbc = 1;
+	capa->ciphers.bit.aes128_gcm = 1;
+	capa->auths.bit.md5_96       = 1;
+	capa->auths.bit.sha256_128   = 1;
+	capa->auths.bit.aes128_gcm   = 1;
+
+	capa->max_sessions = global->max_sessions;
 
 	return 0;
 }
 
-static int process_sha256_param(odp_crypto_generic_session_t *session,
-				uint32_t bits)
+int odp_crypto_cipher_capability(odp_cipher_alg_t cipher,
+				 odp_crypto_cipher_capability_t dst[],
+				 int num_copy)
 {
-	/* Set function */
-	if (ODP_CRYPTO_OP_ENCODE == session->p.op)
-		session->auth.func = sha256_gen;
-	else
-		session->auth.func = sha256_check;
+	const odp_crypto_cipher_capability_t *src;
+	int num;
+	int size = sizeof(odp_crypto_cipher_capability_t);
+
+	switch (cipher) {
+	case ODP_CIPHER_ALG_NULL:
+		src = NULL;
+		num = 0;
+		break;
+	case ODP_CIPHER_ALG_DES:
+		src = cipher_capa_des;
+		num = sizeof(cipher_capa_des) / size;
+		break;
+	case ODP_CIPHER_ALG_3DES_CBC:
+		src = cipher_capa_trides_cbc;
+		num = sizeof(cipher_capa_trides_cbc) / size;
+		break;
+	case ODP_CIPHER_ALG_AES_CBC:
+		src = cipher_capa_aes_cbc;
+		num = sizeof(cipher_capa_aes_cbc) / size;
+		break;
+	case ODP_CIPHER_ALG_AES_CTR:
+		src = cipher_capa_aes_ctr;
+		num = sizeof(cipher_capa_aes_ctr) / size;
+		break;
+	case ODP_CIPHER_ALG_AES_GCM:
+		src = cipher_capa_aes_gcm;
+		num = sizeof(cipher_capa_aes_gcm) / size;
+		break;
+#ifdef HAVE_CHACHA20_POLY1305
+	case ODP_CIPHER_ALG_CHACHA20_POLY1305:
+		src = cipher_capa_chacha20_poly1305;
+		num = sizeof(cipher_capa_chacha20_poly1305) / size;
+		break;
+#endif
+	default:
+		return -1;
+	}
+
+	if (num < num_copy)
+		num_copy = num;
+
+	memcpy(dst, src, num_copy * size);
+
+	return num;
+}
+
+int odp_crypto_auth_capability(odp_auth_alg_t auth,
+			       odp_crypto_auth_capability_t dst[], int num_copy)
+{
+	const odp_crypto_auth_capability_t *src;
+	int num;
+	int size = sizeof(odp_crypto_auth_capability_t);
+
+	switch (auth) {
+	case ODP_AUTH_ALG_NULL:
+		src = NULL;
+		num = 0;
+		break;
+	case ODP_AUTH_ALG_MD5_HMAC:
+		src = auth_capa_md5_hmac;
+		num = sizeof(auth_capa_md5_hmac) / size;
+		break;
+	case ODP_AUTH_ALG_SHA1_HMAC:
+		src = auth_capa_sha1_hmac;
+		num = sizeof(auth_capa_sha1_hmac) / size;
+		break;
+	case ODP_AUTH_ALG_SHA256_HMAC:
+		src = auth_capa_sha256_hmac;
+		num = sizeof(auth_capa_sha256_hmac) / size;
+		break;
+	case ODP_AUTH_ALG_SHA384_HMAC:
+		src = auth_capa_sha384_hmac;
+		num = sizeof(auth_capa_sha384_hmac) / size;
+		break;
+	case ODP_AUTH_ALG_SHA512_HMAC:
+		src = auth_capa_sha512_hmac;
+		num = sizeof(auth_capa_sha512_hmac) / size;
+		break;
+	case ODP_AUTH_ALG_AES_GCM:
+		src = auth_capa_aes_gcm;
+		num = sizeof(auth_capa_aes_gcm) / size;
+		break;
+	case ODP_AUTH_ALG_AES_GMAC:
+		src = auth_capa_aes_gmac;
+		num = sizeof(auth_capa_aes_gmac) / size;
+		break;
+#ifdef HAVE_CHACHA20_POLY1305
+	case ODP_AUTH_ALG_CHACHA20_POLY1305:
+		src = auth_capa_chacha20_poly1305;
+		num = sizeof(auth_capa_chacha20_poly1305) / size;
+		break;
+#endif
+	default:
+		return -1;
+	}
+
+	if (num < num_copy)
+		num_copy = num;
+
+	memcpy(dst, src, num_copy * size);
+
+	return num;
+}
+
+static inline odp_crypto_generic_session_t *
+session_from_handle(odp_crypto_session_t hdl)
+{
+	return (odp_crypto_generic_session_t *)(intptr_t)hdl;
+}
+
+/* Resolve output packet of an operation and copy input data into it */
+static int crypto_op_output(odp_crypto_op_param_t *param,
+			    odp_crypto_generic_session_t *session)
+{
+	if (ODP_PACKET_INVALID == param->out_pkt &&
+	    ODP_POOL_INVALID != session->p.output_pool)
+		param->out_pkt = odp_packet_alloc(session->p.output_pool,
+				odp_packet_len(param->pkt));
+
+	if (odp_unlikely(ODP_PACKET_INVALID == param->out_pkt)) {
+		ODP_DBG("Alloc failed.\n");
+		return -1;
+	}
+
+	if (param->pkt != param->out_pkt) {
+		(void)odp_packet_copy_from_pkt(param->out_pkt,
+					       0,
+					       param->pkt,
+					       0,
+					       odp_packet_len(param->pkt));
+		_odp_packet_copy_md_to_packet(param->pkt, param->out_pkt);
+		odp_packet_free(param->pkt);
+		param->pkt = ODP_PACKET_INVALID;
+	}
+
+	return 0;
+}
+
+/* Run cipher and auth functions of the session on the output packet */
+static void crypto_op_process(odp_crypto_op_param_t *param,
+			      odp_crypto_generic_session_t *session,
+			      odp_crypto_op_result_t *result)
+{
+	odp_crypto_alg_err_t rc_cipher;
+	odp_crypto_alg_err_t rc_auth;
+
+	if (session->do_cipher_first) {
+		rc_cipher = session->cipher.func(param, session);
+		rc_auth = session->auth.func(param, session);
+	} else {
+		rc_auth = session->auth.func(param, session);
+		rc_cipher = session->cipher.func(param, session);
+	}
+
+	result->ctx = param->ctx;
+	result->pkt = param->out_pkt;
+	result->cipher_status.alg_err = rc_cipher;
+	result->cipher_status.hw_err = ODP_CRYPTO_HW_ERR_NONE;
+	result->auth_status.alg_err = rc_auth;
+	result->auth_status.hw_err = ODP_CRYPTO_HW_ERR_NONE;
+	result->ok =
+		(rc_cipher == ODP_CRYPTO_ALG_ERR_NONE) &&
+		(rc_auth == ODP_CRYPTO_ALG_ERR_NONE);
+}
+
+/* Linux generic will always use the output packet as completion event. The
+ * operation result is stored into the packet header. */
+static odp_crypto_op_result_t *crypto_op_compl_init(odp_packet_t pkt)
+{
+	odp_event_t completion_event = odp_packet_to_event(pkt);
+	odp_crypto_generic_op_result_t *op_result;
+
+	_odp_buffer_event_type_set(odp_buffer_from_event(completion_event),
+				   ODP_EVENT_CRYPTO_COMPL);
+	op_result = get_op_result_from_event(completion_event);
+	op_result->magic = OP_RESULT_MAGIC;
+
+	return &op_result->result;
+}
+
+/* Enqueue events into the queue. Returns the number of events enqueued. */
+static int crypto_enq_events(odp_queue_t queue, odp_event_t ev[], int num)
+{
+	int done = 0;
+	int ret;
+
+	/* Queues may accept less than 'num' events per call */
+	while (done < num) {
+		ret = odp_queue_enq_multi(queue, &ev[done], num - done);
+		if (odp_unlikely(ret <= 0))
+			break;
+		done += ret;
+	}
+
+	return done;
+}
+
+static void crypto_worker_detach(odp_crypto_generic_session_t *session);
+
+/* Take a reference to the session for an operation. Fails when the session
+ * has been destroyed and freed, i.e. its last reference has been dropped. */
+static inline int session_acquire(odp_crypto_generic_session_t *session)
+{
+	uint32_t ref = odp_atomic_load_u32(&session->ref);
+
+	do {
+		if (odp_unlikely(ref == 0))
+			return -1;
+	} while (!odp_atomic_cas_acq_u32(&session->ref, &ref, ref + 1));
+
+	return 0;
+}
+
+/* Drop a reference to the session. Session resources are released and the
+ * session is freed with the last reference. Every operation holds a
+ * reference until it has been processed, so the last one may be dropped by
+ * an operation or a crypto worker after the session has been destroyed. */
+static void session_release(odp_crypto_generic_session_t *session)
+{
+	uint32_t index = session->index;
+
+	/* Session data accesses complete before the reference is dropped */
+	odp_mb_release();
+
+	if (odp_atomic_fetch_dec_u32(&session->ref) != 1)
+		return;
+
+	odp_mb_acquire();
+
+	if (session->use_worker)
+		crypto_worker_detach(session);
+
+	if (session->auth.func == hmac_gen ||
+	    session->auth.func == hmac_check) {
+		EVP_MD_CTX_free(session->auth.data.hmac.ictx);
+		EVP_MD_CTX_free(session->auth.data.hmac.octx);
+	}
+
+	memset(session, 0, sizeof(*session));
+	session->index = index;
+	free_session(session);
+}
+
+/* Queue an asynchronous operation to the crypto worker of the session. The
+ * reference of the operation to the session passes to the request. */
+static int crypto_async_submit(odp_crypto_op_param_t *param,
+			       odp_crypto_generic_session_t *session)
+{
+	crypto_worker_t *worker = &global->worker[session->worker];
+	uint32_t idx;
+
+	idx = ring_deq(&global->free_ring.hdr, REQ_RING_MASK);
+	if (odp_unlikely(idx == RING_EMPTY)) {
+		ODP_DBG("No free crypto request slots.\n");
+		return -1;
+	}
+
+	if (odp_unlikely(crypto_op_output(param, session))) {
+		ring_enq(&global->free_ring.hdr, REQ_RING_MASK, idx);
+		return -1;
+	}
+
+	global->req[idx].param   = *param;
+	global->req[idx].session = session;
+
+	/* A session is served by a single worker, through a FIFO ring. This
+	 * keeps operations of a session in order. */
+	ring_enq(&worker->ring.hdr, REQ_RING_MASK, idx);
+
+	return 0;
+}
+
+static void *crypto_worker(void *arg)
+{
+	crypto_worker_t *worker = arg;
+	uint32_t idx[MAX_BURST];
+	odp_queue_t queue[MAX_BURST];
+	odp_event_t ev[MAX_BURST];
+	uint32_t i, j, num, stop;
+	uint32_t idle = 0;
+	int done;
+
+	if (odp_init_local((odp_instance_t)odp_global_data.main_pid,
+			   ODP_THREAD_CONTROL)) {
+		ODP_ERR("Crypto worker local init failed\n");
+		odp_atomic_store_rel_u32(&worker->status, WORKER_FAILED);
+		return NULL;
+	}
+
+	local.no_cache = 1;
+	odp_atomic_store_rel_u32(&worker->status, WORKER_RUNNING);
+
+	while (1) {
+		stop = odp_atomic_load_acq_u32(&global->worker_exit);
+		num  = ring_deq_multi(&worker->ring.hdr, REQ_RING_MASK, idx,
+				      MAX_BURST);
+
+		if (num == 0) {
+			/* Requests queued before the exit request have been
+			 * processed */
+			if (stop)
+				break;
+
+			if (++idle % WORKER_IDLE_POLLS == 0)
+				sched_yield();
+			else
+				odp_cpu_pause();
+			continue;
+		}
+
+		idle = 0;
+
+		for (i = 0; i < num; i++) {
+			crypto_req_t *req = &global->req[idx[i]];
+			odp_packet_t pkt = req->param.out_pkt;
+
+			if (i + 1 < num)
+				odp_prefetch(&global->req[idx[i + 1]]);
+
+			crypto_op_process(&req->param, req->session,
+					  crypto_op_compl_init(pkt));
+			queue[i] = req->session->p.compl_queue;
+			ev[i] = odp_packet_to_event(pkt);
+			session_release(req->session);
+		}
+
+		/* Request parameters are not needed anymore */
+		ring_enq_multi(&global->free_ring.hdr, REQ_RING_MASK, idx, num);
+
+		/* Post completion events, a burst per queue */
+		for (i = 0; i < num; i = j) {
+			j = i + 1;
+			while (j < num && queue[j] == queue[i])
+				j++;
+
+			done = crypto_enq_events(queue[i], &ev[i], j - i);
+			/* Completion events are packets. odp_event_free() of
+			 * a completion event would not free the packet. */
+			if (odp_unlikely(done < (int)(j - i))) {
+				ODP_ERR("Crypto completion enqueue failed\n");
+				while (i + done < j)
+					odp_packet_free(odp_packet_from_event(
+							ev[i + done++]));
+			}
+		}
+	}
+
+	odp_term_local();
+	return NULL;
+}
 
-	/* Number of valid bytes */
-	session->auth.data.sha256.bytes = bits / 8;
+/* Stop and join the first 'num' crypto worker threads */
+static void crypto_workers_stop(uint32_t num)
+{
+	uint32_t i;
 
-	/* Convert keys */
-	memcpy(session->auth.data.sha256.key, session->p.auth_key.data, 32);
+	odp_atomic_store_rel_u32(&global->worker_exit, 1);
 
-	return 0;
+	for (i = 0; i < num; i++)
+		pthread_join(global->worker[i].thread, NULL);
 }
 
-int odp_crypto_capability(odp_crypto_capability_t *capa)
+/* Start crypto worker threads. Called with the global lock held. */
+static int crypto_workers_start(void)
 {
-	if (NULL == capa)
-		return -1;
+	crypto_worker_t *worker;
+	pthread_attr_t attr;
+	cpu_set_t cpu_set;
+	uint32_t i, status;
+	int cpu = -1;
+
+	odp_atomic_store_u32(&global->worker_exit, 0);
+
+	for (i = 0; i < global->num_workers; i++) {
+		worker = &global->worker[i];
+		ring_init(&worker->ring.hdr);
+		odp_atomic_init_u32(&worker->status, WORKER_STARTING);
+
+		pthread_attr_init(&attr);
+
+		/* Pin workers to CPUs of the mask round robin */
+		if (odp_cpumask_count(&global->worker_mask)) {
+			cpu = odp_cpumask_next(&global->worker_mask, cpu);
+			if (cpu < 0)
+				cpu = odp_cpumask_first(&global->worker_mask);
+
+			CPU_ZERO(&cpu_set);
+			CPU_SET(cpu, &cpu_set);
+			pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t),
+						    &cpu_set);
+		}
 
-	/* Initialize crypto capability structure */
-	memset(capa, 0, sizeof(odp_crypto_capability_t));
+		if (pthread_create(&worker->thread, &attr, crypto_worker,
+				   worker)) {
+			pthread_attr_destroy(&attr);
+			ODP_ERR("Crypto worker thread create failed\n");
+			break;
+		}
 
-	capa->ciphers.bit.null       = 1;
-	capa->ciphers.bit.des        = 1;
-	capa->ciphers.bit.trides_cbc = 1;
-	capa->ciphers.bit.aes_cbc    = 1;
-	capa->ciphers.bit.aes_gcm    = 1;
+		pthread_attr_destroy(&attr);
 
-	capa->auths.bit.null         = 1;
-	capa->auths.bit.md5_hmac     = 1;
-	capa->auths.bit.sha256_hmac  = 1;
-	capa->auths.bit.aes_gcm      = 1;
+		do {
+			sched_yield();
+			status = odp_atomic_load_acq_u32(&worker->status);
+		} while (status == WORKER_STARTING);
 
-	/* Deprecated */
-	capa->ciphers.bit.aes128_cbc = 1;
-	capa->ciphers.bit.aes128_gcm = 1;
-	capa->auths.bit.md5_96       = 1;
-	capa->auths.bit.sha256_128   = 1;
-	capa->auths.bit.aes128_gcm   = 1;
+		if (status != WORKER_RUNNING) {
+			pthread_join(worker->thread, NULL);
+			break;
+		}
+	}
 
-	capa->max_sessions = MAX_SESSIONS;
+	if (i < global->num_workers) {
+		crypto_workers_stop(i);
+		return -1;
+	}
 
+	ODP_DBG("Started %" PRIu32 " crypto worker threads\n", i);
 	return 0;
 }
 
-int odp_crypto_cipher_capability(odp_cipher_alg_t cipher,
-				 odp_crypto_cipher_capability_t dst[],
-				 int num_copy)
+/* Assign an asynchronous session to a crypto worker. Workers are started
+ * with the first session that uses them, and exit when the last one is
+ * freed (so that they do not outlive application threads). Operations
+ * of the session are processed by the caller, if workers cannot be
+ * started. */
+static void crypto_worker_attach(odp_crypto_generic_session_t *session)
 {
-	const odp_crypto_cipher_capability_t *src;
-	int num;
-	int size = sizeof(odp_crypto_cipher_capability_t);
+	odp_spinlock_lock(&global->lock);
 
-	switch (cipher) {
-	case ODP_CIPHER_ALG_NULL:
-		src = NULL;
-		num = 0;
-		break;
-	case ODP_CIPHER_ALG_DES:
-		src = cipher_capa_des;
-		num = sizeof(cipher_capa_des) / size;
-		break;
-	case ODP_CIPHER_ALG_3DES_CBC:
-		src = cipher_capa_trides_cbc;
-		num = sizeof(cipher_capa_trides_cbc) / size;
-		break;
-	case ODP_CIPHER_ALG_AES_CBC:
-		src = cipher_capa_aes_cbc;
-		num = sizeof(cipher_capa_aes_cbc) / size;
-		break;
-	case ODP_CIPHER_ALG_AES_GCM:
-		src = cipher_capa_aes_gcm;
-		num = sizeof(cipher_capa_aes_gcm) / size;
-		break;
-	default:
-		return -1;
-	}
+	if (global->num_worker_sessions == 0) {
+		/* Join workers that have exited */
+		if (global->workers_created) {
+			crypto_workers_stop(global->num_workers);
+			global->workers_created = 0;
+		}
 
-	if (num < num_copy)
-		num_copy = num;
+		if (crypto_workers_start()) {
+			odp_spinlock_unlock(&global->lock);
+			return;
+		}
 
-	memcpy(dst, src, num_copy * size);
+		global->workers_created = 1;
+	}
 
-	return num;
+	global->num_worker_sessions++;
+	session->use_worker = 1;
+	session->worker = session->index % global->num_workers;
+
+	odp_spinlock_unlock(&global->lock);
 }
 
-int odp_crypto_auth_capability(odp_auth_alg_t auth,
-			       odp_crypto_auth_capability_t dst[], int num_copy)
+/* Release the crypto worker of a freed session. The session has no
+ * operations in flight. Workers are requested to exit with the last
+ * session, which may be freed by a worker itself, and are joined later. */
+static void crypto_worker_detach(odp_crypto_generic_session_t *session)
 {
-	const odp_crypto_auth_capability_t *src;
-	int num;
-	int size = sizeof(odp_crypto_auth_capability_t);
-
-	switch (auth) {
-	case ODP_AUTH_ALG_NULL:
-		src = NULL;
-		num = 0;
-		break;
-	case ODP_AUTH_ALG_MD5_HMAC:
-		src = auth_capa_md5_hmac;
-		num = sizeof(auth_capa_md5_hmac) / size;
-		break;
-	case ODP_AUTH_ALG_SHA256_HMAC:
-		src = auth_capa_sha256_hmac;
-		num = sizeof(auth_capa_sha256_hmac) / size;
-		break;
-	case ODP_AUTH_ALG_AES_GCM:
-		src = auth_capa_aes_gcm;
-		num = sizeof(auth_capa_aes_gcm) / size;
-		break;
-	default:
-		return -1;
-	}
+	odp_spinlock_lock(&global->lock);
 
-	if (num < num_copy)
-		num_copy = num;
+	if (--global->num_worker_sessions == 0)
+		odp_atomic_store_rel_u32(&global->worker_exit, 1);
 
-	memcpy(dst, src, num_copy * size);
+	session->use_worker = 0;
 
-	return num;
+	odp_spinlock_unlock(&global->lock);
 }
 
 int
@@ -756,6 +1441,7 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 	if (session->p.iv.data) {
 		if (session->p.iv.length > MAX_IV_LEN) {
 			ODP_DBG("Maximum IV length exceeded\n");
+			session_release(session);
 			return -1;
 		}
 
@@ -763,6 +1449,19 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 		       session->p.iv.length);
 	}
 
+	/* Copy cipher key data, thread local contexts are keyed from it */
+	if (session->p.cipher_key.data) {
+		if (session->p.cipher_key.length > MAX_KEY_LEN) {
+			ODP_DBG("Maximum key length exceeded\n");
+			*status = ODP_CRYPTO_SES_CREATE_ERR_INV_CIPHER;
+			session_release(session);
+			return -1;
+		}
+
+		memcpy(session->cipher.key_data, session->p.cipher_key.data,
+		       session->p.cipher_key.length);
+	}
+
 	/* Derive order */
 	if (ODP_CRYPTO_OP_ENCODE == param->op)
 		session->do_cipher_first =  param->auth_cipher_text;
@@ -782,7 +1481,10 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 	case ODP_CIPHER_ALG_AES_CBC:
 	     /* deprecated */
 	case ODP_CIPHER_ALG_AES128_CBC:
-		rc = process_aes_param(session);
+		rc = process_aes_param(session, EVP_CIPH_CBC_MODE);
+		break;
+	case ODP_CIPHER_ALG_AES_CTR:
+		rc = process_aes_param(session, EVP_CIPH_CTR_MODE);
 		break;
 	case ODP_CIPHER_ALG_AES_GCM:
 	     /* deprecated */
@@ -795,6 +1497,14 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 		else
 			rc = -1;
 		break;
+#ifdef HAVE_CHACHA20_POLY1305
+	case ODP_CIPHER_ALG_CHACHA20_POLY1305:
+		if (param->auth_alg == ODP_AUTH_ALG_CHACHA20_POLY1305)
+			rc = process_chacha20_poly1305_param(session);
+		else
+			rc = -1;
+		break;
+#endif
 	default:
 		rc = -1;
 	}
@@ -802,9 +1512,13 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 	/* Check result */
 	if (rc) {
 		*status = ODP_CRYPTO_SES_CREATE_ERR_INV_CIPHER;
+		session_release(session);
 		return -1;
 	}
 
+	/* Thread local cipher contexts of a previous session are rekeyed */
+	session->cipher.gen = odp_atomic_fetch_inc_u32(&global->cipher_gen);
+
 	/* Process based on auth */
 	switch (param->auth_alg) {
 	case ODP_AUTH_ALG_NULL:
@@ -814,12 +1528,21 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 	case ODP_AUTH_ALG_MD5_HMAC:
 	     /* deprecated */
 	case ODP_AUTH_ALG_MD5_96:
-		rc = process_md5_param(session, 96);
+		rc = process_hmac_param(session, EVP_md5(), 96);
+		break;
+	case ODP_AUTH_ALG_SHA1_HMAC:
+		rc = process_hmac_param(session, EVP_sha1(), 96);
 		break;
 	case ODP_AUTH_ALG_SHA256_HMAC:
 	     /* deprecated */
 	case ODP_AUTH_ALG_SHA256_128:
-		rc = process_sha256_param(session, 128);
+		rc = process_hmac_param(session, EVP_sha256(), 128);
+		break;
+	case ODP_AUTH_ALG_SHA384_HMAC:
+		rc = process_hmac_param(session, EVP_sha384(), 192);
+		break;
+	case ODP_AUTH_ALG_SHA512_HMAC:
+		rc = process_hmac_param(session, EVP_sha512(), 256);
 		break;
 	case ODP_AUTH_ALG_AES_GCM:
 	     /* deprecated */
@@ -834,6 +1557,22 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 			rc = -1;
 		}
 		break;
+	case ODP_AUTH_ALG_AES_GMAC:
+		if (param->cipher_alg == ODP_CIPHER_ALG_NULL)
+			rc = process_aes_gmac_param(session);
+		else
+			rc = -1;
+		break;
+#ifdef HAVE_CHACHA20_POLY1305
+	case ODP_AUTH_ALG_CHACHA20_POLY1305:
+		if (param->cipher_alg == ODP_CIPHER_ALG_CHACHA20_POLY1305) {
+			session->auth.func = null_crypto_routine;
+			rc = 0;
+		} else {
+			rc = -1;
+		}
+		break;
+#endif
 	default:
 		rc = -1;
 	}
@@ -841,9 +1580,13 @@ odp_crypto_session_create(odp_crypto_session_param_t *param,
 	/* Check result */
 	if (rc) {
 		*status = ODP_CRYPTO_SES_CREATE_ERR_INV_AUTH;
+		session_release(session);
 		return -1;
 	}
 
+	if (global->num_workers && ODP_QUEUE_INVALID != param->compl_queue)
+		crypto_worker_attach(session);
+
 	/* We're happy */
 	*session_out = (intptr_t)session;
 	return 0;
@@ -853,12 +1596,11 @@ int odp_crypto_session_destroy(odp_crypto_session_t session)
 {
 	odp_crypto_generic_session_t *generic;
 
-	generic = (odp_crypto_generic_session_t *)(intptr_t)session;
-	if (generic->p.cipher_alg == ODP_CIPHER_ALG_AES128_GCM ||
-	    generic->p.cipher_alg == ODP_CIPHER_ALG_AES_GCM)
-		EVP_CIPHER_CTX_free(generic->cipher.data.aes_gcm.ctx);
-	memset(generic, 0, sizeof(*generic));
-	free_session(generic);
+	generic = session_from_handle(session);
+
+	/* Operations in flight hold references to the session. The last
+	 * one frees it. */
+	session_release(generic);
 	return 0;
 }
 
@@ -867,71 +1609,51 @@ odp_crypto_operation(odp_crypto_op_param_t *param,
 		     odp_bool_t *posted,
 		     odp_crypto_op_result_t *result)
 {
-	odp_crypto_alg_err_t rc_cipher = ODP_CRYPTO_ALG_ERR_NONE;
-	odp_crypto_alg_err_t rc_auth = ODP_CRYPTO_ALG_ERR_NONE;
 	odp_crypto_generic_session_t *session;
 	odp_crypto_op_result_t local_result;
 
-	session = (odp_crypto_generic_session_t *)(intptr_t)param->session;
-
-	/* Resolve output buffer */
-	if (ODP_PACKET_INVALID == param->out_pkt &&
-	    ODP_POOL_INVALID != session->p.output_pool)
-		param->out_pkt = odp_packet_alloc(session->p.output_pool,
-				odp_packet_len(param->pkt));
+	session = session_from_handle(param->session);
 
-	if (odp_unlikely(ODP_PACKET_INVALID == param->out_pkt)) {
-		ODP_DBG("Alloc failed.\n");
+	/* The operation holds a reference to the session until processed */
+	if (odp_unlikely(session_acquire(session)))
 		return -1;
+
+	/* Crypto worker threads process asynchronous operations */
+	if (session->use_worker) {
+		if (crypto_async_submit(param, session)) {
+			session_release(session);
+			return -1;
+		}
+
+		*posted = 1;
+		return 0;
 	}
 
-	if (param->pkt != param->out_pkt) {
-		(void)odp_packet_copy_from_pkt(param->out_pkt,
-					       0,
-					       param->pkt,
-					       0,
-					       odp_packet_len(param->pkt));
-		_odp_packet_copy_md_to_packet(param->pkt, param->out_pkt);
-		odp_packet_free(param->pkt);
-		param->pkt = ODP_PACKET_INVALID;
+	/* Synchronous operations need a result */
+	if (ODP_QUEUE_INVALID == session->p.compl_queue && !result) {
+		session_release(session);
+		return -1;
 	}
 
-	/* Invoke the functions */
-	if (session->do_cipher_first) {
-		rc_cipher = session->cipher.func(param, session);
-		rc_auth = session->auth.func(param, session);
-	} else {
-		rc_auth = session->auth.func(param, session);
-		rc_cipher = session->cipher.func(param, session);
+	/* Resolve output buffer */
+	if (crypto_op_output(param, session)) {
+		session_release(session);
+		return -1;
 	}
 
-	/* Fill in result */
-	local_result.ctx = param->ctx;
-	local_result.pkt = param->out_pkt;
-	local_result.cipher_status.alg_err = rc_cipher;
-	local_result.cipher_status.hw_err = ODP_CRYPTO_HW_ERR_NONE;
-	local_result.auth_status.alg_err = rc_auth;
-	local_result.auth_status.hw_err = ODP_CRYPTO_HW_ERR_NONE;
-	local_result.ok =
-		(rc_cipher == ODP_CRYPTO_ALG_ERR_NONE) &&
-		(rc_auth == ODP_CRYPTO_ALG_ERR_NONE);
+	/* Invoke the functions */
+	crypto_op_process(param, session, &local_result);
 
 	/* If specified during creation post event to completion queue */
 	if (ODP_QUEUE_INVALID != session->p.compl_queue) {
 		odp_event_t completion_event;
-		odp_crypto_generic_op_result_t *op_result;
 
-		/* Linux generic will always use packet for completion event */
-		completion_event = odp_packet_to_event(param->out_pkt);
-		_odp_buffer_event_type_set(
-			odp_buffer_from_event(completion_event),
-			ODP_EVENT_CRYPTO_COMPL);
 		/* Asynchronous, build result (no HW so no errors) and send it*/
-		op_result = get_op_result_from_event(completion_event);
-		op_result->magic = OP_RESULT_MAGIC;
-		op_result->result = local_result;
+		*crypto_op_compl_init(param->out_pkt) = local_result;
+		completion_event = odp_packet_to_event(param->out_pkt);
 		if (odp_queue_enq(session->p.compl_queue, completion_event)) {
-			odp_event_free(completion_event);
+			session_release(session);
+			odp_packet_free(param->out_pkt);
 			return -1;
 		}
 
@@ -939,16 +1661,178 @@ odp_crypto_operation(odp_crypto_op_param_t *param,
 		*posted = 1;
 	} else {
 		/* Synchronous, simply return results */
-		if (!result)
-			return -1;
 		*result = local_result;
 
 		/* Indicate to caller operation was sync */
 		*posted = 0;
 	}
+
+	session_release(session);
 	return 0;
 }
 
+/* Enqueue completion events into the queue. Returns 'num' on success. On
+ * failure, returns the index of the first failed operation and frees output
+ * packets of operations from it onwards, which were processed by the caller
+ * but not delivered. Packets of synchronous operations are left to the
+ * application. Operations submitted to crypto workers are never after a
+ * failed one. */
+static int crypto_compl_enq(odp_queue_t queue, odp_event_t ev[], int num_ev,
+			    odp_crypto_op_param_t param[],
+			    const odp_bool_t posted[],
+			    odp_crypto_op_result_t *op_result[],
+			    const uint8_t idx[], int num)
+{
+	int done, i, failed;
+
+	done = crypto_enq_events(queue, ev, num_ev);
+	if (odp_likely(done == num_ev))
+		return num;
+
+	failed = idx[done];
+
+	for (i = failed; i < num; i++)
+		if (posted[i] && op_result[i] != NULL)
+			odp_packet_free(param[i].out_pkt);
+
+	return failed;
+}
+
+int odp_crypto_operation_multi(odp_crypto_op_param_t param[],
+			       odp_bool_t posted[],
+			       odp_crypto_op_result_t result[], int num)
+{
+	odp_crypto_generic_session_t *session[MAX_BURST];
+	odp_crypto_op_result_t *op_result[MAX_BURST];
+	uint8_t order[MAX_BURST];
+	odp_event_t ev[MAX_BURST];
+	uint8_t ev_idx[MAX_BURST];
+	odp_queue_t queue = ODP_QUEUE_INVALID;
+	int num_ev = 0;
+	int num_proc = 0;
+	int num_compl = 0;
+	int i, j, ret;
+
+	if (num > MAX_BURST)
+		num = MAX_BURST;
+
+	/* Resolve output packets. Operations are started in order, the first
+	 * one that cannot be started ends the burst. */
+	for (i = 0; i < num; i++) {
+		session[i] = session_from_handle(param[i].session);
+
+		/* Operations hold a reference to the session until
+		 * processed */
+		if (odp_unlikely(session_acquire(session[i])))
+			break;
+
+		posted[i] = ODP_QUEUE_INVALID != session[i]->p.compl_queue;
+
+		if (odp_unlikely(!posted[i] && result == NULL)) {
+			session_release(session[i]);
+			break;
+		}
+
+		/* Crypto worker threads process asynchronous operations. A
+		 * completion enqueue of an earlier operation may still fail,
+		 * after which this operation would be reported as failed
+		 * while a worker owns it. The burst ends here instead. */
+		if (session[i]->use_worker) {
+			if (num_compl ||
+			    odp_unlikely(crypto_async_submit(&param[i],
+							     session[i]))) {
+				session_release(session[i]);
+				break;
+			}
+
+			op_result[i] = NULL;
+			continue;
+		}
+
+		if (odp_unlikely(crypto_op_output(&param[i], session[i]))) {
+			session_release(session[i]);
+			break;
+		}
+
+		if (posted[i]) {
+			op_result[i] = crypto_op_compl_init(param[i].out_pkt);
+			num_compl++;
+		} else {
+			op_result[i] = &result[i];
+		}
+
+		/* Insertion sort groups operations by session, and keeps the
+		 * order of operations within a session */
+		for (j = num_proc; j > 0 && session[order[j - 1]] > session[i];
+		     j--)
+			order[j] = order[j - 1];
+
+		order[j] = i;
+		num_proc++;
+	}
+
+	num = i;
+	if (odp_unlikely(num == 0))
+		return -1;
+
+	/* Operations of a session run back to back, while session state,
+	 * keys and cipher contexts are hot in cache */
+	for (i = 0; i < num_proc; i++) {
+		j = order[i];
+
+		if (i + 1 < num_proc) {
+			odp_packet_t next = param[order[i + 1]].out_pkt;
+
+			odp_prefetch(odp_packet_data(next));
+		}
+
+		crypto_op_process(&param[j], session[j], op_result[j]);
+	}
+
+	/* Post completion events in operation order, a burst per queue */
+	ret = num;
+
+	for (i = 0; i < num; i++) {
+		if (!posted[i] || op_result[i] == NULL)
+			continue;
+
+		if (num_ev && session[i]->p.compl_queue != queue) {
+			j = crypto_compl_enq(queue, ev, num_ev, param, posted,
+					     op_result, ev_idx, num);
+			if (odp_unlikely(j < num)) {
+				ret = j ? j : -1;
+				goto release;
+			}
+			num_ev = 0;
+		}
+
+		queue = session[i]->p.compl_queue;
+		ev[num_ev] = odp_packet_to_event(param[i].out_pkt);
+		ev_idx[num_ev] = i;
+		num_ev++;
+	}
+
+	if (num_ev) {
+		j = crypto_compl_enq(queue, ev, num_ev, param, posted,
+				     op_result, ev_idx, num);
+		if (odp_unlikely(j < num))
+			ret = j ? j : -1;
+	}
+
+release:
+	/* References of operations submitted to workers passed to the
+	 * requests */
+	for (i = 0; i < num; i++)
+		if (op_result[i] != NULL)
+			session_release(session[i]);
+
+	return ret;
+}
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+/* OpenSSL versions before 1.1.0 need application locking callbacks for
+ * thread safety. Newer versions lock internally and keep RNG state per
+ * thread, so these are not installed. */
 static unsigned long openssl_thread_id(void)
 {
 	return (unsigned long)odp_thread_id();
@@ -959,53 +1843,122 @@ static void openssl_lock(int mode, int n,
 			 int line ODP_UNUSED)
 {
 	if (mode & CRYPTO_LOCK)
-		odp_ticketlock_lock((odp_ticketlock_t *)
-				    &global->openssl_lock[n]);
+		odp_ticketlock_lock(&global->openssl_lock[n]);
 	else
-		odp_ticketlock_unlock((odp_ticketlock_t *)
-				      &global->openssl_lock[n]);
+		odp_ticketlock_unlock(&global->openssl_lock[n]);
 }
+#endif
 
 int
 odp_crypto_init_global(void)
 {
-	size_t mem_size;
+	size_t mem_size, ring_offset, lock_offset;
 	odp_shm_t shm;
-	int idx;
-	int nlocks = CRYPTO_num_locks();
+	uint32_t idx;
+	int nlocks = 0;
+	int num_workers, num_sessions;
+	uint32_t ring_size, table_size;
+	const char *env;
+
+	num_sessions = CONFIG_CRYPTO_MAX_SESSIONS;
+	env = getenv("ODP_CRYPTO_MAX_SESSIONS");
+	if (env != NULL)
+		num_sessions = atoi(env);
+
+	if (num_sessions < 1 || num_sessions > (1 << 24)) {
+		ODP_ERR("Bad number of crypto sessions: %i\n", num_sessions);
+		return -1;
+	}
 
-	/* Calculate the memory size we need */
-	mem_size  = sizeof(*global);
-	mem_size += (MAX_SESSIONS * sizeof(odp_crypto_generic_session_t));
-	mem_size += nlocks * sizeof(odp_ticketlock_t);
+	/* Thread local caches may hold free sessions that other threads
+	 * cannot allocate. The table has room for those on top of
+	 * max_sessions, so that max_sessions can always be created. */
+	table_size = num_sessions + odp_thread_count_max() * SESSION_CACHE_SIZE;
+	ring_size  = ROUNDUP_POWER2_U32(table_size);
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+	nlocks = CRYPTO_num_locks();
+#endif
+
+	/* Calculate the memory size we need: session table, free session
+	 * ring and OpenSSL locks */
+	ring_offset  = sizeof(*global);
+	ring_offset += table_size * sizeof(odp_crypto_generic_session_t);
+	ring_offset  = ROUNDUP_CACHE_LINE(ring_offset);
+	lock_offset  = ring_offset + sizeof(ring_t);
+	lock_offset += ring_size * sizeof(uint32_t);
+	mem_size     = lock_offset + nlocks * sizeof(odp_ticketlock_t);
 
 	/* Allocate our globally shared memory */
 	shm = odp_shm_reserve("crypto_pool", mem_size,
 			      ODP_CACHE_LINE_SIZE, 0);
 
 	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		ODP_ERR("Crypto shm reserve failed\n");
+		return -1;
+	}
 
 	/* Clear it out */
 	memset(global, 0, mem_size);
 
-	/* Initialize free list and lock */
-	for (idx = 0; idx < MAX_SESSIONS; idx++) {
-		global->sessions[idx].next = global->free;
-		global->free = &global->sessions[idx];
+	/* Initialize free session ring and lock */
+	global->max_sessions = num_sessions;
+	global->num_sessions = table_size;
+	global->session_ring = (ring_t *)(uintptr_t)((uint8_t *)global +
+						     ring_offset);
+	global->session_mask = ring_size - 1;
+	ring_init(global->session_ring);
+
+	for (idx = 0; idx < global->num_sessions; idx++) {
+		global->sessions[idx].index = idx;
+		ring_enq(global->session_ring, global->session_mask, idx);
 	}
 	odp_spinlock_init(&global->lock);
 
+	/* Generation zero marks unused thread local cipher contexts */
+	odp_atomic_init_u32(&global->cipher_gen, 1);
+
+	/* Crypto worker threads for asynchronous sessions. By default there
+	 * is one worker per CPU of the mask. */
+	odp_cpumask_zero(&global->worker_mask);
+	env = getenv("ODP_CRYPTO_WORKER_CPUMASK");
+	if (env != NULL)
+		odp_cpumask_from_str(&global->worker_mask, env);
+
+	num_workers = odp_cpumask_count(&global->worker_mask);
+	env = getenv("ODP_CRYPTO_WORKERS");
+	if (env != NULL)
+		num_workers = atoi(env);
+
+	if (num_workers < 0)
+		num_workers = 0;
+	if (num_workers > CONFIG_CRYPTO_MAX_WORKERS)
+		num_workers = CONFIG_CRYPTO_MAX_WORKERS;
+
+	global->num_workers = num_workers;
+	odp_atomic_init_u32(&global->worker_exit, 0);
+
+	ring_init(&global->free_ring.hdr);
+	for (idx = 0; idx < CONFIG_CRYPTO_ASYNC_REQS; idx++)
+		ring_enq(&global->free_ring.hdr, REQ_RING_MASK, idx);
+
+	if (num_workers)
+		ODP_DBG("Crypto worker threads: %i\n", num_workers);
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
 	if (nlocks > 0) {
 		global->openssl_lock =
-			(odp_ticketlock_t **)&global->sessions[MAX_SESSIONS];
+			(odp_ticketlock_t *)(uintptr_t)((uint8_t *)global +
+							lock_offset);
 
-		for (idx = 0; idx < nlocks; idx++)
-			odp_ticketlock_init((odp_ticketlock_t *)
-					    &global->openssl_lock[idx]);
+		for (idx = 0; idx < (uint32_t)nlocks; idx++)
+			odp_ticketlock_init(&global->openssl_lock[idx]);
 
 		CRYPTO_set_id_callback(openssl_thread_id);
 		CRYPTO_set_locking_callback(openssl_lock);
 	}
+#endif
 
 	return 0;
 }
@@ -1014,18 +1967,24 @@ int odp_crypto_term_global(void)
 {
 	int rc = 0;
 	int ret;
-	int count = 0;
-	odp_crypto_generic_session_t *session;
+	uint32_t count = 0;
+
+	if (global->workers_created)
+		crypto_workers_stop(global->num_workers);
 
-	for (session = global->free; session != NULL; session = session->next)
+	/* Thread local caches of free sessions have been flushed */
+	while (ring_deq(global->session_ring, global->session_mask) !=
+	       RING_EMPTY)
 		count++;
-	if (count != MAX_SESSIONS) {
+	if (count != global->num_sessions) {
 		ODP_ERR("crypto sessions still active\n");
 		rc = -1;
 	}
 
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
 	CRYPTO_set_locking_callback(NULL);
 	CRYPTO_set_id_callback(NULL);
+#endif
 
 	ret = odp_shm_free(odp_shm_lookup("crypto_pool"));
 	if (ret < 0) {
@@ -1036,21 +1995,115 @@ int odp_crypto_term_global(void)
 	return rc;
 }
 
+int odp_crypto_init_local(void)
+{
+	uint32_t num = global->num_sessions;
+
+	local.cipher_ctx = calloc(num, sizeof(EVP_CIPHER_CTX *));
+	local.cipher_gen = calloc(num, sizeof(uint32_t));
+	local.md_ctx = EVP_MD_CTX_new();
+	local.rand_ctx = EVP_CIPHER_CTX_new();
+	local.rand_left = 0;
+
+	if (local.cipher_ctx == NULL || local.cipher_gen == NULL ||
+	    local.md_ctx == NULL || local.rand_ctx == NULL) {
+		ODP_ERR("Crypto thread local init failed\n");
+		odp_crypto_term_local();
+		return -1;
+	}
+
+	return 0;
+}
+
+int odp_crypto_term_local(void)
+{
+	uint32_t i;
+
+	/* Return cached free sessions */
+	if (local.num_free)
+		ring_enq_multi(global->session_ring, global->session_mask,
+			       local.free_idx, local.num_free);
+
+	if (local.cipher_ctx) {
+		for (i = 0; i < global->num_sessions; i++)
+			EVP_CIPHER_CTX_free(local.cipher_ctx[i]);
+	}
+
+	free(local.cipher_ctx);
+	free(local.cipher_gen);
+	EVP_MD_CTX_free(local.md_ctx);
+	EVP_CIPHER_CTX_free(local.rand_ctx);
+	memset(&local, 0, sizeof(local));
+
+	return 0;
+}
+
 odp_random_kind_t odp_random_max_kind(void)
 {
 	return ODP_RANDOM_CRYPTO;
 }
 
+/* Key the thread local keystream generator from the OpenSSL RNG */
+static int rand_seed(void)
+{
+	uint8_t seed[RAND_SEED_LEN];
+	int ret;
+
+	if (RAND_bytes(seed, sizeof(seed)) != 1)
+		return -1;
+
+	ret = EVP_EncryptInit_ex(local.rand_ctx, EVP_aes_128_ctr(), NULL,
+				 seed, &seed[16]);
+	OPENSSL_cleanse(seed, sizeof(seed));
+
+	if (!ret)
+		return -1;
+
+	local.rand_left = RAND_RESEED_LEN;
+	return 0;
+}
+
+/* Basic random data is AES-CTR keystream from a thread local, periodically
+ * reseeded generator. Threads do not share any state. */
+static int32_t rand_basic(uint8_t *buf, uint32_t len)
+{
+	uint32_t num, done = 0;
+	int out_len;
+
+	/* Not a crypto enabled ODP thread (e.g. during global init) */
+	if (odp_unlikely(local.rand_ctx == NULL))
+		return RAND_bytes(buf, len) == 1 ? (int32_t)len : -1;
+
+	while (done < len) {
+		if (odp_unlikely(local.rand_left == 0) && rand_seed())
+			return -1;
+
+		num = len - done;
+		if (num > local.rand_left)
+			num = local.rand_left;
+
+		memset(&buf[done], 0, num);
+		if (!EVP_EncryptUpdate(local.rand_ctx, &buf[done], &out_len,
+				       &buf[done], num))
+			return -1;
+
+		local.rand_left -= num;
+		done += num;
+	}
+
+	return len;
+}
+
 int32_t odp_random_data(uint8_t *buf, uint32_t len, odp_random_kind_t kind)
 {
 	int rc;
 
 	switch (kind) {
 	case ODP_RANDOM_BASIC:
-		RAND_pseudo_bytes(buf, len);
-		return len;
+		return rand_basic(buf, len);
 
 	case ODP_RANDOM_CRYPTO:
+		/* OpenSSL 1.1.1 and newer use per thread DRBG instances */
 		rc = RAND_bytes(buf, len);
 		return (1 == rc) ? (int)len /*success*/: -1 /*failure*/;
 
@@ -7,6 +7,7 @@
 #include <odp/api/event.h>
 #include <odp/api/buffer.h>
 #include <odp/api/crypto.h>
+#include <odp/api/ipsec.h>
 #include <odp/api/packet.h>
 #include <odp/api/timer.h>
 #include <odp/api/pool.h>
@@ -14,6 +15,19 @@
 #include <odp_buffer_inlines.h>
 #include <odp_debug_internal.h>
 
+static void packet_vector_free_all(odp_packet_vector_t pktv)
+{
+	odp_packet_t *pkt_tbl;
+	uint32_t num;
+
+	num = odp_packet_vector_tbl(pktv, &pkt_tbl);
+
+	if (num)
+		odp_packet_free_multi(pkt_tbl, num);
+
+	odp_packet_vector_free(pktv);
+}
+
 odp_event_type_t odp_event_type(odp_event_t event)
 {
 	return _odp_buffer_event_type(odp_buffer_from_event(event));
@@ -34,6 +48,12 @@ void odp_event_free(odp_event_t event)
 	case ODP_EVENT_CRYPTO_COMPL:
 		odp_crypto_compl_free(odp_crypto_compl_from_event(event));
 		break;
+	case ODP_EVENT_PACKET_VECTOR:
+		packet_vector_free_all(odp_packet_vector_from_event(event));
+		break;
+	case ODP_EVENT_IPSEC_RESULT:
+		odp_packet_free(odp_ipsec_packet_from_event(event));
+		break;
 	default:
 		ODP_ABORT("Invalid event type: %d\n", odp_event_type(event));
 	}
@@ -39,8 +39,26 @@
 
 #include <odp/api/hash.h>
 #include <odp/api/std_types.h>
+#include <odp/api/byteorder.h>
+#include <odp/api/hints.h>
+#include <odp_debug_internal.h>
+#include <odp_internal.h>
 
 #include <stddef.h>
+#include <string.h>
+
+/* Number of keys hashed in parallel by the multi functions */
+#define HASH_LANES 4
+
+#if defined(__x86_64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CRC32C_HW
+#include <cpuid.h>
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CRC32C_HW
+#include <sys/auxv.h>
+#include <arm_acle.h>
+#endif
 
 static const uint32_t crc32c_tables[8][256] = {{
 	0x00000000, 0xF26B8303, 0xE13B70F7, 0x1350F3F4, 0xC79A971F, 0x35F1141C,
@@ -444,8 +462,10 @@ static inline uint32_t crc32c_u64(uint64_t data, uint32_t init_val)
 	return crc;
 }
 
-uint32_t odp_hash_crc32c(const void *data, uint32_t data_len,
-			 uint32_t init_val)
+/* Table based implementation, used when CRC instructions are not
+ * available */
+static uint32_t crc32c_sw(const void *data, uint32_t data_len,
+			  uint32_t init_val)
 {
 	size_t i;
 	uint64_t temp = 0;
@@ -487,3 +507,447 @@ uint32_t odp_hash_crc32c(const void *data, uint32_t data_len,
 
 	return init_val;
 }
+
+#ifdef CRC32C_HW
+/*
+ * Implementation using CRC32C instructions. Results are identical to
+ * crc32c_sw(), including the zero padding of the last 1-3 or 5-7 bytes.
+ *
+ * Long inputs are processed as three interleaved streams, which hides the
+ * latency of the CRC instruction. The CRCs of the streams are combined by
+ * shifting a CRC over the length of a stream with crc32c_shift().
+ */
+
+/* Stream lengths of the interleaved loops */
+#define CRC32C_LONG  8192
+#define CRC32C_SHORT 256
+
+#if defined(__x86_64__)
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+
+CRC32C_TARGET
+static inline uint32_t crc32c_hw_u32(uint32_t crc, uint32_t data)
+{
+	return _mm_crc32_u32(crc, data);
+}
+
+CRC32C_TARGET
+static inline uint32_t crc32c_hw_u64(uint32_t crc, uint64_t data)
+{
+	return (uint32_t)_mm_crc32_u64(crc, data);
+}
+
+static int crc32c_hw_supported(void)
+{
+	uint32_t eax, ebx, ecx, edx;
+
+	if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0)
+		return 0;
+
+	return (ecx & bit_SSE4_2) != 0;
+}
+#else
+#define CRC32C_TARGET __attribute__((target("+crc")))
+
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+
+CRC32C_TARGET
+static inline uint32_t crc32c_hw_u32(uint32_t crc, uint32_t data)
+{
+	return __crc32cw(crc, data);
+}
+
+CRC32C_TARGET
+static inline uint32_t crc32c_hw_u64(uint32_t crc, uint64_t data)
+{
+	return __crc32cd(crc, data);
+}
+
+static int crc32c_hw_supported(void)
+{
+	return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+#endif
+
+/* CRC of CRC32C_LONG and CRC32C_SHORT zero bytes, one table per CRC byte */
+static uint32_t crc32c_long[4][256];
+static uint32_t crc32c_short[4][256];
+
+/* Shift a CRC over the number of zero bytes the table was generated for */
+static inline uint32_t crc32c_shift(uint32_t zeros[][256], uint32_t crc)
+{
+	return zeros[0][crc & 0xff] ^ zeros[1][(crc >> 8) & 0xff] ^
+	       zeros[2][(crc >> 16) & 0xff] ^ zeros[3][crc >> 24];
+}
+
+/* Shifting a CRC over zero bytes is linear, so the table entries are
+ * combined from the shifts of single bit CRC values */
+static void crc32c_zeros(uint32_t zeros[][256], uint32_t len)
+{
+	uint32_t bit[32];
+	uint32_t i, j, k, crc;
+
+	for (i = 0; i < 32; i++) {
+		crc = 1U << i;
+		for (j = 0; j < len / 8; j++)
+			crc = crc32c_u64(0, crc);
+		bit[i] = crc;
+	}
+
+	for (k = 0; k < 4; k++) {
+		for (j = 0; j < 256; j++) {
+			crc = 0;
+			for (i = 0; i < 8; i++)
+				if (j & (1U << i))
+					crc ^= bit[8 * k + i];
+			zeros[k][j] = crc;
+		}
+	}
+}
+
+/* Three interleaved streams of 'len' bytes each */
+CRC32C_TARGET
+static inline uint32_t crc32c_hw_3way(uintptr_t pd, uint32_t len,
+				      uint32_t zeros[][256], uint32_t crc0)
+{
+	uintptr_t end = pd + len;
+	uint32_t crc1 = 0;
+	uint32_t crc2 = 0;
+
+	do {
+		crc0 = crc32c_hw_u64(crc0, *(const uint64_t *)pd);
+		crc1 = crc32c_hw_u64(crc1, *(const uint64_t *)(pd + len));
+		crc2 = crc32c_hw_u64(crc2, *(const uint64_t *)(pd + 2 * len));
+		pd += 8;
+	} while (pd < end);
+
+	crc0 = crc32c_shift(zeros, crc0) ^ crc1;
+	return crc32c_shift(zeros, crc0) ^ crc2;
+}
+
+/* Zero padded tail of 1-7 bytes, e.g. 13 byte keys end with one 8 byte
+ * step */
+CRC32C_TARGET
+static inline uint32_t crc32c_hw_tail(uintptr_t pd, uint32_t len, uint32_t crc)
+{
+	uint64_t temp = 0;
+
+	if (len & 4)
+		temp = *(const uint32_t *)pd;
+	if (len & 2)
+		temp |= (uint64_t)*(const uint16_t *)(pd + (len & 4))
+			<< (8 * (len & 4));
+	if (len & 1)
+		temp |= (uint64_t)*(const uint8_t *)(pd + len - 1)
+			<< (8 * (len - 1));
+
+	if (len > 4)
+		return crc32c_hw_u64(crc, temp);
+
+	return crc32c_hw_u32(crc, (uint32_t)temp);
+}
+
+CRC32C_TARGET
+static uint32_t crc32c_hw(const void *data, uint32_t data_len,
+			  uint32_t init_val)
+{
+	uintptr_t pd = (uintptr_t)data;
+	uint32_t crc = init_val;
+
+	if (odp_unlikely(data_len >= 3 * CRC32C_SHORT)) {
+		while (data_len >= 3 * CRC32C_LONG) {
+			crc = crc32c_hw_3way(pd, CRC32C_LONG, crc32c_long, crc);
+			pd += 3 * CRC32C_LONG;
+			data_len -= 3 * CRC32C_LONG;
+		}
+
+		while (data_len >= 3 * CRC32C_SHORT) {
+			crc = crc32c_hw_3way(pd, CRC32C_SHORT, crc32c_short,
+					     crc);
+			pd += 3 * CRC32C_SHORT;
+			data_len -= 3 * CRC32C_SHORT;
+		}
+	}
+
+	while (data_len >= 8) {
+		crc = crc32c_hw_u64(crc, *(const uint64_t *)pd);
+		pd += 8;
+		data_len -= 8;
+	}
+
+	if (data_len == 0)
+		return crc;
+
+	return crc32c_hw_tail(pd, data_len, crc);
+}
+
+/* Short keys are processed four at a time, since a CRC instruction has a
+ * latency of several cycles but a throughput of one per cycle. Long keys are
+ * faster to process one by one, in three streams. */
+CRC32C_TARGET
+static void crc32c_hw_multi(const void *const data[], uint32_t data_len,
+			    uint32_t init_val, uint32_t hash[], int num)
+{
+	uintptr_t pd[HASH_LANES];
+	uint32_t crc[HASH_LANES];
+	uint32_t off;
+	int num_lanes = 0;
+	int i, j;
+
+	if (data_len < 3 * CRC32C_SHORT)
+		num_lanes = num - num % HASH_LANES;
+
+	for (i = 0; i < num_lanes; i += HASH_LANES) {
+		for (j = 0; j < HASH_LANES; j++) {
+			pd[j]  = (uintptr_t)data[i + j];
+			crc[j] = init_val;
+		}
+
+		for (off = 0; off + 8 <= data_len; off += 8)
+			for (j = 0; j < HASH_LANES; j++)
+				crc[j] = crc32c_hw_u64(crc[j],
+						       *(const uint64_t *)
+						       (pd[j] + off));
+
+		for (j = 0; j < HASH_LANES; j++) {
+			if (data_len & 7)
+				crc[j] = crc32c_hw_tail(pd[j] + off,
+							data_len & 7, crc[j]);
+			hash[i + j] = crc[j];
+		}
+	}
+
+	for (; i < num; i++)
+		hash[i] = crc32c_hw(data[i], data_len, init_val);
+}
+#endif
+
+static void crc32c_sw_multi(const void *const data[], uint32_t data_len,
+			    uint32_t init_val, uint32_t hash[], int num)
+{
+	int i;
+
+	for (i = 0; i < num; i++)
+		hash[i] = crc32c_sw(data[i], data_len, init_val);
+}
+
+typedef uint32_t (*crc32c_fn_t)(const void *data, uint32_t data_len,
+				uint32_t init_val);
+
+typedef void (*crc32c_multi_fn_t)(const void *const data[],
+				  uint32_t data_len, uint32_t init_val,
+				  uint32_t hash[], int num);
+
+/* Selected at global init */
+static crc32c_fn_t crc32c_fn = crc32c_sw;
+static crc32c_multi_fn_t crc32c_multi_fn = crc32c_sw_multi;
+
+uint32_t odp_hash_crc32c(const void *data, uint32_t data_len,
+			 uint32_t init_val)
+{
+	return crc32c_fn(data, data_len, init_val);
+}
+
+void odp_hash_crc32c_multi(const void *const data[], uint32_t data_len,
+			   uint32_t init_val, uint32_t hash[], int num)
+{
+	crc32c_multi_fn(data, data_len, init_val, hash, num);
+}
+
+/*
+ * XXH64, as specified by the xxHash project (https://github.com/Cyan4973/
+ * xxHash). Data is read in little endian byte order.
+ */
+#define XXH_PRIME64_1 UINT64_C(0x9E3779B185EBCA87)
+#define XXH_PRIME64_2 UINT64_C(0xC2B2AE3D27D4EB4F)
+#define XXH_PRIME64_3 UINT64_C(0x165667B19E3779F9)
+#define XXH_PRIME64_4 UINT64_C(0x85EBCA77C2B2AE63)
+#define XXH_PRIME64_5 UINT64_C(0x27D4EB2F165667C5)
+
+static inline uint64_t xxh_rotl64(uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t xxh_read64(const uint8_t *p)
+{
+	odp_u64le_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return odp_le_to_cpu_64(v);
+}
+
+static inline uint32_t xxh_read32(const uint8_t *p)
+{
+	odp_u32le_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return odp_le_to_cpu_32(v);
+}
+
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input)
+{
+	acc += input * XXH_PRIME64_2;
+	acc  = xxh_rotl64(acc, 31);
+	return acc * XXH_PRIME64_1;
+}
+
+static inline uint64_t xxh64_merge(uint64_t acc, uint64_t val)
+{
+	acc ^= xxh64_round(0, val);
+	return acc * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+/* Hash state after the 32 byte stripes of the data */
+static inline uint64_t xxh64_stripes(const uint8_t *p, uint32_t len,
+				     uint64_t seed)
+{
+	uint64_t v1, v2, v3, v4, h;
+	const uint8_t *end = p + (len & ~31U);
+
+	if (len < 32)
+		return seed + XXH_PRIME64_5 + len;
+
+	v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+	v2 = seed + XXH_PRIME64_2;
+	v3 = seed;
+	v4 = seed - XXH_PRIME64_1;
+
+	do {
+		v1 = xxh64_round(v1, xxh_read64(p));
+		v2 = xxh64_round(v2, xxh_read64(p + 8));
+		v3 = xxh64_round(v3, xxh_read64(p + 16));
+		v4 = xxh64_round(v4, xxh_read64(p + 24));
+		p += 32;
+	} while (p < end);
+
+	h = xxh_rotl64(v1, 1) + xxh_rotl64(v2, 7) + xxh_rotl64(v3, 12) +
+	    xxh_rotl64(v4, 18);
+	h = xxh64_merge(h, v1);
+	h = xxh64_merge(h, v2);
+	h = xxh64_merge(h, v3);
+	h = xxh64_merge(h, v4);
+
+	return h + len;
+}
+
+/* Remaining 0-31 bytes and final mixing */
+static inline uint64_t xxh64_finalize(const uint8_t *p, uint32_t len,
+				      uint64_t h)
+{
+	len &= 31;
+
+	while (len >= 8) {
+		h ^= xxh64_round(0, xxh_read64(p));
+		h  = xxh_rotl64(h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+		p += 8;
+		len -= 8;
+	}
+
+	if (len >= 4) {
+		h ^= (uint64_t)xxh_read32(p) * XXH_PRIME64_1;
+		h  = xxh_rotl64(h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+		p += 4;
+		len -= 4;
+	}
+
+	while (len) {
+		h ^= *p * XXH_PRIME64_5;
+		h  = xxh_rotl64(h, 11) * XXH_PRIME64_1;
+		p++;
+		len--;
+	}
+
+	h ^= h >> 33;
+	h *= XXH_PRIME64_2;
+	h ^= h >> 29;
+	h *= XXH_PRIME64_3;
+	h ^= h >> 32;
+
+	return h;
+}
+
+uint64_t odp_hash_xxh64(const void *data, uint32_t data_len, uint64_t seed)
+{
+	const uint8_t *p = data;
+	uint64_t h = xxh64_stripes(p, data_len, seed);
+
+	return xxh64_finalize(p + (data_len & ~31U), data_len, h);
+}
+
+/* Keys shorter than a stripe are hashed in parallel. A single key has only
+ * one dependency chain of multiplications, while longer keys have four. */
+void odp_hash_xxh64_multi(const void *const data[], uint32_t data_len,
+			  uint64_t seed, uint64_t hash[], int num)
+{
+	uint64_t h[HASH_LANES];
+	int i = 0;
+	int j;
+
+	if (data_len < 32) {
+		for (; i + HASH_LANES <= num; i += HASH_LANES) {
+			for (j = 0; j < HASH_LANES; j++)
+				h[j] = xxh64_finalize(data[i + j], data_len,
+						      seed + XXH_PRIME64_5 +
+						      data_len);
+			for (j = 0; j < HASH_LANES; j++)
+				hash[i + j] = h[j];
+		}
+	}
+
+	for (; i < num; i++)
+		hash[i] = odp_hash_xxh64(data[i], data_len, seed);
+}
+
+uint32_t odp_hash_toeplitz(const void *data, uint32_t data_len,
+			   const uint8_t *key, uint32_t key_len)
+{
+	const uint8_t *p = data;
+	uint32_t hash = 0;
+	uint64_t win = 0;
+	uint32_t i;
+	int bit;
+
+	/* 64 key bits starting from the current data byte. Data bit 'bit'
+	 * (7 is the MSB) selects window bits 25 + bit ... 56 + bit. */
+	for (i = 0; i < 8; i++)
+		win = (win << 8) | (i < key_len ? key[i] : 0);
+
+	for (i = 0; i < data_len; i++) {
+		uint32_t byte = p[i];
+
+		/* Loop only over set bits */
+		while (byte) {
+			bit = __builtin_ctz(byte);
+			hash ^= (uint32_t)(win >> (25 + bit));
+			byte &= byte - 1;
+		}
+
+		win = (win << 8) | (i + 8 < key_len ? key[i + 8] : 0);
+	}
+
+	return hash;
+}
+
+int _odp_hash_init_global(void)
+{
+#ifdef CRC32C_HW
+	if (crc32c_hw_supported()) {
+		crc32c_zeros(crc32c_long, CRC32C_LONG);
+		crc32c_zeros(crc32c_short, CRC32C_SHORT);
+		crc32c_fn = crc32c_hw;
+		crc32c_multi_fn = crc32c_hw_multi;
+		ODP_DBG("CRC32C: using CRC instructions\n");
+		return 0;
+	}
+#endif
+	ODP_DBG("CRC32C: using lookup tables\n");
+	return 0;
+}
+
+int _odp_hash_term_global(void)
+{
+	return 0;
+}
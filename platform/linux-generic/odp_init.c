@@ -99,6 +99,12 @@ int odp_init_global(odp_instance_t *instance,
 	}
 	stage = TIME_INIT;
 
+	if (_odp_hash_init_global()) {
+		ODP_ERR("ODP hash init failed.\n");
+		goto init_failed;
+	}
+	stage = HASH_INIT;
+
 	if (odp_system_info_init()) {
 		ODP_ERR("ODP system_info init failed.\n");
 		goto init_failed;
@@ -163,6 +169,12 @@ int odp_init_global(odp_instance_t *instance,
 	}
 	stage = CRYPTO_INIT;
 
+	if (odp_ipsec_init_global()) {
+		ODP_ERR("ODP IPSEC init failed.\n");
+		goto init_failed;
+	}
+	stage = IPSEC_INIT;
+
 	if (odp_classification_init_global()) {
 		ODP_ERR("ODP classification init failed.\n");
 		goto init_failed;
@@ -225,6 +237,13 @@ int _odp_term_global(enum init_stage stage)
 		}
 		/* Fall through */
 
+	case IPSEC_INIT:
+		if (odp_ipsec_term_global()) {
+			ODP_ERR("ODP IPSEC term failed.\n");
+			rc = -1;
+		}
+		/* Fall through */
+
 	case CRYPTO_INIT:
 		if (odp_crypto_term_global()) {
 			ODP_ERR("ODP crypto term failed.\n");
@@ -295,6 +314,13 @@ int _odp_term_global(enum init_stage stage)
 		}
 		/* Fall through */
 
+	case HASH_INIT:
+		if (_odp_hash_term_global()) {
+			ODP_ERR("ODP hash term failed.\n");
+			rc = -1;
+		}
+		/* Fall through */
+
 	case TIME_INIT:
 		if (odp_time_term_global()) {
 			ODP_ERR("ODP time term failed.\n");
@@ -349,6 +375,12 @@ int odp_init_local(odp_instance_t instance, odp_thread_type_t thr_type)
 	}
 	stage = POOL_INIT;
 
+	if (odp_crypto_init_local()) {
+		ODP_ERR("ODP crypto local init failed.\n");
+		goto init_fail;
+	}
+	stage = CRYPTO_INIT;
+
 	if (sched_fn->init_local()) {
 		ODP_ERR("ODP schedule local init failed.\n");
 		goto init_fail;
@@ -382,6 +414,13 @@ int _odp_term_local(enum init_stage stage)
 		}
 		/* Fall through */
 
+	case CRYPTO_INIT:
+		if (odp_crypto_term_local()) {
+			ODP_ERR("ODP crypto local term failed.\n");
+			rc = -1;
+		}
+		/* Fall through */
+
 	case POOL_INIT:
 		if (odp_pool_term_local()) {
 			ODP_ERR("ODP buffer pool local term failed.\n");
@@ -0,0 +1,1466 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <odp_posix_extensions.h>
+#include <odp/api/ipsec.h>
+#include <odp/api/atomic.h>
+#include <odp/api/byteorder.h>
+#include <odp/api/crypto.h>
+#include <odp/api/hints.h>
+#include <odp/api/packet.h>
+#include <odp/api/packet_flags.h>
+#include <odp/api/queue.h>
+#include <odp/api/random.h>
+#include <odp/api/shared_memory.h>
+#include <odp/api/spinlock.h>
+#include <odp/api/thread.h>
+#include <odp_internal.h>
+#include <odp_debug_internal.h>
+#include <odp_config_internal.h>
+#include <odp_align_internal.h>
+#include <odp_buffer_inlines.h>
+#include <odp_packet_internal.h>
+#include <odp_ipsec_internal.h>
+#include <odp_chksum_internal.h>
+#include <protocols/ip.h>
+#include <protocols/ipsec.h>
+
+#include <stddef.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* Maximum number of packets processed at once */
+#define MAX_BURST 32
+
+/* Anti-replay window is a ring of 64 bit words, with one word more than the
+ * maximum window size for moving the window forward */
+#define MAX_ANTIREPLAY_WS 1024
+#define WINDOW_WORDS      32
+#define WINDOW_MASK       (WINDOW_WORDS - 1)
+
+/* SPI lookup table: open addressing, at most half full */
+#define SPI_TBL_SIZE  (2 * CONFIG_IPSEC_MAX_NUM_SA)
+#define SPI_TBL_MASK  (SPI_TBL_SIZE - 1)
+#define SPI_SLOT_FREE 0
+#define SPI_SLOT_DEL  0xffffffff
+
+/* ESP field limits */
+#define ESP_MAX_IV_LEN    16
+#define ESP_MAX_PAD_LEN   255
+#define SALT_LEN      4
+
+/* Per thread IV counters are reserved in blocks of 2^32 values */
+#define IV_BLOCK_BITS 32
+#define IV_BLOCK_MASK ((1ULL << IV_BLOCK_BITS) - 1)
+
+/* Random bytes fetched at once for CBC IVs */
+#define RAND_BUF_LEN  256
+
+#define SA_STATE_FREE   0
+#define SA_STATE_ACTIVE 1
+
+#define IPV4_DF          0x4000
+#define IPV4_DEFAULT_TTL 64
+#define IPV4_MAX_HDR_LEN 60
+
+ODP_STATIC_ASSERT(CHECK_IS_POWER2(CONFIG_IPSEC_MAX_NUM_SA),
+		  "CONFIG_IPSEC_MAX_NUM_SA must be a power of two");
+ODP_STATIC_ASSERT(WINDOW_WORDS * 64 > MAX_ANTIREPLAY_WS,
+		  "Anti-replay window too small");
+
+/* How the crypto IV is formed from the IV in the packet */
+typedef enum {
+	/* No IV */
+	NONCE_NONE = 0,
+	/* Random IV, used as is (CBC) */
+	NONCE_IV,
+	/* Salt, IV and 32 bit block counter starting from one (RFC 3686) */
+	NONCE_CTR,
+	/* Salt and IV (RFC 4106, RFC 4543, RFC 7634) */
+	NONCE_SALT
+} nonce_mode_t;
+
+typedef struct ipsec_sa_s {
+	/* SA_STATE_FREE or SA_STATE_ACTIVE */
+	odp_atomic_u32_t state;
+	uint32_t index;
+
+	/* Creation parameters, without key pointers */
+	odp_ipsec_sa_param_t param;
+	odp_crypto_session_t session;
+
+	/* ESP format */
+	uint32_t iv_len;
+	uint32_t icv_len;
+	/* Cipher block size, encrypted data length must be a multiple */
+	uint32_t block;
+	/* Payload and ESP trailer are padded to a multiple of this */
+	uint32_t align;
+	nonce_mode_t nonce;
+	/* AEAD cipher, AAD is the ESP header */
+	odp_bool_t aead;
+	uint8_t salt[SALT_LEN];
+
+	/* Last outbound sequence number */
+	odp_atomic_u64_t seq;
+
+	/* Outer header of outbound tunnel mode SA */
+	_odp_ipv4hdr_t tun_hdr;
+
+	/* Inbound anti-replay window, protected by the lock. Bit 'seq' of
+	 * the ring of words marks a received sequence number. */
+	odp_spinlock_t lock;
+	uint32_t ws;
+	uint64_t top;
+	uint64_t window[WINDOW_WORDS];
+
+} ODP_ALIGNED_CACHE ipsec_sa_t;
+
+typedef struct {
+	/* Protects SA create and destroy, and SPI table updates */
+	odp_spinlock_t lock;
+	odp_ipsec_config_t config;
+	uint32_t max_num_sa;
+	/* Next IV counter block */
+	odp_atomic_u64_t iv_block;
+	/* SA index + 1, SPI_SLOT_FREE or SPI_SLOT_DEL */
+	odp_atomic_u32_t spi_tbl[SPI_TBL_SIZE];
+	ipsec_sa_t sa[CONFIG_IPSEC_MAX_NUM_SA];
+} ipsec_global_t;
+
+/* Thread local IV and IP ID generation state */
+typedef struct {
+	/* ODP thread ID + 1 of the owner, state is reset on mismatch (e.g.
+	 * after fork) */
+	int owner;
+	uint64_t iv_ctr;
+	uint16_t ip_id;
+	uint32_t rand_left;
+	uint8_t rand[RAND_BUF_LEN];
+} ipsec_local_t;
+
+/* Processing state of a packet */
+typedef struct {
+	ipsec_sa_t *sa;
+	odp_ipsec_error_t err;
+	uint32_t seq;
+	uint32_t l3_off;
+	uint32_t esp_off;
+	/* Encrypted data: payload and ESP trailer */
+	uint32_t data_off;
+	uint32_t data_len;
+	/* IV was overwritten by AEAD AAD in the packet */
+	odp_bool_t iv_saved;
+	uint8_t iv[ESP_MAX_IV_LEN];
+	uint8_t nonce[16];
+} ipsec_state_t;
+
+static ipsec_global_t *global;
+static __thread ipsec_local_t local;
+
+static inline ipsec_sa_t *sa_from_handle(odp_ipsec_sa_t sa)
+{
+	return &global->sa[_odp_typeval(sa) - 1];
+}
+
+static inline odp_ipsec_sa_t sa_to_handle(ipsec_sa_t *sa)
+{
+	return _odp_cast_scalar(odp_ipsec_sa_t, sa->index + 1);
+}
+
+static inline uint32_t spi_hash(uint32_t spi)
+{
+	return (spi * 0x9e3779b1) >> 16;
+}
+
+static inline uint32_t packet_l3_offset(odp_packet_t pkt)
+{
+	uint32_t offset = odp_packet_l3_offset(pkt);
+
+	return offset == ODP_PACKET_OFFSET_INVALID ? 0 : offset;
+}
+
+static void ipv4_chksum_set(uint8_t *hdr, uint32_t len)
+{
+	_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(uintptr_t)hdr;
+
+	ip->chksum = 0;
+	ip->chksum = ~chksum_fold(chksum_partial(hdr, len, 0));
+}
+
+static void local_reset(void)
+{
+	int thr = odp_thread_id();
+
+	memset(&local, 0, sizeof(local));
+	local.owner = thr + 1;
+	local.ip_id = thr << 9;
+}
+
+static inline void local_check(void)
+{
+	if (odp_unlikely(local.owner != odp_thread_id() + 1))
+		local_reset();
+}
+
+/* Unique IV values without atomic operations per packet. The IV counter of a
+ * thread is reserved in blocks from the global counter. */
+static inline uint64_t iv_counter(void)
+{
+	if (odp_unlikely((local.iv_ctr & IV_BLOCK_MASK) == 0))
+		local.iv_ctr = (odp_atomic_fetch_inc_u64(&global->iv_block) <<
+				IV_BLOCK_BITS) + 1;
+
+	return local.iv_ctr++;
+}
+
+static inline int iv_random(uint8_t *iv, uint32_t len)
+{
+	if (odp_unlikely(local.rand_left < len)) {
+		if (odp_random_data(local.rand, RAND_BUF_LEN,
+				    ODP_RANDOM_CRYPTO) != RAND_BUF_LEN)
+			return -1;
+
+		local.rand_left = RAND_BUF_LEN;
+	}
+
+	local.rand_left -= len;
+	memcpy(iv, &local.rand[local.rand_left], len);
+
+	return 0;
+}
+
+/* Crypto IV of the operation from the IV in the packet */
+static void nonce_set(ipsec_sa_t *sa, ipsec_state_t *st)
+{
+	switch (sa->nonce) {
+	case NONCE_IV:
+		memcpy(st->nonce, st->iv, sa->iv_len);
+		break;
+	case NONCE_CTR:
+		memcpy(st->nonce, sa->salt, SALT_LEN);
+		memcpy(&st->nonce[SALT_LEN], st->iv, 8);
+		st->nonce[12] = 0;
+		st->nonce[13] = 0;
+		st->nonce[14] = 0;
+		st->nonce[15] = 1;
+		break;
+	case NONCE_SALT:
+		memcpy(st->nonce, sa->salt, SALT_LEN);
+		memcpy(&st->nonce[SALT_LEN], st->iv, 8);
+		break;
+	default:
+		break;
+	}
+}
+
+static void crypto_op_init(odp_crypto_op_param_t *op, odp_packet_t pkt,
+			   ipsec_state_t *st)
+{
+	ipsec_sa_t *sa = st->sa;
+	uint32_t icv_off = st->data_off + st->data_len;
+
+	memset(op, 0, sizeof(*op));
+	op->session = sa->session;
+	op->pkt     = pkt;
+	op->out_pkt = pkt;
+	op->override_iv_ptr = st->nonce;
+	op->hash_result_offset = icv_off;
+	op->cipher_range.offset = st->data_off;
+	op->cipher_range.length = st->data_len;
+
+	/* AEAD authenticates the ESP header as AAD, which the crypto layer
+	 * takes from the bytes preceding cipher data. The ESP header is
+	 * copied over the IV for the operation. */
+	if (sa->aead) {
+		op->auth_range.offset = st->data_off - _ODP_ESPHDR_LEN;
+		op->auth_range.length = st->data_len + _ODP_ESPHDR_LEN;
+	} else {
+		op->auth_range.offset = st->esp_off;
+		op->auth_range.length = icv_off - st->esp_off;
+	}
+}
+
+static void crypto_op_status(odp_crypto_op_result_t *res, ipsec_state_t *st)
+{
+	if (odp_likely(res->ok))
+		return;
+
+	/* AEAD ciphers report integrity check failures as cipher status */
+	if (res->auth_status.alg_err == ODP_CRYPTO_ALG_ERR_ICV_CHECK ||
+	    res->cipher_status.alg_err == ODP_CRYPTO_ALG_ERR_ICV_CHECK)
+		st->err.bit.auth = 1;
+	else
+		st->err.bit.alg = 1;
+}
+
+/* Run crypto operations of packets without errors */
+static void crypto_burst(odp_packet_t pkt[], ipsec_state_t st[], int num)
+{
+	odp_crypto_op_param_t op[MAX_BURST];
+	odp_crypto_op_result_t res[MAX_BURST];
+	odp_bool_t posted[MAX_BURST];
+	int idx[MAX_BURST];
+	int i, n = 0;
+	int ret;
+
+	for (i = 0; i < num; i++) {
+		if (st[i].err.all)
+			continue;
+
+		crypto_op_init(&op[n], pkt[i], &st[i]);
+		idx[n++] = i;
+	}
+
+	if (n == 0)
+		return;
+
+	ret = odp_crypto_operation_multi(op, posted, res, n);
+	if (ret < 0)
+		ret = 0;
+
+	for (i = 0; i < n; i++) {
+		if (odp_unlikely(i >= ret || posted[i]))
+			st[idx[i]].err.bit.alg = 1;
+		else
+			crypto_op_status(&res[i], &st[idx[i]]);
+	}
+}
+
+/* Check a sequence number against the anti-replay window. Returns non-zero
+ * for a replayed or too old sequence number. Called with the SA lock held. */
+static int antireplay_check(ipsec_sa_t *sa, uint32_t seq)
+{
+	uint64_t bit = 1ULL << (seq & 63);
+	uint64_t word = seq >> 6;
+
+	if (seq == 0)
+		return -1;
+
+	if (seq > sa->top)
+		return 0;
+
+	return (uint64_t)seq + sa->ws <= sa->top ||
+	       (sa->window[word & WINDOW_MASK] & bit);
+}
+
+/* Check a sequence number against the anti-replay window, and mark it
+ * received. Called with the SA lock held. */
+static int antireplay_update(ipsec_sa_t *sa, uint32_t seq)
+{
+	uint64_t bit = 1ULL << (seq & 63);
+	uint64_t word = seq >> 6;
+	uint64_t top_word, i;
+
+	if (antireplay_check(sa, seq))
+		return -1;
+
+	if (seq > sa->top) {
+		/* Move the window forward, clearing skipped words */
+		top_word = sa->top >> 6;
+		if (word - top_word > WINDOW_WORDS)
+			top_word = word - WINDOW_WORDS;
+
+		for (i = top_word + 1; i <= word; i++)
+			sa->window[i & WINDOW_MASK] = 0;
+
+		sa->top = seq;
+	}
+
+	sa->window[word & WINDOW_MASK] |= bit;
+
+	return 0;
+}
+
+static void result_set(odp_packet_t pkt, ipsec_state_t *st)
+{
+	odp_ipsec_generic_result_t *res = &odp_packet_hdr(pkt)->ipsec_result;
+
+	res->magic = IPSEC_RESULT_MAGIC;
+	res->result.error = st->err;
+	res->result.sa  = st->sa ? sa_to_handle(st->sa) : ODP_IPSEC_SA_INVALID;
+	res->result.seq = st->seq;
+}
+
+static ipsec_sa_t *sa_lookup(uint32_t spi)
+{
+	uint32_t slot = spi_hash(spi);
+	uint32_t i, val;
+	ipsec_sa_t *sa;
+
+	for (i = 0; i < SPI_TBL_SIZE; i++, slot++) {
+		val = odp_atomic_load_acq_u32(&global->spi_tbl[slot &
+							       SPI_TBL_MASK]);
+		if (val == SPI_SLOT_FREE)
+			return NULL;
+
+		if (val == SPI_SLOT_DEL)
+			continue;
+
+		sa = &global->sa[val - 1];
+		if (sa->param.spi == spi &&
+		    odp_atomic_load_u32(&sa->state) == SA_STATE_ACTIVE)
+			return sa;
+	}
+
+	return NULL;
+}
+
+/* Encapsulate a packet into ESP. Sequence number and IV are set. Returns the
+ * packet handle, which may change. */
+static odp_packet_t esp_out(odp_packet_t pkt, ipsec_state_t *st)
+{
+	ipsec_sa_t *sa = st->sa;
+	uint8_t ip[IPV4_MAX_HDR_LEN];
+	uint8_t trl[ESP_MAX_PAD_LEN + _ODP_ESPTRL_LEN];
+	_odp_ipv4hdr_t *ipv4 = (_odp_ipv4hdr_t *)(uintptr_t)ip;
+	_odp_esphdr_t esp[2];
+	uint32_t l3_off, len, ip_len, ip_hdr_len, ins_off, hdr_len;
+	uint32_t payload, pad, trl_len, i;
+	uint8_t next_hdr, ecn = 0;
+	uint16_t df = 0;
+	int tunnel = sa->param.mode == ODP_IPSEC_MODE_TUNNEL;
+	int ver;
+
+	l3_off = packet_l3_offset(pkt);
+	len    = odp_packet_len(pkt);
+	st->l3_off = l3_off;
+
+	if (odp_unlikely(l3_off + _ODP_IPV4HDR_LEN > len ||
+			 odp_packet_copy_to_mem(pkt, l3_off, _ODP_IPV4HDR_LEN,
+						ip))) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	ver = ip[0] >> 4;
+
+	if (ver == _ODP_IPV4) {
+		ip_len     = odp_be_to_cpu_16(ipv4->tot_len);
+		ip_hdr_len = _ODP_IPV4HDR_IHL(ipv4->ver_ihl) * 4;
+		next_hdr   = _ODP_IPPROTO_IPIP;
+		ecn        = ipv4->tos & _ODP_IP_TOS_ECN_MASK;
+		df         = odp_be_to_cpu_16(ipv4->frag_offset) & IPV4_DF;
+	} else if (ver == _ODP_IPV6 && tunnel) {
+		ip_len     = _ODP_IPV6HDR_LEN + ((ip[4] << 8) | ip[5]);
+		ip_hdr_len = _ODP_IPV6HDR_LEN;
+		next_hdr   = _ODP_IPPROTO_IPV6;
+		ecn        = (ip[1] >> 4) & _ODP_IP_TOS_ECN_MASK;
+	} else {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	if (odp_unlikely(ip_hdr_len < _ODP_IPV4HDR_LEN ||
+			 ip_len < ip_hdr_len || l3_off + ip_len > len)) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	if (tunnel) {
+		/* Outer IPv4 and ESP headers are inserted before the packet */
+		ins_off = l3_off;
+		hdr_len = _ODP_IPV4HDR_LEN + _ODP_ESPHDR_LEN + sa->iv_len;
+		payload = ip_len;
+		st->esp_off = l3_off + _ODP_IPV4HDR_LEN;
+	} else {
+		/* ESP header is inserted after the IPv4 header. Transport
+		 * mode applies to whole datagrams only. */
+		if (odp_unlikely(_ODP_IPV4HDR_IS_FRAGMENT(
+				 odp_be_to_cpu_16(ipv4->frag_offset)) ||
+				 odp_packet_copy_to_mem(pkt, l3_off,
+							ip_hdr_len, ip))) {
+			st->err.bit.proto = 1;
+			return pkt;
+		}
+
+		next_hdr = ipv4->proto;
+		ins_off  = l3_off + ip_hdr_len;
+		hdr_len  = _ODP_ESPHDR_LEN + sa->iv_len;
+		payload  = ip_len - ip_hdr_len;
+		st->esp_off = ins_off;
+	}
+
+	/* Remove link layer padding after the IP packet */
+	if (l3_off + ip_len < len &&
+	    odp_packet_trunc_tail(&pkt, len - l3_off - ip_len, NULL,
+				  NULL) < 0) {
+		st->err.bit.alloc = 1;
+		return pkt;
+	}
+
+	pad = (0 - (payload + _ODP_ESPTRL_LEN)) & (sa->align - 1);
+	trl_len = pad + _ODP_ESPTRL_LEN + sa->icv_len;
+
+	if (odp_unlikely(odp_packet_extend_tail(&pkt, trl_len, NULL,
+						NULL) < 0)) {
+		st->err.bit.alloc = 1;
+		return pkt;
+	}
+
+	if (odp_unlikely(odp_packet_extend_head(&pkt, hdr_len, NULL,
+						NULL) < 0)) {
+		odp_packet_trunc_tail(&pkt, trl_len, NULL, NULL);
+		st->err.bit.alloc = 1;
+		return pkt;
+	}
+
+	/* Move data before the insertion point to the new packet head */
+	if (ins_off)
+		odp_packet_move_data(pkt, 0, hdr_len, ins_off);
+
+	st->data_off = st->esp_off + _ODP_ESPHDR_LEN + sa->iv_len;
+	st->data_len = payload + pad + _ODP_ESPTRL_LEN;
+
+	/* Default padding and ESP trailer */
+	for (i = 0; i < pad; i++)
+		trl[i] = i + 1;
+
+	trl[pad]     = pad;
+	trl[pad + 1] = next_hdr;
+
+	odp_packet_copy_from_mem(pkt, st->data_off + payload,
+				 pad + _ODP_ESPTRL_LEN, trl);
+
+	/* IPv4 header */
+	if (tunnel) {
+		memcpy(ip, &sa->tun_hdr, _ODP_IPV4HDR_LEN);
+		ip_hdr_len      = _ODP_IPV4HDR_LEN;
+		ipv4->tos      |= ecn;
+		ipv4->id        = odp_cpu_to_be_16(local.ip_id++);
+		ipv4->frag_offset = odp_cpu_to_be_16(df);
+	} else {
+		ipv4->proto = _ODP_IPPROTO_ESP;
+	}
+
+	ipv4->tot_len = odp_cpu_to_be_16(st->data_off + st->data_len +
+					 sa->icv_len - l3_off);
+	ipv4_chksum_set(ip, ip_hdr_len);
+	odp_packet_copy_from_mem(pkt, l3_off, ip_hdr_len, ip);
+
+	/* ESP header. The second copy is the AAD of AEAD ciphers, and it is
+	 * overwritten by the IV after the crypto operation. */
+	esp[0].spi    = odp_cpu_to_be_32(sa->param.spi);
+	esp[0].seq_no = odp_cpu_to_be_32(st->seq);
+	esp[1] = esp[0];
+
+	odp_packet_copy_from_mem(pkt, st->esp_off, sa->aead ?
+				 2 * _ODP_ESPHDR_LEN : _ODP_ESPHDR_LEN, esp);
+
+	if (sa->nonce == NONCE_IV) {
+		if (odp_unlikely(iv_random(st->iv, sa->iv_len))) {
+			st->err.bit.alg = 1;
+			return pkt;
+		}
+	} else if (sa->nonce != NONCE_NONE) {
+		uint64_t ctr = odp_cpu_to_be_64(iv_counter());
+
+		memcpy(st->iv, &ctr, sizeof(ctr));
+	}
+
+	if (!sa->aead)
+		odp_packet_copy_from_mem(pkt, st->esp_off + _ODP_ESPHDR_LEN,
+					 sa->iv_len, st->iv);
+
+	nonce_set(sa, st);
+
+	return pkt;
+}
+
+/* Finish an outbound packet after the crypto operation */
+static void esp_out_finish(odp_packet_t pkt, ipsec_state_t *st)
+{
+	ipsec_sa_t *sa = st->sa;
+
+	if (sa->aead)
+		odp_packet_copy_from_mem(pkt, st->esp_off + _ODP_ESPHDR_LEN,
+					 sa->iv_len, st->iv);
+
+	odp_packet_l3_offset_set(pkt, st->l3_off);
+	odp_packet_l4_offset_set(pkt, st->esp_off);
+	odp_packet_has_ipv4_set(pkt, 1);
+	odp_packet_has_ipv6_set(pkt, 0);
+	odp_packet_has_ipsec_set(pkt, 1);
+}
+
+/* Parse an inbound ESP packet and prepare it for the crypto operation. SA is
+ * looked up when not given. Returns the packet handle, which may change. */
+static odp_packet_t esp_in(odp_packet_t pkt, ipsec_state_t *st,
+			   ipsec_sa_t **sa_prev)
+{
+	_odp_ipv4hdr_t ip;
+	_odp_esphdr_t esp;
+	ipsec_sa_t *sa = st->sa;
+	uint32_t l3_off, len, ip_len, spi;
+
+	if (odp_unlikely(st->err.all))
+		return pkt;
+
+	l3_off = packet_l3_offset(pkt);
+	len    = odp_packet_len(pkt);
+	st->l3_off = l3_off;
+
+	if (odp_unlikely(l3_off + _ODP_IPV4HDR_LEN > len ||
+			 odp_packet_copy_to_mem(pkt, l3_off, _ODP_IPV4HDR_LEN,
+						&ip))) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	ip_len = odp_be_to_cpu_16(ip.tot_len);
+	st->esp_off = l3_off + _ODP_IPV4HDR_IHL(ip.ver_ihl) * 4;
+
+	/* Fragments must be reassembled before IPSEC processing */
+	if (odp_unlikely(_ODP_IPV4HDR_VER(ip.ver_ihl) != _ODP_IPV4 ||
+			 ip.proto != _ODP_IPPROTO_ESP ||
+			 _ODP_IPV4HDR_IS_FRAGMENT(
+				odp_be_to_cpu_16(ip.frag_offset)) ||
+			 _ODP_IPV4HDR_IHL(ip.ver_ihl) < _ODP_IPV4HDR_IHL_MIN ||
+			 l3_off + ip_len > len ||
+			 st->esp_off + _ODP_ESPHDR_LEN > l3_off + ip_len ||
+			 odp_packet_copy_to_mem(pkt, st->esp_off,
+						_ODP_ESPHDR_LEN, &esp))) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	spi     = odp_be_to_cpu_32(esp.spi);
+	st->seq = odp_be_to_cpu_32(esp.seq_no);
+
+	if (sa == NULL) {
+		/* Consecutive packets of an SA are looked up once */
+		sa = *sa_prev;
+		if (sa == NULL || sa->param.spi != spi)
+			sa = sa_lookup(spi);
+
+		if (odp_unlikely(sa == NULL)) {
+			st->err.bit.sa_lookup = 1;
+			return pkt;
+		}
+
+		*sa_prev = sa;
+	}
+
+	st->sa = sa;
+
+	if (odp_unlikely(sa->param.dir != ODP_IPSEC_DIR_INBOUND)) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	/* Replayed and too old packets are dropped before the crypto
+	 * operation (RFC 4303 3.4.3). The window is updated only after the
+	 * ICV check. */
+	if (sa->ws) {
+		int ret;
+
+		odp_spinlock_lock(&sa->lock);
+		ret = antireplay_check(sa, st->seq);
+		odp_spinlock_unlock(&sa->lock);
+
+		if (odp_unlikely(ret)) {
+			st->err.bit.antireplay = 1;
+			return pkt;
+		}
+	}
+
+	/* Remove link layer padding after the IP packet */
+	if (l3_off + ip_len < len &&
+	    odp_packet_trunc_tail(&pkt, len - l3_off - ip_len, NULL,
+				  NULL) < 0) {
+		st->err.bit.alloc = 1;
+		return pkt;
+	}
+
+	st->data_off = st->esp_off + _ODP_ESPHDR_LEN + sa->iv_len;
+
+	if (odp_unlikely(st->data_off + _ODP_ESPTRL_LEN + sa->icv_len >
+			 l3_off + ip_len)) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	st->data_len = l3_off + ip_len - sa->icv_len - st->data_off;
+
+	if (odp_unlikely(st->data_len & (sa->block - 1))) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	if (sa->iv_len)
+		odp_packet_copy_to_mem(pkt, st->esp_off + _ODP_ESPHDR_LEN,
+				       sa->iv_len, st->iv);
+
+	if (sa->aead) {
+		odp_packet_copy_from_mem(pkt, st->data_off - _ODP_ESPHDR_LEN,
+					 _ODP_ESPHDR_LEN, &esp);
+		st->iv_saved = 1;
+	}
+
+	nonce_set(sa, st);
+
+	return pkt;
+}
+
+/* Decapsulate an inbound packet after the crypto operation. Returns the
+ * packet handle, which may change. */
+static odp_packet_t esp_in_finish(odp_packet_t pkt, ipsec_state_t *st)
+{
+	ipsec_sa_t *sa = st->sa;
+	uint8_t trl[ESP_MAX_PAD_LEN + _ODP_ESPTRL_LEN];
+	uint8_t ip[IPV4_MAX_HDR_LEN];
+	_odp_ipv4hdr_t *ipv4 = (_odp_ipv4hdr_t *)(uintptr_t)ip;
+	uint32_t pad, next_hdr, hdr_len, trl_len, ins_off, ip_hdr_len, i;
+	uint32_t l3_off = st->l3_off;
+	int ret;
+
+	/* Restore the IV, in case the packet is returned with an error */
+	if (st->iv_saved)
+		odp_packet_copy_from_mem(pkt, st->data_off - sa->iv_len,
+					 sa->iv_len, st->iv);
+
+	if (odp_unlikely(st->err.all))
+		return pkt;
+
+	if (sa->ws) {
+		odp_spinlock_lock(&sa->lock);
+		ret = antireplay_update(sa, st->seq);
+		odp_spinlock_unlock(&sa->lock);
+
+		if (odp_unlikely(ret)) {
+			st->err.bit.antireplay = 1;
+			return pkt;
+		}
+	}
+
+	odp_packet_copy_to_mem(pkt, st->data_off + st->data_len -
+			       _ODP_ESPTRL_LEN, _ODP_ESPTRL_LEN, trl);
+	pad      = trl[0];
+	next_hdr = trl[1];
+
+	if (odp_unlikely(pad + _ODP_ESPTRL_LEN > st->data_len)) {
+		st->err.bit.proto = 1;
+		return pkt;
+	}
+
+	/* Check default padding */
+	odp_packet_copy_to_mem(pkt, st->data_off + st->data_len -
+			       _ODP_ESPTRL_LEN - pad, pad, trl);
+
+	for (i = 0; i < pad; i++) {
+		if (odp_unlikely(trl[i] != i + 1)) {
+			st->err.bit.proto = 1;
+			return pkt;
+		}
+	}
+
+	trl_len = pad + _ODP_ESPTRL_LEN + sa->icv_len;
+
+	if (sa->param.mode == ODP_IPSEC_MODE_TUNNEL) {
+		if (odp_unlikely(next_hdr != _ODP_IPPROTO_IPIP &&
+				 next_hdr != _ODP_IPPROTO_IPV6)) {
+			st->err.bit.proto = 1;
+			return pkt;
+		}
+
+		/* Outer IPv4 header, ESP header and IV are removed */
+		hdr_len = st->data_off - l3_off;
+		ins_off = l3_off;
+	} else {
+		/* ESP header and IV are removed after the IPv4 header */
+		hdr_len = st->data_off - st->esp_off;
+		ins_off = st->esp_off;
+		ip_hdr_len = st->esp_off - l3_off;
+		odp_packet_copy_to_mem(pkt, l3_off, ip_hdr_len, ip);
+		ipv4->proto   = next_hdr;
+		ipv4->tot_len = odp_cpu_to_be_16(st->data_off + st->data_len -
+						 pad - _ODP_ESPTRL_LEN -
+						 hdr_len - l3_off);
+		ipv4_chksum_set(ip, ip_hdr_len);
+		odp_packet_copy_from_mem(pkt, l3_off, ip_hdr_len, ip);
+	}
+
+	/* Move data before the removed headers next to the payload */
+	if (ins_off)
+		odp_packet_move_data(pkt, hdr_len, 0, ins_off);
+
+	if (odp_unlikely(odp_packet_trunc_tail(&pkt, trl_len, NULL, NULL) < 0) ||
+	    odp_unlikely(odp_packet_trunc_head(&pkt, hdr_len, NULL, NULL) < 0)) {
+		st->err.bit.alloc = 1;
+		return pkt;
+	}
+
+	odp_packet_copy_to_mem(pkt, l3_off, 1, ip);
+	ip_hdr_len = (ip[0] >> 4) == _ODP_IPV4 ? (ip[0] & 0xf) * 4 :
+		     _ODP_IPV6HDR_LEN;
+
+	odp_packet_l3_offset_set(pkt, l3_off);
+	odp_packet_l4_offset_set(pkt, l3_off + ip_hdr_len);
+	odp_packet_has_ipv4_set(pkt, (ip[0] >> 4) == _ODP_IPV4);
+	odp_packet_has_ipv6_set(pkt, (ip[0] >> 4) == _ODP_IPV6);
+	odp_packet_has_ipsec_set(pkt, 0);
+
+	return pkt;
+}
+
+/* Set SA of each packet from operation parameters */
+static int state_init(ipsec_state_t st[], int num, int first, int num_sa,
+		      const odp_ipsec_sa_t sa_tbl[])
+{
+	odp_ipsec_sa_t sa;
+	int i;
+
+	memset(st, 0, num * sizeof(ipsec_state_t));
+
+	if (num_sa == 0)
+		return 0;
+
+	for (i = 0; i < num; i++) {
+		sa = num_sa == 1 ? sa_tbl[0] : sa_tbl[first + i];
+
+		if (odp_unlikely(sa == ODP_IPSEC_SA_INVALID))
+			st[i].err.bit.sa_lookup = 1;
+		else
+			st[i].sa = sa_from_handle(sa);
+	}
+
+	return 0;
+}
+
+static void ipsec_in_burst(odp_packet_t pkt[], ipsec_state_t st[], int num)
+{
+	ipsec_sa_t *sa_prev = NULL;
+	int i;
+
+	for (i = 0; i < num; i++)
+		pkt[i] = esp_in(pkt[i], &st[i], &sa_prev);
+
+	crypto_burst(pkt, st, num);
+
+	for (i = 0; i < num; i++) {
+		pkt[i] = esp_in_finish(pkt[i], &st[i]);
+		result_set(pkt[i], &st[i]);
+	}
+}
+
+static void ipsec_out_burst(odp_packet_t pkt[], ipsec_state_t st[], int num)
+{
+	ipsec_sa_t *sa;
+	uint64_t seq;
+	int i, j;
+
+	for (i = 0; i < num; i = j) {
+		sa = st[i].sa;
+
+		for (j = i + 1; j < num && st[j].sa == sa; j++)
+			;
+
+		if (odp_unlikely(sa == NULL ||
+				 sa->param.dir != ODP_IPSEC_DIR_OUTBOUND)) {
+			for (; i < j; i++) {
+				if (st[i].err.all == 0)
+					st[i].err.bit.proto = 1;
+			}
+			continue;
+		}
+
+		/* Sequence numbers of consecutive packets of an SA are
+		 * reserved at once */
+		seq = odp_atomic_fetch_add_u64(&sa->seq, j - i);
+
+		for (; i < j; i++) {
+			seq++;
+
+			if (odp_unlikely(seq > UINT32_MAX)) {
+				st[i].err.bit.seq = 1;
+				continue;
+			}
+
+			st[i].seq = seq;
+			pkt[i] = esp_out(pkt[i], &st[i]);
+		}
+	}
+
+	crypto_burst(pkt, st, num);
+
+	for (i = 0; i < num; i++) {
+		if (odp_likely(st[i].err.all == 0))
+			esp_out_finish(pkt[i], &st[i]);
+
+		result_set(pkt[i], &st[i]);
+	}
+}
+
+static int ipsec_process(const odp_packet_t pkt_in[], int num_in,
+			 odp_packet_t pkt_out[], int *num_out, int num_sa,
+			 const odp_ipsec_sa_t sa_tbl[], odp_bool_t inbound)
+{
+	ipsec_state_t st[MAX_BURST];
+	int num = num_in;
+	int i, n;
+
+	if (num > *num_out)
+		num = *num_out;
+
+	if (odp_unlikely(num < 0 || (num_sa != 1 && num_sa != num_in &&
+				     !(inbound && num_sa == 0)))) {
+		ODP_ERR("Bad number of SAs: %i\n", num_sa);
+		return -1;
+	}
+
+	local_check();
+
+	for (i = 0; i < num; i += n) {
+		n = num - i;
+		if (n > MAX_BURST)
+			n = MAX_BURST;
+
+		memcpy(&pkt_out[i], &pkt_in[i], n * sizeof(odp_packet_t));
+		state_init(st, n, i, num_sa, sa_tbl);
+
+		if (inbound)
+			ipsec_in_burst(&pkt_out[i], st, n);
+		else
+			ipsec_out_burst(&pkt_out[i], st, n);
+	}
+
+	*num_out = num;
+
+	return num;
+}
+
+/* Enqueue results as events. Packets of the same destination queue are
+ * enqueued together. */
+static void ipsec_result_enq(odp_packet_t pkt[], int num)
+{
+	odp_event_t ev[MAX_BURST];
+	odp_ipsec_packet_result_t res;
+	odp_queue_t queue[MAX_BURST];
+	int i, j, k, ret;
+
+	for (i = 0; i < num; i++) {
+		odp_ipsec_result(&res, pkt[i]);
+
+		if (res.sa != ODP_IPSEC_SA_INVALID)
+			queue[i] = sa_from_handle(res.sa)->param.dest_queue;
+		else
+			queue[i] = global->config.inbound_default_queue;
+
+		ev[i] = odp_packet_to_event(pkt[i]);
+		_odp_buffer_event_type_set(odp_buffer_from_event(ev[i]),
+					   ODP_EVENT_IPSEC_RESULT);
+	}
+
+	for (i = 0; i < num; i = j) {
+		for (j = i + 1; j < num && queue[j] == queue[i]; j++)
+			;
+
+		k = i;
+
+		if (queue[i] != ODP_QUEUE_INVALID) {
+			while (k < j) {
+				ret = odp_queue_enq_multi(queue[i], &ev[k],
+							  j - k);
+				if (ret <= 0)
+					break;
+
+				k += ret;
+			}
+		}
+
+		/* Drop what could not be delivered */
+		for (; k < j; k++)
+			odp_event_free(ev[k]);
+	}
+}
+
+static int ipsec_process_enq(const odp_packet_t pkt_in[], int num_in,
+			     int num_sa, const odp_ipsec_sa_t sa_tbl[],
+			     odp_bool_t inbound)
+{
+	odp_packet_t pkt[MAX_BURST];
+	const odp_ipsec_sa_t *sa = sa_tbl;
+	int i, n, ret;
+
+	if (odp_unlikely(num_sa != 1 && num_sa != num_in &&
+			 !(inbound && num_sa == 0))) {
+		ODP_ERR("Bad number of SAs: %i\n", num_sa);
+		return -1;
+	}
+
+	for (i = 0; i < num_in; i += n) {
+		n = num_in - i;
+		if (n > MAX_BURST)
+			n = MAX_BURST;
+
+		if (num_sa > 1)
+			sa = &sa_tbl[i];
+
+		ret = ipsec_process(&pkt_in[i], n, pkt, &n,
+				    num_sa > 1 ? n : num_sa, sa, inbound);
+		if (odp_unlikely(ret < 0))
+			return i ? i : ret;
+
+		ipsec_result_enq(pkt, n);
+	}
+
+	return num_in;
+}
+
+static int sa_alg_set(ipsec_sa_t *sa, const odp_ipsec_sa_param_t *param,
+		      odp_crypto_session_param_t *crypto)
+{
+	odp_crypto_key_t *salted = NULL;
+
+	crypto->cipher_alg = param->crypto.cipher_alg;
+	crypto->cipher_key = param->crypto.cipher_key;
+	crypto->auth_alg   = param->crypto.auth_alg;
+	crypto->auth_key   = param->crypto.auth_key;
+
+	sa->block = 1;
+
+	switch (param->crypto.cipher_alg) {
+	case ODP_CIPHER_ALG_NULL:
+		break;
+	case ODP_CIPHER_ALG_3DES_CBC:
+		sa->iv_len = 8;
+		sa->block  = 8;
+		sa->nonce  = NONCE_IV;
+		break;
+	case ODP_CIPHER_ALG_AES_CBC:
+	case ODP_CIPHER_ALG_AES128_CBC:
+		sa->iv_len = 16;
+		sa->block  = 16;
+		sa->nonce  = NONCE_IV;
+		break;
+	case ODP_CIPHER_ALG_AES_CTR:
+		sa->iv_len = 8;
+		sa->nonce  = NONCE_CTR;
+		salted = &crypto->cipher_key;
+		break;
+	case ODP_CIPHER_ALG_AES_GCM:
+	case ODP_CIPHER_ALG_AES128_GCM:
+	case ODP_CIPHER_ALG_CHACHA20_POLY1305:
+		sa->iv_len  = 8;
+		sa->icv_len = 16;
+		sa->nonce   = NONCE_SALT;
+		sa->aead    = 1;
+		salted = &crypto->cipher_key;
+		break;
+	default:
+		return -1;
+	}
+
+	switch (param->crypto.auth_alg) {
+	case ODP_AUTH_ALG_NULL:
+		break;
+	case ODP_AUTH_ALG_MD5_HMAC:
+	case ODP_AUTH_ALG_MD5_96:
+	case ODP_AUTH_ALG_SHA1_HMAC:
+		sa->icv_len = 12;
+		break;
+	case ODP_AUTH_ALG_SHA256_HMAC:
+	case ODP_AUTH_ALG_SHA256_128:
+		sa->icv_len = 16;
+		break;
+	case ODP_AUTH_ALG_SHA384_HMAC:
+		sa->icv_len = 24;
+		break;
+	case ODP_AUTH_ALG_SHA512_HMAC:
+		sa->icv_len = 32;
+		break;
+	case ODP_AUTH_ALG_AES_GCM:
+	case ODP_AUTH_ALG_AES128_GCM:
+	case ODP_AUTH_ALG_CHACHA20_POLY1305:
+		if (!sa->aead)
+			return -1;
+		break;
+	case ODP_AUTH_ALG_AES_GMAC:
+		if (param->crypto.cipher_alg != ODP_CIPHER_ALG_NULL)
+			return -1;
+
+		sa->iv_len  = 8;
+		sa->icv_len = 16;
+		sa->nonce   = NONCE_SALT;
+		salted = &crypto->auth_key;
+		break;
+	default:
+		return -1;
+	}
+
+	/* AEAD cipher must be paired with its own authentication */
+	if (sa->aead && crypto->auth_alg == ODP_AUTH_ALG_NULL)
+		return -1;
+
+	/* Salt is the last four bytes of the key */
+	if (salted) {
+		if (salted->data == NULL || salted->length <= SALT_LEN)
+			return -1;
+
+		salted->length -= SALT_LEN;
+		memcpy(sa->salt, salted->data + salted->length, SALT_LEN);
+	}
+
+	if (sa->nonce == NONCE_IV)
+		crypto->iv.length = sa->iv_len;
+	else if (sa->nonce == NONCE_CTR)
+		crypto->iv.length = 16;
+	else if (sa->nonce == NONCE_SALT)
+		crypto->iv.length = SALT_LEN + sa->iv_len;
+
+	sa->align = sa->block > 4 ? sa->block : 4;
+
+	return 0;
+}
+
+static void sa_tunnel_init(ipsec_sa_t *sa)
+{
+	const odp_ipsec_tunnel_param_t *tun = &sa->param.tunnel;
+	_odp_ipv4hdr_t *ip = &sa->tun_hdr;
+
+	ip->ver_ihl  = (_ODP_IPV4 << 4) | _ODP_IPV4HDR_IHL_MIN;
+	ip->tos      = tun->dscp << 2;
+	ip->ttl      = tun->ttl;
+	ip->proto    = _ODP_IPPROTO_ESP;
+	ip->src_addr = tun->src_addr;
+	ip->dst_addr = tun->dst_addr;
+}
+
+static int spi_insert(ipsec_sa_t *sa)
+{
+	uint32_t slot = spi_hash(sa->param.spi);
+	uint32_t i, val;
+
+	for (i = 0; i < SPI_TBL_SIZE; i++, slot++) {
+		val = odp_atomic_load_u32(&global->spi_tbl[slot &
+							  SPI_TBL_MASK]);
+		if (val == SPI_SLOT_FREE || val == SPI_SLOT_DEL) {
+			odp_atomic_store_rel_u32(&global->spi_tbl[slot &
+								  SPI_TBL_MASK],
+						 sa->index + 1);
+			return 0;
+		}
+	}
+
+	return -1;
+}
+
+static void spi_remove(ipsec_sa_t *sa)
+{
+	uint32_t slot = spi_hash(sa->param.spi);
+	uint32_t i, val;
+
+	for (i = 0; i < SPI_TBL_SIZE; i++, slot++) {
+		if (odp_atomic_load_u32(&global->spi_tbl[slot &
+							 SPI_TBL_MASK]) !=
+		    sa->index + 1)
+			continue;
+
+		/* Last slot of a probe sequence can be freed, otherwise
+		 * lookups must continue past the slot */
+		val = odp_atomic_load_u32(&global->spi_tbl[(slot + 1) &
+							   SPI_TBL_MASK]);
+		odp_atomic_store_rel_u32(&global->spi_tbl[slot & SPI_TBL_MASK],
+					 val == SPI_SLOT_FREE ? SPI_SLOT_FREE :
+					 SPI_SLOT_DEL);
+		return;
+	}
+}
+
+int odp_ipsec_capability(odp_ipsec_capability_t *capa)
+{
+	odp_crypto_capability_t crypto;
+
+	memset(capa, 0, sizeof(odp_ipsec_capability_t));
+
+	if (odp_crypto_capability(&crypto))
+		return -1;
+
+	capa->max_num_sa        = global->max_num_sa;
+	capa->max_antireplay_ws = MAX_ANTIREPLAY_WS;
+
+	capa->ciphers.bit.null              = crypto.ciphers.bit.null;
+	capa->ciphers.bit.trides_cbc        = crypto.ciphers.bit.trides_cbc;
+	capa->ciphers.bit.aes_cbc           = crypto.ciphers.bit.aes_cbc;
+	capa->ciphers.bit.aes_ctr           = crypto.ciphers.bit.aes_ctr;
+	capa->ciphers.bit.aes_gcm           = crypto.ciphers.bit.aes_gcm;
+	capa->ciphers.bit.chacha20_poly1305 =
+		crypto.ciphers.bit.chacha20_poly1305;
+
+	capa->auths.bit.null              = crypto.auths.bit.null;
+	capa->auths.bit.md5_hmac          = crypto.auths.bit.md5_hmac;
+	capa->auths.bit.sha1_hmac         = crypto.auths.bit.sha1_hmac;
+	capa->auths.bit.sha256_hmac       = crypto.auths.bit.sha256_hmac;
+	capa->auths.bit.sha384_hmac       = crypto.auths.bit.sha384_hmac;
+	capa->auths.bit.sha512_hmac       = crypto.auths.bit.sha512_hmac;
+	capa->auths.bit.aes_gcm           = crypto.auths.bit.aes_gcm;
+	capa->auths.bit.aes_gmac          = crypto.auths.bit.aes_gmac;
+	capa->auths.bit.chacha20_poly1305 = crypto.auths.bit.chacha20_poly1305;
+
+	return 0;
+}
+
+void odp_ipsec_config_init(odp_ipsec_config_t *config)
+{
+	memset(config, 0, sizeof(odp_ipsec_config_t));
+	config->inbound_default_queue = ODP_QUEUE_INVALID;
+}
+
+int odp_ipsec_config(const odp_ipsec_config_t *config)
+{
+	global->config = *config;
+
+	return 0;
+}
+
+void odp_ipsec_sa_param_init(odp_ipsec_sa_param_t *param)
+{
+	memset(param, 0, sizeof(odp_ipsec_sa_param_t));
+	param->tunnel.ttl    = IPV4_DEFAULT_TTL;
+	param->lookup        = 1;
+	param->antireplay_ws = 64;
+	param->dest_queue    = ODP_QUEUE_INVALID;
+}
+
+odp_ipsec_sa_t odp_ipsec_sa_create(const odp_ipsec_sa_param_t *param)
+{
+	odp_crypto_session_param_t crypto;
+	odp_crypto_ses_create_err_t status;
+	ipsec_sa_t *sa = NULL;
+	int inbound = param->dir == ODP_IPSEC_DIR_INBOUND;
+	uint32_t i;
+
+	if (param->proto != ODP_IPSEC_ESP ||
+	    param->antireplay_ws > MAX_ANTIREPLAY_WS) {
+		ODP_ERR("Bad SA parameters\n");
+		return ODP_IPSEC_SA_INVALID;
+	}
+
+	odp_spinlock_lock(&global->lock);
+
+	if (inbound && param->lookup && sa_lookup(param->spi)) {
+		ODP_ERR("SPI %" PRIu32 " already in use\n", param->spi);
+		goto error;
+	}
+
+	for (i = 0; i < global->max_num_sa; i++) {
+		if (odp_atomic_load_u32(&global->sa[i].state) ==
+		    SA_STATE_FREE) {
+			sa = &global->sa[i];
+			break;
+		}
+	}
+
+	if (sa == NULL) {
+		ODP_ERR("Out of SAs\n");
+		goto error;
+	}
+
+	memset(&sa->param, 0, offsetof(ipsec_sa_t, lock) -
+	       offsetof(ipsec_sa_t, param));
+	memset(sa->window, 0, sizeof(sa->window));
+	sa->param = *param;
+	sa->param.crypto.cipher_key.data = NULL;
+	sa->param.crypto.auth_key.data   = NULL;
+	sa->ws  = inbound ? param->antireplay_ws : 0;
+	sa->top = 0;
+	odp_atomic_init_u64(&sa->seq, 0);
+
+	odp_crypto_session_param_init(&crypto);
+
+	if (sa_alg_set(sa, param, &crypto)) {
+		ODP_ERR("Bad SA algorithms\n");
+		goto error;
+	}
+
+	crypto.op = inbound ? ODP_CRYPTO_OP_DECODE : ODP_CRYPTO_OP_ENCODE;
+	crypto.auth_cipher_text = 1;
+	crypto.pref_mode   = ODP_CRYPTO_SYNC;
+	crypto.compl_queue = ODP_QUEUE_INVALID;
+	crypto.output_pool = ODP_POOL_INVALID;
+
+	if (odp_crypto_session_create(&crypto, &sa->session, &status)) {
+		ODP_ERR("Crypto session create failed: %i\n", status);
+		goto error;
+	}
+
+	if (param->mode == ODP_IPSEC_MODE_TUNNEL && !inbound)
+		sa_tunnel_init(sa);
+
+	odp_atomic_store_rel_u32(&sa->state, SA_STATE_ACTIVE);
+
+	if (inbound && param->lookup && spi_insert(sa)) {
+		odp_atomic_store_u32(&sa->state, SA_STATE_FREE);
+		odp_crypto_session_destroy(sa->session);
+		goto error;
+	}
+
+	odp_spinlock_unlock(&global->lock);
+
+	return sa_to_handle(sa);
+
+error:
+	odp_spinlock_unlock(&global->lock);
+	return ODP_IPSEC_SA_INVALID;
+}
+
+int odp_ipsec_sa_destroy(odp_ipsec_sa_t sa_hdl)
+{
+	ipsec_sa_t *sa;
+	int ret;
+
+	if (sa_hdl == ODP_IPSEC_SA_INVALID)
+		return -1;
+
+	sa = sa_from_handle(sa_hdl);
+
+	odp_spinlock_lock(&global->lock);
+
+	if (odp_atomic_load_u32(&sa->state) != SA_STATE_ACTIVE) {
+		odp_spinlock_unlock(&global->lock);
+		return -1;
+	}
+
+	if (sa->param.dir == ODP_IPSEC_DIR_INBOUND && sa->param.lookup)
+		spi_remove(sa);
+
+	ret = odp_crypto_session_destroy(sa->session);
+	odp_atomic_store_rel_u32(&sa->state, SA_STATE_FREE);
+
+	odp_spinlock_unlock(&global->lock);
+
+	return ret;
+}
+
+void *odp_ipsec_sa_context(odp_ipsec_sa_t sa)
+{
+	return sa_from_handle(sa)->param.context;
+}
+
+uint64_t odp_ipsec_sa_to_u64(odp_ipsec_sa_t sa)
+{
+	return _odp_pri(sa);
+}
+
+int odp_ipsec_in(const odp_packet_t pkt_in[], int num_in,
+		 odp_packet_t pkt_out[], int *num_out,
+		 const odp_ipsec_in_param_t *param)
+{
+	return ipsec_process(pkt_in, num_in, pkt_out, num_out, param->num_sa,
+			     param->sa, 1);
+}
+
+int odp_ipsec_out(const odp_packet_t pkt_in[], int num_in,
+		  odp_packet_t pkt_out[], int *num_out,
+		  const odp_ipsec_out_param_t *param)
+{
+	return ipsec_process(pkt_in, num_in, pkt_out, num_out, param->num_sa,
+			     param->sa, 0);
+}
+
+int odp_ipsec_in_enq(const odp_packet_t pkt[], int num,
+		     const odp_ipsec_in_param_t *param)
+{
+	return ipsec_process_enq(pkt, num, param->num_sa, param->sa, 1);
+}
+
+int odp_ipsec_out_enq(const odp_packet_t pkt[], int num,
+		      const odp_ipsec_out_param_t *param)
+{
+	return ipsec_process_enq(pkt, num, param->num_sa, param->sa, 0);
+}
+
+int odp_ipsec_result(odp_ipsec_packet_result_t *result, odp_packet_t pkt)
+{
+	odp_ipsec_generic_result_t *res = &odp_packet_hdr(pkt)->ipsec_result;
+
+	if (res->magic != IPSEC_RESULT_MAGIC)
+		return -1;
+
+	*result = res->result;
+
+	return 0;
+}
+
+odp_packet_t odp_ipsec_packet_from_event(odp_event_t ev)
+{
+	_odp_buffer_event_type_set(odp_buffer_from_event(ev),
+				   ODP_EVENT_PACKET);
+
+	return odp_packet_from_event(ev);
+}
+
+int odp_ipsec_init_global(void)
+{
+	odp_crypto_capability_t crypto;
+	odp_shm_t shm;
+	uint64_t iv_block;
+	uint32_t i;
+
+	shm = odp_shm_reserve("_odp_ipsec", sizeof(ipsec_global_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+
+	global = odp_shm_addr(shm);
+	if (global == NULL) {
+		ODP_ERR("IPSEC shm reserve failed\n");
+		return -1;
+	}
+
+	memset(global, 0, sizeof(ipsec_global_t));
+	odp_spinlock_init(&global->lock);
+	odp_ipsec_config_init(&global->config);
+
+	/* Each SA uses a crypto session */
+	global->max_num_sa = CONFIG_IPSEC_MAX_NUM_SA;
+	if (odp_crypto_capability(&crypto) == 0 &&
+	    crypto.max_sessions < global->max_num_sa)
+		global->max_num_sa = crypto.max_sessions;
+
+	for (i = 0; i < CONFIG_IPSEC_MAX_NUM_SA; i++) {
+		global->sa[i].index = i;
+		odp_atomic_init_u32(&global->sa[i].state, SA_STATE_FREE);
+		odp_spinlock_init(&global->sa[i].lock);
+	}
+
+	for (i = 0; i < SPI_TBL_SIZE; i++)
+		odp_atomic_init_u32(&global->spi_tbl[i], SPI_SLOT_FREE);
+
+	/* Counter based IVs must not repeat over restarts with the same
+	 * keys. Counter blocks start from a random point. */
+	iv_block = 0;
+	if (odp_random_data((uint8_t *)&iv_block, sizeof(iv_block),
+			    ODP_RANDOM_CRYPTO) != sizeof(iv_block)) {
+		ODP_ERR("IPSEC random data failed\n");
+		odp_shm_free(shm);
+		return -1;
+	}
+
+	odp_atomic_init_u64(&global->iv_block, iv_block >> IV_BLOCK_BITS);
+
+	return 0;
+}
+
+int odp_ipsec_term_global(void)
+{
+	int rc = 0;
+	uint32_t i;
+
+	for (i = 0; i < CONFIG_IPSEC_MAX_NUM_SA; i++) {
+		if (odp_atomic_load_u32(&global->sa[i].state) ==
+		    SA_STATE_ACTIVE) {
+			ODP_ERR("IPSEC SA still active\n");
+			rc = -1;
+			break;
+		}
+	}
+
+	if (odp_shm_free(odp_shm_lookup("_odp_ipsec")) < 0) {
+		ODP_ERR("shm free failed for _odp_ipsec\n");
+		rc = -1;
+	}
+
+	return rc;
+}
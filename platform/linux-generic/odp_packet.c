@@ -1183,11 +1183,33 @@ void *odp_packet_offset(odp_packet_t pkt, uint32_t offset, uint32_t *len,
 	return addr;
 }
 
-/* This function is a no-op */
-void odp_packet_prefetch(odp_packet_t pkt ODP_UNUSED,
-			 uint32_t offset ODP_UNUSED,
-			 uint32_t len ODP_UNUSED)
+void odp_packet_prefetch(odp_packet_t pkt, uint32_t offset, uint32_t len)
 {
+	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
+	uint32_t seg_len = 0;
+	uintptr_t addr, end;
+
+	if (odp_unlikely(offset >= pkt_hdr->frame_len))
+		return;
+
+	if (len > pkt_hdr->frame_len - offset)
+		len = pkt_hdr->frame_len - offset;
+
+	while (len) {
+		addr = (uintptr_t)packet_map(pkt_hdr, offset, &seg_len, NULL);
+
+		if (seg_len > len)
+			seg_len = len;
+
+		end = addr + seg_len;
+		addr = addr & ~((uintptr_t)ODP_CACHE_LINE_SIZE - 1);
+
+		for (; addr < end; addr += ODP_CACHE_LINE_SIZE)
+			odp_prefetch((void *)addr);
+
+		offset += seg_len;
+		len    -= seg_len;
+	}
 }
 
 /*
@@ -1324,6 +1346,40 @@ int odp_packet_l4_offset_set(odp_packet_t pkt, uint32_t offset)
 	return 0;
 }
 
+void odp_packet_l3_chksum_insert(odp_packet_t pkt, int insert)
+{
+	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
+
+	pkt_hdr->p.output_flags.l3_chksum_set = 1;
+	pkt_hdr->p.output_flags.l3_chksum = !!insert;
+}
+
+void odp_packet_l4_chksum_insert(odp_packet_t pkt, int insert)
+{
+	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
+
+	pkt_hdr->p.output_flags.l4_chksum_set = 1;
+	pkt_hdr->p.output_flags.l4_chksum = !!insert;
+}
+
+void odp_packet_gso_size_set(odp_packet_t pkt, uint32_t size)
+{
+	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
+
+	/* IP length limits segment size */
+	if (size > UINT16_MAX)
+		size = UINT16_MAX;
+
+	pkt_hdr->p.output_flags.gso_size = size;
+}
+
+uint32_t odp_packet_gso_size(odp_packet_t pkt)
+{
+	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
+
+	return pkt_hdr->p.output_flags.gso_size;
+}
+
 uint32_t odp_packet_flow_hash(odp_packet_t pkt)
 {
 	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
@@ -1732,6 +1788,77 @@ int odp_packet_move_data(odp_packet_t pkt, uint32_t dst_offset,
 					pkt, src_offset, len);
 }
 
+/*
+ *
+ * Packet vectors
+ * ********************************************************
+ *
+ */
+
+odp_packet_vector_t odp_packet_vector_from_event(odp_event_t ev)
+{
+	return (odp_packet_vector_t)ev;
+}
+
+odp_event_t odp_packet_vector_to_event(odp_packet_vector_t pktv)
+{
+	return (odp_event_t)pktv;
+}
+
+odp_packet_vector_t odp_packet_vector_alloc(odp_pool_t pool_hdl)
+{
+	pool_t *pool = pool_entry_from_hdl(pool_hdl);
+	odp_buffer_t buf;
+	odp_buffer_hdr_t *buf_hdr;
+
+	if (odp_unlikely(pool->params.type != ODP_POOL_PACKET_VECTOR)) {
+		__odp_errno = EINVAL;
+		return ODP_PACKET_VECTOR_INVALID;
+	}
+
+	if (odp_unlikely(buffer_alloc_multi(pool, &buf, &buf_hdr, 1) != 1))
+		return ODP_PACKET_VECTOR_INVALID;
+
+	((odp_packet_vector_hdr_t *)(void *)buf_hdr)->size = 0;
+
+	return (odp_packet_vector_t)buf;
+}
+
+void odp_packet_vector_free(odp_packet_vector_t pktv)
+{
+	buffer_free_multi((odp_buffer_t *)&pktv, 1);
+}
+
+uint32_t odp_packet_vector_tbl(odp_packet_vector_t pktv,
+			       odp_packet_t **pkt_tbl)
+{
+	odp_packet_vector_hdr_t *vec_hdr = odp_packet_vector_hdr(pktv);
+
+	*pkt_tbl = packet_vector_tbl(vec_hdr);
+
+	return vec_hdr->size;
+}
+
+uint32_t odp_packet_vector_size(odp_packet_vector_t pktv)
+{
+	return odp_packet_vector_hdr(pktv)->size;
+}
+
+void odp_packet_vector_size_set(odp_packet_vector_t pktv, uint32_t size)
+{
+	odp_packet_vector_hdr(pktv)->size = size;
+}
+
+odp_pool_t odp_packet_vector_pool(odp_packet_vector_t pktv)
+{
+	return odp_packet_vector_hdr(pktv)->buf_hdr.pool_hdl;
+}
+
+uint64_t odp_packet_vector_to_u64(odp_packet_vector_t hdl)
+{
+	return _odp_pri(hdl);
+}
+
 /*
  *
  * Debugging
@@ -50,7 +50,7 @@ static inline pktio_entry_t *pktio_entry_by_index(int index)
 int odp_pktio_init_global(void)
 {
 	pktio_entry_t *pktio_entry;
-	int i;
+	int i, j;
 	odp_shm_t shm;
 	int pktio_if;
 
@@ -71,9 +71,15 @@ int odp_pktio_init_global(void)
 
 		odp_ticketlock_init(&pktio_entry->s.rxl);
 		odp_ticketlock_init(&pktio_entry->s.txl);
+		odp_ticketlock_init(&pktio_entry->s.sw_hash_lock);
 		odp_spinlock_init(&pktio_entry->s.cls.l2_cos_table.lock);
 		odp_spinlock_init(&pktio_entry->s.cls.l3_cos_table.lock);
 
+		for (j = 0; j < PKTIO_MAX_QUEUES; j++) {
+			odp_spinlock_init(&pktio_entry->s.gro.queue[j].lock);
+			odp_spinlock_init(&pktio_entry->s.gso.queue[j].lock);
+		}
+
 		pktio_entry_ptr[i] = pktio_entry;
 	}
 
@@ -205,6 +211,12 @@ static odp_pktio_t setup_pktio_entry(const char *name, odp_pool_t pool,
 	pktio_entry->s.pool = pool;
 	memcpy(&pktio_entry->s.param, param, sizeof(odp_pktio_param_t));
 	pktio_entry->s.handle = hdl;
+	odp_pktio_config_init(&pktio_entry->s.config);
+	pktio_entry->s.gso_sw.all_bits = 0;
+	pktio_gro_config(pktio_entry, &pktio_entry->s.config);
+	odp_atomic_init_u64(&pktio_entry->s.gro.pkts, 0);
+	odp_atomic_init_u64(&pktio_entry->s.gro.segs, 0);
+	odp_atomic_init_u64(&pktio_entry->s.gso.discards, 0);
 
 	for (pktio_if = 0; pktio_if_ops[pktio_if]; ++pktio_if) {
 		ret = pktio_if_ops[pktio_if]->open(hdl, pktio_entry, name,
@@ -295,12 +307,28 @@ static int _pktio_close(pktio_entry_t *entry)
 	return 0;
 }
 
+/* Free packets spread into a direct input queue and not received */
+static void spread_queue_flush(odp_queue_t queue)
+{
+	odp_buffer_hdr_t *hdr_tbl[QUEUE_MULTI_MAX];
+	queue_entry_t *qentry = queue_to_qentry(queue);
+	int i, num;
+
+	while ((num = queue_deq_multi(qentry, hdr_tbl, QUEUE_MULTI_MAX)) > 0)
+		for (i = 0; i < num; i++)
+			odp_packet_free(_odp_packet_from_buffer(
+						hdr_tbl[i]->handle.handle));
+}
+
 static void destroy_in_queues(pktio_entry_t *entry, int num)
 {
 	int i;
 
 	for (i = 0; i < num; i++) {
 		if (entry->s.in_queue[i].queue != ODP_QUEUE_INVALID) {
+			if (entry->s.param.in_mode == ODP_PKTIN_MODE_DIRECT)
+				spread_queue_flush(entry->s.in_queue[i].queue);
+
 			odp_queue_destroy(entry->s.in_queue[i].queue);
 			entry->s.in_queue[i].queue = ODP_QUEUE_INVALID;
 		}
@@ -373,6 +401,9 @@ int odp_pktio_close(odp_pktio_t hdl)
 	entry->s.num_in_queue  = 0;
 	entry->s.num_out_queue = 0;
 
+	pktio_gro_term(entry);
+	pktio_gso_term(entry);
+
 	res = _pktio_close(entry);
 	if (res)
 		ODP_ABORT("unable to close pktio\n");
@@ -425,6 +456,14 @@ int odp_pktio_config(odp_pktio_t hdl, const odp_pktio_config_t *config)
 
 	entry->s.config = *config;
 
+	/* Drivers with native segmentation offload clear these */
+	pktio_gso_term(entry);
+	entry->s.gso_sw.all_bits    = 0;
+	entry->s.gso_sw.bit.tcp_gso = config->pktout.bit.tcp_gso;
+	entry->s.gso_sw.bit.udp_gso = config->pktout.bit.udp_gso;
+
+	pktio_gro_config(entry, config);
+
 	if (entry->s.ops->config)
 		res = entry->s.ops->config(entry, config);
 
@@ -471,6 +510,10 @@ int odp_pktio_start(odp_pktio_t hdl)
 			}
 		}
 
+		/* Software spread queues are filled from the first queue */
+		if (entry->s.sw_hash.num_queues)
+			num = 1;
+
 		sched_fn->pktio_start(pktio_to_id(hdl), num, index);
 	}
 
@@ -545,6 +588,197 @@ odp_pktio_t odp_pktio_lookup(const char *name)
 	return hdl;
 }
 
+/* Select input queue of a packet when spreading packets in software */
+static inline unsigned sw_hash_queue(pktio_entry_t *entry,
+				     odp_packet_hdr_t *pkt_hdr)
+{
+	if (!pkt_hdr->p.input_flags.flow_hash)
+		_pktio_sw_hash(entry, pkt_hdr);
+
+	if (!pkt_hdr->p.input_flags.flow_hash)
+		return 0;
+
+	return pkt_hdr->flow_hash % entry->s.sw_hash.num_queues;
+}
+
+/* Enqueue received packets. Packets that cannot be enqueued are freed. */
+static inline void pktin_enq_pkts(queue_entry_t *qentry,
+				  odp_buffer_hdr_t *hdr_tbl[], int num)
+{
+	int i, ret;
+
+	ret = queue_enq_multi(qentry, hdr_tbl, num);
+	if (odp_unlikely(ret < 0))
+		ret = 0;
+
+	for (i = ret; i < num; i++)
+		odp_packet_free(_odp_packet_from_buffer(
+					hdr_tbl[i]->handle.handle));
+}
+
+/* Combine received packets into vectors and enqueue those. Packets are
+ * enqueued as is when running out of vectors. Vectors and packets that
+ * cannot be enqueued are freed. */
+static inline void pktin_enq_vector(pktio_entry_t *entry,
+				    queue_entry_t *qentry,
+				    odp_buffer_hdr_t *hdr_tbl[], int num)
+{
+	odp_pktin_vector_config_t *vector = &entry->s.in_vector;
+	odp_buffer_t vec_buf[QUEUE_MULTI_MAX];
+	odp_buffer_hdr_t *vec_hdr[QUEUE_MULTI_MAX];
+	odp_packet_vector_hdr_t *hdr;
+	odp_packet_t *pkt_tbl;
+	uint32_t max_size = vector->max_size;
+	pool_t *pool;
+	int num_vec, i, j, ret;
+	int first = 0;
+
+	pool    = pool_entry_from_hdl(vector->pool);
+	num_vec = (num + max_size - 1) / max_size;
+	num_vec = buffer_alloc_multi(pool, vec_buf, vec_hdr, num_vec);
+
+	for (i = 0; i < num_vec; i++) {
+		hdr     = (odp_packet_vector_hdr_t *)(void *)vec_hdr[i];
+		pkt_tbl = packet_vector_tbl(hdr);
+
+		for (j = 0; j < (int)max_size && first < num; j++, first++)
+			pkt_tbl[j] = _odp_packet_from_buffer(
+					hdr_tbl[first]->handle.handle);
+
+		hdr->size = j;
+	}
+
+	if (num_vec > 0) {
+		ret = queue_enq_multi(qentry, vec_hdr, num_vec);
+		if (odp_unlikely(ret < 0))
+			ret = 0;
+
+		if (odp_unlikely(ret < num_vec)) {
+			for (i = ret; i < num_vec; i++) {
+				hdr = (odp_packet_vector_hdr_t *)
+				      (void *)vec_hdr[i];
+				odp_packet_free_multi(packet_vector_tbl(hdr),
+						      hdr->size);
+			}
+
+			buffer_free_multi(&vec_buf[ret], num_vec - ret);
+		}
+	}
+
+	if (first < num)
+		pktin_enq_pkts(qentry, &hdr_tbl[first], num - first);
+}
+
+/* Enqueue packets spread to other input queues than the polled one. Packets
+ * are enqueued in a burst per queue, and formed into vectors like packets
+ * of the polled queue. Packets that cannot be enqueued are freed. */
+static void pktin_enq_spread(pktio_entry_t *entry, odp_buffer_hdr_t *hdr_tbl[],
+			     unsigned idx_tbl[], int num)
+{
+	odp_buffer_hdr_t *burst[num];
+	queue_entry_t *qentry;
+	unsigned idx;
+	int i, num_burst, left;
+
+	while (num) {
+		idx = idx_tbl[0];
+		num_burst = 0;
+		left = 0;
+
+		/* Packets of a queue keep their order */
+		for (i = 0; i < num; i++) {
+			if (idx_tbl[i] == idx) {
+				burst[num_burst++] = hdr_tbl[i];
+			} else {
+				hdr_tbl[left] = hdr_tbl[i];
+				idx_tbl[left++] = idx_tbl[i];
+			}
+		}
+
+		num = left;
+		qentry = queue_to_qentry(entry->s.in_queue[idx].queue);
+
+		if (entry->s.in_vector.enable)
+			pktin_enq_vector(entry, qentry, burst, num_burst);
+		else
+			pktin_enq_pkts(qentry, burst, num_burst);
+	}
+}
+
+/* Receive packets of input queue 'index' when the driver has only the first
+ * queue and packets are spread into input queues in software. Packets of
+ * other queues are enqueued into their event queues. All input queues
+ * receive from the same driver queue, so receive and spreading are
+ * serialized to keep packet order within each queue. Returns the number of
+ * packets of the queue. */
+static int pktin_recv_spread(pktio_entry_t *entry, unsigned index,
+			     odp_packet_t packets[], int num)
+{
+	odp_buffer_hdr_t *spread_hdr[num];
+	unsigned spread_idx[num];
+	odp_packet_hdr_t *pkt_hdr;
+	unsigned idx;
+	int i, pkts;
+	int num_rx = 0;
+	int num_spread = 0;
+
+	odp_ticketlock_lock(&entry->s.sw_hash_lock);
+
+	pkts = pktio_recv(entry, 0, packets, num);
+
+	for (i = 0; i < pkts; i++) {
+		pkt_hdr = odp_packet_hdr(packets[i]);
+		idx = sw_hash_queue(entry, pkt_hdr);
+
+		if (idx == index) {
+			packets[num_rx++] = packets[i];
+			continue;
+		}
+
+		spread_hdr[num_spread] =
+			buf_hdl_to_hdr(_odp_packet_to_buffer(packets[i]));
+		spread_idx[num_spread++] = idx;
+	}
+
+	if (num_spread)
+		pktin_enq_spread(entry, spread_hdr, spread_idx, num_spread);
+
+	odp_ticketlock_unlock(&entry->s.sw_hash_lock);
+
+	return pkts < 0 ? pkts : num_rx;
+}
+
+/* Receive packets of a direct input queue when packets are spread in
+ * software. Packets spread into the queue by receive calls of other queues
+ * are received first. */
+static int pktin_recv_direct_spread(pktio_entry_t *entry, unsigned index,
+				    odp_packet_t packets[], int num)
+{
+	queue_entry_t *qentry = queue_to_qentry(entry->s.in_queue[index].queue);
+	odp_buffer_hdr_t *hdr_tbl[QUEUE_MULTI_MAX];
+	int i, n, ret;
+
+	if (num > QUEUE_MULTI_MAX)
+		num = QUEUE_MULTI_MAX;
+
+	n = queue_deq_multi(qentry, hdr_tbl, num);
+	if (odp_unlikely(n < 0))
+		n = 0;
+
+	for (i = 0; i < n; i++)
+		packets[i] = _odp_packet_from_buffer(hdr_tbl[i]->handle.handle);
+
+	if (n == num)
+		return n;
+
+	ret = pktin_recv_spread(entry, index, &packets[n], num - n);
+
+	if (ret < 0)
+		return n ? n : ret;
+
+	return n + ret;
+}
+
 static inline int pktin_recv_buf(odp_pktin_queue_t queue,
 				 odp_buffer_hdr_t *buffer_hdrs[], int num)
 {
@@ -553,11 +787,19 @@ static inline int pktin_recv_buf(odp_pktin_queue_t queue,
 	odp_packet_hdr_t *pkt_hdr;
 	odp_buffer_hdr_t *buf_hdr;
 	odp_buffer_t buf;
+	pktio_entry_t *entry;
 	int i;
 	int pkts;
 	int num_rx = 0;
 
-	pkts = odp_pktin_recv(queue, packets, num);
+	entry = get_pktio_entry(queue.pktio);
+	if (entry == NULL)
+		return -1;
+
+	if (entry->s.sw_hash.num_queues)
+		pkts = pktin_recv_spread(entry, queue.index, packets, num);
+	else
+		pkts = pktio_recv(entry, queue.index, packets, num);
 
 	for (i = 0; i < pkts; i++) {
 		pkt = packets[i];
@@ -575,8 +817,10 @@ static inline int pktin_recv_buf(odp_pktin_queue_t queue,
 				odp_packet_free(pkt);
 			continue;
 		}
+
 		buffer_hdrs[num_rx++] = buf_hdr;
 	}
+
 	return num_rx;
 }
 
@@ -719,7 +963,11 @@ int sched_cb_pktin_poll(int pktio_index, int num_queue, int index[])
 
 		queue = entry->s.in_queue[index[idx]].queue;
 		qentry = queue_to_qentry(queue);
-		queue_enq_multi(qentry, hdr_tbl, num);
+
+		if (entry->s.in_vector.enable)
+			pktin_enq_vector(entry, qentry, hdr_tbl, num);
+		else
+			queue_enq_multi(qentry, hdr_tbl, num);
 	}
 
 	return 0;
@@ -911,6 +1159,7 @@ void odp_pktin_queue_param_init(odp_pktin_queue_param_t *param)
 	param->num_queues = 1;
 	/* no need to choose queue type since pktin mode defines it */
 	odp_queue_param_init(&param->queue_param);
+	param->vector.pool = ODP_POOL_INVALID;
 }
 
 void odp_pktout_queue_param_init(odp_pktout_queue_param_t *param)
@@ -1095,6 +1344,14 @@ int odp_pktio_term_global(void)
 	return ret;
 }
 
+static int drv_capability(pktio_entry_t *entry, odp_pktio_capability_t *capa)
+{
+	if (entry->s.ops->capability)
+		return entry->s.ops->capability(entry, capa);
+
+	return single_capability(capa);
+}
+
 int odp_pktio_capability(odp_pktio_t pktio, odp_pktio_capability_t *capa)
 {
 	pktio_entry_t *entry;
@@ -1105,10 +1362,27 @@ int odp_pktio_capability(odp_pktio_t pktio, odp_pktio_capability_t *capa)
 		return -1;
 	}
 
-	if (entry->s.ops->capability)
-		return entry->s.ops->capability(entry, capa);
+	if (drv_capability(entry, capa))
+		return -1;
 
-	return single_capability(capa);
+	/* Packets of a single queue driver are spread into multiple input
+	 * queues with software flow hashing */
+	if (capa->max_input_queues == 1)
+		capa->max_input_queues = PKTIO_MAX_QUEUES;
+
+	/* Packets are segmented in software on output */
+	capa->config.pktout.bit.tcp_gso = 1;
+	capa->config.pktout.bit.udp_gso = 1;
+
+	/* Packets are coalesced in software on input */
+	capa->config.pktin.bit.tcp_gro = 1;
+	capa->config.pktin.bit.udp_gro = 1;
+
+	/* Packet vectors are formed in software for scheduled input */
+	capa->vector.supported = 1;
+	capa->vector.max_size  = CONFIG_PACKET_VECTOR_MAX_SIZE;
+
+	return 0;
 }
 
 unsigned odp_pktio_max_index(void)
@@ -1138,6 +1412,13 @@ int odp_pktio_stats(odp_pktio_t pktio,
 
 	if (entry->s.ops->stats)
 		ret = entry->s.ops->stats(entry, stats);
+
+	if (ret == 0) {
+		stats->in_gro_pkts = odp_atomic_load_u64(&entry->s.gro.pkts);
+		stats->in_gro_segs = odp_atomic_load_u64(&entry->s.gro.segs);
+		stats->out_discards +=
+			odp_atomic_load_u64(&entry->s.gso.discards);
+	}
 	unlock_entry(entry);
 
 	return ret;
@@ -1164,11 +1445,60 @@ int odp_pktio_stats_reset(odp_pktio_t pktio)
 
 	if (entry->s.ops->stats)
 		ret = entry->s.ops->stats_reset(entry);
+
+	odp_atomic_store_u64(&entry->s.gro.pkts, 0);
+	odp_atomic_store_u64(&entry->s.gro.segs, 0);
+	odp_atomic_store_u64(&entry->s.gso.discards, 0);
 	unlock_entry(entry);
 
 	return ret;
 }
 
+/* Check packet vector configuration of input queue parameters. Vector
+ * configuration is written into 'vector'. */
+static int pktin_vector_config(pktio_entry_t *entry,
+			       const odp_pktin_queue_param_t *param,
+			       odp_pktin_vector_config_t *vector)
+{
+	pool_t *pool;
+
+	memset(vector, 0, sizeof(odp_pktin_vector_config_t));
+	vector->pool = ODP_POOL_INVALID;
+
+	if (!param->vector.enable)
+		return 0;
+
+	if (entry->s.param.in_mode != ODP_PKTIN_MODE_SCHED) {
+		ODP_DBG("pktio %s: vectors require scheduled input\n",
+			entry->s.name);
+		return -1;
+	}
+
+	if (param->vector.pool == ODP_POOL_INVALID) {
+		ODP_DBG("pktio %s: no vector pool\n", entry->s.name);
+		return -1;
+	}
+
+	pool = pool_entry_from_hdl(param->vector.pool);
+
+	if (pool->params.type != ODP_POOL_PACKET_VECTOR) {
+		ODP_DBG("pktio %s: bad vector pool type\n", entry->s.name);
+		return -1;
+	}
+
+	if (param->vector.max_size > pool->params.vector.max_size) {
+		ODP_DBG("pktio %s: too large vector size\n", entry->s.name);
+		return -1;
+	}
+
+	*vector = param->vector;
+
+	if (vector->max_size == 0)
+		vector->max_size = pool->params.vector.max_size;
+
+	return 0;
+}
+
 int odp_pktin_queue_config(odp_pktio_t pktio,
 			   const odp_pktin_queue_param_t *param)
 {
@@ -1180,6 +1510,9 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 	int rc;
 	odp_queue_t queue;
 	odp_pktin_queue_param_t default_param;
+	odp_pktin_queue_param_t drv_param;
+	odp_pktin_vector_config_t vector;
+	pktio_sw_hash_t sw_hash;
 
 	if (param == NULL) {
 		odp_pktin_queue_param_init(&default_param);
@@ -1222,13 +1555,40 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 		return -1;
 	}
 
+	if (drv_capability(entry, &capa))
+		return -1;
+
+	drv_param = *param;
+
+	if (num_queues > capa.max_input_queues) {
+		if (!param->hash_enable) {
+			ODP_DBG("pktio %s: multiple input queues require "
+				"hashing\n", entry->s.name);
+			return -1;
+		}
+
+		/* Driver receives into one queue, which is spread into
+		 * event queues in software */
+		drv_param.num_queues = capa.max_input_queues;
+	}
+
+	/* Configuration is checked before the entry is modified */
+	if (pktin_vector_config(entry, param, &vector))
+		return -1;
+
+	pktio_sw_hash_config(&sw_hash, param, capa.max_input_queues);
+
 	/* If re-configuring, destroy old queues */
-	if (entry->s.num_in_queue)
+	if (entry->s.num_in_queue) {
 		destroy_in_queues(entry, entry->s.num_in_queue);
+		entry->s.num_in_queue = 0;
+	}
 
 	for (i = 0; i < num_queues; i++) {
+		/* Direct input queues hold packets spread into them by
+		 * receive calls of other queues */
 		if (mode == ODP_PKTIN_MODE_QUEUE ||
-		    mode == ODP_PKTIN_MODE_SCHED) {
+		    mode == ODP_PKTIN_MODE_SCHED || sw_hash.num_queues) {
 			odp_queue_param_t queue_param;
 			char name[ODP_QUEUE_NAME_LEN];
 			int pktio_id = pktio_to_id(pktio);
@@ -1243,6 +1603,8 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 
 			if (mode == ODP_PKTIN_MODE_SCHED)
 				queue_param.type = ODP_QUEUE_TYPE_SCHED;
+			else if (mode == ODP_PKTIN_MODE_DIRECT)
+				odp_queue_param_init(&queue_param);
 
 			queue = odp_queue_create(name, &queue_param);
 
@@ -1275,10 +1637,12 @@ int odp_pktin_queue_config(odp_pktio_t pktio,
 		entry->s.in_queue[i].pktin.pktio = entry->s.handle;
 	}
 
+	entry->s.in_vector    = vector;
+	entry->s.sw_hash      = sw_hash;
 	entry->s.num_in_queue = num_queues;
 
 	if (entry->s.ops->input_queues_config)
-		return entry->s.ops->input_queues_config(entry, param);
+		return entry->s.ops->input_queues_config(entry, &drv_param);
 
 	return 0;
 }
@@ -1347,8 +1711,14 @@ int odp_pktout_queue_config(odp_pktio_t pktio,
 		entry->s.num_out_queue = 0;
 	}
 
+	pktio_gso_term(entry);
 	init_out_queues(entry);
 
+	/* Output queues of a packet output event queue are used by many
+	 * threads */
+	entry->s.gso.lockless = mode == ODP_PKTOUT_MODE_DIRECT &&
+				param->op_mode == ODP_PKTIO_OP_MT_UNSAFE;
+
 	for (i = 0; i < num_queues; i++) {
 		entry->s.out_queue[i].pktout.index = i;
 		entry->s.out_queue[i].pktout.pktio = pktio;
@@ -1536,7 +1906,11 @@ int odp_pktin_recv(odp_pktin_queue_t queue, odp_packet_t packets[], int num)
 		return -1;
 	}
 
-	return entry->s.ops->recv(entry, queue.index, packets, num);
+	if (odp_unlikely(entry->s.sw_hash.num_queues))
+		return pktin_recv_direct_spread(entry, queue.index, packets,
+						num);
+
+	return pktio_recv(entry, queue.index, packets, num);
 }
 
 int odp_pktin_recv_tmo(odp_pktin_queue_t queue, odp_packet_t packets[], int num,
@@ -1646,6 +2020,101 @@ uint64_t odp_pktin_wait_time(uint64_t nsec)
 	return (nsec / SLEEP_NSEC) + 1;
 }
 
+/* Send segments with a few retries on a full output queue. Returns the
+ * number of segments sent. Segments are dropped on a send error. */
+static int pktout_send_segs(pktio_entry_t *entry, int index,
+			    const odp_packet_t seg_tbl[], int num)
+{
+	int ret;
+	int sent = 0;
+	int retry = 0;
+
+	while (sent < num && retry < PKTIO_GSO_SEND_RETRY) {
+		ret = entry->s.ops->send(entry, index, &seg_tbl[sent],
+					 num - sent);
+		if (odp_unlikely(ret < 0)) {
+			odp_packet_free_multi(&seg_tbl[sent], num - sent);
+			odp_atomic_add_u64(&entry->s.gso.discards, num - sent);
+			return num;
+		}
+
+		if (ret == 0)
+			retry++;
+
+		sent += ret;
+	}
+
+	return sent;
+}
+
+/* Send packets up to the first packet with segmentation size set. That packet
+ * is segmented in software and the segments are sent in place of it.
+ * Segments left unsent by a full output queue are kept in the queue and sent
+ * first on the next call. New packets are sent on the same call when all
+ * kept segments have been sent. The queue lock is skipped when the
+ * application does not share the output queue between threads. */
+static int pktout_send_gso(pktio_entry_t *entry, int index,
+			   const odp_packet_t packets[], int num)
+{
+	pktio_gso_queue_t *queue = &entry->s.gso.queue[index];
+	odp_packet_t seg_tbl[PKTIO_GSO_MAX_SEGS];
+	int i, n, sent;
+	int ret = 1;
+
+	if (!entry->s.gso.lockless)
+		odp_spinlock_lock(&queue->lock);
+
+	if (odp_unlikely(queue->num)) {
+		sent = pktout_send_segs(entry, index,
+					&queue->seg[queue->first], queue->num);
+		queue->first += sent;
+		queue->num   -= sent;
+
+		if (queue->num) {
+			ret = 0;
+			goto unlock;
+		}
+	}
+
+	for (i = 0; i < num; i++)
+		if (odp_packet_hdr(packets[i])->p.output_flags.gso_size)
+			break;
+
+	if (i > 0) {
+		ret = entry->s.ops->send(entry, index, packets, i);
+		goto unlock;
+	}
+
+	n = pktio_gso_segment(entry, packets[0], seg_tbl, PKTIO_GSO_MAX_SEGS);
+
+	if (n < 0) {
+		__odp_errno = EMSGSIZE;
+		ret = -1;
+		goto unlock;
+	}
+
+	if (n == 0) {
+		ret = entry->s.ops->send(entry, index, packets, 1);
+		goto unlock;
+	}
+
+	/* The packet has been consumed into segments */
+	sent = pktout_send_segs(entry, index, seg_tbl, n);
+
+	if (odp_unlikely(sent < n)) {
+		memcpy(queue->seg, &seg_tbl[sent],
+		       (n - sent) * sizeof(odp_packet_t));
+		queue->first = 0;
+		queue->num   = n - sent;
+	}
+
+unlock:
+	if (!entry->s.gso.lockless)
+		odp_spinlock_unlock(&queue->lock);
+
+	return ret;
+}
+
 int odp_pktout_send(odp_pktout_queue_t queue, const odp_packet_t packets[],
 		    int num)
 {
@@ -1658,6 +2127,9 @@ int odp_pktout_send(odp_pktout_queue_t queue, const odp_packet_t packets[],
 		return -1;
 	}
 
+	if (odp_unlikely(entry->s.gso_sw.all_bits) && num > 0)
+		return pktout_send_gso(entry, queue.index, packets, num);
+
 	return entry->s.ops->send(entry, queue.index, packets, num);
 }
 
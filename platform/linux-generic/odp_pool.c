@@ -218,6 +218,7 @@ static void init_buffers(pool_t *pool)
 	uint32_t i;
 	odp_buffer_hdr_t *buf_hdr;
 	odp_packet_hdr_t *pkt_hdr;
+	odp_packet_vector_hdr_t *vec_hdr;
 	odp_buffer_t buf_hdl;
 	void *addr;
 	void *uarea = NULL;
@@ -236,6 +237,7 @@ static void init_buffers(pool_t *pool)
 		addr    = &pool->base_addr[i * pool->block_size];
 		buf_hdr = addr;
 		pkt_hdr = addr;
+		vec_hdr = addr;
 
 		if (pool->uarea_size)
 			uarea = &pool->uarea_base_addr[i * pool->uarea_size];
@@ -244,6 +246,8 @@ static void init_buffers(pool_t *pool)
 
 		if (type == ODP_POOL_PACKET)
 			data = pkt_hdr->data;
+		else if (type == ODP_POOL_PACKET_VECTOR)
+			data = vec_hdr->data;
 
 		offset = pool->headroom;
 
@@ -343,6 +347,11 @@ static odp_pool_t pool_create(const char *name, odp_pool_param_t *params,
 		num = params->tmo.num;
 		break;
 
+	case ODP_POOL_PACKET_VECTOR:
+		num       = params->vector.num;
+		data_size = params->vector.max_size * sizeof(odp_packet_t);
+		break;
+
 	default:
 		ODP_ERR("Bad pool type");
 		return ODP_POOL_INVALID;
@@ -499,6 +508,21 @@ static int check_params(odp_pool_param_t *params)
 		}
 		break;
 
+	case ODP_POOL_PACKET_VECTOR:
+		if (params->vector.num > capa.vector.max_num) {
+			printf("vector.num too large %u\n",
+			       params->vector.num);
+			return -1;
+		}
+
+		if (params->vector.max_size == 0 ||
+		    params->vector.max_size > capa.vector.max_size) {
+			printf("bad vector.max_size %u\n",
+			       params->vector.max_size);
+			return -1;
+		}
+		break;
+
 	default:
 		printf("bad pool type %i\n", params->type);
 		return -1;
@@ -825,6 +849,11 @@ int odp_pool_capability(odp_pool_capability_t *capa)
 	capa->tmo.max_pools = ODP_CONFIG_POOLS;
 	capa->tmo.max_num   = CONFIG_POOL_MAX_NUM;
 
+	/* Packet vector pools */
+	capa->vector.max_pools = ODP_CONFIG_POOLS;
+	capa->vector.max_num   = CONFIG_POOL_MAX_NUM;
+	capa->vector.max_size  = CONFIG_PACKET_VECTOR_MAX_SIZE;
+
 	return 0;
 }
 
@@ -843,7 +872,8 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	       pool->params.type == ODP_POOL_BUFFER ? "buffer" :
 	       (pool->params.type == ODP_POOL_PACKET ? "packet" :
 	       (pool->params.type == ODP_POOL_TIMEOUT ? "timeout" :
-		"unknown")));
+	       (pool->params.type == ODP_POOL_PACKET_VECTOR ? "vector" :
+		"unknown"))));
 	printf("  pool shm        %" PRIu64 "\n",
 	       odp_shm_to_u64(pool->shm));
 	printf("  user area shm   %" PRIu64 "\n",
@@ -19,6 +19,7 @@
 #include <odp_config_internal.h>
 #include <odp_packet_io_internal.h>
 #include <odp_packet_io_queue.h>
+#include <odp_timer_internal.h>
 #include <odp_debug_internal.h>
 #include <odp/api/hints.h>
 #include <odp/api/sync.h>
@@ -597,6 +598,8 @@ int odp_queue_deq_multi(odp_queue_t handle, odp_event_t events[], int num)
 	if (num > QUEUE_MULTI_MAX)
 		num = QUEUE_MULTI_MAX;
 
+	timer_run();
+
 	queue = queue_to_qentry(handle);
 
 	ret = queue->s.dequeue_multi(queue, buf_hdr, num);
@@ -613,6 +616,8 @@ odp_event_t odp_queue_deq(odp_queue_t handle)
 	queue_entry_t *queue;
 	odp_buffer_hdr_t *buf_hdr;
 
+	timer_run();
+
 	queue   = queue_to_qentry(handle);
 	buf_hdr = queue->s.dequeue(queue);
 
@@ -724,9 +729,12 @@ int sched_cb_queue_deq_multi(uint32_t queue_index, odp_event_t ev[], int num)
 
 	ret = deq_multi(qe, buf_hdr, num);
 
-	if (ret > 0)
-		for (i = 0; i < ret; i++)
-			ev[i] = odp_buffer_to_event(buf_hdr[i]->handle.handle);
+	for (i = 0; i < ret; i++) {
+		if (i < CONFIG_PACKET_PREFETCH_DIST)
+			packet_prefetch_data(buf_hdr[i]);
+
+		ev[i] = odp_buffer_to_event(buf_hdr[i]->handle.handle);
+	}
 
 	return ret;
 }
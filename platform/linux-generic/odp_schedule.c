@@ -22,6 +22,8 @@
 #include <odp/api/sync.h>
 #include <odp_ring_internal.h>
 #include <odp_queue_internal.h>
+#include <odp_packet_internal.h>
+#include <odp_timer_internal.h>
 
 /* Number of priority levels  */
 #define NUM_PRIO 8
@@ -610,8 +612,16 @@ static inline void schedule_release_context(void)
 static inline int copy_events(odp_event_t out_ev[], unsigned int max)
 {
 	int i = 0;
+	odp_event_t ev;
 
 	while (sched_local.num && max) {
+		/* Packet data of the first events was prefetched on dequeue */
+		if (sched_local.num > CONFIG_PACKET_PREFETCH_DIST) {
+			ev = sched_local.ev_stash[sched_local.index +
+						  CONFIG_PACKET_PREFETCH_DIST];
+			packet_prefetch_data(buf_hdl_to_hdr((odp_buffer_t)ev));
+		}
+
 		out_ev[i] = sched_local.ev_stash[sched_local.index];
 		sched_local.index++;
 		sched_local.num--;
@@ -884,6 +894,8 @@ static int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 	int ret;
 
 	while (1) {
+		timer_run();
+
 		ret = do_schedule(out_queue, out_ev, max_num);
 
 		if (ret)
@@ -6,87 +6,193 @@
 
 #include <odp_posix_extensions.h>
 
+#include <string.h>
+#include <inttypes.h>
 #include <time.h>
 #include <odp/api/time.h>
 #include <odp/api/hints.h>
 #include <odp_debug_internal.h>
+#include <odp_time_internal.h>
 
-static odp_time_t start_time;
+/* Time over which HW time counter frequency is calibrated */
+#define CALIBRATION_NS (20 * ODP_TIME_MSEC_IN_NS)
 
-static inline
-uint64_t time_to_ns(odp_time_t time)
-{
-	uint64_t ns;
+/* Number of tries to sample HW time and system time close together */
+#define SAMPLE_TRIES 5
 
-	ns = time.tv_sec * ODP_TIME_SEC_IN_NS;
-	ns += time.tv_nsec;
+/* Conversion between two time units */
+typedef struct {
+	uint64_t to_hz;
+	uint64_t from_hz;
+#ifdef __SIZEOF_INT128__
+	/* Fixed point multiplier with 'shift' fraction bits */
+	uint64_t mul;
+	uint32_t shift;
+#endif
+} time_conv_t;
 
-	return ns;
-}
+typedef struct {
+	/* System time (nsec) at global init */
+	uint64_t sys_start_ns;
 
-static inline odp_time_t time_diff(odp_time_t t2, odp_time_t t1)
-{
-	odp_time_t time;
+	/* Time stamps are HW time counter ticks instead of nanoseconds */
+	int use_hw;
 
-	time.tv_sec = t2.tv_sec - t1.tv_sec;
-	time.tv_nsec = t2.tv_nsec - t1.tv_nsec;
+	/* HW time counter value at global init */
+	uint64_t hw_start;
 
-	if (time.tv_nsec < 0) {
-		time.tv_nsec += ODP_TIME_SEC_IN_NS;
-		--time.tv_sec;
-	}
+	/* HW time counter frequency in Hz */
+	uint64_t hw_freq_hz;
 
-	return time;
+	/* HW time counter ticks to nanoseconds */
+	time_conv_t hw_to_ns;
+
+	/* Nanoseconds to HW time counter ticks */
+	time_conv_t ns_to_hw;
+
+} time_global_t;
+
+static time_global_t global;
+
+static void time_conv_init(time_conv_t *conv, uint64_t to_hz,
+			   uint64_t from_hz)
+{
+#ifdef __SIZEOF_INT128__
+	uint32_t shift = 0;
+#endif
+
+	conv->to_hz   = to_hz;
+	conv->from_hz = from_hz;
+
+#ifdef __SIZEOF_INT128__
+	/* Use as many fraction bits as fit into a 63 bit multiplier */
+	while (shift < 63 &&
+	       (((unsigned __int128)to_hz << (shift + 1)) / from_hz) >> 63 == 0)
+		shift++;
+
+	conv->mul   = ((unsigned __int128)to_hz << shift) / from_hz;
+	conv->shift = shift;
+#endif
 }
 
-static inline odp_time_t time_local(void)
+static inline uint64_t time_conv(const time_conv_t *conv, uint64_t val)
+{
+#ifdef __SIZEOF_INT128__
+	return ((unsigned __int128)val * conv->mul) >> conv->shift;
+#else
+	uint64_t sec = val / conv->from_hz;
+	uint64_t rem = val - sec * conv->from_hz;
+
+	return sec * conv->to_hz + (rem * conv->to_hz) / conv->from_hz;
+#endif
+}
+
+static inline uint64_t time_sys_ns(void)
 {
 	int ret;
-	odp_time_t time;
 	struct timespec sys_time;
 
 	ret = clock_gettime(CLOCK_MONOTONIC_RAW, &sys_time);
 	if (odp_unlikely(ret != 0))
 		ODP_ABORT("clock_gettime failed\n");
 
-	time.tv_sec = sys_time.tv_sec;
-	time.tv_nsec = sys_time.tv_nsec;
+	return sys_time.tv_sec * ODP_TIME_SEC_IN_NS + sys_time.tv_nsec;
+}
 
-	return time_diff(time, start_time);
+/* Sample HW time and system time as close together as possible */
+static void time_sample(uint64_t *hw, uint64_t *ns)
+{
+	uint64_t hw1, hw2, sys;
+	uint64_t best = UINT64_MAX;
+	int i;
+
+	for (i = 0; i < SAMPLE_TRIES; i++) {
+		hw1 = cpu_global_time();
+		sys = time_sys_ns();
+		hw2 = cpu_global_time();
+
+		if (hw2 - hw1 < best) {
+			best = hw2 - hw1;
+			*hw  = hw1 + best / 2;
+			*ns  = sys;
+		}
+	}
 }
 
-static inline int time_cmp(odp_time_t t2, odp_time_t t1)
+/* Measure HW time counter frequency against system time */
+static uint64_t time_hw_calibrate(void)
 {
-	if (t2.tv_sec < t1.tv_sec)
-		return -1;
+	struct timespec wait = {0, CALIBRATION_NS};
+	uint64_t hw1, hw2, ns1, ns2;
 
-	if (t2.tv_sec > t1.tv_sec)
-		return 1;
+	time_sample(&hw1, &ns1);
+	nanosleep(&wait, NULL);
+	time_sample(&hw2, &ns2);
+
+	if (hw2 <= hw1 || ns2 <= ns1)
+		return 0;
 
-	return t2.tv_nsec - t1.tv_nsec;
+	return (uint64_t)((double)(hw2 - hw1) * ODP_TIME_SEC_IN_NS /
+			  (ns2 - ns1) + 0.5);
 }
 
-static inline odp_time_t time_sum(odp_time_t t1, odp_time_t t2)
+static inline odp_time_t time_local(void)
 {
 	odp_time_t time;
 
-	time.tv_sec = t2.tv_sec + t1.tv_sec;
-	time.tv_nsec = t2.tv_nsec + t1.tv_nsec;
-
-	if (time.tv_nsec >= (long)ODP_TIME_SEC_IN_NS) {
-		time.tv_nsec -= ODP_TIME_SEC_IN_NS;
-		++time.tv_sec;
-	}
+	if (odp_likely(global.use_hw))
+		time.count = cpu_global_time() - global.hw_start;
+	else
+		time.nsec = time_sys_ns() - global.sys_start_ns;
 
 	return time;
 }
 
+static inline uint64_t time_to_ns(odp_time_t time)
+{
+	if (odp_likely(global.use_hw))
+		return time_conv(&global.hw_to_ns, time.count);
+
+	return time.nsec;
+}
+
 static inline odp_time_t time_local_from_ns(uint64_t ns)
 {
 	odp_time_t time;
 
-	time.tv_sec = ns / ODP_TIME_SEC_IN_NS;
-	time.tv_nsec = ns - time.tv_sec * ODP_TIME_SEC_IN_NS;
+	if (odp_likely(global.use_hw))
+		time.count = time_conv(&global.ns_to_hw, ns);
+	else
+		time.nsec = ns;
+
+	return time;
+}
+
+static inline odp_time_t time_diff(odp_time_t t2, odp_time_t t1)
+{
+	odp_time_t time;
+
+	time.u64 = t2.u64 - t1.u64;
+
+	return time;
+}
+
+static inline int time_cmp(odp_time_t t2, odp_time_t t1)
+{
+	if (odp_likely(t2.u64 > t1.u64))
+		return 1;
+
+	if (t2.u64 < t1.u64)
+		return -1;
+
+	return 0;
+}
+
+static inline odp_time_t time_sum(odp_time_t t1, odp_time_t t2)
+{
+	odp_time_t time;
+
+	time.u64 = t1.u64 + t2.u64;
 
 	return time;
 }
@@ -105,6 +211,9 @@ static inline uint64_t time_local_res(void)
 	int ret;
 	struct timespec tres;
 
+	if (global.use_hw)
+		return global.hw_freq_hz;
+
 	ret = clock_getres(CLOCK_MONOTONIC_RAW, &tres);
 	if (odp_unlikely(ret != 0))
 		ODP_ABORT("clock_getres failed\n");
@@ -178,33 +287,47 @@ void odp_time_wait_until(odp_time_t time)
 
 uint64_t odp_time_to_u64(odp_time_t time)
 {
-	int ret;
-	struct timespec tres;
-	uint64_t resolution;
-
-	ret = clock_getres(CLOCK_MONOTONIC_RAW, &tres);
-	if (odp_unlikely(ret != 0))
-		ODP_ABORT("clock_getres failed\n");
-
-	resolution = (uint64_t)tres.tv_nsec;
-
-	return time_to_ns(time) / resolution;
+	return time.u64;
 }
 
 int odp_time_init_global(void)
 {
 	int ret;
+	uint64_t freq;
 	struct timespec time;
 
+	memset(&global, 0, sizeof(time_global_t));
+
 	ret = clock_gettime(CLOCK_MONOTONIC_RAW, &time);
-	if (ret) {
-		start_time = ODP_TIME_NULL;
-	} else {
-		start_time.tv_sec = time.tv_sec;
-		start_time.tv_nsec = time.tv_nsec;
+	if (ret)
+		return ret;
+
+	global.sys_start_ns = time.tv_sec * ODP_TIME_SEC_IN_NS + time.tv_nsec;
+
+	if (!cpu_has_global_time()) {
+		ODP_DBG("Time source: clock_gettime()\n");
+		return 0;
 	}
 
-	return ret;
+	freq = cpu_global_time_freq();
+	if (freq == 0)
+		freq = time_hw_calibrate();
+
+	if (freq == 0) {
+		ODP_DBG("Time source: clock_gettime(), HW time calibration "
+			"failed\n");
+		return 0;
+	}
+
+	time_conv_init(&global.hw_to_ns, ODP_TIME_SEC_IN_NS, freq);
+	time_conv_init(&global.ns_to_hw, freq, ODP_TIME_SEC_IN_NS);
+	global.hw_freq_hz = freq;
+	global.hw_start   = cpu_global_time();
+	global.use_hw     = 1;
+
+	ODP_DBG("Time source: HW time counter, %" PRIu64 " Hz\n", freq);
+
+	return 0;
 }
 
 int odp_time_term_global(void)
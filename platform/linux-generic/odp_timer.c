@@ -38,6 +38,7 @@
 #include <odp/api/buffer.h>
 #include <odp_buffer_inlines.h>
 #include <odp/api/cpu.h>
+#include <odp_config_internal.h>
 #include <odp/api/pool.h>
 #include <odp_pool_internal.h>
 #include <odp/api/debug.h>
@@ -60,6 +61,20 @@
  * for checking the freshness of received timeouts */
 #define TMO_INACTIVE ((uint64_t)0x8000000000000000)
 
+/* Timer wheel geometry: TW_LEVELS levels of TW_SLOTS slots. A level covers
+ * TW_SLOTS times the range of the level below it. */
+#define TW_LEVELS    4
+#define TW_SLOT_BITS 8
+#define TW_SLOTS     (1U << TW_SLOT_BITS)
+#define TW_SLOT_MASK (TW_SLOTS - 1)
+/* Maximum distance of a wheel slot from the current tick */
+#define TW_MAX_DELTA ((UINT64_C(1) << (TW_LEVELS * TW_SLOT_BITS)) - 1)
+/* Empty list, timer not in wheel or empty set ring entry */
+#define TW_NONE      UINT32_MAX
+
+/* Number of timers processed at a time by the multi-timer calls */
+#define TIMER_MULTI_BURST 32
+
 /******************************************************************************
  * Mutual exclusion in the absence of CAS16
  *****************************************************************************/
@@ -117,6 +132,14 @@ ODP_STATIC_ASSERT(sizeof(tick_buf_t) == 16, "sizeof(tick_buf_t) == 16");
 typedef struct odp_timer_s {
 	void *user_ptr;
 	odp_queue_t queue;/* Used for free list when timer is free */
+	odp_atomic_u64_t due;/* Tick when the wheel checks the timer next */
+	odp_atomic_u32_t dirty;/* Timer index is in the wheel set ring */
+	uint32_t shard;/* Shard the timer belongs to */
+	uint64_t period;/* Period in ticks, 0 for a one-shot timer */
+	/* Fields below are owned by the thread expiring the timer pool */
+	uint32_t slot;/* Wheel slot of the timer, TW_NONE if not in wheel */
+	uint32_t next;/* Next timer in the wheel slot list */
+	uint32_t prev;/* Previous timer in the wheel slot list */
 } odp_timer;
 
 static void timer_init(odp_timer *tim,
@@ -126,6 +149,7 @@ static void timer_init(odp_timer *tim,
 {
 	tim->queue = _q;
 	tim->user_ptr = _up;
+	tim->period = 0;
 	tb->tmo_buf = ODP_BUFFER_INVALID;
 	/* All pad fields need a defined and constant value */
 	TB_SET_PAD(*tb);
@@ -164,6 +188,39 @@ static inline void set_next_free(odp_timer *tim, uint32_t nf)
  * Inludes alloc and free timer
  *****************************************************************************/
 
+/* Hierarchical timer wheel. Timers are linked into slot lists by their
+ * expiration tick, so that a tick needs to check only the timers in the
+ * current slot instead of all timers of the pool. Lists are modified only by
+ * the thread expiring the pool. Other threads pass set timers to it through
+ * the set ring. Timer state in tick_buf remains the only source of truth,
+ * the wheel merely tells which timers need to be checked on which tick. */
+typedef struct timer_wheel_s {
+	uint64_t next_tick;/* Next tick to process */
+	uint32_t ring_head;/* Next set ring entry to read */
+	uint32_t ring_mask;
+	odp_atomic_u32_t *ring;/* Indexes of set timers */
+	uint32_t head[TW_LEVELS][TW_SLOTS];/* Slot list heads */
+	odp_atomic_u32_t ring_tail ODP_ALIGNED_CACHE;/* Next entry to write */
+} timer_wheel_t;
+
+/* Timers of a pool are partitioned into shards of consecutive indexes. Each
+ * shard has its own free list, wheel and inline expiry state. Threads
+ * allocate timers from the shard of their CPU, so that threads on different
+ * CPUs do not contend on the same lock and set ring. A timer stays in the
+ * shard it belongs to, also when other threads set it. */
+typedef struct timer_shard_s {
+	odp_spinlock_t lock;/* Protects the free list */
+	uint32_t num_alloc;/* Current number of allocated timers */
+	uint32_t high_wm;/* High watermark of allocated timers */
+	uint32_t first_free;/* Head of the free list, 'end' when empty */
+	uint32_t base;/* Index of the first timer */
+	uint32_t end;/* One past the index of the last timer */
+	uint64_t cur_tick;/* Last tick expired inline */
+	odp_atomic_u64_t next_ns; /* Time of the next tick for inline expiry */
+	odp_spinlock_t expire_lock; /* Serializes inline expiry */
+	timer_wheel_t tw;
+} timer_shard_t;
+
 typedef struct odp_timer_pool_s {
 /* Put frequently accessed fields in the first cache line */
 	odp_atomic_u64_t cur_tick;/* Current tick value */
@@ -171,10 +228,9 @@ typedef struct odp_timer_pool_s {
 	uint64_t max_rel_tck;
 	tick_buf_t *tick_buf; /* Expiration tick and timeout buffer */
 	odp_timer *timers; /* User pointer and queue handle (and lock) */
-	odp_atomic_u32_t high_wm;/* High watermark of allocated timers */
-	odp_spinlock_t lock;
-	uint32_t num_alloc;/* Current number of allocated timers */
-	uint32_t first_free;/* 0..max_timers-1 => free timer */
+	timer_shard_t *shard; /* Free lists and wheels */
+	uint32_t num_shards;
+	odp_atomic_u32_t high_wm;/* One past the highest allocated index */
 	uint32_t tp_idx;/* Index into timer_pool array */
 	odp_timer_pool_param_t param;
 	char name[ODP_TIMER_POOL_NAME_LEN];
@@ -184,12 +240,29 @@ typedef struct odp_timer_pool_s {
 	pthread_t timer_thread; /* pthread_t of timer thread */
 	pid_t timer_thread_id; /* gettid() for timer thread */
 	int timer_thread_exit; /* request to exit for timer thread */
+	int inline_exp; /* Expired inline by threads polling for events */
+	uint64_t start_ns; /* Time of tick 0 for inline expiry */
 } odp_timer_pool;
 
 #define MAX_TIMER_POOLS 255 /* Leave one for ODP_TIMER_INVALID */
 #define INDEX_BITS 24
 static odp_atomic_u32_t num_timer_pools;
 static odp_timer_pool *timer_pool[MAX_TIMER_POOLS];
+/* Timer pools with ODP_CLOCK_CPU are expired inline instead of by a timer
+ * thread. Enabled with a non-zero ODP_TIMER_INLINE environment variable. */
+static int timer_inline;
+/* Number of shards per timer pool. Set with the ODP_TIMER_SHARDS environment
+ * variable. */
+static uint32_t timer_shards;
+/* One past the highest index of an inline timer pool */
+static odp_atomic_u32_t inline_max_idx;
+/* Number of threads expiring a timer pool inline. Kept outside of the pool,
+ * so that threads register before they access the pool. A pool is freed only
+ * after the count has drained. */
+static struct {
+	odp_atomic_u32_t num ODP_ALIGNED_CACHE;
+} inline_users[MAX_TIMER_POOLS];
+odp_atomic_u32_t _timer_num_inline;
 
 static inline odp_timer_pool *handle_to_tp(odp_timer_t hdl)
 {
@@ -219,9 +292,29 @@ static inline odp_timer_t tp_idx_to_handle(struct odp_timer_pool_s *tp,
 	return _odp_cast_scalar(odp_timer_t, (tp->tp_idx << INDEX_BITS) | idx);
 }
 
+static void tw_init(timer_wheel_t *tw, odp_atomic_u32_t *ring,
+		    uint32_t ring_size)
+{
+	uint32_t i, j;
+
+	tw->next_tick = 0;
+	for (i = 0; i < TW_LEVELS; i++)
+		for (j = 0; j < TW_SLOTS; j++)
+			tw->head[i][j] = TW_NONE;
+
+	tw->ring = ring;
+	tw->ring_mask = ring_size - 1;
+	tw->ring_head = 0;
+	odp_atomic_init_u32(&tw->ring_tail, 0);
+	for (i = 0; i < ring_size; i++)
+		odp_atomic_init_u32(&ring[i], TW_NONE);
+}
+
 /* Forward declarations */
 static void itimer_init(odp_timer_pool *tp);
 static void itimer_fini(odp_timer_pool *tp);
+static void inline_init(odp_timer_pool *tp);
+static void inline_fini(odp_timer_pool *tp);
 
 static odp_timer_pool_t odp_timer_pool_new(const char *name,
 					   const odp_timer_pool_param_t *param)
@@ -233,15 +326,27 @@ static odp_timer_pool_t odp_timer_pool_new(const char *name,
 		__odp_errno = ENFILE; /* Table overflow */
 		return ODP_TIMER_POOL_INVALID;
 	}
+	uint32_t num_shards = timer_shards;
+
+	if (num_shards > param->num_timers)
+		num_shards = param->num_timers ? param->num_timers : 1;
+	/* Shard sizes differ at most by one */
+	uint32_t max_shard_size = (param->num_timers + num_shards - 1) /
+				  num_shards;
 	size_t sz0 = ROUNDUP_CACHE_LINE(sizeof(odp_timer_pool));
+	size_t szs = ROUNDUP_CACHE_LINE(sizeof(timer_shard_t) * num_shards);
 	size_t sz1 = ROUNDUP_CACHE_LINE(sizeof(tick_buf_t) * param->num_timers);
 	size_t sz2 = ROUNDUP_CACHE_LINE(sizeof(odp_timer) * param->num_timers);
-	odp_shm_t shm = odp_shm_reserve(name, sz0 + sz1 + sz2,
-			ODP_CACHE_LINE_SIZE, ODP_SHM_SW_ONLY);
+	uint32_t ring_size = ROUNDUP_POWER2_U32(max_shard_size);
+	size_t sz3 = ROUNDUP_CACHE_LINE(sizeof(odp_atomic_u32_t) * ring_size);
+	size_t sz = sz0 + szs + sz1 + sz2 + sz3 * num_shards;
+	odp_shm_t shm = odp_shm_reserve(name, sz, ODP_CACHE_LINE_SIZE,
+					ODP_SHM_SW_ONLY);
 	if (odp_unlikely(shm == ODP_SHM_INVALID))
 		ODP_ABORT("%s: timer pool shm-alloc(%zuKB) failed\n",
-			  name, (sz0 + sz1 + sz2) / 1024);
+			  name, sz / 1024);
 	odp_timer_pool *tp = (odp_timer_pool *)odp_shm_addr(shm);
+	char *base = (char *)tp;
 	odp_atomic_init_u64(&tp->cur_tick, 0);
 
 	if (name == NULL) {
@@ -254,30 +359,55 @@ static odp_timer_pool_t odp_timer_pool_new(const char *name,
 	tp->param = *param;
 	tp->min_rel_tck = odp_timer_ns_to_tick(tp, param->min_tmo);
 	tp->max_rel_tck = odp_timer_ns_to_tick(tp, param->max_tmo);
-	tp->num_alloc = 0;
 	odp_atomic_init_u32(&tp->high_wm, 0);
-	tp->first_free = 0;
 	tp->notify_overrun = 1;
-	tp->tick_buf = (void *)((char *)odp_shm_addr(shm) + sz0);
-	tp->timers = (void *)((char *)odp_shm_addr(shm) + sz0 + sz1);
-	/* Initialize all odp_timer entries */
-	uint32_t i;
-	for (i = 0; i < tp->param.num_timers; i++) {
-		tp->timers[i].queue = ODP_QUEUE_INVALID;
-		set_next_free(&tp->timers[i], i + 1);
-		tp->timers[i].user_ptr = NULL;
+	tp->shard = (void *)(base + sz0);
+	tp->num_shards = num_shards;
+	tp->tick_buf = (void *)(base + sz0 + szs);
+	tp->timers = (void *)(base + sz0 + szs + sz1);
+	uint32_t i, j;
+
+	for (j = 0; j < num_shards; j++) {
+		timer_shard_t *sh = &tp->shard[j];
+
+		odp_spinlock_init(&sh->lock);
+		odp_spinlock_init(&sh->expire_lock);
+		sh->num_alloc = 0;
+		sh->high_wm = 0;
+		sh->base = (uint64_t)param->num_timers * j / num_shards;
+		sh->end = (uint64_t)param->num_timers * (j + 1) / num_shards;
+		sh->first_free = sh->base;
+		sh->cur_tick = 0;
+		tw_init(&sh->tw, (void *)(base + sz0 + szs + sz1 + sz2 +
+					  sz3 * j), ring_size);
+		/* Initialize all odp_timer entries of the shard. The free
+		 * list of the shard ends at index 'end'. */
+		for (i = sh->base; i < sh->end; i++) {
+			tp->timers[i].queue = ODP_QUEUE_INVALID;
+			set_next_free(&tp->timers[i], i + 1);
+			tp->timers[i].user_ptr = NULL;
+			odp_atomic_init_u64(&tp->timers[i].due, UINT64_MAX);
+			odp_atomic_init_u32(&tp->timers[i].dirty, 0);
+			tp->timers[i].shard = j;
+			tp->timers[i].slot = TW_NONE;
 #if __GCC_ATOMIC_LLONG_LOCK_FREE < 2
-		tp->tick_buf[i].exp_tck.v = TMO_UNUSED;
+			tp->tick_buf[i].exp_tck.v = TMO_UNUSED;
 #else
-		odp_atomic_init_u64(&tp->tick_buf[i].exp_tck, TMO_UNUSED);
+			odp_atomic_init_u64(&tp->tick_buf[i].exp_tck,
+					    TMO_UNUSED);
 #endif
-		tp->tick_buf[i].tmo_buf = ODP_BUFFER_INVALID;
+			tp->tick_buf[i].tmo_buf = ODP_BUFFER_INVALID;
+		}
 	}
 	tp->tp_idx = tp_idx;
-	odp_spinlock_init(&tp->lock);
+	tp->inline_exp = 0;
 	timer_pool[tp_idx] = tp;
-	if (tp->param.clk_src == ODP_CLOCK_CPU)
-		itimer_init(tp);
+	if (tp->param.clk_src == ODP_CLOCK_CPU) {
+		if (timer_inline)
+			inline_init(tp);
+		else
+			itimer_init(tp);
+	}
 	return tp;
 }
 
@@ -301,18 +431,32 @@ static void stop_timer_thread(odp_timer_pool *tp)
 		ODP_ABORT("unable to join thread, err %d\n", ret);
 }
 
+static uint32_t timer_pool_num_alloc(odp_timer_pool *tp)
+{
+	uint32_t i, num = 0;
+
+	for (i = 0; i < tp->num_shards; i++)
+		num += tp->shard[i].num_alloc;
+
+	return num;
+}
+
 static void odp_timer_pool_del(odp_timer_pool *tp)
 {
-	odp_spinlock_lock(&tp->lock);
 	timer_pool[tp->tp_idx] = NULL;
+	odp_mb_full();
 
 	/* Stop timer triggering */
-	if (tp->param.clk_src == ODP_CLOCK_CPU)
-		itimer_fini(tp);
+	if (tp->inline_exp) {
+		inline_fini(tp);
+	} else {
+		if (tp->param.clk_src == ODP_CLOCK_CPU)
+			itimer_fini(tp);
 
-	stop_timer_thread(tp);
+		stop_timer_thread(tp);
+	}
 
-	if (tp->num_alloc != 0) {
+	if (timer_pool_num_alloc(tp) != 0) {
 		/* It's a programming error to attempt to destroy a */
 		/* timer pool which is still in use */
 		ODP_ABORT("%s: timers in use\n", tp->name);
@@ -324,37 +468,67 @@ static void odp_timer_pool_del(odp_timer_pool *tp)
 	odp_atomic_sub_u32(&num_timer_pools, 1);
 }
 
-static inline odp_timer_t timer_alloc(odp_timer_pool *tp,
+/* Shard of the CPU of the calling thread */
+static inline uint32_t this_shard(odp_timer_pool *tp)
+{
+	if (tp->num_shards == 1)
+		return 0;
+
+	return (uint32_t)odp_cpu_id() % tp->num_shards;
+}
+
+static inline odp_timer_t shard_alloc(odp_timer_pool *tp,
+				      timer_shard_t *sh,
 				      odp_queue_t queue,
 				      void *user_ptr)
 {
 	odp_timer_t hdl;
-	odp_spinlock_lock(&tp->lock);
-	if (odp_likely(tp->num_alloc < tp->param.num_timers)) {
-		tp->num_alloc++;
+	odp_spinlock_lock(&sh->lock);
+	if (odp_likely(sh->first_free != sh->end)) {
+		sh->num_alloc++;
 		/* Remove first unused timer from free list */
-		ODP_ASSERT(tp->first_free != tp->param.num_timers);
-		uint32_t idx = tp->first_free;
+		uint32_t idx = sh->first_free;
 		odp_timer *tim = &tp->timers[idx];
-		tp->first_free = get_next_free(tim);
+		sh->first_free = get_next_free(tim);
 		/* Initialize timer */
 		timer_init(tim, &tp->tick_buf[idx], queue, user_ptr);
-		if (odp_unlikely(tp->num_alloc >
-				 odp_atomic_load_u32(&tp->high_wm)))
-			/* Update high_wm last with release model to
-			 * ensure timer initialization is visible */
-			_odp_atomic_u32_store_mm(&tp->high_wm,
-						 tp->num_alloc,
-						 _ODP_MEMMODEL_RLS);
+		if (odp_unlikely(sh->num_alloc > sh->high_wm)) {
+			sh->high_wm = sh->num_alloc;
+			/* Free lists hand out unused indexes in order */
+			odp_atomic_max_u32(&tp->high_wm,
+					   sh->base + sh->high_wm);
+		}
 		hdl = tp_idx_to_handle(tp, idx);
 	} else {
-		__odp_errno = ENFILE; /* Reusing file table overflow */
 		hdl = ODP_TIMER_INVALID;
 	}
-	odp_spinlock_unlock(&tp->lock);
+	odp_spinlock_unlock(&sh->lock);
 	return hdl;
 }
 
+static inline odp_timer_t timer_alloc(odp_timer_pool *tp,
+				      odp_queue_t queue,
+				      void *user_ptr)
+{
+	uint32_t first = this_shard(tp);
+	uint32_t i, j;
+	odp_timer_t hdl;
+
+	/* Use timers of other shards when the own shard runs out */
+	for (i = 0; i < tp->num_shards; i++) {
+		j = first + i;
+		if (j >= tp->num_shards)
+			j -= tp->num_shards;
+
+		hdl = shard_alloc(tp, &tp->shard[j], queue, user_ptr);
+		if (odp_likely(hdl != ODP_TIMER_INVALID))
+			return hdl;
+	}
+
+	__odp_errno = ENFILE; /* Reusing file table overflow */
+	return ODP_TIMER_INVALID;
+}
+
 static odp_buffer_t timer_cancel(odp_timer_pool *tp,
 		uint32_t idx,
 		uint64_t new_state);
@@ -362,6 +536,7 @@ static odp_buffer_t timer_cancel(odp_timer_pool *tp,
 static inline odp_buffer_t timer_free(odp_timer_pool *tp, uint32_t idx)
 {
 	odp_timer *tim = &tp->timers[idx];
+	timer_shard_t *sh = &tp->shard[tim->shard];
 
 	/* Free the timer by setting timer state to unused and
 	 * grab any timeout buffer */
@@ -371,12 +546,12 @@ static inline odp_buffer_t timer_free(odp_timer_pool *tp, uint32_t idx)
 	timer_fini(tim, &tp->tick_buf[idx]);
 
 	/* Insert timer into free list */
-	odp_spinlock_lock(&tp->lock);
-	set_next_free(tim, tp->first_free);
-	tp->first_free = idx;
-	ODP_ASSERT(tp->num_alloc != 0);
-	tp->num_alloc--;
-	odp_spinlock_unlock(&tp->lock);
+	odp_spinlock_lock(&sh->lock);
+	set_next_free(tim, sh->first_free);
+	sh->first_free = idx;
+	ODP_ASSERT(sh->num_alloc != 0);
+	sh->num_alloc--;
+	odp_spinlock_unlock(&sh->lock);
 
 	return old_buf;
 }
@@ -386,6 +561,44 @@ static inline odp_buffer_t timer_free(odp_timer_pool *tp, uint32_t idx)
  * expire/reset/cancel timer
  *****************************************************************************/
 
+/* Pass a set timer to the thread expiring the pool, unless the wheel is
+ * going to check the timer before the new expiration tick anyway. Each timer
+ * is in the set ring at most once, so that the ring cannot overflow. Must be
+ * preceded by tw_set_barrier() after the new expiration tick has been written
+ * into tick_buf. */
+static inline void tw_push(odp_timer_pool *tp, uint32_t idx, uint64_t abs_tck)
+{
+	odp_timer *tim = &tp->timers[idx];
+	timer_wheel_t *tw = &tp->shard[tim->shard].tw;
+	uint32_t pos;
+
+	if (odp_likely(abs_tck >= odp_atomic_load_u64(&tim->due)))
+		return;
+
+	if (odp_atomic_load_u32(&tim->dirty) ||
+	    _odp_atomic_u32_xchg_mm(&tim->dirty, 1, _ODP_MEMMODEL_ACQ))
+		return;
+
+	pos = odp_atomic_fetch_inc_u32(&tw->ring_tail);
+	_odp_atomic_u32_store_mm(&tw->ring[pos & tw->ring_mask], idx,
+				 _ODP_MEMMODEL_RLS);
+}
+
+/* Order tick_buf writes before loads of due and dirty in tw_push(). Pairs
+ * with the barrier in tw_check(). Either the wheel thread sees the new
+ * expiration tick, or this thread sees the timer unlinked. A single barrier
+ * covers any number of timers set before it. */
+static inline void tw_set_barrier(void)
+{
+	odp_mb_full();
+}
+
+static inline void tw_set(odp_timer_pool *tp, uint32_t idx, uint64_t abs_tck)
+{
+	tw_set_barrier();
+	tw_push(tp, idx, abs_tck);
+}
+
 static bool timer_reset(uint32_t idx,
 		uint64_t abs_tck,
 		odp_buffer_t *tmo_buf,
@@ -527,6 +740,9 @@ static odp_buffer_t timer_cancel(odp_timer_pool *tp,
 	tick_buf_t *tb = &tp->tick_buf[idx];
 	odp_buffer_t old_buf;
 
+	/* Stop a periodic timer. It is published by the next set operation. */
+	tp->timers[idx].period = 0;
+
 #ifdef ODP_ATOMIC_U128
 	tick_buf_t new, old;
 	/* Update the timer state (e.g. cancel the current timeout) */
@@ -559,6 +775,65 @@ static odp_buffer_t timer_cancel(odp_timer_pool *tp,
 	return old_buf;
 }
 
+/* Expiration tick of the first period of a periodic timer after 'tick'.
+ * Periods that have already passed are skipped. */
+static inline uint64_t next_period(uint64_t exp_tck, uint64_t period,
+				   uint64_t tick)
+{
+	return exp_tck + ((tick - exp_tck) / period + 1) * period;
+}
+
+/* Hand a timeout buffer back to a periodic timer. Returns 1 without taking
+ * the buffer when the timer has been stopped meanwhile. */
+static int timer_ack(odp_timer_pool *tp, uint32_t idx, odp_buffer_t buf)
+{
+	tick_buf_t *tb = &tp->tick_buf[idx];
+	int ret = 0;
+
+#ifdef ODP_ATOMIC_U128
+	tick_buf_t new, old;
+
+	do {
+		/* Relaxed and non-atomic read of current values */
+		old.exp_tck.v = tb->exp_tck.v;
+		old.tmo_buf = tb->tmo_buf;
+		TB_SET_PAD(old);
+		/* Cancelled or freed timer */
+		if (old.exp_tck.v & TMO_INACTIVE)
+			return 1;
+		/* Timer already has a timeout buffer */
+		if (old.tmo_buf != ODP_BUFFER_INVALID)
+			return -1;
+		new.exp_tck.v = old.exp_tck.v;
+		new.tmo_buf = buf;
+		TB_SET_PAD(new);
+		/* Release the timeout buffer to the thread expiring the
+		 * timer */
+	} while (!_odp_atomic_u128_cmp_xchg_mm((_odp_atomic_u128_t *)tb,
+					       (_uint128_t *)&old,
+					       (_uint128_t *)&new,
+					       _ODP_MEMMODEL_RLS,
+					       _ODP_MEMMODEL_RLX));
+#else
+	/* Take a related lock */
+	while (_odp_atomic_flag_tas(IDX2LOCK(idx)))
+		/* While lock is taken, spin using relaxed loads */
+		while (_odp_atomic_flag_load(IDX2LOCK(idx)))
+			odp_cpu_pause();
+
+	if (tb->exp_tck.v & TMO_INACTIVE)
+		ret = 1;
+	else if (tb->tmo_buf != ODP_BUFFER_INVALID)
+		ret = -1;
+	else
+		tb->tmo_buf = buf;
+
+	/* Release the lock */
+	_odp_atomic_flag_clear(IDX2LOCK(idx));
+#endif
+	return ret;
+}
+
 static unsigned timer_expire(odp_timer_pool *tp, uint32_t idx, uint64_t tick)
 {
 	odp_timer *tim = &tp->timers[idx];
@@ -566,20 +841,27 @@ static unsigned timer_expire(odp_timer_pool *tp, uint32_t idx, uint64_t tick)
 	odp_buffer_t tmo_buf = ODP_BUFFER_INVALID;
 	uint64_t exp_tck;
 #ifdef ODP_ATOMIC_U128
-	/* Atomic re-read for correctness */
-	exp_tck = _odp_atomic_u64_load_mm(&tb->exp_tck, _ODP_MEMMODEL_RLX);
+	/* Atomic re-read for correctness. Acquire the period of a timer
+	 * released by odp_timer_periodic_start(). */
+	exp_tck = _odp_atomic_u64_load_mm(&tb->exp_tck, _ODP_MEMMODEL_ACQ);
 	/* Re-check exp_tck */
 	if (odp_likely(exp_tck <= tick)) {
 		/* Attempt to grab timeout buffer, replace with inactive timer
 		 * and invalid buffer */
 		tick_buf_t new, old;
+		uint64_t period = tim->period;
+
 		old.exp_tck.v = exp_tck;
 		old.tmo_buf = tb->tmo_buf;
 		TB_SET_PAD(old);
 		/* Set the inactive/expired bit keeping the expiration tick so
 		 * that we can check against the expiration tick of the timeout
-		 * when it is received */
-		new.exp_tck.v = exp_tck | TMO_INACTIVE;
+		 * when it is received. Periodic timers are re-armed instead,
+		 * also when the application still holds the timeout. */
+		if (odp_unlikely(period))
+			new.exp_tck.v = next_period(exp_tck, period, tick);
+		else
+			new.exp_tck.v = exp_tck | TMO_INACTIVE;
 		new.tmo_buf = ODP_BUFFER_INVALID;
 		TB_SET_PAD(new);
 		int succ = _odp_atomic_u128_cmp_xchg_mm(
@@ -600,7 +882,12 @@ static unsigned timer_expire(odp_timer_pool *tp, uint32_t idx, uint64_t tick)
 			odp_cpu_pause();
 	/* Proper check for timer expired */
 	exp_tck = tb->exp_tck.v;
-	if (odp_likely(exp_tck <= tick)) {
+	if (odp_unlikely(exp_tck <= tick && tim->period)) {
+		/* Re-arm periodic timer, grab any timeout buffer */
+		tmo_buf = tb->tmo_buf;
+		tb->tmo_buf = ODP_BUFFER_INVALID;
+		tb->exp_tck.v = next_period(exp_tck, tim->period, tick);
+	} else if (odp_likely(exp_tck <= tick)) {
 		/* Verify that there is a timeout buffer */
 		if (odp_likely(tb->tmo_buf != ODP_BUFFER_INVALID)) {
 			/* Grab timeout buffer, replace with inactive timer
@@ -645,31 +932,184 @@ static unsigned timer_expire(odp_timer_pool *tp, uint32_t idx, uint64_t tick)
 	}
 }
 
-static unsigned odp_timer_pool_expire(odp_timer_pool_t tpid, uint64_t tick)
+static void tw_link(odp_timer_pool *tp, timer_wheel_t *tw, uint32_t idx,
+		    uint64_t exp_tck)
+{
+	odp_timer *tim = &tp->timers[idx];
+	uint64_t delta = exp_tck - tw->next_tick;
+	uint32_t level = 0;
+	uint32_t shift, slot;
+
+	if (odp_unlikely(delta > TW_MAX_DELTA)) {
+		/* Beyond the wheel, check again when the last level slot
+		 * is cascaded */
+		exp_tck = tw->next_tick + TW_MAX_DELTA;
+		delta = TW_MAX_DELTA;
+	}
+
+	while (delta >> ((level + 1) * TW_SLOT_BITS))
+		level++;
+
+	shift = level * TW_SLOT_BITS;
+	slot = (exp_tck >> shift) & TW_SLOT_MASK;
+
+	tim->slot = level * TW_SLOTS + slot;
+	tim->prev = TW_NONE;
+	tim->next = tw->head[level][slot];
+	if (tim->next != TW_NONE)
+		tp->timers[tim->next].prev = idx;
+	tw->head[level][slot] = idx;
+
+	/* Slot is processed (level 0) or cascaded on this tick */
+	odp_atomic_store_u64(&tim->due, (exp_tck >> shift) << shift);
+}
+
+static void tw_unlink(odp_timer_pool *tp, timer_wheel_t *tw, uint32_t idx)
+{
+	odp_timer *tim = &tp->timers[idx];
+
+	if (tim->prev != TW_NONE)
+		tp->timers[tim->prev].next = tim->next;
+	else
+		tw->head[tim->slot / TW_SLOTS][tim->slot % TW_SLOTS] =
+			tim->next;
+
+	if (tim->next != TW_NONE)
+		tp->timers[tim->next].prev = tim->prev;
+
+	tim->slot = TW_NONE;
+}
+
+/* Expire or (re)link a timer based on its current expiration tick. The
+ * timer must not be in any wheel list. */
+static unsigned tw_check(odp_timer_pool *tp, timer_wheel_t *tw, uint32_t idx)
+{
+	uint64_t exp_tck;
+
+	odp_atomic_store_u64(&tp->timers[idx].due, UINT64_MAX);
+	/* Pairs with the barrier in tw_set() */
+	odp_mb_full();
+#if __GCC_ATOMIC_LLONG_LOCK_FREE < 2
+	exp_tck = tp->tick_buf[idx].exp_tck.v;
+#else
+	exp_tck = odp_atomic_load_u64(&tp->tick_buf[idx].exp_tck);
+#endif
+	/* Inactive and unused timers drop out of the wheel. They are set
+	 * again through tw_set(). */
+	if (exp_tck & TMO_INACTIVE)
+		return 0;
+
+	if (exp_tck < tw->next_tick) {
+		unsigned nexp = timer_expire(tp, idx, tw->next_tick - 1);
+
+		/* Periodic timers have been re-armed for the next period */
+#if __GCC_ATOMIC_LLONG_LOCK_FREE < 2
+		exp_tck = tp->tick_buf[idx].exp_tck.v;
+#else
+		exp_tck = odp_atomic_load_u64(&tp->tick_buf[idx].exp_tck);
+#endif
+		if ((exp_tck & TMO_INACTIVE) || exp_tck < tw->next_tick)
+			return nexp;
+
+		tw_link(tp, tw, idx, exp_tck);
+		return nexp;
+	}
+
+	tw_link(tp, tw, idx, exp_tck);
+	return 0;
+}
+
+/* Check all timers of a slot list */
+static unsigned tw_run_slot(odp_timer_pool *tp, timer_wheel_t *tw,
+			    uint32_t level, uint32_t slot)
 {
-	tick_buf_t *array = &tpid->tick_buf[0];
-	uint32_t high_wm = _odp_atomic_u32_load_mm(&tpid->high_wm,
-			_ODP_MEMMODEL_ACQ);
+	uint32_t idx = tw->head[level][slot];
 	unsigned nexp = 0;
-	uint32_t i;
 
-	ODP_ASSERT(high_wm <= tpid->param.num_timers);
-	for (i = 0; i < high_wm;) {
-		/* As a rare occurrence, we can outsmart the HW prefetcher
-		 * and the compiler (GCC -fprefetch-loop-arrays) with some
-		 * tuned manual prefetching (32x16=512B ahead), seems to
-		 * give 30% better performance on ARM C-A15 */
-		__builtin_prefetch(&array[i + 32], 0, 0);
-		/* Non-atomic read for speed */
-		uint64_t exp_tck = array[i++].exp_tck.v;
-		if (odp_unlikely(exp_tck <= tick)) {
-			/* Attempt to expire timer */
-			nexp += timer_expire(tpid, i - 1, tick);
+	tw->head[level][slot] = TW_NONE;
+
+	while (idx != TW_NONE) {
+		odp_timer *tim = &tp->timers[idx];
+		uint32_t next = tim->next;
+
+		if (next != TW_NONE)
+			__builtin_prefetch(&tp->tick_buf[next], 0, 0);
+		tim->slot = TW_NONE;
+		nexp += tw_check(tp, tw, idx);
+		idx = next;
+	}
+	return nexp;
+}
+
+/* Move timers set by other threads into the wheel */
+static unsigned tw_drain(odp_timer_pool *tp, timer_wheel_t *tw)
+{
+	unsigned nexp = 0;
+
+	while (1) {
+		odp_atomic_u32_t *entry = &tw->ring[tw->ring_head &
+						    tw->ring_mask];
+		uint32_t idx = _odp_atomic_u32_load_mm(entry,
+						       _ODP_MEMMODEL_ACQ);
+		odp_timer *tim;
+
+		/* Empty, or a writer has not yet completed the entry */
+		if (idx == TW_NONE)
+			break;
+
+		_odp_atomic_u32_store_mm(entry, TW_NONE, _ODP_MEMMODEL_RLX);
+		tw->ring_head++;
+
+		tim = &tp->timers[idx];
+		odp_atomic_store_u32(&tim->dirty, 0);
+		if (tim->slot != TW_NONE)
+			tw_unlink(tp, tw, idx);
+		nexp += tw_check(tp, tw, idx);
+	}
+	return nexp;
+}
+
+/* Process all ticks of a shard up to and including 'tick'. The cost is
+ * proportional to the number of timers set and expired since the previous
+ * call, not to the number of timers in the shard. */
+static unsigned shard_expire(odp_timer_pool *tp, timer_shard_t *sh,
+			     uint64_t tick)
+{
+	timer_wheel_t *tw = &sh->tw;
+	unsigned nexp = tw_drain(tp, tw);
+
+	while (tw->next_tick <= tick) {
+		uint64_t cur = tw->next_tick;
+		uint32_t level;
+
+		/* Cascade timers of higher level slots down to lower levels
+		 * when the lower level wraps around */
+		for (level = 1; level < TW_LEVELS; level++) {
+			uint32_t shift = level * TW_SLOT_BITS;
+
+			if (cur & ((UINT64_C(1) << shift) - 1))
+				break;
+			nexp += tw_run_slot(tp, tw, level,
+					    (cur >> shift) & TW_SLOT_MASK);
 		}
+
+		tw->next_tick = cur + 1;
+		nexp += tw_run_slot(tp, tw, 0, cur & TW_SLOT_MASK);
 	}
 	return nexp;
 }
 
+static unsigned odp_timer_pool_expire(odp_timer_pool_t tpid, uint64_t tick)
+{
+	unsigned nexp = 0;
+	uint32_t i;
+
+	for (i = 0; i < tpid->num_shards; i++)
+		nexp += shard_expire(tpid, &tpid->shard[i], tick);
+
+	return nexp;
+}
+
 /******************************************************************************
  * POSIX timer support
  * Functions that use Linux/POSIX per-process timers and related facilities
@@ -689,18 +1129,10 @@ static void timer_notify(odp_timer_pool *tp)
 		}
 	}
 
-	odp_timer *array = &tp->timers[0];
-	uint32_t i;
-	/* Prefetch initial cache lines (match 32 above) */
-	for (i = 0; i < 32; i += ODP_CACHE_LINE_SIZE / sizeof(array[0]))
-		__builtin_prefetch(&array[i], 0, 0);
 	prev_tick = odp_atomic_fetch_inc_u64(&tp->cur_tick);
 
-	/* Scan timer array, looking for timers to expire */
+	/* Expire timers of the tick */
 	(void)odp_timer_pool_expire(tp, prev_tick + 1);
-
-	/* Else skip scan of timers. cur_tick was updated and next itimer
-	 * invocation will process older expiration ticks as well */
 }
 
 static void *timer_thread(void *arg)
@@ -787,6 +1219,124 @@ static void itimer_fini(odp_timer_pool *tp)
 			  strerror(errno));
 }
 
+/******************************************************************************
+ * Inline timer support
+ * Threads polling for events advance and expire timer pools, when the
+ * tick period has elapsed. No signals or timer threads are needed.
+ *****************************************************************************/
+
+static inline uint64_t inline_tick(odp_timer_pool *tp, uint64_t now_ns)
+{
+	return (now_ns - tp->start_ns) / tp->param.res_ns;
+}
+
+static void inline_init(odp_timer_pool *tp)
+{
+	uint32_t i;
+
+	ODP_DBG("Timer pool %s expired inline, period %" PRIu64 " ns\n",
+		tp->name, tp->param.res_ns);
+
+	tp->inline_exp = 1;
+	tp->start_ns = odp_time_to_ns(odp_time_local());
+	for (i = 0; i < tp->num_shards; i++)
+		odp_atomic_init_u64(&tp->shard[i].next_ns,
+				    tp->start_ns + tp->param.res_ns);
+
+	odp_atomic_max_u32(&inline_max_idx, tp->tp_idx + 1);
+	odp_atomic_inc_u32(&_timer_num_inline);
+}
+
+static void inline_fini(odp_timer_pool *tp)
+{
+	odp_atomic_u32_t *users = &inline_users[tp->tp_idx].num;
+
+	odp_atomic_dec_u32(&_timer_num_inline);
+
+	/* The pool has been removed from timer_pool[]. Wait for threads that
+	 * registered before that and may still access the pool. */
+	while (odp_atomic_load_acq_u32(users))
+		odp_cpu_pause();
+}
+
+static inline void inline_expire(odp_timer_pool *tp, timer_shard_t *sh,
+				 uint64_t now)
+{
+	uint64_t tick;
+
+	/* Another thread is expiring the shard */
+	if (!odp_spinlock_trylock(&sh->expire_lock))
+		return;
+
+	tick = inline_tick(tp, now);
+
+	if (tick > sh->cur_tick + CONFIG_TIMER_INLINE_MAX_TICKS)
+		tick = sh->cur_tick + CONFIG_TIMER_INLINE_MAX_TICKS;
+
+	if (tick > sh->cur_tick) {
+		sh->cur_tick = tick;
+		odp_atomic_max_u64(&tp->cur_tick, tick);
+		(void)shard_expire(tp, sh, tick);
+		odp_atomic_store_u64(&sh->next_ns, tp->start_ns +
+				     (tick + 1) * tp->param.res_ns);
+	}
+
+	odp_spinlock_unlock(&sh->expire_lock);
+}
+
+void _timer_run(void)
+{
+	uint32_t max_idx = odp_atomic_load_u32(&inline_max_idx);
+	uint64_t now = odp_time_to_ns(odp_time_local());
+	uint32_t i, j, own;
+
+	for (i = 0; i < max_idx; i++) {
+		odp_atomic_u32_t *users = &inline_users[i].num;
+		odp_timer_pool *tp;
+
+		if (timer_pool[i] == NULL)
+			continue;
+
+		/* Register before loading the pool, pairs with
+		 * odp_timer_pool_del() */
+		odp_atomic_inc_u32(users);
+		odp_mb_full();
+
+		tp = timer_pool[i];
+		if (tp == NULL || !tp->inline_exp) {
+			odp_atomic_sub_rel_u32(users, 1);
+			continue;
+		}
+
+		own = this_shard(tp);
+
+		for (j = 0; j < tp->num_shards; j++) {
+			timer_shard_t *sh = &tp->shard[j];
+			uint64_t next_ns = odp_atomic_load_u64(&sh->next_ns);
+
+			/* Shards of other CPUs are left to their own threads,
+			 * unless those have fallen a full tick behind */
+			if (j != own)
+				next_ns += tp->param.res_ns;
+
+			if (now >= next_ns)
+				inline_expire(tp, sh, now);
+		}
+
+		odp_atomic_sub_rel_u32(users, 1);
+	}
+}
+
+/* Current tick for setting timers. Inline pools derive it from time, since
+ * expiry may lag behind when threads do not poll for events. */
+static inline uint64_t current_tick(odp_timer_pool *tp)
+{
+	if (tp->inline_exp)
+		return inline_tick(tp, odp_time_to_ns(odp_time_local()));
+
+	return odp_atomic_load_u64(&tp->cur_tick);
+}
+
 /******************************************************************************
  * Public API functions
  * Some parameter checks and error messages
@@ -827,16 +1377,20 @@ uint64_t odp_timer_ns_to_tick(odp_timer_pool_t tpid, uint64_t ns)
 
 uint64_t odp_timer_current_tick(odp_timer_pool_t tpid)
 {
-	/* Relaxed atomic read for lowest overhead */
-	return odp_atomic_load_u64(&tpid->cur_tick);
+	return current_tick(tpid);
 }
 
 int odp_timer_pool_info(odp_timer_pool_t tpid,
 			odp_timer_pool_info_t *buf)
 {
+	uint32_t i, hwm = 0;
+
+	for (i = 0; i < tpid->num_shards; i++)
+		hwm += tpid->shard[i].high_wm;
+
 	buf->param = tpid->param;
-	buf->cur_timers = tpid->num_alloc;
-	buf->hwm_timers = odp_atomic_load_u32(&tpid->high_wm);
+	buf->cur_timers = timer_pool_num_alloc(tpid);
+	buf->hwm_timers = hwm;
 	buf->name = tpid->name;
 	return 0;
 }
@@ -878,15 +1432,19 @@ int odp_timer_set_abs(odp_timer_t hdl,
 {
 	odp_timer_pool *tp = handle_to_tp(hdl);
 	uint32_t idx = handle_to_idx(hdl, tp);
-	uint64_t cur_tick = odp_atomic_load_u64(&tp->cur_tick);
+	uint64_t cur_tick = current_tick(tp);
 	if (odp_unlikely(abs_tck < cur_tick + tp->min_rel_tck))
 		return ODP_TIMER_TOOEARLY;
 	if (odp_unlikely(abs_tck > cur_tick + tp->max_rel_tck))
 		return ODP_TIMER_TOOLATE;
-	if (timer_reset(idx, abs_tck, (odp_buffer_t *)tmo_ev, tp))
+	/* One-shot set stops a periodic timer */
+	tp->timers[idx].period = 0;
+	if (timer_reset(idx, abs_tck, (odp_buffer_t *)tmo_ev, tp)) {
+		tw_set(tp, idx, abs_tck);
 		return ODP_TIMER_SUCCESS;
-	else
+	} else {
 		return ODP_TIMER_NOEVENT;
+	}
 }
 
 int odp_timer_set_rel(odp_timer_t hdl,
@@ -895,15 +1453,19 @@ int odp_timer_set_rel(odp_timer_t hdl,
 {
 	odp_timer_pool *tp = handle_to_tp(hdl);
 	uint32_t idx = handle_to_idx(hdl, tp);
-	uint64_t abs_tck = odp_atomic_load_u64(&tp->cur_tick) + rel_tck;
+	uint64_t abs_tck = current_tick(tp) + rel_tck;
 	if (odp_unlikely(rel_tck < tp->min_rel_tck))
 		return ODP_TIMER_TOOEARLY;
 	if (odp_unlikely(rel_tck > tp->max_rel_tck))
 		return ODP_TIMER_TOOLATE;
-	if (timer_reset(idx, abs_tck, (odp_buffer_t *)tmo_ev, tp))
+	/* One-shot set stops a periodic timer */
+	tp->timers[idx].period = 0;
+	if (timer_reset(idx, abs_tck, (odp_buffer_t *)tmo_ev, tp)) {
+		tw_set(tp, idx, abs_tck);
 		return ODP_TIMER_SUCCESS;
-	else
+	} else {
 		return ODP_TIMER_NOEVENT;
+	}
 }
 
 int odp_timer_cancel(odp_timer_t hdl, odp_event_t *tmo_ev)
@@ -920,6 +1482,153 @@ int odp_timer_cancel(odp_timer_t hdl, odp_event_t *tmo_ev)
 	}
 }
 
+/* Set timers in bursts. Handles of a burst are decoded first, so that the
+ * timer state of all timers is prefetched before it is modified. The wheel is
+ * notified of the whole burst after a single barrier. */
+static int timer_set_multi(const odp_timer_t hdl[], const uint64_t tck[],
+			   int rel, odp_event_t tmo_ev[], int num)
+{
+	odp_timer_pool *tp[TIMER_MULTI_BURST];
+	uint32_t idx[TIMER_MULTI_BURST];
+	uint64_t abs_tck[TIMER_MULTI_BURST];
+	odp_timer_pool *cur_tp = NULL;
+	uint64_t cur_tick = 0;
+	int num_set = 0;
+
+	while (num_set < num) {
+		int burst = num - num_set;
+		int i, n;
+
+		if (burst > TIMER_MULTI_BURST)
+			burst = TIMER_MULTI_BURST;
+
+		for (i = 0; i < burst; i++) {
+			tp[i] = handle_to_tp(hdl[num_set + i]);
+			idx[i] = handle_to_idx(hdl[num_set + i], tp[i]);
+			__builtin_prefetch(&tp[i]->timers[idx[i]], 1, 0);
+			__builtin_prefetch(&tp[i]->tick_buf[idx[i]], 1, 0);
+		}
+
+		for (n = 0; n < burst; n++) {
+			uint64_t t = tck[num_set + n];
+			odp_buffer_t *tmo_buf = NULL;
+
+			/* Current tick is read once per run of timers from
+			 * the same pool */
+			if (tp[n] != cur_tp) {
+				cur_tp = tp[n];
+				cur_tick = current_tick(cur_tp);
+			}
+
+			abs_tck[n] = rel ? cur_tick + t : t;
+			if (odp_unlikely(abs_tck[n] <
+					 cur_tick + cur_tp->min_rel_tck ||
+					 abs_tck[n] >
+					 cur_tick + cur_tp->max_rel_tck))
+				break;
+
+			if (tmo_ev != NULL)
+				tmo_buf = (odp_buffer_t *)&tmo_ev[num_set + n];
+
+			/* One-shot set stops a periodic timer */
+			tp[n]->timers[idx[n]].period = 0;
+
+			if (odp_unlikely(!timer_reset(idx[n], abs_tck[n],
+						      tmo_buf, tp[n])))
+				break;
+		}
+
+		tw_set_barrier();
+		for (i = 0; i < n; i++)
+			tw_push(tp[i], idx[i], abs_tck[i]);
+
+		num_set += n;
+		if (n < burst)
+			break;
+	}
+
+	return num_set;
+}
+
+int odp_timer_set_abs_multi(const odp_timer_t tim[], const uint64_t abs_tck[],
+			    odp_event_t tmo_ev[], int num)
+{
+	return timer_set_multi(tim, abs_tck, 0, tmo_ev, num);
+}
+
+int odp_timer_set_rel_multi(const odp_timer_t tim[], const uint64_t rel_tck[],
+			    odp_event_t tmo_ev[], int num)
+{
+	return timer_set_multi(tim, rel_tck, 1, tmo_ev, num);
+}
+
+int odp_timer_cancel_multi(const odp_timer_t tim[], odp_event_t tmo_ev[],
+			   int num)
+{
+	odp_timer_pool *tp[TIMER_MULTI_BURST];
+	uint32_t idx[TIMER_MULTI_BURST];
+	int num_cancel = 0;
+	int done = 0;
+
+	while (done < num) {
+		int burst = num - done;
+		int i;
+
+		if (burst > TIMER_MULTI_BURST)
+			burst = TIMER_MULTI_BURST;
+
+		for (i = 0; i < burst; i++) {
+			tp[i] = handle_to_tp(tim[done + i]);
+			idx[i] = handle_to_idx(tim[done + i], tp[i]);
+		}
+
+		for (i = 0; i < burst; i++) {
+			odp_buffer_t old_buf = timer_cancel(tp[i], idx[i],
+							    TMO_INACTIVE);
+
+			tmo_ev[done + i] = odp_buffer_to_event(old_buf);
+			if (old_buf != ODP_BUFFER_INVALID)
+				num_cancel++;
+		}
+
+		done += burst;
+	}
+
+	return num_cancel;
+}
+
+int odp_timer_periodic_start(odp_timer_t hdl, uint64_t first_tck,
+			     uint64_t period, odp_event_t *tmo_ev)
+{
+	odp_timer_pool *tp = handle_to_tp(hdl);
+	uint32_t idx = handle_to_idx(hdl, tp);
+	uint64_t cur_tick = current_tick(tp);
+
+	if (odp_unlikely(tmo_ev == NULL || *tmo_ev == ODP_EVENT_INVALID))
+		return ODP_TIMER_NOEVENT;
+	if (odp_unlikely(first_tck < cur_tick + tp->min_rel_tck ||
+			 period == 0 || period < tp->min_rel_tck))
+		return ODP_TIMER_TOOEARLY;
+	if (odp_unlikely(first_tck > cur_tick + tp->max_rel_tck ||
+			 period > tp->max_rel_tck))
+		return ODP_TIMER_TOOLATE;
+
+	/* Released to the thread expiring the timer together with the
+	 * timeout buffer */
+	tp->timers[idx].period = period;
+	(void)timer_reset(idx, first_tck, (odp_buffer_t *)tmo_ev, tp);
+	tw_set(tp, idx, first_tck);
+	return ODP_TIMER_SUCCESS;
+}
+
+int odp_timer_periodic_ack(odp_timer_t hdl, odp_event_t tmo_ev)
+{
+	odp_timer_pool *tp = handle_to_tp(hdl);
+	uint32_t idx = handle_to_idx(hdl, tp);
+
+	return timer_ack(tp, idx, odp_buffer_from_event(tmo_ev));
+}
+
 uint64_t odp_timer_to_u64(odp_timer_t hdl)
 {
 	return _odp_pri(hdl);
@@ -991,14 +1700,35 @@ void odp_timeout_free(odp_timeout_t tmo)
 
 int odp_timer_init_global(void)
 {
-#ifndef ODP_ATOMIC_U128
+	const char *env;
 	uint32_t i;
+
+#ifndef ODP_ATOMIC_U128
 	for (i = 0; i < NUM_LOCKS; i++)
 		_odp_atomic_flag_clear(&locks[i]);
 #else
 	ODP_DBG("Using lock-less timer implementation\n");
 #endif
 	odp_atomic_init_u32(&num_timer_pools, 0);
+	odp_atomic_init_u32(&inline_max_idx, 0);
+	odp_atomic_init_u32(&_timer_num_inline, 0);
+	for (i = 0; i < MAX_TIMER_POOLS; i++)
+		odp_atomic_init_u32(&inline_users[i].num, 0);
+
+	env = getenv("ODP_TIMER_INLINE");
+	timer_inline = env != NULL && atoi(env) > 0;
+	if (timer_inline)
+		ODP_DBG("Timer pools expired inline\n");
+
+	timer_shards = 1;
+	env = getenv("ODP_TIMER_SHARDS");
+	if (env != NULL && atoi(env) > 1) {
+		timer_shards = atoi(env);
+		if (timer_shards > CONFIG_TIMER_MAX_SHARDS)
+			timer_shards = CONFIG_TIMER_MAX_SHARDS;
+		ODP_DBG("Timer pools partitioned into %" PRIu32 " shards\n",
+			timer_shards);
+	}
 
 	block_sigalarm();
 
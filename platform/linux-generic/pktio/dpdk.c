@@ -24,6 +24,9 @@
 #include <rte_config.h>
 #include <rte_mbuf.h>
 #include <rte_ethdev.h>
+#include <rte_ip.h>
+#include <rte_udp.h>
+#include <rte_tcp.h>
 #include <rte_string_fns.h>
 
 static int disable_pktio; /** !0 this pktio disabled, 0 enabled */
@@ -333,7 +336,9 @@ static int dpdk_setup_port(pktio_entry_t *pktio_entry)
 {
 	int ret;
 	pkt_dpdk_t *pkt_dpdk = &pktio_entry->s.pkt_dpdk;
+	odp_pktin_config_opt_t pktin = pktio_entry->s.config.pktin;
 	struct rte_eth_rss_conf rss_conf;
+	uint16_t hw_ip_checksum;
 
 	/* Always set some hash functions to enable DPDK RSS hash calculation */
 	if (pkt_dpdk->hash.all_bits == 0) {
@@ -343,13 +348,17 @@ static int dpdk_setup_port(pktio_entry_t *pktio_entry)
 		rss_conf_to_hash_proto(&rss_conf, &pkt_dpdk->hash);
 	}
 
+	hw_ip_checksum = pkt_dpdk->hw_chksum_rx &&
+			 (pktin.bit.ipv4_chksum || pktin.bit.udp_chksum ||
+			  pktin.bit.tcp_chksum);
+
 	struct rte_eth_conf port_conf = {
 		.rxmode = {
 			.mq_mode = ETH_MQ_RX_RSS,
 			.max_rx_pkt_len = pkt_dpdk->data_room,
 			.split_hdr_size = 0,
 			.header_split   = 0,
-			.hw_ip_checksum = 0,
+			.hw_ip_checksum = hw_ip_checksum,
 			.hw_vlan_filter = 0,
 			.jumbo_frame    = 1,
 			.hw_strip_crc   = 0,
@@ -579,6 +588,21 @@ static void dpdk_init_capability(pktio_entry_t *pktio_entry,
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+
+	/* Checksums not supported by the device are handled in software */
+	pktio_chksum_capa(&capa->config);
+
+	pkt_dpdk->hw_chksum_tx = 0;
+	if (dev_info->tx_offload_capa & DEV_TX_OFFLOAD_IPV4_CKSUM)
+		pkt_dpdk->hw_chksum_tx |= PKTIO_CHKSUM_L3;
+	if ((dev_info->tx_offload_capa & DEV_TX_OFFLOAD_UDP_CKSUM) &&
+	    (dev_info->tx_offload_capa & DEV_TX_OFFLOAD_TCP_CKSUM))
+		pkt_dpdk->hw_chksum_tx |= PKTIO_CHKSUM_L4;
+
+	pkt_dpdk->hw_chksum_rx =
+		(dev_info->rx_offload_capa & DEV_RX_OFFLOAD_IPV4_CKSUM) &&
+		(dev_info->rx_offload_capa & DEV_RX_OFFLOAD_UDP_CKSUM) &&
+		(dev_info->rx_offload_capa & DEV_RX_OFFLOAD_TCP_CKSUM);
 }
 
 static int dpdk_open(odp_pktio_t id ODP_UNUSED,
@@ -682,9 +706,18 @@ static int dpdk_start(pktio_entry_t *pktio_entry)
 {
 	pkt_dpdk_t *pkt_dpdk = &pktio_entry->s.pkt_dpdk;
 	uint8_t port_id = pkt_dpdk->port_id;
+	struct rte_eth_dev_info dev_info;
+	struct rte_eth_txconf *txconf = NULL;
 	int ret;
 	unsigned i;
 
+	/* Default TX configuration of many PMDs disables checksum offloads */
+	if (pktio_entry->s.config.pktout.all_bits && pkt_dpdk->hw_chksum_tx) {
+		rte_eth_dev_info_get(port_id, &dev_info);
+		txconf = &dev_info.default_txconf;
+		txconf->txq_flags &= ~ETH_TXQ_FLAGS_NOXSUMS;
+	}
+
 	/* DPDK doesn't support nb_rx_q/nb_tx_q being 0 */
 	if (!pktio_entry->s.num_in_queue)
 		pktio_entry->s.num_in_queue = 1;
@@ -700,7 +733,7 @@ static int dpdk_start(pktio_entry_t *pktio_entry)
 	for (i = 0; i < pktio_entry->s.num_out_queue; i++) {
 		ret = rte_eth_tx_queue_setup(port_id, i, DPDK_NM_TX_DESC,
 					     rte_eth_dev_socket_id(port_id),
-					     NULL);
+					     txconf);
 		if (ret < 0) {
 			ODP_ERR("Queue setup failed: err=%d, port=%" PRIu8 "\n",
 				ret, port_id);
@@ -736,6 +769,34 @@ static int dpdk_stop(pktio_entry_t *pktio_entry)
 	return 0;
 }
 
+/* Set error flags of checksums checked by the device */
+static inline void mbuf_chksum_check(pktio_entry_t *pktio_entry,
+				     odp_packet_hdr_t *pkt_hdr,
+				     uint64_t ol_flags)
+{
+	odp_pktin_config_opt_t pktin = pktio_entry->s.config.pktin;
+	packet_parser_t *prs = &pkt_hdr->p;
+
+	if (odp_likely(!(ol_flags & (PKT_RX_IP_CKSUM_BAD |
+				     PKT_RX_L4_CKSUM_BAD))))
+		return;
+
+	if (packet_parse_not_complete(pkt_hdr))
+		packet_parse_layer(pkt_hdr, LAYER_ALL);
+
+	if ((ol_flags & PKT_RX_IP_CKSUM_BAD) && pktin.bit.ipv4_chksum &&
+	    prs->input_flags.ipv4)
+		prs->error_flags.ip_err = 1;
+
+	if (!(ol_flags & PKT_RX_L4_CKSUM_BAD))
+		return;
+
+	if (prs->input_flags.udp && pktin.bit.udp_chksum)
+		prs->error_flags.udp_err = 1;
+	else if (prs->input_flags.tcp && pktin.bit.tcp_chksum)
+		prs->error_flags.tcp_err = 1;
+}
+
 static inline int mbuf_to_pkt(pktio_entry_t *pktio_entry,
 			      odp_packet_t pkt_table[],
 			      struct rte_mbuf *mbuf_table[],
@@ -762,9 +823,17 @@ static inline int mbuf_to_pkt(pktio_entry_t *pktio_entry,
 			rte_pktmbuf_free(mbuf_table[i]);
 	}
 
+	for (i = 0; i < num && i < CONFIG_PACKET_PREFETCH_DIST; i++)
+		odp_prefetch(rte_pktmbuf_mtod(mbuf_table[i], char *));
+
 	for (i = 0; i < num; i++) {
 		odp_packet_hdr_t parsed_hdr;
 
+		if (i + CONFIG_PACKET_PREFETCH_DIST < num) {
+			mbuf = mbuf_table[i + CONFIG_PACKET_PREFETCH_DIST];
+			odp_prefetch(rte_pktmbuf_mtod(mbuf, char *));
+		}
+
 		mbuf = mbuf_table[i];
 		if (odp_unlikely(mbuf->nb_segs != 1)) {
 			ODP_ERR("Segmented buffers not supported\n");
@@ -772,7 +841,6 @@ static inline int mbuf_to_pkt(pktio_entry_t *pktio_entry,
 		}
 
 		buf = rte_pktmbuf_mtod(mbuf, char *);
-		odp_prefetch(buf);
 
 		pkt_len = rte_pktmbuf_pkt_len(mbuf);
 
@@ -803,6 +871,12 @@ static inline int mbuf_to_pkt(pktio_entry_t *pktio_entry,
 		if (mbuf->ol_flags & PKT_RX_RSS_HASH)
 			odp_packet_flow_hash_set(pkt, mbuf->hash.rss);
 
+		if (pktio_entry->s.pkt_dpdk.hw_chksum_rx)
+			mbuf_chksum_check(pktio_entry, pkt_hdr,
+					  mbuf->ol_flags);
+		else
+			pktio_chksum_check(pktio_entry, pkt_hdr);
+
 		packet_set_ts(pkt_hdr, ts);
 
 		pkt_table[nb_pkts++] = pkt;
@@ -821,12 +895,58 @@ fail:
 	return (i > 0 ? i : -1);
 }
 
+/* Request the device to insert checksums (PKTIO_CHKSUM_XXX) */
+static inline void mbuf_chksum_offload(struct rte_mbuf *mbuf,
+				       odp_packet_hdr_t *pkt_hdr, char *data,
+				       int chksum)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	void *l3 = data + prs->l3_offset;
+	void *l4 = data + prs->l4_offset;
+	struct ipv4_hdr *ipv4 = l3;
+	struct udp_hdr *udp = l4;
+	struct tcp_hdr *tcp = l4;
+
+	mbuf->l2_len = prs->l3_offset;
+
+	if (prs->input_flags.ipv4) {
+		mbuf->l3_len = (ipv4->version_ihl & 0xf) * 4;
+		mbuf->ol_flags |= PKT_TX_IPV4;
+
+		if (chksum & PKTIO_CHKSUM_L3) {
+			mbuf->ol_flags |= PKT_TX_IP_CKSUM;
+			ipv4->hdr_checksum = 0;
+		}
+	} else {
+		mbuf->l3_len = prs->l4_offset - prs->l3_offset;
+		mbuf->ol_flags |= PKT_TX_IPV6;
+	}
+
+	if (!(chksum & PKTIO_CHKSUM_L4))
+		return;
+
+	/* Device expects pseudo header checksum in the L4 header */
+	if (prs->input_flags.udp) {
+		mbuf->ol_flags |= PKT_TX_UDP_CKSUM;
+		udp->dgram_cksum = prs->input_flags.ipv4 ?
+			rte_ipv4_phdr_cksum(l3, mbuf->ol_flags) :
+			rte_ipv6_phdr_cksum(l3, mbuf->ol_flags);
+	} else {
+		mbuf->ol_flags |= PKT_TX_TCP_CKSUM;
+		tcp->cksum = prs->input_flags.ipv4 ?
+			rte_ipv4_phdr_cksum(l3, mbuf->ol_flags) :
+			rte_ipv6_phdr_cksum(l3, mbuf->ol_flags);
+	}
+}
+
 static inline int pkt_to_mbuf(pktio_entry_t *pktio_entry,
 			      struct rte_mbuf *mbuf_table[],
 			      const odp_packet_t pkt_table[], uint16_t num)
 {
 	pkt_dpdk_t *pkt_dpdk = &pktio_entry->s.pkt_dpdk;
+	odp_packet_hdr_t *pkt_hdr = NULL;
 	int i, j;
+	int chksum;
 	char *data;
 	uint16_t pkt_len;
 
@@ -844,10 +964,28 @@ static inline int pkt_to_mbuf(pktio_entry_t *pktio_entry,
 			goto fail;
 		}
 
+		/* Checksums not supported by the device are inserted before
+		 * copying the packet */
+		chksum = 0;
+		if (odp_unlikely(pktio_entry->s.config.pktout.all_bits)) {
+			pkt_hdr = odp_packet_hdr(pkt_table[i]);
+			chksum  = pktio_chksum_out_flags(pktio_entry, pkt_hdr);
+
+			if (chksum & ~pkt_dpdk->hw_chksum_tx)
+				pktio_chksum_insert_sw(pkt_hdr, chksum &
+						       ~pkt_dpdk->hw_chksum_tx);
+
+			chksum &= pkt_dpdk->hw_chksum_tx;
+		}
+
 		/* Packet always fits in mbuf */
 		data = rte_pktmbuf_append(mbuf_table[i], pkt_len);
 
 		odp_packet_copy_to_mem(pkt_table[i], 0, pkt_len, data);
+
+		if (chksum)
+			mbuf_chksum_offload(mbuf_table[i], pkt_hdr, data,
+					    chksum);
 	}
 	return i;
 
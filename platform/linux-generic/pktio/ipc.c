@@ -495,6 +495,8 @@ static int ipc_pktio_recv_lockless(pktio_entry_t *pktio_entry,
 		/* Take classification fields */
 		odp_packet_hdr(pkt)->p = phdr->p;
 
+		pktio_sw_hash(pktio_entry, odp_packet_hdr(pkt));
+
 		pkt_table[i] = pkt;
 	}
 
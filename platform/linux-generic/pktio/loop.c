@@ -129,11 +129,16 @@ static int loopback_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 
 		pkt_hdr->input = pktio_entry->s.handle;
 
-		if (pktio_cls_enabled(pktio_entry))
+		if (pktio_cls_enabled(pktio_entry)) {
 			copy_packet_cls_metadata(&parsed_hdr, pkt_hdr);
-		else
+		} else {
+			/* Metadata of the sent packet is not valid on input */
+			packet_parse_reset(pkt_hdr);
 			packet_parse_l2(&pkt_hdr->p, pkt_len);
+		}
 
+		pktio_sw_hash(pktio_entry, pkt_hdr);
+		pktio_chksum_check(pktio_entry, pkt_hdr);
 		packet_set_ts(pkt_hdr, ts);
 
 		pktio_entry->s.stats.in_octets += pkt_len;
@@ -168,6 +173,8 @@ static int loopback_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 
 	odp_ticketlock_lock(&pktio_entry->s.txl);
 
+	pktio_chksum_insert(pktio_entry, pkt_tbl, len);
+
 	qentry = queue_to_qentry(pktio_entry->s.pkt_loop.loopq);
 	ret = queue_enq_multi(qentry, hdr_tbl, len);
 
@@ -215,6 +222,7 @@ static int loopback_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+	pktio_chksum_capa(&capa->config);
 	return 0;
 }
 
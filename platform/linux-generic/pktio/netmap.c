@@ -292,6 +292,7 @@ static void netmap_init_capability(pktio_entry_t *pktio_entry)
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+	pktio_chksum_capa(&capa->config);
 }
 
 /**
@@ -619,15 +620,21 @@ static inline int netmap_pkt_to_odp(pktio_entry_t *pktio_entry,
 
 	num = packet_alloc_multi(pool, alloc_len, pkt_tbl, slot_num);
 
+	for (i = 0; i < num && i < CONFIG_PACKET_PREFETCH_DIST; i++)
+		odp_prefetch(slot_tbl[i].buf);
+
 	for (i = 0; i < num; i++) {
 		netmap_slot_t slot;
 		uint16_t len;
 
+		if (i + CONFIG_PACKET_PREFETCH_DIST < num) {
+			slot = slot_tbl[i + CONFIG_PACKET_PREFETCH_DIST];
+			odp_prefetch(slot.buf);
+		}
+
 		slot = slot_tbl[i];
 		len = slot.len;
 
-		odp_prefetch(slot.buf);
-
 		if (odp_unlikely(len > pktio_entry->s.pkt_nm.max_frame_len)) {
 			ODP_ERR("RX: frame too big %" PRIu16 " %zu!\n", len,
 				pktio_entry->s.pkt_nm.max_frame_len);
@@ -663,6 +670,7 @@ static inline int netmap_pkt_to_odp(pktio_entry_t *pktio_entry,
 			packet_parse_l2(&pkt_hdr->p, len);
 
 		packet_set_ts(pkt_hdr, ts);
+		pktio_chksum_check(pktio_entry, pkt_hdr);
 	}
 
 	return i;
@@ -801,6 +809,8 @@ static int netmap_send(pktio_entry_t *pktio_entry, int index,
 	if (!pkt_nm->lockless_tx)
 		odp_ticketlock_lock(&pkt_nm->tx_desc_ring[index].s.lock);
 
+	pktio_chksum_insert(pktio_entry, pkt_table, num);
+
 	polld.fd = desc->fd;
 	polld.events = POLLOUT;
 
@@ -253,6 +253,8 @@ static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 		}
 
 		packet_parse_l2(&pkt_hdr->p, pkt_len);
+		pktio_sw_hash(pktio_entry, pkt_hdr);
+		pktio_chksum_check(pktio_entry, pkt_hdr);
 		pktio_entry->s.stats.in_octets += pkt_hdr->frame_len;
 
 		packet_set_ts(pkt_hdr, ts);
@@ -302,6 +304,8 @@ static int pcapif_send_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 		return 0;
 	}
 
+	pktio_chksum_insert(pktio_entry, pkts, len);
+
 	for (i = 0; i < len; ++i) {
 		int pkt_len = odp_packet_len(pkts[i]);
 
@@ -352,6 +356,7 @@ static int pcapif_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+	pktio_chksum_capa(&capa->config);
 	return 0;
 }
 
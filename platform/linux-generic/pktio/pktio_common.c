@@ -7,7 +7,1258 @@
 
 #include <odp_packet_io_internal.h>
 #include <odp_classification_internal.h>
+#include <odp_chksum_internal.h>
+#include <odp/api/hash.h>
+#include <protocols/ip.h>
+#include <protocols/tcp.h>
+#include <protocols/udp.h>
 #include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <linux/virtio_net.h>
+
+/* Longest hashed flow tuple: IPv6 addresses and port numbers */
+#define HASH_TUPLE_LEN (2 * _ODP_IPV6ADDR_LEN + 4)
+
+/* Default Toeplitz key. The same key is used by many NIC drivers by default,
+ * so that software and hardware calculated hash values match. */
+static const uint8_t default_hash_key[PKTIO_HASH_KEY_LEN] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+static int hex_val(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+
+	c = tolower(c);
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+
+	return -1;
+}
+
+/* Parse hash key from a hex string. Colons between bytes are ignored. */
+static int hash_key_parse(const char *str, uint8_t key[])
+{
+	int i = 0;
+	int hi, lo;
+
+	while (*str && i < PKTIO_HASH_KEY_LEN) {
+		if (*str == ':') {
+			str++;
+			continue;
+		}
+
+		hi = hex_val(str[0]);
+		lo = hi < 0 ? -1 : hex_val(str[1]);
+		if (lo < 0)
+			return -1;
+
+		key[i++] = (hi << 4) | lo;
+		str += 2;
+	}
+
+	/* Remaining bytes of a short key are zero */
+	for (; i < PKTIO_HASH_KEY_LEN; i++)
+		key[i] = 0;
+
+	return 0;
+}
+
+void pktio_sw_hash_config(pktio_sw_hash_t *sw_hash,
+			  const odp_pktin_queue_param_t *param,
+			  unsigned num_drv_queues)
+{
+	const char *str;
+
+	memset(sw_hash, 0, sizeof(pktio_sw_hash_t));
+
+	/* Driver with multiple queues hashes packets itself */
+	if (!param->hash_enable || param->classifier_enable ||
+	    num_drv_queues > 1)
+		return;
+
+	sw_hash->proto = param->hash_proto;
+	sw_hash->alg = PKTIO_HASH_TOEPLITZ;
+	memcpy(sw_hash->key, default_hash_key, PKTIO_HASH_KEY_LEN);
+
+	if (param->num_queues > num_drv_queues)
+		sw_hash->num_queues = param->num_queues;
+
+	str = getenv("ODP_PKTIO_HASH_ALG");
+	if (str) {
+		if (!strcmp(str, "crc32c"))
+			sw_hash->alg = PKTIO_HASH_CRC32C;
+		else if (strcmp(str, "toeplitz"))
+			ODP_ERR("Unknown hash algorithm: %s\n", str);
+	}
+
+	str = getenv("ODP_PKTIO_HASH_KEY");
+	if (str && hash_key_parse(str, sw_hash->key)) {
+		ODP_ERR("Bad hash key: %s\n", str);
+		memcpy(sw_hash->key, default_hash_key, PKTIO_HASH_KEY_LEN);
+	}
+}
+
+void _pktio_sw_hash(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	odp_pktin_hash_proto_t proto = entry->s.sw_hash.proto;
+	const uint8_t *data = pkt_hdr->buf_hdr.seg[0].data;
+	uint32_t seg_len = pkt_hdr->buf_hdr.seg[0].len;
+	uint8_t tuple[HASH_TUPLE_LEN];
+	uint32_t addr_off, addr_len, len;
+	int ports;
+
+	if (packet_parse_not_complete(pkt_hdr))
+		packet_parse_layer(pkt_hdr, LAYER_ALL);
+
+	if (prs->error_flags.ip_err)
+		return;
+
+	if (prs->input_flags.ipv4 &&
+	    (proto.proto.ipv4 || proto.proto.ipv4_udp ||
+	     proto.proto.ipv4_tcp)) {
+		addr_len = 2 * _ODP_IPV4ADDR_LEN;
+		ports = (prs->input_flags.udp && proto.proto.ipv4_udp) ||
+			(prs->input_flags.tcp && proto.proto.ipv4_tcp);
+		if (!ports && !proto.proto.ipv4)
+			return;
+		/* Source and destination addresses are adjacent */
+		addr_off = prs->l3_offset +
+			   offsetof(_odp_ipv4hdr_t, src_addr);
+	} else if (prs->input_flags.ipv6 &&
+		   (proto.proto.ipv6 || proto.proto.ipv6_udp ||
+		    proto.proto.ipv6_tcp)) {
+		addr_len = 2 * _ODP_IPV6ADDR_LEN;
+		ports = (prs->input_flags.udp && proto.proto.ipv6_udp) ||
+			(prs->input_flags.tcp && proto.proto.ipv6_tcp);
+		if (!ports && !proto.proto.ipv6)
+			return;
+		addr_off = prs->l3_offset +
+			   offsetof(_odp_ipv6hdr_t, src_addr);
+	} else {
+		return;
+	}
+
+	/* Only the first fragment carries port numbers */
+	if (prs->input_flags.ipfrag)
+		ports = 0;
+
+	if (addr_off + addr_len > seg_len ||
+	    (ports && prs->l4_offset + 4 > seg_len))
+		return;
+
+	memcpy(tuple, &data[addr_off], addr_len);
+	len = addr_len;
+
+	/* Source and destination ports */
+	if (ports) {
+		memcpy(&tuple[len], &data[prs->l4_offset], 4);
+		len += 4;
+	}
+
+	if (entry->s.sw_hash.alg == PKTIO_HASH_CRC32C)
+		pkt_hdr->flow_hash = odp_hash_crc32c(tuple, len, 0);
+	else
+		pkt_hdr->flow_hash = odp_hash_toeplitz(tuple, len,
+						       entry->s.sw_hash.key,
+						       PKTIO_HASH_KEY_LEN);
+
+	prs->input_flags.flow_hash = 1;
+}
+
+/* One's complement sum over packet data. Segment sums are byte swapped when
+ * a segment starts from an odd offset of the summed data. */
+static uint64_t packet_sum(odp_packet_hdr_t *pkt_hdr, uint32_t offset,
+			   uint32_t len, uint64_t sum)
+{
+	odp_buffer_hdr_t *buf_hdr = &pkt_hdr->buf_hdr;
+	const uint8_t *data;
+	uint32_t seg_len;
+	uint16_t seg_sum;
+	int odd = 0;
+	int i;
+
+	for (i = 0; i < buf_hdr->segcount && len; i++) {
+		seg_len = buf_hdr->seg[i].len;
+
+		if (offset >= seg_len) {
+			offset -= seg_len;
+			continue;
+		}
+
+		data     = buf_hdr->seg[i].data + offset;
+		seg_len -= offset;
+		offset   = 0;
+
+		if (seg_len > len)
+			seg_len = len;
+
+		seg_sum = chksum_fold(chksum_partial(data, seg_len, 0));
+		sum    += odd ? chksum_swap(seg_sum) : seg_sum;
+		odd    ^= seg_len & 1;
+		len    -= seg_len;
+	}
+
+	return sum;
+}
+
+/* Length of L4 header and data from IP header. Returns zero when IP and L4
+ * headers are not contiguous in the first segment, or lengths do not match
+ * packet length. */
+static uint32_t l4_len(odp_packet_hdr_t *pkt_hdr, uint32_t l4_hdr_len)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint32_t seg_len = pkt_hdr->buf_hdr.seg[0].len;
+	const uint8_t *l3 = pkt_hdr->buf_hdr.seg[0].data + prs->l3_offset;
+	const _odp_ipv4hdr_t *ipv4 = (const _odp_ipv4hdr_t *)(const void *)l3;
+	const _odp_ipv6hdr_t *ipv6 = (const _odp_ipv6hdr_t *)(const void *)l3;
+	uint32_t ip_len, ip_hdr_len;
+
+	if (prs->l3_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l4_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l4_offset <= prs->l3_offset ||
+	    prs->l4_offset + l4_hdr_len > seg_len)
+		return 0;
+
+	ip_hdr_len = prs->l4_offset - prs->l3_offset;
+
+	if (prs->input_flags.ipv4) {
+		if (ip_hdr_len < _ODP_IPV4HDR_LEN)
+			return 0;
+		ip_len = odp_be_to_cpu_16(ipv4->tot_len);
+	} else {
+		if (ip_hdr_len < _ODP_IPV6HDR_LEN)
+			return 0;
+		ip_len = odp_be_to_cpu_16(ipv6->payload_len) + _ODP_IPV6HDR_LEN;
+	}
+
+	if (ip_len < ip_hdr_len + l4_hdr_len ||
+	    prs->l3_offset + ip_len > pkt_hdr->frame_len)
+		return 0;
+
+	return ip_len - ip_hdr_len;
+}
+
+/* Partial sum of L4 pseudo header */
+static uint64_t pseudo_sum(odp_packet_hdr_t *pkt_hdr, uint32_t len)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	const uint8_t *l3 = pkt_hdr->buf_hdr.seg[0].data + prs->l3_offset;
+	uint8_t proto = prs->input_flags.udp ? _ODP_IPPROTO_UDP :
+					       _ODP_IPPROTO_TCP;
+	uint64_t sum;
+
+	/* Source and destination addresses are adjacent */
+	if (prs->input_flags.ipv4)
+		sum = chksum_partial(l3 + offsetof(_odp_ipv4hdr_t, src_addr),
+				     2 * _ODP_IPV4ADDR_LEN, 0);
+	else
+		sum = chksum_partial(l3 + offsetof(_odp_ipv6hdr_t, src_addr),
+				     2 * _ODP_IPV6ADDR_LEN, 0);
+
+	sum += chksum_u16(proto);
+	sum += chksum_u16(len);
+
+	return sum;
+}
+
+/* Folded sum of L4 pseudo header and L4 data, including the checksum field.
+ * The caller checks headers with l4_len(). */
+static uint16_t l4_sum(odp_packet_hdr_t *pkt_hdr, uint32_t len)
+{
+	uint64_t sum = pseudo_sum(pkt_hdr, len);
+
+	sum = packet_sum(pkt_hdr, pkt_hdr->p.l4_offset, len, sum);
+
+	return chksum_fold(sum);
+}
+
+/* IPv4 header of a packet, or NULL when the header is not contiguous */
+static inline _odp_ipv4hdr_t *ipv4_hdr(odp_packet_hdr_t *pkt_hdr,
+				       uint32_t *hdr_len)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint32_t seg_len = pkt_hdr->buf_hdr.seg[0].len;
+	uint8_t *data = pkt_hdr->buf_hdr.seg[0].data;
+	_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(void *)&data[prs->l3_offset];
+
+	if (prs->l3_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l3_offset + _ODP_IPV4HDR_LEN > seg_len)
+		return NULL;
+
+	*hdr_len = _ODP_IPV4HDR_IHL(ip->ver_ihl) * 4;
+	if (*hdr_len < _ODP_IPV4HDR_LEN || prs->l3_offset + *hdr_len > seg_len)
+		return NULL;
+
+	return ip;
+}
+
+void _pktio_chksum_check(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+			 int l4)
+{
+	odp_pktin_config_opt_t pktin = entry->s.config.pktin;
+	packet_parser_t *prs = &pkt_hdr->p;
+	_odp_ipv4hdr_t *ip;
+	_odp_udphdr_t *udp;
+	uint32_t hdr_len, len;
+
+	if (packet_parse_not_complete(pkt_hdr))
+		packet_parse_layer(pkt_hdr, LAYER_ALL);
+
+	if (prs->input_flags.ipv4 && pktin.bit.ipv4_chksum &&
+	    !prs->error_flags.ip_err) {
+		ip = ipv4_hdr(pkt_hdr, &hdr_len);
+
+		if (ip && chksum_fold(chksum_partial(ip, hdr_len, 0)) != 0xffff)
+			prs->error_flags.ip_err = 1;
+	}
+
+	/* L4 checksum of a fragment can be checked only after reassembly */
+	if (!l4 || prs->error_flags.ip_err || prs->input_flags.ipfrag)
+		return;
+
+	if (prs->input_flags.udp && pktin.bit.udp_chksum &&
+	    !prs->error_flags.udp_err) {
+		len = l4_len(pkt_hdr, _ODP_UDPHDR_LEN);
+		if (!len)
+			return;
+
+		udp = (_odp_udphdr_t *)(void *)(pkt_hdr->buf_hdr.seg[0].data +
+						prs->l4_offset);
+
+		/* Zero checksum means no checksum over IPv4 */
+		if (prs->input_flags.ipv4 && udp->chksum == 0)
+			return;
+
+		if (l4_sum(pkt_hdr, len) != 0xffff)
+			prs->error_flags.udp_err = 1;
+	} else if (prs->input_flags.tcp && pktin.bit.tcp_chksum &&
+		   !prs->error_flags.tcp_err) {
+		len = l4_len(pkt_hdr, _ODP_TCPHDR_LEN);
+
+		if (len && l4_sum(pkt_hdr, len) != 0xffff)
+			prs->error_flags.tcp_err = 1;
+	}
+}
+
+int pktio_chksum_out_flags(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr)
+{
+	odp_pktout_config_opt_t pktout = entry->s.config.pktout;
+	packet_parser_t *prs = &pkt_hdr->p;
+	output_flags_t out = prs->output_flags;
+	int l3 = out.l3_chksum_set ? out.l3_chksum : 1;
+	int l4 = out.l4_chksum_set ? out.l4_chksum : 1;
+	int flags = 0;
+
+	if (!l3 && !l4)
+		return 0;
+
+	/* Checksums of a packet to be segmented are inserted during
+	 * segmentation */
+	if (out.gso_size && (entry->s.config.pktout.bit.tcp_gso ||
+			     entry->s.config.pktout.bit.udp_gso))
+		return 0;
+
+	/* Received packets are parsed here. Application built packets must
+	 * have protocol flags and offsets set. */
+	if (packet_parse_not_complete(pkt_hdr))
+		packet_parse_layer(pkt_hdr, LAYER_ALL);
+
+	if (prs->error_flags.ip_err)
+		return 0;
+
+	if (prs->l3_offset == ODP_PACKET_OFFSET_INVALID)
+		return 0;
+
+	if (l3 && pktout.bit.ipv4_chksum && prs->input_flags.ipv4)
+		flags |= PKTIO_CHKSUM_L3;
+
+	/* Checksum of a fragment covers the whole datagram */
+	if (!l4 || prs->input_flags.ipfrag ||
+	    prs->l4_offset == ODP_PACKET_OFFSET_INVALID ||
+	    !(prs->input_flags.ipv4 || prs->input_flags.ipv6))
+		return flags;
+
+	if ((pktout.bit.udp_chksum && prs->input_flags.udp &&
+	     !prs->error_flags.udp_err) ||
+	    (pktout.bit.tcp_chksum && prs->input_flags.tcp &&
+	     !prs->error_flags.tcp_err))
+		flags |= PKTIO_CHKSUM_L4;
+
+	return flags;
+}
+
+void pktio_chksum_insert_sw(odp_packet_hdr_t *pkt_hdr, int flags)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint8_t *l4 = pkt_hdr->buf_hdr.seg[0].data + prs->l4_offset;
+	_odp_ipv4hdr_t *ip;
+	uint8_t *field;
+	uint16_t chksum;
+	uint32_t hdr_len, len;
+
+	if (flags & PKTIO_CHKSUM_L3) {
+		ip = ipv4_hdr(pkt_hdr, &hdr_len);
+
+		if (ip) {
+			ip->chksum = 0;
+			ip->chksum = ~chksum_fold(chksum_partial(ip, hdr_len,
+								 0));
+		}
+	}
+
+	if (!(flags & PKTIO_CHKSUM_L4))
+		return;
+
+	if (prs->input_flags.udp) {
+		len   = l4_len(pkt_hdr, _ODP_UDPHDR_LEN);
+		field = l4 + offsetof(_odp_udphdr_t, chksum);
+	} else {
+		len   = l4_len(pkt_hdr, _ODP_TCPHDR_LEN);
+		field = l4 + offsetof(_odp_tcphdr_t, cksm);
+	}
+
+	if (!len)
+		return;
+
+	/* Checksum field is in memory byte order as the sum */
+	memset(field, 0, sizeof(chksum));
+	chksum = ~l4_sum(pkt_hdr, len);
+
+	/* Zero UDP checksum is transmitted as all ones */
+	if (prs->input_flags.udp && chksum == 0)
+		chksum = 0xffff;
+
+	memcpy(field, &chksum, sizeof(chksum));
+}
+
+void _pktio_chksum_insert(pktio_entry_t *entry, const odp_packet_t pkt_tbl[],
+			  int num)
+{
+	odp_packet_hdr_t *pkt_hdr;
+	int flags;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		pkt_hdr = odp_packet_hdr(pkt_tbl[i]);
+		flags = pktio_chksum_out_flags(entry, pkt_hdr);
+
+		if (flags)
+			pktio_chksum_insert_sw(pkt_hdr, flags);
+	}
+}
+
+/* TCP flags byte and flags that are set only in the first or the last
+ * segment */
+#define TCP_FLAGS_OFFSET 13
+#define TCP_FLAG_FIN     0x01
+#define TCP_FLAG_PSH     0x08
+#define TCP_FLAG_ACK     0x10
+#define TCP_FLAG_CWR     0x80
+
+/* Length of L2, L3 and L4 headers of a packet to be segmented, or zero when
+ * the packet cannot be segmented. Headers must be contiguous in the first
+ * segment. */
+static uint32_t gso_hdr_len(odp_packet_hdr_t *pkt_hdr,
+			    odp_pktout_config_opt_t gso)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint32_t seg_len = pkt_hdr->buf_hdr.seg[0].len;
+	const _odp_tcphdr_t *tcp;
+	uint32_t ip_hdr_len, hdr_len;
+
+	if (packet_parse_not_complete(pkt_hdr))
+		packet_parse_layer(pkt_hdr, LAYER_ALL);
+
+	if (prs->l3_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l4_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l4_offset <= prs->l3_offset ||
+	    prs->input_flags.ipfrag || prs->error_flags.ip_err)
+		return 0;
+
+	ip_hdr_len = prs->l4_offset - prs->l3_offset;
+
+	if (!((prs->input_flags.ipv4 && ip_hdr_len >= _ODP_IPV4HDR_LEN) ||
+	      (prs->input_flags.ipv6 && ip_hdr_len >= _ODP_IPV6HDR_LEN)))
+		return 0;
+
+	if (gso.bit.tcp_gso && prs->input_flags.tcp) {
+		if (prs->l4_offset + _ODP_TCPHDR_LEN > seg_len)
+			return 0;
+
+		tcp = (const _odp_tcphdr_t *)(const void *)
+		      (pkt_hdr->buf_hdr.seg[0].data + prs->l4_offset);
+		hdr_len = tcp->hl * 4;
+		if (hdr_len < _ODP_TCPHDR_LEN)
+			return 0;
+	} else if (gso.bit.udp_gso && prs->input_flags.udp) {
+		hdr_len = _ODP_UDPHDR_LEN;
+	} else {
+		return 0;
+	}
+
+	hdr_len += prs->l4_offset;
+	if (hdr_len > seg_len)
+		return 0;
+
+	return hdr_len;
+}
+
+/* Update headers and checksums of a segment. Headers are a copy of
+ * the original packet headers. */
+static void gso_fixup(odp_packet_hdr_t *pkt_hdr, uint32_t mss, int idx,
+		      int last)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint8_t *data = pkt_hdr->buf_hdr.seg[0].data;
+	uint8_t *l4 = data + prs->l4_offset;
+	uint32_t l3_len = pkt_hdr->frame_len - prs->l3_offset;
+	int flags = PKTIO_CHKSUM_L4;
+	uint16_t chksum;
+
+	if (prs->input_flags.ipv4) {
+		_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(void *)
+				     (data + prs->l3_offset);
+
+		ip->tot_len = odp_cpu_to_be_16(l3_len);
+		ip->id = odp_cpu_to_be_16(odp_be_to_cpu_16(ip->id) + idx);
+		flags |= PKTIO_CHKSUM_L3;
+	} else {
+		_odp_ipv6hdr_t *ip = (_odp_ipv6hdr_t *)(void *)
+				     (data + prs->l3_offset);
+
+		ip->payload_len = odp_cpu_to_be_16(l3_len - _ODP_IPV6HDR_LEN);
+	}
+
+	if (prs->input_flags.tcp) {
+		_odp_tcphdr_t *tcp = (_odp_tcphdr_t *)(void *)l4;
+
+		tcp->seq_no = odp_cpu_to_be_32(odp_be_to_cpu_32(tcp->seq_no) +
+					       idx * mss);
+		if (idx != last)
+			l4[TCP_FLAGS_OFFSET] &= ~(TCP_FLAG_FIN | TCP_FLAG_PSH);
+		if (idx != 0)
+			l4[TCP_FLAGS_OFFSET] &= ~TCP_FLAG_CWR;
+	} else {
+		_odp_udphdr_t *udp = (_odp_udphdr_t *)(void *)l4;
+
+		udp->length = odp_cpu_to_be_16(pkt_hdr->frame_len -
+					       prs->l4_offset);
+
+		/* Zero checksum means no checksum over IPv4 */
+		memcpy(&chksum, l4 + offsetof(_odp_udphdr_t, chksum),
+		       sizeof(chksum));
+		if (prs->input_flags.ipv4 && chksum == 0)
+			flags &= ~PKTIO_CHKSUM_L4;
+	}
+
+	pktio_chksum_insert_sw(pkt_hdr, flags);
+
+	/* Checksums are not inserted again on output */
+	prs->output_flags.gso_size      = 0;
+	prs->output_flags.l3_chksum_set = 1;
+	prs->output_flags.l3_chksum     = 0;
+	prs->output_flags.l4_chksum_set = 1;
+	prs->output_flags.l4_chksum     = 0;
+}
+
+int pktio_gso_segment(pktio_entry_t *entry, odp_packet_t pkt,
+		      odp_packet_t seg_tbl[], int max_num)
+{
+	odp_packet_hdr_t *pkt_hdr = odp_packet_hdr(pkt);
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint32_t mss = prs->output_flags.gso_size;
+	uint32_t hdr_len, payload_len, offset, len;
+	const uint8_t *hdr;
+	int num, n, i;
+
+	hdr_len = gso_hdr_len(pkt_hdr, entry->s.gso_sw);
+
+	if (!hdr_len || pkt_hdr->frame_len - hdr_len <= mss) {
+		/* Driver segments TCP packets natively */
+		if (!(prs->input_flags.tcp &&
+		      entry->s.config.pktout.bit.tcp_gso &&
+		      !entry->s.gso_sw.bit.tcp_gso))
+			prs->output_flags.gso_size = 0;
+		return 0;
+	}
+
+	payload_len = pkt_hdr->frame_len - hdr_len;
+	num = (payload_len + mss - 1) / mss;
+
+	if (num > max_num || hdr_len - prs->l3_offset + mss > UINT16_MAX)
+		return -1;
+
+	/* The packet is the first segment. Headers are copied into the other
+	 * segments and payload after the first segment is copied once. */
+	n = packet_alloc_multi(odp_packet_pool(pkt), hdr_len + mss,
+			       &seg_tbl[1], num - 1);
+	if (n != num - 1) {
+		if (n > 0)
+			odp_packet_free_multi(&seg_tbl[1], n);
+		return -1;
+	}
+
+	hdr = pkt_hdr->buf_hdr.seg[0].data;
+
+	for (i = 1; i < num; i++) {
+		offset = hdr_len + i * mss;
+		len    = pkt_hdr->frame_len - offset;
+
+		if (len > mss)
+			len = mss;
+		else if (odp_packet_trunc_tail(&seg_tbl[i], mss - len,
+					       NULL, NULL) < 0)
+			goto copy_error;
+
+		if (odp_packet_copy_from_mem(seg_tbl[i], 0, hdr_len, hdr) ||
+		    odp_packet_copy_from_pkt(seg_tbl[i], hdr_len, pkt, offset,
+					     len))
+			goto copy_error;
+
+		copy_packet_parser_metadata(pkt_hdr,
+					    odp_packet_hdr(seg_tbl[i]));
+	}
+
+	if (odp_packet_trunc_tail(&pkt, payload_len - mss, NULL, NULL) < 0)
+		goto copy_error;
+
+	seg_tbl[0] = pkt;
+
+	for (i = 0; i < num; i++)
+		gso_fixup(odp_packet_hdr(seg_tbl[i]), mss, i, num - 1);
+
+	return num;
+
+copy_error:
+	odp_packet_free_multi(&seg_tbl[1], num - 1);
+	return -1;
+}
+
+int pktio_gso_vnet_hdr(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+		       struct virtio_net_hdr *vnet)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint32_t mss = prs->output_flags.gso_size;
+	odp_pktout_config_opt_t gso;
+	uint32_t hdr_len, l3_len, l4_len;
+	uint16_t sum;
+	int flags;
+
+	memset(vnet, 0, sizeof(*vnet));
+
+	if (!mss)
+		return 0;
+
+	prs->output_flags.gso_size = 0;
+
+	gso.all_bits    = 0;
+	gso.bit.tcp_gso = entry->s.config.pktout.bit.tcp_gso;
+	hdr_len = gso.all_bits ? gso_hdr_len(pkt_hdr, gso) : 0;
+	l3_len  = pkt_hdr->frame_len - prs->l3_offset;
+
+	if (!hdr_len || pkt_hdr->frame_len - hdr_len <= mss ||
+	    l3_len > UINT16_MAX) {
+		/* Sent as is. Checksums were skipped by pktio_chksum_insert()
+		 * while segmentation size was set. */
+		flags = pktio_chksum_out_flags(entry, pkt_hdr);
+		if (flags)
+			pktio_chksum_insert_sw(pkt_hdr, flags);
+		return 0;
+	}
+
+	if (prs->input_flags.ipv4) {
+		_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(void *)
+				     (pkt_hdr->buf_hdr.seg[0].data +
+				      prs->l3_offset);
+
+		ip->tot_len = odp_cpu_to_be_16(l3_len);
+		pktio_chksum_insert_sw(pkt_hdr, PKTIO_CHKSUM_L3);
+	} else {
+		_odp_ipv6hdr_t *ip = (_odp_ipv6hdr_t *)(void *)
+				     (pkt_hdr->buf_hdr.seg[0].data +
+				      prs->l3_offset);
+
+		ip->payload_len = odp_cpu_to_be_16(l3_len - _ODP_IPV6HDR_LEN);
+	}
+
+	/* Kernel completes TCP checksums of segments from the pseudo header
+	 * sum */
+	l4_len = pkt_hdr->frame_len - prs->l4_offset;
+	sum    = chksum_fold(pseudo_sum(pkt_hdr, l4_len));
+	memcpy(pkt_hdr->buf_hdr.seg[0].data + prs->l4_offset +
+	       offsetof(_odp_tcphdr_t, cksm), &sum, sizeof(sum));
+
+	vnet->flags       = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+	vnet->gso_type    = prs->input_flags.ipv4 ? VIRTIO_NET_HDR_GSO_TCPV4 :
+						    VIRTIO_NET_HDR_GSO_TCPV6;
+	vnet->hdr_len     = hdr_len;
+	vnet->gso_size    = mss;
+	vnet->csum_start  = prs->l4_offset;
+	vnet->csum_offset = offsetof(_odp_tcphdr_t, cksm);
+
+	return 1;
+}
+
+void pktio_vnet_hdr_recv(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+			 const struct virtio_net_hdr *vnet)
+{
+	odp_pktout_config_opt_t gso;
+	uint32_t offset, hdr_len;
+	uint16_t chksum;
+
+	/* Kernel left checksum calculation to the device. The checksum field
+	 * contains the pseudo header sum. */
+	if (vnet->flags & VIRTIO_NET_HDR_F_NEEDS_CSUM) {
+		offset = vnet->csum_start + vnet->csum_offset;
+
+		if (vnet->csum_start < pkt_hdr->frame_len &&
+		    offset + sizeof(chksum) <= pkt_hdr->buf_hdr.seg[0].len) {
+			chksum = ~chksum_fold(packet_sum(pkt_hdr,
+							 vnet->csum_start,
+							 pkt_hdr->frame_len -
+							 vnet->csum_start, 0));
+			if (chksum == 0)
+				chksum = 0xffff;
+
+			memcpy(pkt_hdr->buf_hdr.seg[0].data + offset, &chksum,
+			       sizeof(chksum));
+		}
+	}
+
+	if ((vnet->gso_type & ~VIRTIO_NET_HDR_GSO_ECN) ==
+	    VIRTIO_NET_HDR_GSO_NONE || vnet->gso_size == 0)
+		return;
+
+	/* Packet was coalesced by the kernel */
+	gso.all_bits    = 0;
+	gso.bit.tcp_gso = 1;
+	gso.bit.udp_gso = 1;
+	hdr_len = gso_hdr_len(pkt_hdr, gso);
+
+	if (!hdr_len || pkt_hdr->frame_len - hdr_len <= vnet->gso_size)
+		return;
+
+	pkt_hdr->p.output_flags.gso_size = vnet->gso_size;
+	pktio_gro_stats(entry, (pkt_hdr->frame_len - hdr_len +
+				vnet->gso_size - 1) / vnet->gso_size);
+}
+
+/*
+ * Packet input coalescing
+ */
+
+/* Hash of IP addresses and ports */
+static uint32_t gro_flow_hash(const uint8_t *l3, const uint8_t *l4, int ipv4)
+{
+	const uint8_t *addr;
+	uint32_t words, hash, w;
+	uint32_t i;
+
+	if (ipv4) {
+		addr  = l3 + offsetof(_odp_ipv4hdr_t, src_addr);
+		words = 2 * _ODP_IPV4ADDR_LEN / 4;
+	} else {
+		addr  = l3 + offsetof(_odp_ipv6hdr_t, src_addr);
+		words = 2 * _ODP_IPV6ADDR_LEN / 4;
+	}
+
+	memcpy(&hash, l4, sizeof(hash));
+
+	for (i = 0; i < words; i++) {
+		memcpy(&w, addr + 4 * i, sizeof(w));
+		hash = (hash ^ w) * 0x9e3779b1;
+	}
+
+	/* Zero is reserved for packets without a flow */
+	return hash | 1;
+}
+
+/* Parse a received packet for coalescing */
+static void gro_parse(pktio_entry_t *entry, odp_packet_hdr_t *pkt_hdr,
+		      pktio_gro_pkt_t *g)
+{
+	odp_pktin_config_opt_t gro = entry->s.gro.sw;
+	packet_parser_t *prs = &pkt_hdr->p;
+	odp_buffer_hdr_t *buf_hdr = &pkt_hdr->buf_hdr;
+	uint32_t seg_len = buf_hdr->seg[0].len;
+	const uint8_t *l3, *l4;
+	uint32_t ip_hdr_len, l4_hdr_len, ip_len;
+	uint16_t chksum;
+	uint8_t flags = 0;
+	uint64_t sum;
+
+	g->flow  = 0;
+	g->segs  = 1;
+	g->merge = 0;
+	g->open  = 0;
+
+	if (packet_parse_not_complete(pkt_hdr))
+		packet_parse_layer(pkt_hdr, LAYER_ALL);
+
+	if (!((gro.bit.tcp_gro && prs->input_flags.tcp) ||
+	      (gro.bit.udp_gro && prs->input_flags.udp)) ||
+	    prs->error_flags.all || prs->input_flags.ipfrag ||
+	    prs->l3_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l4_offset == ODP_PACKET_OFFSET_INVALID ||
+	    prs->l4_offset <= prs->l3_offset)
+		return;
+
+	/* No IPv4 options or IPv6 extension headers */
+	ip_hdr_len = prs->l4_offset - prs->l3_offset;
+	if (ip_hdr_len != (prs->input_flags.ipv4 ? _ODP_IPV4HDR_LEN :
+						   _ODP_IPV6HDR_LEN))
+		return;
+
+	l3 = buf_hdr->seg[0].data + prs->l3_offset;
+	l4 = buf_hdr->seg[0].data + prs->l4_offset;
+
+	if (prs->input_flags.tcp) {
+		if (prs->l4_offset + _ODP_TCPHDR_LEN > seg_len)
+			return;
+
+		l4_hdr_len = ((const _odp_tcphdr_t *)(const void *)l4)->hl * 4;
+		if (l4_hdr_len < _ODP_TCPHDR_LEN)
+			return;
+		flags = l4[TCP_FLAGS_OFFSET];
+	} else {
+		l4_hdr_len = _ODP_UDPHDR_LEN;
+	}
+
+	/* Headers are followed by payload in the first segment */
+	g->hdr_len = prs->l4_offset + l4_hdr_len;
+	if (g->hdr_len >= seg_len)
+		return;
+
+	if (prs->input_flags.ipv4)
+		ip_len = odp_be_to_cpu_16(((const _odp_ipv4hdr_t *)
+					   (const void *)l3)->tot_len);
+	else
+		ip_len = odp_be_to_cpu_16(((const _odp_ipv6hdr_t *)
+					   (const void *)l3)->payload_len) +
+			 _ODP_IPV6HDR_LEN;
+
+	if (ip_len < ip_hdr_len + l4_hdr_len ||
+	    prs->l3_offset + ip_len > pkt_hdr->frame_len)
+		return;
+
+	g->flow    = gro_flow_hash(l3, l4, prs->input_flags.ipv4);
+	g->payload = ip_len - ip_hdr_len - l4_hdr_len;
+	g->pad     = pkt_hdr->frame_len - prs->l3_offset - ip_len;
+
+	/* Other packets of the flow are not merged, but they stop merging of
+	 * later packets into earlier ones */
+	if (g->payload == 0 ||
+	    g->pad >= buf_hdr->seg[buf_hdr->segcount - 1].len)
+		return;
+
+	if (prs->input_flags.tcp) {
+		if ((flags & ~TCP_FLAG_PSH) != TCP_FLAG_ACK)
+			return;
+	} else {
+		/* Zero means no checksum over IPv4 */
+		memcpy(&chksum, l4 + offsetof(_odp_udphdr_t, chksum),
+		       sizeof(chksum));
+		if (chksum == 0)
+			return;
+	}
+
+	/* Payload sum is derived from the checksum, which covers the pseudo
+	 * header, the L4 header and the payload */
+	sum = pseudo_sum(pkt_hdr, ip_len - ip_hdr_len);
+	sum = chksum_partial(l4, l4_hdr_len, sum);
+	g->sum = (uint16_t)~chksum_fold(sum);
+
+	/* Packets coalesced by the kernel have the segmentation size set */
+	g->seg_size = g->payload;
+	if (prs->output_flags.gso_size &&
+	    prs->output_flags.gso_size < g->payload) {
+		g->seg_size = prs->output_flags.gso_size;
+		g->segs     = 2;
+	}
+
+	g->merge = 1;
+	g->open  = !(flags & TCP_FLAG_PSH) &&
+		   buf_hdr->segcount < CONFIG_PACKET_MAX_SEGS;
+}
+
+/* Packets have the same protocols, IP addresses and ports */
+static int gro_same_flow(odp_packet_hdr_t *dst, odp_packet_hdr_t *src)
+{
+	packet_parser_t *d = &dst->p;
+	packet_parser_t *s = &src->p;
+	const uint8_t *d_l3 = dst->buf_hdr.seg[0].data + d->l3_offset;
+	const uint8_t *s_l3 = src->buf_hdr.seg[0].data + s->l3_offset;
+	const uint8_t *d_l4 = dst->buf_hdr.seg[0].data + d->l4_offset;
+	const uint8_t *s_l4 = src->buf_hdr.seg[0].data + s->l4_offset;
+
+	if (d->input_flags.ipv4 != s->input_flags.ipv4 ||
+	    d->input_flags.tcp != s->input_flags.tcp ||
+	    memcmp(d_l4, s_l4, 4))
+		return 0;
+
+	if (d->input_flags.ipv4)
+		return !memcmp(d_l3 + offsetof(_odp_ipv4hdr_t, src_addr),
+			       s_l3 + offsetof(_odp_ipv4hdr_t, src_addr),
+			       2 * _ODP_IPV4ADDR_LEN);
+
+	return !memcmp(d_l3 + offsetof(_odp_ipv6hdr_t, src_addr),
+		       s_l3 + offsetof(_odp_ipv6hdr_t, src_addr),
+		       2 * _ODP_IPV6ADDR_LEN);
+}
+
+/* Packet of the same flow can be appended to the destination packet.
+ * Headers must match, except for the fields updated when packets are
+ * coalesced. */
+static int gro_can_merge(odp_packet_hdr_t *dst, pktio_gro_pkt_t *dg,
+			 odp_packet_hdr_t *src, pktio_gro_pkt_t *sg)
+{
+	packet_parser_t *prs = &dst->p;
+	const uint8_t *d = dst->buf_hdr.seg[0].data;
+	const uint8_t *s = src->buf_hdr.seg[0].data;
+	const uint8_t *d_l3 = d + prs->l3_offset;
+	const uint8_t *s_l3 = s + prs->l3_offset;
+	const _odp_tcphdr_t *d_tcp, *s_tcp;
+
+	if (!dg->open || !sg->merge || sg->payload > dg->seg_size ||
+	    dg->hdr_len != sg->hdr_len ||
+	    prs->l3_offset != src->p.l3_offset ||
+	    dg->hdr_len - prs->l3_offset + dg->payload + sg->payload >
+	    UINT16_MAX ||
+	    dst->buf_hdr.segcount + src->buf_hdr.segcount >
+	    CONFIG_PACKET_MAX_SEGS ||
+	    dst->buf_hdr.pool_hdl != src->buf_hdr.pool_hdl ||
+	    dst->p.input_flags.dst_queue != src->p.input_flags.dst_queue ||
+	    (dst->p.input_flags.dst_queue && dst->dst_queue != src->dst_queue))
+		return 0;
+
+	/* L2 header */
+	if (memcmp(d, s, prs->l3_offset))
+		return 0;
+
+	if (prs->input_flags.ipv4) {
+		/* Version, TOS, fragmentation flags, TTL and protocol */
+		if (memcmp(d_l3, s_l3, offsetof(_odp_ipv4hdr_t, tot_len)) ||
+		    memcmp(d_l3 + offsetof(_odp_ipv4hdr_t, frag_offset),
+			   s_l3 + offsetof(_odp_ipv4hdr_t, frag_offset),
+			   offsetof(_odp_ipv4hdr_t, chksum) -
+			   offsetof(_odp_ipv4hdr_t, frag_offset)))
+			return 0;
+	} else {
+		/* Version, traffic class, flow label, next header and hop
+		 * limit */
+		if (memcmp(d_l3, s_l3, offsetof(_odp_ipv6hdr_t, payload_len)) ||
+		    memcmp(d_l3 + offsetof(_odp_ipv6hdr_t, next_hdr),
+			   s_l3 + offsetof(_odp_ipv6hdr_t, next_hdr),
+			   offsetof(_odp_ipv6hdr_t, src_addr) -
+			   offsetof(_odp_ipv6hdr_t, next_hdr)))
+			return 0;
+	}
+
+	if (!prs->input_flags.tcp)
+		return 1;
+
+	/* Acknowledgment, options and the next sequence number */
+	d_tcp = (const _odp_tcphdr_t *)(const void *)(d + prs->l4_offset);
+	s_tcp = (const _odp_tcphdr_t *)(const void *)(s + prs->l4_offset);
+
+	return d_tcp->ack_no == s_tcp->ack_no &&
+	       !memcmp(d_tcp + 1, s_tcp + 1, dg->hdr_len - prs->l4_offset -
+			_ODP_TCPHDR_LEN) &&
+	       odp_be_to_cpu_32(s_tcp->seq_no) ==
+	       odp_be_to_cpu_32(d_tcp->seq_no) + dg->payload;
+}
+
+/* Append payload of a packet to the destination packet. Segments are linked
+ * without copying payload data. */
+static void gro_merge(odp_packet_t *dst, pktio_gro_pkt_t *dg, odp_packet_t src,
+		      pktio_gro_pkt_t *sg)
+{
+	odp_packet_hdr_t *dst_hdr = odp_packet_hdr(*dst);
+	odp_packet_hdr_t *src_hdr = odp_packet_hdr(src);
+	uint32_t l4_offset = dst_hdr->p.l4_offset;
+	uint8_t *d_l4 = dst_hdr->buf_hdr.seg[0].data + l4_offset;
+	uint8_t *s_l4 = src_hdr->buf_hdr.seg[0].data + l4_offset;
+	uint16_t sum = sg->sum;
+
+	/* PSH flag and window of the last segment */
+	if (dst_hdr->p.input_flags.tcp) {
+		d_l4[TCP_FLAGS_OFFSET] |= s_l4[TCP_FLAGS_OFFSET] & TCP_FLAG_PSH;
+		memcpy(d_l4 + offsetof(_odp_tcphdr_t, window),
+		       s_l4 + offsetof(_odp_tcphdr_t, window),
+		       sizeof(odp_u16be_t));
+	}
+
+	if (dg->pad) {
+		odp_packet_pull_tail(*dst, dg->pad);
+		dg->pad = 0;
+	}
+
+	if (sg->pad)
+		odp_packet_pull_tail(src, sg->pad);
+
+	odp_packet_pull_head(src, sg->hdr_len);
+
+	/* Cannot fail, since packets are from the same pool and there is
+	 * room for the segments */
+	(void)odp_packet_concat(dst, src);
+
+	/* Payload sum is swapped when it starts from an odd offset */
+	dg->sum     += (dg->payload & 1) ? chksum_swap(sum) : sum;
+	dg->payload += sg->payload;
+	dg->segs++;
+
+	if (sg->payload < dg->seg_size || !sg->open ||
+	    dst_hdr->buf_hdr.segcount >= CONFIG_PACKET_MAX_SEGS)
+		dg->open = 0;
+}
+
+/* Update lengths and checksums of a coalesced packet. IPv4 ID and other
+ * header fields are those of the first segment. */
+static void gro_finalize(odp_packet_hdr_t *pkt_hdr, pktio_gro_pkt_t *g)
+{
+	packet_parser_t *prs = &pkt_hdr->p;
+	uint8_t *data = pkt_hdr->buf_hdr.seg[0].data;
+	uint8_t *l4 = data + prs->l4_offset;
+	uint32_t l4_hdr_len = g->hdr_len - prs->l4_offset;
+	uint32_t len = l4_hdr_len + g->payload;
+	uint8_t *field;
+	uint16_t chksum;
+	uint64_t sum;
+
+	if (prs->input_flags.ipv4) {
+		_odp_ipv4hdr_t *ip = (_odp_ipv4hdr_t *)(void *)
+				     (data + prs->l3_offset);
+
+		ip->tot_len = odp_cpu_to_be_16(_ODP_IPV4HDR_LEN + len);
+		pktio_chksum_insert_sw(pkt_hdr, PKTIO_CHKSUM_L3);
+	} else {
+		_odp_ipv6hdr_t *ip = (_odp_ipv6hdr_t *)(void *)
+				     (data + prs->l3_offset);
+
+		ip->payload_len = odp_cpu_to_be_16(len);
+	}
+
+	if (prs->input_flags.tcp) {
+		field = l4 + offsetof(_odp_tcphdr_t, cksm);
+	} else {
+		((_odp_udphdr_t *)(void *)l4)->length = odp_cpu_to_be_16(len);
+		field = l4 + offsetof(_odp_udphdr_t, chksum);
+	}
+
+	memset(field, 0, sizeof(chksum));
+	sum    = pseudo_sum(pkt_hdr, len);
+	sum    = chksum_partial(l4, l4_hdr_len, sum);
+	chksum = ~chksum_fold(sum + g->sum);
+
+	if (prs->input_flags.udp && chksum == 0)
+		chksum = 0xffff;
+
+	memcpy(field, &chksum, sizeof(chksum));
+
+	prs->output_flags.gso_size = g->seg_size;
+}
+
+/* Coalesce packets. Merged packets are removed from the table and the rest
+ * are moved to the beginning of the tables. The first 'held' packets have
+ * been parsed already, and their state is in 'g'. Returns the number of
+ * packets left. */
+static int gro_packets(pktio_entry_t *entry, odp_packet_t pkt_tbl[],
+		       pktio_gro_pkt_t g[], int held, int num)
+{
+	odp_packet_hdr_t *pkt_hdr;
+	uint64_t pkts = 0;
+	uint64_t segs = 0;
+	pktio_gro_pkt_t cur;
+	int i, j;
+	int out = 0;
+
+	for (i = 0; i < num; i++) {
+		pkt_hdr = odp_packet_hdr(pkt_tbl[i]);
+
+		if (i < held)
+			cur = g[i];
+		else
+			gro_parse(entry, pkt_hdr, &cur);
+
+		if (cur.flow) {
+			/* The latest packet of the flow */
+			for (j = out - 1; j >= 0; j--) {
+				if (g[j].flow == cur.flow &&
+				    gro_same_flow(odp_packet_hdr(pkt_tbl[j]),
+						  pkt_hdr))
+					break;
+			}
+
+			if (j >= 0) {
+				if (gro_can_merge(odp_packet_hdr(pkt_tbl[j]),
+						  &g[j], pkt_hdr, &cur)) {
+					if (g[j].segs == 1) {
+						pkts++;
+						segs++;
+					}
+					segs++;
+					gro_merge(&pkt_tbl[j], &g[j],
+						  pkt_tbl[i], &cur);
+					continue;
+				}
+
+				/* Packet order within a flow is maintained */
+				g[j].open = 0;
+			}
+		}
+
+		pkt_tbl[out] = pkt_tbl[i];
+		g[out++] = cur;
+	}
+
+	if (segs) {
+		odp_atomic_add_u64(&entry->s.gro.pkts, pkts);
+		odp_atomic_add_u64(&entry->s.gro.segs, segs);
+	}
+
+	return out;
+}
+
+int _pktio_gro_recv(pktio_entry_t *entry, int index, odp_packet_t packets[],
+		    int num)
+{
+	pktio_gro_t *gro = &entry->s.gro;
+	pktio_gro_queue_t *queue = &gro->queue[index];
+	odp_packet_t pkt_tbl[PKTIO_GRO_MAX_HELD + QUEUE_MULTI_MAX];
+	pktio_gro_pkt_t g[PKTIO_GRO_MAX_HELD + QUEUE_MULTI_MAX];
+	odp_time_t now;
+	int held, ret, flush, i;
+	int out = 0;
+
+	if (odp_unlikely(num <= 0))
+		return 0;
+
+	if (num > QUEUE_MULTI_MAX)
+		num = QUEUE_MULTI_MAX;
+
+	if (!gro->flush_ns) {
+		ret = entry->s.ops->recv(entry, index, packets, num);
+		if (ret <= 1)
+			return ret;
+
+		ret = gro_packets(entry, packets, g, 0, ret);
+
+		for (i = 0; i < ret; i++) {
+			if (g[i].segs > 1)
+				gro_finalize(odp_packet_hdr(packets[i]), &g[i]);
+		}
+
+		return ret;
+	}
+
+	odp_spinlock_lock(&queue->lock);
+
+	/* Held packets are older than received ones */
+	held = queue->num;
+	memcpy(pkt_tbl, queue->pkt, held * sizeof(odp_packet_t));
+	memcpy(g, queue->g, held * sizeof(pktio_gro_pkt_t));
+
+	ret = entry->s.ops->recv(entry, index, &pkt_tbl[held], num);
+	if (ret < 0) {
+		if (!held) {
+			odp_spinlock_unlock(&queue->lock);
+			return ret;
+		}
+		ret = 0;
+	}
+
+	ret = gro_packets(entry, pkt_tbl, g, held, held + ret);
+
+	/* All packets are output when the oldest held packet has been held
+	 * for the flush time */
+	now   = odp_time_global();
+	flush = held && odp_time_to_ns(odp_time_diff(now, queue->time)) >=
+		gro->flush_ns;
+
+	/* Packets that may be coalesced with later packets are held, and
+	 * the rest are output in order. Packets that do not fit into
+	 * the output table are held also. */
+	queue->num = 0;
+
+	for (i = 0; i < ret; i++) {
+		if (out < num &&
+		    (flush || !g[i].open || queue->num == PKTIO_GRO_MAX_HELD)) {
+			if (g[i].segs > 1)
+				gro_finalize(odp_packet_hdr(pkt_tbl[i]), &g[i]);
+
+			packets[out++] = pkt_tbl[i];
+		} else {
+			queue->g[queue->num]     = g[i];
+			queue->pkt[queue->num++] = pkt_tbl[i];
+		}
+	}
+
+	if (queue->num && (!held || flush))
+		queue->time = now;
+
+	odp_spinlock_unlock(&queue->lock);
+
+	return out;
+}
+
+void pktio_gro_config(pktio_entry_t *entry, const odp_pktio_config_t *config)
+{
+	pktio_gro_t *gro = &entry->s.gro;
+
+	pktio_gro_term(entry);
+
+	/* Drivers with native coalescing clear these */
+	gro->sw.all_bits    = 0;
+	gro->sw.bit.tcp_gro = config->pktin.bit.tcp_gro;
+	gro->sw.bit.udp_gro = config->pktin.bit.udp_gro;
+	gro->flush_ns       = config->gro.flush_ns;
+}
+
+void pktio_gro_term(pktio_entry_t *entry)
+{
+	pktio_gro_queue_t *queue;
+	int i;
+
+	for (i = 0; i < PKTIO_MAX_QUEUES; i++) {
+		queue = &entry->s.gro.queue[i];
+
+		odp_spinlock_lock(&queue->lock);
+		if (queue->num)
+			odp_packet_free_multi(queue->pkt, queue->num);
+		queue->num = 0;
+		odp_spinlock_unlock(&queue->lock);
+	}
+}
+
+void pktio_gso_term(pktio_entry_t *entry)
+{
+	pktio_gso_queue_t *queue;
+	int i;
+
+	for (i = 0; i < PKTIO_MAX_QUEUES; i++) {
+		queue = &entry->s.gso.queue[i];
+
+		odp_spinlock_lock(&queue->lock);
+		if (queue->num) {
+			odp_packet_free_multi(&queue->seg[queue->first],
+					      queue->num);
+			odp_atomic_add_u64(&entry->s.gso.discards, queue->num);
+		}
+		queue->first = 0;
+		queue->num   = 0;
+		odp_spinlock_unlock(&queue->lock);
+	}
+}
 
 int sock_stats_reset_fd(pktio_entry_t *pktio_entry, int fd)
 {
@@ -31,6 +31,7 @@
 #include <sys/syscall.h>
 #include <linux/ethtool.h>
 #include <linux/sockios.h>
+#include <linux/virtio_net.h>
 
 #include <odp_api.h>
 #include <odp_packet_socket.h>
@@ -461,6 +462,12 @@ static int sock_close(pktio_entry_t *pktio_entry)
 		return -1;
 	}
 
+	if (pkt_sock->gso_fd != -1 && close(pkt_sock->gso_fd) != 0) {
+		__odp_errno = errno;
+		ODP_ERR("close(gso_fd): %s\n", strerror(errno));
+		return -1;
+	}
+
 	odp_shm_free(pkt_sock->shm);
 
 	return 0;
@@ -475,6 +482,7 @@ static int sock_setup_pkt(pktio_entry_t *pktio_entry, const char *netdev,
 	int sockfd;
 	int err;
 	int i;
+	int val = 1;
 	unsigned int if_idx;
 	struct ifreq ethreq;
 	struct sockaddr_ll sa_ll;
@@ -487,6 +495,7 @@ static int sock_setup_pkt(pktio_entry_t *pktio_entry, const char *netdev,
 	memset(pkt_sock, 0, sizeof(*pkt_sock));
 	/* set sockfd to -1, because a valid socked might be initialized to 0 */
 	pkt_sock->sockfd = -1;
+	pkt_sock->gso_fd = -1;
 
 	if (pool == ODP_POOL_INVALID)
 		return -1;
@@ -525,6 +534,7 @@ static int sock_setup_pkt(pktio_entry_t *pktio_entry, const char *netdev,
 		goto error;
 	}
 	if_idx = ethreq.ifr_ifindex;
+	pkt_sock->if_idx = if_idx;
 
 	err = mac_addr_get_fd(sockfd, netdev, pkt_sock->if_mac);
 	if (err != 0)
@@ -545,6 +555,12 @@ static int sock_setup_pkt(pktio_entry_t *pktio_entry, const char *netdev,
 		goto error;
 	}
 
+	/* Receive checksum status of packets in auxiliary data. Checksums
+	 * are checked in software on failure. */
+	if (setsockopt(sockfd, SOL_PACKET, PACKET_AUXDATA, &val,
+		       sizeof(val)) < 0)
+		ODP_DBG("setsockopt(PACKET_AUXDATA): %s\n", strerror(errno));
+
 	err = ethtool_stats_get_fd(pktio_entry->s.pkt_sock.sockfd,
 				   pktio_entry->s.name,
 				   &cur_stats);
@@ -610,6 +626,24 @@ static uint32_t _rx_pkt_to_iovec(odp_packet_t pkt,
 	return iov_count;
 }
 
+/* Packet status (TP_STATUS_XXX) from auxiliary data of a received message */
+static inline uint32_t msg_tp_status(struct msghdr *msg)
+{
+	struct cmsghdr *cmsg;
+	struct tpacket_auxdata *aux;
+
+	for (cmsg = CMSG_FIRSTHDR(msg); cmsg; cmsg = CMSG_NXTHDR(msg, cmsg)) {
+		if (cmsg->cmsg_level != SOL_PACKET ||
+		    cmsg->cmsg_type != PACKET_AUXDATA)
+			continue;
+
+		aux = (struct tpacket_auxdata *)(void *)CMSG_DATA(cmsg);
+		return aux->tp_status;
+	}
+
+	return 0;
+}
+
 /*
  * ODP_PACKET_SOCKET_MMSG:
  */
@@ -622,6 +656,10 @@ static int sock_mmsg_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	const int sockfd = pkt_sock->sockfd;
 	int msgvec_len;
 	struct mmsghdr msgvec[ODP_PACKET_SOCKET_MAX_BURST_RX];
+	union {
+		struct cmsghdr hdr;
+		uint8_t buf[CMSG_SPACE(sizeof(struct tpacket_auxdata))];
+	} cmsg_buf[ODP_PACKET_SOCKET_MAX_BURST_RX];
 	int nb_rx = 0;
 	int recv_msgs;
 	uint8_t **recv_cache;
@@ -639,6 +677,11 @@ static int sock_mmsg_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	memset(msgvec, 0, sizeof(msgvec));
 	recv_cache = pkt_sock->cache_ptr;
 
+	for (i = 0; i < len; i++) {
+		msgvec[i].msg_hdr.msg_control = &cmsg_buf[i];
+		msgvec[i].msg_hdr.msg_controllen = sizeof(cmsg_buf[i]);
+	}
+
 	if (pktio_cls_enabled(pktio_entry)) {
 		struct iovec iovecs[ODP_PACKET_SOCKET_MAX_BURST_RX];
 
@@ -688,6 +731,9 @@ static int sock_mmsg_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			}
 			pkt_hdr->input = pktio_entry->s.handle;
 			copy_packet_cls_metadata(&parsed_hdr, pkt_hdr);
+			pktio_sw_hash(pktio_entry, pkt_hdr);
+			sock_chksum_check(pktio_entry, pkt_hdr,
+					  msg_tp_status(&msgvec[i].msg_hdr));
 			packet_set_ts(pkt_hdr, ts);
 
 			pkt_table[nb_rx++] = pkt;
@@ -750,6 +796,9 @@ static int sock_mmsg_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 
 			pkt_hdr = odp_packet_hdr(pkt);
 			packet_parse_l2(&pkt_hdr->p, pkt_hdr->frame_len);
+			pktio_sw_hash(pktio_entry, pkt_hdr);
+			sock_chksum_check(pktio_entry, pkt_hdr,
+					  msg_tp_status(&msgvec[i].msg_hdr));
 			packet_set_ts(pkt_hdr, ts);
 			pkt_hdr->input = pktio_entry->s.handle;
 
@@ -786,6 +835,62 @@ static uint32_t _tx_pkt_to_iovec(odp_packet_t pkt,
 	return iov_count;
 }
 
+/*
+ * ODP_PACKET_SOCKET_MMSG:
+ */
+static int sock_config(pktio_entry_t *pktio_entry,
+		       const odp_pktio_config_t *config)
+{
+	pkt_sock_t *pkt_sock = &pktio_entry->s.pkt_sock;
+	struct sockaddr_ll sa_ll;
+	int val = 1;
+	int fd;
+
+	if (!config->pktout.bit.tcp_gso) {
+		if (pkt_sock->gso_fd != -1) {
+			close(pkt_sock->gso_fd);
+			pkt_sock->gso_fd = -1;
+		}
+		return 0;
+	}
+
+	if (pkt_sock->gso_fd != -1) {
+		pktio_entry->s.gso_sw.bit.tcp_gso = 0;
+		return 0;
+	}
+
+	/* Packets to be segmented by the kernel are sent with a virtio net
+	 * header through a separate socket, so that packet input is not
+	 * affected. A socket bound to protocol zero does not receive
+	 * packets. Segmentation is done in software on failure. */
+	fd = socket(AF_PACKET, SOCK_RAW, 0);
+	if (fd == -1) {
+		ODP_DBG("socket(): %s\n", strerror(errno));
+		return 0;
+	}
+
+	if (setsockopt(fd, SOL_PACKET, PACKET_VNET_HDR, &val,
+		       sizeof(val)) < 0) {
+		ODP_DBG("setsockopt(PACKET_VNET_HDR): %s\n", strerror(errno));
+		close(fd);
+		return 0;
+	}
+
+	memset(&sa_ll, 0, sizeof(sa_ll));
+	sa_ll.sll_family = AF_PACKET;
+	sa_ll.sll_ifindex = pkt_sock->if_idx;
+	if (bind(fd, (struct sockaddr *)&sa_ll, sizeof(sa_ll)) < 0) {
+		ODP_DBG("bind(to IF): %s\n", strerror(errno));
+		close(fd);
+		return 0;
+	}
+
+	pkt_sock->gso_fd = fd;
+	pktio_entry->s.gso_sw.bit.tcp_gso = 0;
+
+	return 0;
+}
+
 /*
  * ODP_PACKET_SOCKET_MMSG:
  */
@@ -794,7 +899,11 @@ static int sock_mmsg_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 {
 	pkt_sock_t *pkt_sock = &pktio_entry->s.pkt_sock;
 	struct mmsghdr msgvec[ODP_PACKET_SOCKET_MAX_BURST_TX];
-	struct iovec iovecs[ODP_PACKET_SOCKET_MAX_BURST_TX][MAX_SEGS];
+	struct iovec iovecs[ODP_PACKET_SOCKET_MAX_BURST_TX][MAX_SEGS + 1];
+	struct virtio_net_hdr vnet[ODP_PACKET_SOCKET_MAX_BURST_TX];
+	uint8_t gso[ODP_PACKET_SOCKET_MAX_BURST_TX];
+	struct sockaddr_ll sa_ll[2];
+	odp_packet_hdr_t *pkt_hdr;
 	int ret;
 	int sockfd;
 	int n, i;
@@ -804,17 +913,49 @@ static int sock_mmsg_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 
 	odp_ticketlock_lock(&pktio_entry->s.txl);
 
-	sockfd = pkt_sock->sockfd;
+	pktio_chksum_insert(pktio_entry, pkt_table, len);
+
 	memset(msgvec, 0, sizeof(msgvec));
 
 	for (i = 0; i < len; i++) {
-		msgvec[i].msg_hdr.msg_iov = iovecs[i];
+		pkt_hdr = odp_packet_hdr(pkt_table[i]);
+		gso[i]  = pkt_sock->gso_fd != -1 &&
+			  pktio_gso_vnet_hdr(pktio_entry, pkt_hdr, &vnet[i]);
+
+		msgvec[i].msg_hdr.msg_iov = &iovecs[i][1];
 		msgvec[i].msg_hdr.msg_iovlen = _tx_pkt_to_iovec(pkt_table[i],
-				iovecs[i]);
+				&iovecs[i][1]);
+
+		if (!gso[i])
+			continue;
+
+		/* Virtio net header precedes packet data. Protocol of
+		 * the destination address is needed for segmentation. */
+		iovecs[i][0].iov_base = &vnet[i];
+		iovecs[i][0].iov_len  = sizeof(vnet[i]);
+		msgvec[i].msg_hdr.msg_iov = iovecs[i];
+		msgvec[i].msg_hdr.msg_iovlen++;
+		msgvec[i].msg_hdr.msg_name =
+			&sa_ll[pkt_hdr->p.input_flags.ipv6];
+		msgvec[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_ll);
 	}
 
+	memset(sa_ll, 0, sizeof(sa_ll));
+	sa_ll[0].sll_family   = AF_PACKET;
+	sa_ll[0].sll_ifindex  = pkt_sock->if_idx;
+	sa_ll[0].sll_protocol = htons(ETH_P_IP);
+	sa_ll[1].sll_family   = AF_PACKET;
+	sa_ll[1].sll_ifindex  = pkt_sock->if_idx;
+	sa_ll[1].sll_protocol = htons(ETH_P_IPV6);
+
 	for (i = 0; i < len; ) {
-		ret = sendmmsg(sockfd, &msgvec[i], len - i, MSG_DONTWAIT);
+		/* Send until the next change between the sockets */
+		sockfd = gso[i] ? pkt_sock->gso_fd : pkt_sock->sockfd;
+
+		for (n = i + 1; n < len && gso[n] == gso[i]; n++)
+			;
+
+		ret = sendmmsg(sockfd, &msgvec[i], n - i, MSG_DONTWAIT);
 		if (odp_unlikely(ret <= -1)) {
 			if (i == 0 && SOCK_ERR_REPORT(errno)) {
 				__odp_errno = errno;
@@ -891,6 +1032,7 @@ static int sock_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+	pktio_chksum_capa(&capa->config);
 	return 0;
 }
 
@@ -954,7 +1096,7 @@ const pktio_if_ops_t sock_mmsg_pktio_ops = {
 	.capability = sock_capability,
 	.pktin_ts_res = NULL,
 	.pktin_ts_from_ns = NULL,
-	.config = NULL,
+	.config = sock_config,
 	.input_queues_config = NULL,
 	.output_queues_config = NULL,
 };
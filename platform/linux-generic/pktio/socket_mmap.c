@@ -176,6 +176,18 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 		if (!mmap_rx_kernel_ready(ring->rd[frame_num].iov_base))
 			break;
 
+		/* Prefetch frame header and packet start of a later frame */
+		if (CONFIG_PACKET_PREFETCH_DIST) {
+			unsigned next_num;
+			uint8_t *next;
+
+			next_num = (frame_num + CONFIG_PACKET_PREFETCH_DIST) %
+				   ring->rd_num;
+			next = ring->rd[next_num].iov_base;
+			odp_prefetch(next);
+			odp_prefetch(next + ODP_CACHE_LINE_SIZE);
+		}
+
 		if (ts != NULL)
 			ts_val = odp_time_global();
 
@@ -233,6 +245,8 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 		else
 			packet_parse_l2(&hdr->p, pkt_len);
 
+		pktio_sw_hash(pktio_entry, hdr);
+		sock_chksum_check(pktio_entry, hdr, ppd.v2->tp_h.tp_status);
 		packet_set_ts(hdr, ts);
 
 		mmap_rx_user_ready(ppd.raw);
@@ -612,6 +626,7 @@ static int sock_mmap_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	pkt_sock_mmap_t *const pkt_sock = &pktio_entry->s.pkt_sock_mmap;
 
 	odp_ticketlock_lock(&pktio_entry->s.txl);
+	pktio_chksum_insert(pktio_entry, pkt_table, len);
 	ret = pkt_mmap_v2_tx(pkt_sock->tx_ring.sock, &pkt_sock->tx_ring,
 			     pkt_table, len);
 	odp_ticketlock_unlock(&pktio_entry->s.txl);
@@ -662,6 +677,7 @@ static int sock_mmap_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+	pktio_chksum_capa(&capa->config);
 	return 0;
 }
 
@@ -37,15 +37,22 @@
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <linux/if_link.h>
 #include <linux/if_tun.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/virtio_net.h>
 
 #include <odp_api.h>
 #include <odp_packet_socket.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
+#include <odp_pool_internal.h>
 #include <odp_classification_internal.h>
+#include <protocols/eth.h>
 
-#define BUF_SIZE 65536
+/* Maximum IP packet with L2 and virtio net headers */
+#define BUF_SIZE (65536 + 128)
 
 static int gen_random_mac(unsigned char *mac)
 {
@@ -62,6 +69,7 @@ static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
 			  const char *devname, odp_pool_t pool)
 {
 	int fd, skfd, flags;
+	unsigned int features;
 	uint32_t mtu;
 	struct ifreq ifr;
 	pkt_tap_t *tap = &pktio_entry->s.pkt_tap;
@@ -91,6 +99,16 @@ static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
 	 *        IFF_NO_PI - Do not provide packet information
 	 */
 	ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
+
+	/* IFF_VNET_HDR - Prepend virtio net header to packets. The header
+	 *                enables segmentation offload on packet output.
+	 *                It cannot be changed after the device is created. */
+	if (ioctl(fd, TUNGETFEATURES, &features) == 0 &&
+	    (features & IFF_VNET_HDR)) {
+		ifr.ifr_flags |= IFF_VNET_HDR;
+		tap->vnet_hdr = 1;
+	}
+
 	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", devname + 4);
 
 	if (ioctl(fd, TUNSETIFF, (void *)&ifr) < 0) {
@@ -187,8 +205,18 @@ static odp_packet_t pack_odp_pkt(pktio_entry_t *pktio_entry, const void *data,
 	odp_packet_t pkt;
 	odp_packet_hdr_t *pkt_hdr;
 	odp_packet_hdr_t parsed_hdr;
+	struct virtio_net_hdr vnet;
 	int num;
 
+	if (pktio_entry->s.pkt_tap.vnet_hdr) {
+		if (len < sizeof(struct virtio_net_hdr))
+			return ODP_PACKET_INVALID;
+
+		memcpy(&vnet, data, sizeof(vnet));
+		data = (const uint8_t *)data + sizeof(struct virtio_net_hdr);
+		len -= sizeof(struct virtio_net_hdr);
+	}
+
 	if (pktio_cls_enabled(pktio_entry)) {
 		if (cls_classify_packet(pktio_entry, data, len, len,
 					&pktio_entry->s.pkt_tap.pool,
@@ -215,6 +243,12 @@ static odp_packet_t pack_odp_pkt(pktio_entry_t *pktio_entry, const void *data,
 	else
 		packet_parse_l2(&pkt_hdr->p, len);
 
+	/* Input offloads are enabled only with packet input coalescing */
+	if (pktio_entry->s.pkt_tap.offload)
+		pktio_vnet_hdr_recv(pktio_entry, pkt_hdr, &vnet);
+
+	pktio_sw_hash(pktio_entry, pkt_hdr);
+	pktio_chksum_check(pktio_entry, pkt_hdr);
 	packet_set_ts(pkt_hdr, ts);
 	pkt_hdr->input = pktio_entry->s.handle;
 
@@ -265,14 +299,23 @@ static int tap_pktio_send_lockless(pktio_entry_t *pktio_entry,
 {
 	ssize_t retval;
 	int i, n;
-	uint32_t pkt_len;
+	uint32_t pkt_len, hdr_len, max_len;
 	uint8_t buf[BUF_SIZE];
 	pkt_tap_t *tap = &pktio_entry->s.pkt_tap;
+	struct virtio_net_hdr *vnet = (struct virtio_net_hdr *)(void *)buf;
+
+	hdr_len = tap->vnet_hdr ? sizeof(struct virtio_net_hdr) : 0;
 
 	for (i = 0; i < len; i++) {
 		pkt_len = odp_packet_len(pkts[i]);
+		max_len = tap->mtu;
 
-		if (pkt_len > tap->mtu) {
+		if (tap->vnet_hdr &&
+		    pktio_gso_vnet_hdr(pktio_entry, odp_packet_hdr(pkts[i]),
+				       vnet))
+			max_len = BUF_SIZE - hdr_len;
+
+		if (pkt_len > max_len) {
 			if (i == 0) {
 				__odp_errno = EMSGSIZE;
 				return -1;
@@ -280,11 +323,14 @@ static int tap_pktio_send_lockless(pktio_entry_t *pktio_entry,
 			break;
 		}
 
-		if (odp_packet_copy_to_mem(pkts[i], 0, pkt_len, buf) < 0) {
+		if (odp_packet_copy_to_mem(pkts[i], 0, pkt_len,
+					   buf + hdr_len) < 0) {
 			ODP_ERR("failed to copy packet data\n");
 			break;
 		}
 
+		pkt_len += hdr_len;
+
 		do {
 			retval = write(tap->fd, buf, pkt_len);
 		} while (retval < 0 && errno == EINTR);
@@ -319,6 +365,8 @@ static int tap_pktio_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 
 	odp_ticketlock_lock(&pktio_entry->s.txl);
 
+	pktio_chksum_insert(pktio_entry, pkts, len);
+
 	ret = tap_pktio_send_lockless(pktio_entry, pkts, len);
 
 	odp_ticketlock_unlock(&pktio_entry->s.txl);
@@ -357,6 +405,106 @@ static int tap_mac_addr_get(pktio_entry_t *pktio_entry, void *mac_addr)
 	return ETH_ALEN;
 }
 
+/* Maximum length of packets coalesced by the kernel (gso_max_size of the
+ * interface), or 0 on failure. The host interface setting is not changed. */
+static uint32_t tap_gso_max_size_get(pktio_entry_t *pktio_entry)
+{
+	pkt_tap_t *tap = &pktio_entry->s.pkt_tap;
+	struct ifreq ifr;
+	struct {
+		struct nlmsghdr nh;
+		struct ifinfomsg ifi;
+	} req;
+	union {
+		struct nlmsghdr nh;
+		uint8_t buf[8192];
+	} resp;
+	struct ifinfomsg *ifi;
+	struct rtattr *rta;
+	uint32_t size = 0;
+	ssize_t len;
+	int fd;
+
+	memset(&ifr, 0, sizeof(ifr));
+	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", pktio_entry->s.name + 4);
+
+	if (ioctl(tap->skfd, SIOCGIFINDEX, &ifr) < 0)
+		return 0;
+
+	fd = socket(AF_NETLINK, SOCK_RAW, NETLINK_ROUTE);
+	if (fd < 0)
+		return 0;
+
+	memset(&req, 0, sizeof(req));
+	req.nh.nlmsg_len   = sizeof(req);
+	req.nh.nlmsg_type  = RTM_GETLINK;
+	req.nh.nlmsg_flags = NLM_F_REQUEST;
+	req.ifi.ifi_family = AF_UNSPEC;
+	req.ifi.ifi_index  = ifr.ifr_ifindex;
+
+	if (send(fd, &req, sizeof(req), 0) != sizeof(req)) {
+		close(fd);
+		return 0;
+	}
+
+	len = recv(fd, &resp, sizeof(resp), 0);
+	close(fd);
+
+	if (len < (ssize_t)NLMSG_LENGTH(sizeof(*ifi)) ||
+	    !NLMSG_OK(&resp.nh, (size_t)len) ||
+	    resp.nh.nlmsg_type != RTM_NEWLINK)
+		return 0;
+
+	ifi = NLMSG_DATA(&resp.nh);
+	len = IFLA_PAYLOAD(&resp.nh);
+
+	for (rta = IFLA_RTA(ifi); RTA_OK(rta, len); rta = RTA_NEXT(rta, len))
+		if (rta->rta_type == IFLA_GSO_MAX_SIZE &&
+		    RTA_PAYLOAD(rta) >= sizeof(uint32_t))
+			memcpy(&size, RTA_DATA(rta), sizeof(size));
+
+	return size;
+}
+
+static int tap_config(pktio_entry_t *pktio_entry,
+		      const odp_pktio_config_t *config)
+{
+	pkt_tap_t *tap = &pktio_entry->s.pkt_tap;
+	unsigned int offload = 0;
+	uint32_t max_size;
+
+	if (!tap->vnet_hdr)
+		return 0;
+
+	/* Kernel segments TCP packets */
+	pktio_entry->s.gso_sw.bit.tcp_gso = 0;
+
+	/* Kernel passes coalesced TCP packets, and packets with partial
+	 * checksums. Coalesced packets must fit into packets of the pool,
+	 * otherwise packets are coalesced in software. The limit can be
+	 * lowered with 'ip link set <tap> gso_max_size <bytes>'. */
+	if (config->pktin.bit.tcp_gro) {
+		max_size = tap_gso_max_size_get(pktio_entry);
+
+		if (max_size && max_size + _ODP_ETHHDR_LEN <=
+				pool_entry_from_hdl(tap->pool)->max_len)
+			offload = TUN_F_CSUM | TUN_F_TSO4 | TUN_F_TSO6;
+	}
+
+	if (ioctl(tap->fd, TUNSETOFFLOAD, offload) < 0) {
+		ODP_DBG("%s: TUNSETOFFLOAD failed: %s\n", pktio_entry->s.name,
+			strerror(errno));
+		offload = 0;
+		ioctl(tap->fd, TUNSETOFFLOAD, offload);
+	}
+
+	tap->offload = offload != 0;
+	if (tap->offload)
+		pktio_entry->s.gro.sw.bit.tcp_gro = 0;
+
+	return 0;
+}
+
 static int tap_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 			  odp_pktio_capability_t *capa)
 {
@@ -369,6 +517,7 @@ static int tap_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	odp_pktio_config_init(&capa->config);
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
+	pktio_chksum_capa(&capa->config);
 	return 0;
 }
 
@@ -391,5 +540,5 @@ const pktio_if_ops_t tap_pktio_ops = {
 	.capability = tap_capability,
 	.pktin_ts_res = NULL,
 	.pktin_ts_from_ns = NULL,
-	.config = NULL
+	.config = tap_config
 };
@@ -10,12 +10,14 @@ AC_CONFIG_FILES([test/common_plat/Makefile
 		 test/common_plat/validation/api/atomic/Makefile
 		 test/common_plat/validation/api/barrier/Makefile
 		 test/common_plat/validation/api/buffer/Makefile
+		 test/common_plat/validation/api/chksum/Makefile
 		 test/common_plat/validation/api/classification/Makefile
 		 test/common_plat/validation/api/cpumask/Makefile
 		 test/common_plat/validation/api/crypto/Makefile
 		 test/common_plat/validation/api/errno/Makefile
 		 test/common_plat/validation/api/hash/Makefile
 		 test/common_plat/validation/api/init/Makefile
+		 test/common_plat/validation/api/ipsec/Makefile
 		 test/common_plat/validation/api/lock/Makefile
 		 test/common_plat/validation/api/Makefile
 		 test/common_plat/validation/api/packet/Makefile
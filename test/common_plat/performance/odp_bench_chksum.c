@@ -0,0 +1,301 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_chksum.c  Microbenchmarks for checksum helpers
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+#include <odp/helper/chksum.h>
+
+/** Maximum test data length (jumbo frame) */
+#define TEST_MAX_LEN 9018
+
+/** Default number of rounds per test */
+#define TEST_ROUNDS 10000
+
+/** Number of packets in the pool */
+#define TEST_PKT_NUM 8
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Test data lengths */
+static const uint32_t test_len[] = {64, 128, 256, 512, 1024, 1518, 4096,
+				    TEST_MAX_LEN};
+
+#define NUM_LEN (sizeof(test_len) / sizeof(test_len[0]))
+
+/** Test data */
+static uint8_t test_data[TEST_MAX_LEN];
+
+/** Test packet */
+static odp_packet_t test_pkt;
+
+/** Benchmarked sum function */
+typedef uint32_t (*bench_fn_t)(uint32_t len);
+
+/**
+ * Scalar 16-bit loop, as used by the helper before the vector kernels
+ */
+static uint32_t bench_scalar(uint32_t len)
+{
+	const uint16_t *data = (const uint16_t *)(const void *)test_data;
+	uint32_t sum = 0;
+	uint32_t i;
+
+	for (i = 0; i < len / 2; i++)
+		sum += data[i];
+
+	if (len & 1)
+		sum += test_data[len - 1];
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return sum;
+}
+
+static uint32_t bench_ones_comp16(uint32_t len)
+{
+	return odp_chksum_ones_comp16(test_data, len);
+}
+
+static uint32_t bench_partial(uint32_t len)
+{
+	return odph_chksum_partial(test_data, len, 0);
+}
+
+static uint32_t bench_pkt_partial(uint32_t len)
+{
+	uint32_t sum = 0;
+
+	if (odph_chksum_pkt_partial(test_pkt, 0, len, &sum))
+		return 0;
+
+	return sum;
+}
+
+/**
+ * Benchmark description
+ */
+typedef struct {
+	const char *name;
+	bench_fn_t fn;
+	int pkt;
+} bench_info_t;
+
+static const bench_info_t bench_info[] = {
+	{"scalar loop", bench_scalar, 0},
+	{"odp_chksum_ones_comp16", bench_ones_comp16, 0},
+	{"odph_chksum_partial", bench_partial, 0},
+	{"odph_chksum_pkt_partial", bench_pkt_partial, 1},
+};
+
+#define NUM_BENCH (sizeof(bench_info) / sizeof(bench_info[0]))
+
+static void usage(char *progname)
+{
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -r 100000\n"
+	       "\n"
+	       "Microbenchmarks for Internet checksum helpers\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -r, --rounds <num>  Number of rounds per test (default %i)\n"
+	       "  -h, --help          Display help and exit.\n\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname), TEST_ROUNDS);
+}
+
+static int parse_args(int argc, char *argv[], uint32_t *rounds)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"rounds", required_argument, NULL, 'r'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "r:h";
+
+	*rounds = TEST_ROUNDS;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'r':
+			*rounds = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (*rounds == 0)
+		*rounds = 1;
+
+	return 0;
+}
+
+static int run_bench(const bench_info_t *bench, uint32_t len,
+		     uint32_t rounds)
+{
+	uint64_t c1, c2, cycles, nsec;
+	odp_time_t t1, t2;
+	uint32_t i;
+	uint32_t sum = 0;
+
+	/* Warm up caches */
+	sum += bench->fn(len);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	for (i = 0; i < rounds; i++)
+		sum += bench->fn(len);
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	cycles = odp_cpu_cycles_diff(c2, c1);
+	nsec   = odp_time_to_ns(odp_time_diff(t2, t1));
+
+	if (nsec == 0)
+		nsec = 1;
+
+	printf("  %-24s %5" PRIu32 " B: %8.1f ns %7.3f cycles/B %8.2f Gbps"
+	       "  (sum %" PRIx32 ")\n", bench->name, len,
+	       (double)nsec / rounds, (double)cycles / rounds / len,
+	       (double)len * 8 * rounds / nsec, sum & 0xffff);
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_pool_param_t params;
+	odp_pool_t pool;
+	uint32_t rounds;
+	uint32_t i, j;
+	uint32_t seed = 1;
+	uint32_t max_len;
+	int ret = 0;
+
+	if (parse_args(argc, argv, &rounds))
+		exit(EXIT_FAILURE);
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < TEST_MAX_LEN; i++) {
+		seed = seed * 1103515245 + 12345;
+		test_data[i] = seed >> 16;
+	}
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_PACKET;
+	params.pkt.len = TEST_MAX_LEN;
+	params.pkt.num = TEST_PKT_NUM;
+
+	pool = odp_pool_create("chksum_bench_pool", &params);
+
+	if (pool == ODP_POOL_INVALID) {
+		LOG_ERR("Error: packet pool create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Packet tests are limited to the maximum packet length */
+	max_len = TEST_MAX_LEN;
+	test_pkt = odp_packet_alloc(pool, max_len);
+
+	while (test_pkt == ODP_PACKET_INVALID && max_len > test_len[0]) {
+		max_len /= 2;
+		test_pkt = odp_packet_alloc(pool, max_len);
+	}
+
+	if (test_pkt == ODP_PACKET_INVALID) {
+		LOG_ERR("Error: packet alloc failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_packet_copy_from_mem(test_pkt, 0, max_len, test_data)) {
+		LOG_ERR("Error: packet copy failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("\nChecksum microbenchmarks, %" PRIu32 " rounds, "
+	       "test packet %i segment(s)\n\n", rounds,
+	       odp_packet_num_segs(test_pkt));
+
+	for (i = 0; i < NUM_LEN; i++) {
+		uint32_t ref = bench_scalar(test_len[i]);
+
+		for (j = 0; j < NUM_BENCH; j++) {
+			if (bench_info[j].pkt && test_len[i] > max_len)
+				continue;
+
+			/* All implementations must agree */
+			if (bench_info[j].fn(test_len[i]) != ref) {
+				LOG_ERR("Error: %s: bad sum\n",
+					bench_info[j].name);
+				ret = -1;
+			}
+
+			run_bench(&bench_info[j], test_len[i], rounds);
+		}
+
+		printf("\n");
+	}
+
+	odp_packet_free(test_pkt);
+
+	if (odp_pool_destroy(pool)) {
+		LOG_ERR("Error: pool destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,928 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_crypto.c  Crypto throughput and scaling benchmark
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+/** Maximum number of worker threads */
+#define MAX_WORKERS 16
+
+/** Maximum number of operations per call */
+#define MAX_BURST 32
+
+/** Maximum number of sessions per thread */
+#define MAX_SESSIONS 16
+
+/** Maximum number of values in a list option */
+#define MAX_LIST 16
+
+/** Maximum payload length */
+#define MAX_LEN (16 * 1024)
+
+/** Maximum digest length */
+#define MAX_DIGEST_LEN 32
+
+/** Default test duration per configuration in msec */
+#define TEST_TIME_MS 10
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Output formats */
+typedef enum {
+	FORMAT_TEXT = 0,
+	FORMAT_CSV,
+	FORMAT_JSON
+} format_t;
+
+/**
+ * Benchmarked algorithm configuration
+ */
+typedef struct {
+	const char *name;
+	odp_cipher_alg_t cipher;
+	uint32_t cipher_key_len;
+	uint32_t iv_len;
+	/* Cipher data length must be a multiple of the block size */
+	uint32_t block;
+	odp_auth_alg_t auth;
+	uint32_t auth_key_len;
+	uint32_t digest_len;
+} bench_alg_t;
+
+static const bench_alg_t bench_alg[] = {
+	{"3des-cbc-null", ODP_CIPHER_ALG_3DES_CBC, 24, 8, 8,
+	 ODP_AUTH_ALG_NULL, 0, 0},
+	{"aes128-cbc-null", ODP_CIPHER_ALG_AES_CBC, 16, 16, 16,
+	 ODP_AUTH_ALG_NULL, 0, 0},
+	{"aes256-cbc-null", ODP_CIPHER_ALG_AES_CBC, 32, 16, 16,
+	 ODP_AUTH_ALG_NULL, 0, 0},
+	{"aes128-ctr-null", ODP_CIPHER_ALG_AES_CTR, 16, 16, 1,
+	 ODP_AUTH_ALG_NULL, 0, 0},
+	{"null-hmac-sha1-96", ODP_CIPHER_ALG_NULL, 0, 0, 1,
+	 ODP_AUTH_ALG_SHA1_HMAC, 20, 12},
+	{"null-hmac-sha256-128", ODP_CIPHER_ALG_NULL, 0, 0, 1,
+	 ODP_AUTH_ALG_SHA256_HMAC, 32, 16},
+	{"null-hmac-sha512-256", ODP_CIPHER_ALG_NULL, 0, 0, 1,
+	 ODP_AUTH_ALG_SHA512_HMAC, 64, 32},
+	{"aes128-cbc-hmac-sha1-96", ODP_CIPHER_ALG_AES_CBC, 16, 16, 16,
+	 ODP_AUTH_ALG_SHA1_HMAC, 20, 12},
+	{"aes128-cbc-hmac-sha256-128", ODP_CIPHER_ALG_AES_CBC, 16, 16, 16,
+	 ODP_AUTH_ALG_SHA256_HMAC, 32, 16},
+	{"aes128-gcm", ODP_CIPHER_ALG_AES_GCM, 16, 12, 1,
+	 ODP_AUTH_ALG_AES_GCM, 0, 16},
+	{"aes256-gcm", ODP_CIPHER_ALG_AES_GCM, 32, 12, 1,
+	 ODP_AUTH_ALG_AES_GCM, 0, 16},
+	{"chacha20-poly1305", ODP_CIPHER_ALG_CHACHA20_POLY1305, 32, 12, 1,
+	 ODP_AUTH_ALG_CHACHA20_POLY1305, 0, 16},
+	{"aes128-gmac", ODP_CIPHER_ALG_NULL, 0, 0, 1,
+	 ODP_AUTH_ALG_AES_GMAC, 16, 16},
+};
+
+#define NUM_ALG (sizeof(bench_alg) / sizeof(bench_alg[0]))
+
+/** Default payload lengths: minimum packets to 9 KB jumbo frames. Lengths
+ *  are multiples of the largest cipher block size. */
+static const uint32_t default_len[] = {64, 256, 1024, 1504, 4096, 9216};
+
+/** Default burst sizes */
+static const uint32_t default_burst[] = {1, 8, 32};
+
+static const uint8_t test_key[64] = {
+	0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+	0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+	0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+	0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+	0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+	0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38,
+	0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f, 0x40
+};
+
+static uint8_t test_iv[16] = {
+	0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7,
+	0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf
+};
+
+/**
+ * Parsed command line application arguments
+ */
+typedef struct {
+	/* Algorithm to test, or NULL for all */
+	const bench_alg_t *alg;
+	uint32_t len[MAX_LIST];
+	int num_len;
+	uint32_t burst[MAX_LIST];
+	int num_burst;
+	/* Sessions per thread */
+	uint32_t sessions[MAX_LIST];
+	int num_sessions;
+	uint32_t threads[MAX_LIST];
+	int num_threads;
+	uint32_t time_ms;
+	format_t format;
+	const char *output;
+	/* Minimum scaling efficiency in percent, or 0 for no check */
+	uint32_t efficiency;
+} appl_args_t;
+
+/**
+ * Per thread test state and results
+ */
+typedef struct {
+	odp_crypto_session_t session[MAX_SESSIONS];
+	odp_packet_t pkt[MAX_BURST];
+	uint64_t ops;
+	uint64_t nsec;
+	uint64_t cycles;
+	uint64_t failed;
+} ODP_ALIGNED_CACHE thread_args_t;
+
+/**
+ * Results of one configuration
+ */
+typedef struct {
+	const bench_alg_t *alg;
+	uint32_t len;
+	uint32_t burst;
+	uint32_t sessions;
+	uint32_t threads;
+	uint64_t ops;
+	uint64_t nsec;
+	double mpps;
+	double gbps;
+	double cycles_per_byte;
+	/* Throughput relative to threads x single thread, or <0 if not
+	 * measured */
+	double scaling;
+} bench_result_t;
+
+/**
+ * Grouping of all global data
+ */
+typedef struct {
+	appl_args_t appl;
+	odp_pool_t pool;
+	odp_cpumask_t cpumask;
+	int num_cpu;
+	odp_barrier_t barrier;
+	/* Current configuration */
+	const bench_alg_t *alg;
+	uint32_t len;
+	uint32_t burst;
+	uint32_t sessions;
+	thread_args_t thread[MAX_WORKERS];
+} args_t;
+
+/** Global pointer to args */
+static args_t *gbl_args;
+
+/** Output stream of results */
+static FILE *out;
+
+/** Number of results printed */
+static int num_printed;
+
+static int alg_supported(const bench_alg_t *alg)
+{
+	odp_crypto_cipher_capability_t cipher[16];
+	odp_crypto_auth_capability_t auth[16];
+	int i, num;
+	int ok;
+
+	if (alg->cipher != ODP_CIPHER_ALG_NULL) {
+		num = odp_crypto_cipher_capability(alg->cipher, cipher, 16);
+		if (num > 16)
+			num = 16;
+
+		for (i = 0, ok = 0; i < num; i++)
+			if (cipher[i].key_len == alg->cipher_key_len &&
+			    cipher[i].iv_len == alg->iv_len)
+				ok = 1;
+
+		if (!ok)
+			return 0;
+	}
+
+	if (alg->auth != ODP_AUTH_ALG_NULL) {
+		num = odp_crypto_auth_capability(alg->auth, auth, 16);
+		if (num > 16)
+			num = 16;
+
+		for (i = 0, ok = 0; i < num; i++)
+			if (auth[i].digest_len == alg->digest_len &&
+			    auth[i].key_len == alg->auth_key_len)
+				ok = 1;
+
+		if (!ok)
+			return 0;
+	}
+
+	return 1;
+}
+
+static int session_create(const bench_alg_t *alg, odp_crypto_session_t *ses)
+{
+	odp_crypto_session_param_t param;
+	odp_crypto_ses_create_err_t status;
+
+	odp_crypto_session_param_init(&param);
+	param.op = ODP_CRYPTO_OP_ENCODE;
+	param.auth_cipher_text = 1;
+	param.pref_mode   = ODP_CRYPTO_SYNC;
+	param.cipher_alg  = alg->cipher;
+	param.cipher_key.data   = (uint8_t *)(uintptr_t)test_key;
+	param.cipher_key.length = alg->cipher_key_len;
+	param.iv.data   = NULL;
+	param.iv.length = alg->iv_len;
+	param.auth_alg  = alg->auth;
+	param.auth_key.data   = (uint8_t *)(uintptr_t)&test_key[32];
+	param.auth_key.length = alg->auth_key_len;
+	param.compl_queue = ODP_QUEUE_INVALID;
+	param.output_pool = gbl_args->pool;
+
+	if (alg->cipher == ODP_CIPHER_ALG_NULL &&
+	    alg->auth == ODP_AUTH_ALG_AES_GMAC)
+		param.iv.length = 12;
+
+	return odp_crypto_session_create(&param, ses, &status);
+}
+
+static int run_worker(void *arg)
+{
+	thread_args_t *thr = arg;
+	odp_crypto_op_param_t param[MAX_BURST];
+	odp_crypto_op_result_t result[MAX_BURST];
+	odp_bool_t posted[MAX_BURST];
+	uint32_t burst = gbl_args->burst;
+	uint32_t len = gbl_args->len;
+	uint32_t sessions = gbl_args->sessions;
+	uint64_t duration = gbl_args->appl.time_ms * ODP_TIME_MSEC_IN_NS;
+	uint64_t ops = 0, failed = 0, nsec, c1;
+	uint32_t i, s = 0;
+	odp_time_t t1;
+	int num;
+
+	memset(param, 0, sizeof(param));
+
+	for (i = 0; i < burst; i++) {
+		param[i].pkt     = thr->pkt[i];
+		param[i].out_pkt = thr->pkt[i];
+		param[i].override_iv_ptr = test_iv;
+		param[i].cipher_range.offset = 0;
+		param[i].cipher_range.length = len;
+		param[i].auth_range.offset = 0;
+		param[i].auth_range.length = len;
+		param[i].hash_result_offset = len;
+	}
+
+	odp_barrier_wait(&gbl_args->barrier);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	do {
+		/* Operations spread over the sessions round robin */
+		for (i = 0; i < burst; i++) {
+			param[i].session = thr->session[s];
+			if (++s == sessions)
+				s = 0;
+		}
+
+		if (burst == 1)
+			num = odp_crypto_operation(&param[0], &posted[0],
+						   &result[0]) ? -1 : 1;
+		else
+			num = odp_crypto_operation_multi(param, posted, result,
+							 burst);
+
+		if (odp_unlikely(num <= 0)) {
+			failed++;
+			break;
+		}
+
+		for (i = 0; i < (uint32_t)num; i++)
+			if (odp_unlikely(posted[i] || !result[i].ok))
+				failed++;
+
+		ops += num;
+		nsec = odp_time_to_ns(odp_time_diff(odp_time_local(), t1));
+	} while (nsec < duration);
+
+	thr->cycles = odp_cpu_cycles_diff(odp_cpu_cycles(), c1);
+	thr->nsec   = odp_time_to_ns(odp_time_diff(odp_time_local(), t1));
+	thr->ops    = ops;
+	thr->failed = failed;
+
+	return 0;
+}
+
+/* Run one configuration with 'num_thr' worker threads */
+static int run_bench(odp_instance_t instance, uint32_t num_thr,
+		     bench_result_t *res)
+{
+	odph_odpthread_t thread_tbl[MAX_WORKERS];
+	odph_odpthread_params_t thr_params;
+	odp_cpumask_t thd_mask;
+	const bench_alg_t *alg = gbl_args->alg;
+	uint32_t pkt_len = gbl_args->len + alg->digest_len;
+	uint64_t cycles = 0, failed = 0, bytes;
+	uint32_t i, j;
+	int cpu, ret = 0;
+
+	memset(res, 0, sizeof(*res));
+	memset(thread_tbl, 0, sizeof(thread_tbl));
+
+	for (i = 0; i < num_thr; i++) {
+		thread_args_t *thr = &gbl_args->thread[i];
+
+		memset(thr->session, 0, sizeof(thr->session));
+		memset(thr->pkt, 0, sizeof(thr->pkt));
+
+		for (j = 0; j < gbl_args->sessions && ret == 0; j++) {
+			thr->session[j] = ODP_CRYPTO_SESSION_INVALID;
+			if (session_create(alg, &thr->session[j])) {
+				LOG_ERR("Error: session create failed.\n");
+				thr->session[j] = ODP_CRYPTO_SESSION_INVALID;
+				ret = -1;
+			}
+		}
+
+		for (j = 0; j < gbl_args->burst && ret == 0; j++) {
+			thr->pkt[j] = odp_packet_alloc(gbl_args->pool,
+						       pkt_len);
+			if (thr->pkt[j] == ODP_PACKET_INVALID) {
+				LOG_ERR("Error: packet alloc failed.\n");
+				ret = -1;
+			}
+		}
+	}
+
+	if (ret == 0) {
+		odp_barrier_init(&gbl_args->barrier, num_thr);
+
+		memset(&thr_params, 0, sizeof(thr_params));
+		thr_params.start    = run_worker;
+		thr_params.thr_type = ODP_THREAD_WORKER;
+		thr_params.instance = instance;
+
+		/* Threads are pinned to CPUs of the worker mask round
+		 * robin */
+		cpu = odp_cpumask_first(&gbl_args->cpumask);
+
+		for (i = 0; i < num_thr; i++) {
+			thr_params.arg = &gbl_args->thread[i];
+			odp_cpumask_zero(&thd_mask);
+			odp_cpumask_set(&thd_mask, cpu);
+			odph_odpthreads_create(&thread_tbl[i], &thd_mask,
+					       &thr_params);
+
+			cpu = odp_cpumask_next(&gbl_args->cpumask, cpu);
+			if (cpu < 0)
+				cpu = odp_cpumask_first(&gbl_args->cpumask);
+		}
+
+		for (i = 0; i < num_thr; i++)
+			odph_odpthreads_join(&thread_tbl[i]);
+
+		for (i = 0; i < num_thr; i++) {
+			thread_args_t *thr = &gbl_args->thread[i];
+
+			res->ops += thr->ops;
+			cycles   += thr->cycles;
+			failed   += thr->failed;
+
+			if (thr->nsec > res->nsec)
+				res->nsec = thr->nsec;
+		}
+
+		if (failed) {
+			LOG_ERR("Error: %" PRIu64 " %s operations failed.\n",
+				failed, alg->name);
+			ret = -1;
+		}
+	}
+
+	for (i = 0; i < num_thr; i++) {
+		thread_args_t *thr = &gbl_args->thread[i];
+
+		for (j = 0; j < gbl_args->sessions; j++)
+			if (thr->session[j] != ODP_CRYPTO_SESSION_INVALID)
+				odp_crypto_session_destroy(thr->session[j]);
+
+		for (j = 0; j < gbl_args->burst; j++)
+			if (thr->pkt[j] != ODP_PACKET_INVALID)
+				odp_packet_free(thr->pkt[j]);
+	}
+
+	if (res->nsec == 0)
+		res->nsec = 1;
+
+	bytes = res->ops * gbl_args->len;
+
+	res->alg      = alg;
+	res->len      = gbl_args->len;
+	res->burst    = gbl_args->burst;
+	res->sessions = gbl_args->sessions;
+	res->threads  = num_thr;
+	res->mpps     = (double)res->ops * 1000 / res->nsec;
+	res->gbps     = (double)bytes * 8 / res->nsec;
+	res->cycles_per_byte = bytes ? (double)cycles / bytes : 0.0;
+	res->scaling  = -1.0;
+
+	return ret;
+}
+
+static void print_header(void)
+{
+	switch (gbl_args->appl.format) {
+	case FORMAT_CSV:
+		fprintf(out, "algorithm,length,burst,sessions,threads,ops,"
+			"nsec,mpps,gbps,cycles_per_byte,scaling\n");
+		break;
+	case FORMAT_JSON:
+		fprintf(out, "[");
+		break;
+	default:
+		fprintf(out, "\nCrypto throughput, %" PRIu32 " ms per test\n"
+			"\n  %-27s %5s %5s %4s %3s %9s %8s %8s %7s\n",
+			gbl_args->appl.time_ms, "algorithm", "len", "burst",
+			"sess", "thr", "Mpps", "Gbps", "cycles/B", "scaling");
+		break;
+	}
+}
+
+static void print_footer(void)
+{
+	if (gbl_args->appl.format == FORMAT_JSON)
+		fprintf(out, "\n]\n");
+	else if (gbl_args->appl.format == FORMAT_TEXT)
+		fprintf(out, "\n");
+}
+
+static void print_result(const bench_result_t *res)
+{
+	switch (gbl_args->appl.format) {
+	case FORMAT_CSV:
+		fprintf(out, "%s,%" PRIu32 ",%" PRIu32 ",%" PRIu32 ",%" PRIu32
+			",%" PRIu64 ",%" PRIu64 ",%.4f,%.4f,%.4f,",
+			res->alg->name, res->len, res->burst, res->sessions,
+			res->threads, res->ops, res->nsec, res->mpps,
+			res->gbps, res->cycles_per_byte);
+		if (res->scaling >= 0)
+			fprintf(out, "%.4f", res->scaling);
+		fprintf(out, "\n");
+		break;
+	case FORMAT_JSON:
+		fprintf(out, "%s\n  {\"algorithm\": \"%s\", \"length\": %"
+			PRIu32 ", \"burst\": %" PRIu32 ", \"sessions\": %"
+			PRIu32 ", \"threads\": %" PRIu32 ", \"ops\": %" PRIu64
+			", \"nsec\": %" PRIu64 ", \"mpps\": %.4f, \"gbps\": "
+			"%.4f, \"cycles_per_byte\": %.4f, \"scaling\": ",
+			num_printed ? "," : "", res->alg->name, res->len,
+			res->burst, res->sessions, res->threads, res->ops,
+			res->nsec, res->mpps, res->gbps,
+			res->cycles_per_byte);
+		if (res->scaling >= 0)
+			fprintf(out, "%.4f}", res->scaling);
+		else
+			fprintf(out, "null}");
+		break;
+	default:
+		fprintf(out, "  %-27s %5" PRIu32 " %5" PRIu32 " %4" PRIu32
+			" %3" PRIu32 " %9.3f %8.3f %8.3f ", res->alg->name,
+			res->len, res->burst, res->sessions, res->threads,
+			res->mpps, res->gbps, res->cycles_per_byte);
+		if (res->scaling >= 0)
+			fprintf(out, "%6.1f%%\n", res->scaling * 100);
+		else
+			fprintf(out, "%7s\n", "-");
+		break;
+	}
+
+	num_printed++;
+}
+
+/* Run all thread counts of a configuration. Returns number of scaling
+ * check failures, or <0 on error. */
+static int run_threads(odp_instance_t instance)
+{
+	appl_args_t *appl = &gbl_args->appl;
+	bench_result_t res;
+	double single = 0.0;
+	int i, fail = 0;
+
+	for (i = 0; i < appl->num_threads; i++) {
+		if (run_bench(instance, appl->threads[i], &res))
+			return -1;
+
+		if (res.threads == 1)
+			single = res.gbps;
+		else if (single > 0.0)
+			res.scaling = res.gbps / (single * res.threads);
+
+		print_result(&res);
+
+		/* Scaling is not checked with more threads than CPUs */
+		if (appl->efficiency && res.scaling >= 0 &&
+		    res.threads <= (uint32_t)gbl_args->num_cpu &&
+		    res.scaling * 100 < appl->efficiency) {
+			LOG_ERR("Error: %s len %" PRIu32 " burst %" PRIu32
+				" sessions %" PRIu32 ": %" PRIu32 " threads "
+				"scale %.1f%% (min %" PRIu32 "%%)\n",
+				res.alg->name, res.len, res.burst,
+				res.sessions, res.threads, res.scaling * 100,
+				appl->efficiency);
+			fail++;
+		}
+	}
+
+	return fail;
+}
+
+static int parse_list(const char *str, uint32_t list[], int max,
+		      uint32_t min_val, uint32_t max_val)
+{
+	char *end;
+	long val;
+	int num = 0;
+
+	while (*str) {
+		val = strtol(str, &end, 0);
+
+		if (end == str || val < (long)min_val || val > (long)max_val ||
+		    num == max)
+			return -1;
+
+		list[num++] = val;
+		str = end;
+
+		if (*str == ',')
+			str++;
+		else if (*str)
+			return -1;
+	}
+
+	return num;
+}
+
+static void usage(char *progname)
+{
+	uint32_t i;
+
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -t 1,2,4 -e 80\n"
+	       "\n"
+	       "Crypto throughput and multi-thread scaling benchmark. Sweeps\n"
+	       "algorithms, payload lengths, burst sizes, sessions and thread\n"
+	       "counts in synchronous mode, and reports Gbps and CPU cycles per\n"
+	       "byte over all threads.\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -a, --algorithm <name>  Algorithm (default all):\n",
+	       NO_PATH(progname), NO_PATH(progname));
+
+	for (i = 0; i < NUM_ALG; i++)
+		printf("                          %s\n", bench_alg[i].name);
+
+	printf("  -l, --length <list>     Payload lengths (default 64,256,1024,\n"
+	       "                          1504,4096,9216)\n"
+	       "  -b, --burst <list>      Operations per call (default 1,8,32, max\n"
+	       "                          %i). 1 uses odp_crypto_operation().\n"
+	       "  -s, --sessions <list>   Sessions per thread (default 1, max %i)\n"
+	       "  -t, --threads <list>    Thread counts (default 1, max %i)\n"
+	       "  -T, --time <msec>       Test time per configuration (default %i)\n"
+	       "  -f, --format <fmt>      Output format: text, csv or json\n"
+	       "  -o, --output <file>     Output file (default stdout)\n"
+	       "  -e, --efficiency <pct>  Fail when N threads reach less than\n"
+	       "                          <pct> percent of N times single thread\n"
+	       "                          throughput. Thread count 1 is added.\n"
+	       "  -h, --help              Display help and exit.\n"
+	       "\n"
+	       "Lists are comma separated, e.g. -l 64,1504.\n\n",
+	       MAX_BURST, MAX_SESSIONS, MAX_WORKERS, TEST_TIME_MS);
+}
+
+static int parse_args(int argc, char *argv[], appl_args_t *appl)
+{
+	int opt;
+	int long_index;
+	uint32_t i;
+	static const struct option longopts[] = {
+		{"algorithm", required_argument, NULL, 'a'},
+		{"length", required_argument, NULL, 'l'},
+		{"burst", required_argument, NULL, 'b'},
+		{"sessions", required_argument, NULL, 's'},
+		{"threads", required_argument, NULL, 't'},
+		{"time", required_argument, NULL, 'T'},
+		{"format", required_argument, NULL, 'f'},
+		{"output", required_argument, NULL, 'o'},
+		{"efficiency", required_argument, NULL, 'e'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "+a:l:b:s:t:T:f:o:e:h";
+
+	/* let helper collect its own arguments (e.g. --odph_proc) */
+	odph_parse_options(argc, argv, shortopts, longopts);
+
+	memset(appl, 0, sizeof(*appl));
+	appl->num_len = sizeof(default_len) / sizeof(default_len[0]);
+	memcpy(appl->len, default_len, sizeof(default_len));
+	appl->num_burst = sizeof(default_burst) / sizeof(default_burst[0]);
+	memcpy(appl->burst, default_burst, sizeof(default_burst));
+	appl->sessions[0]  = 1;
+	appl->num_sessions = 1;
+	appl->threads[0]   = 1;
+	appl->num_threads  = 1;
+	appl->time_ms      = TEST_TIME_MS;
+
+	opterr = 0; /* do not issue errors on helper options */
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'a':
+			for (i = 0; i < NUM_ALG; i++)
+				if (!strcmp(optarg, bench_alg[i].name))
+					appl->alg = &bench_alg[i];
+
+			if (appl->alg == NULL) {
+				printf("Unknown algorithm '%s'\n", optarg);
+				return -1;
+			}
+			break;
+		case 'l':
+			appl->num_len = parse_list(optarg, appl->len,
+						   MAX_LIST, 1, MAX_LEN);
+			break;
+		case 'b':
+			appl->num_burst = parse_list(optarg, appl->burst,
+						     MAX_LIST, 1, MAX_BURST);
+			break;
+		case 's':
+			appl->num_sessions = parse_list(optarg, appl->sessions,
+							MAX_LIST, 1,
+							MAX_SESSIONS);
+			break;
+		case 't':
+			appl->num_threads = parse_list(optarg, appl->threads,
+						       MAX_LIST, 1,
+						       MAX_WORKERS);
+			break;
+		case 'T':
+			appl->time_ms = atoi(optarg);
+			break;
+		case 'f':
+			if (!strcmp(optarg, "text")) {
+				appl->format = FORMAT_TEXT;
+			} else if (!strcmp(optarg, "csv")) {
+				appl->format = FORMAT_CSV;
+			} else if (!strcmp(optarg, "json")) {
+				appl->format = FORMAT_JSON;
+			} else {
+				printf("Unknown format '%s'\n", optarg);
+				return -1;
+			}
+			break;
+		case 'o':
+			appl->output = optarg;
+			break;
+		case 'e':
+			appl->efficiency = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			break;
+		}
+	}
+
+	optind = 1; /* reset 'extern optind' from the getopt lib */
+
+	if (appl->num_len <= 0 || appl->num_burst <= 0 ||
+	    appl->num_sessions <= 0 || appl->num_threads <= 0) {
+		printf("Bad list option\n");
+		return -1;
+	}
+
+	if (appl->time_ms == 0)
+		appl->time_ms = 1;
+
+	/* Scaling is measured against a single thread run first */
+	if (appl->efficiency && appl->threads[0] != 1) {
+		if (appl->num_threads == MAX_LIST) {
+			printf("Too many thread counts\n");
+			return -1;
+		}
+
+		memmove(&appl->threads[1], &appl->threads[0],
+			appl->num_threads * sizeof(uint32_t));
+		appl->threads[0] = 1;
+		appl->num_threads++;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_pool_capability_t capa;
+	odp_pool_param_t params;
+	odp_crypto_capability_t crypto_capa;
+	odp_shm_t shm;
+	appl_args_t *appl;
+	const bench_alg_t *alg;
+	uint32_t i, max_len = 0, max_thr = 0, max_ses = 0, max_burst = 0;
+	int a, l, b, s, ret;
+	int fail = 0;
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("shm_args", sizeof(args_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	gbl_args = odp_shm_addr(shm);
+
+	if (gbl_args == NULL) {
+		LOG_ERR("Error: shared mem alloc failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(gbl_args, 0, sizeof(args_t));
+	appl = &gbl_args->appl;
+
+	if (parse_args(argc, argv, appl)) {
+		usage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	out = stdout;
+	if (appl->output) {
+		out = fopen(appl->output, "w");
+		if (out == NULL) {
+			LOG_ERR("Error: cannot open %s\n", appl->output);
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	for (i = 0; i < (uint32_t)appl->num_len; i++)
+		if (appl->len[i] > max_len)
+			max_len = appl->len[i];
+
+	for (i = 0; i < (uint32_t)appl->num_threads; i++)
+		if (appl->threads[i] > max_thr)
+			max_thr = appl->threads[i];
+
+	for (i = 0; i < (uint32_t)appl->num_sessions; i++)
+		if (appl->sessions[i] > max_ses)
+			max_ses = appl->sessions[i];
+
+	for (i = 0; i < (uint32_t)appl->num_burst; i++)
+		if (appl->burst[i] > max_burst)
+			max_burst = appl->burst[i];
+
+	gbl_args->num_cpu = odp_cpumask_default_worker(&gbl_args->cpumask, 0);
+
+	if (max_thr > (uint32_t)gbl_args->num_cpu)
+		fprintf(stderr, "Note: %" PRIu32 " threads share %i worker "
+			"CPUs\n", max_thr, gbl_args->num_cpu);
+
+	if (odp_crypto_capability(&crypto_capa)) {
+		LOG_ERR("Error: crypto capability failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (crypto_capa.max_sessions < max_thr * max_ses) {
+		LOG_ERR("Error: %" PRIu32 " crypto sessions needed, max %"
+			PRIu32 "\n", max_thr * max_ses,
+			crypto_capa.max_sessions);
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_pool_capability(&capa)) {
+		LOG_ERR("Error: pool capability failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odp_pool_param_init(&params);
+	params.pkt.len = max_len + MAX_DIGEST_LEN;
+	params.pkt.num = max_thr * max_burst;
+	params.type    = ODP_POOL_PACKET;
+
+	if (capa.pkt.max_len && capa.pkt.max_len < params.pkt.len) {
+		LOG_ERR("Error: packet length %" PRIu32 " not supported.\n",
+			params.pkt.len);
+		exit(EXIT_FAILURE);
+	}
+
+	/* Pool may count segments instead of packets */
+	if (capa.pkt.max_seg_len)
+		params.pkt.num *= (params.pkt.len + capa.pkt.max_seg_len - 1) /
+				  capa.pkt.max_seg_len;
+
+	gbl_args->pool = odp_pool_create("packet pool", &params);
+
+	if (gbl_args->pool == ODP_POOL_INVALID) {
+		LOG_ERR("Error: packet pool create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	print_header();
+
+	for (a = 0; a < (int)NUM_ALG && fail >= 0; a++) {
+		alg = &bench_alg[a];
+
+		if ((appl->alg && appl->alg != alg) || !alg_supported(alg))
+			continue;
+
+		gbl_args->alg = alg;
+
+		for (l = 0; l < appl->num_len && fail >= 0; l++) {
+			/* Cipher data is rounded down to whole blocks */
+			gbl_args->len = appl->len[l] & ~(alg->block - 1);
+			if (gbl_args->len == 0)
+				continue;
+
+			for (b = 0; b < appl->num_burst && fail >= 0; b++) {
+				gbl_args->burst = appl->burst[b];
+
+				for (s = 0; s < appl->num_sessions; s++) {
+					gbl_args->sessions = appl->sessions[s];
+
+					ret = run_threads(instance);
+					if (ret < 0) {
+						fail = -1;
+						break;
+					}
+
+					fail += ret;
+				}
+			}
+		}
+
+		if (appl->format == FORMAT_TEXT)
+			fprintf(out, "\n");
+	}
+
+	print_footer();
+
+	if (out != stdout)
+		fclose(out);
+
+	if (odp_pool_destroy(gbl_args->pool)) {
+		LOG_ERR("Error: pool destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_shm_free(shm)) {
+		LOG_ERR("Error: shm free\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return fail ? EXIT_FAILURE : EXIT_SUCCESS;
+}
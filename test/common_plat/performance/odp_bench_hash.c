@@ -0,0 +1,319 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_hash.c  Microbenchmarks for hash functions
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+
+#include "dummy_crc.h"
+
+/** Maximum test data length */
+#define TEST_MAX_LEN (32 * 1024)
+
+/** Default number of rounds per test */
+#define TEST_ROUNDS 100000
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Test data lengths: flow tuple keys (IPv4 2-tuple, 5-tuple, IPv6
+ *  5-tuple), packets and long buffers */
+static const uint32_t test_len[] = {4, 8, 13, 37, 64, 256, 1024, 1518, 9018,
+				    TEST_MAX_LEN};
+
+#define NUM_LEN (sizeof(test_len) / sizeof(test_len[0]))
+
+/** Number of keys per multi hash call */
+#define TEST_NUM_KEYS 32
+
+/** Test data */
+static uint8_t test_data[TEST_MAX_LEN];
+
+/** Keys of multi hash calls */
+static const void *test_key[TEST_NUM_KEYS];
+
+/** Toeplitz key, the default key of many NICs */
+static const uint8_t toeplitz_key[40] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+/** Benchmarked hash function */
+typedef uint32_t (*bench_fn_t)(uint32_t len, uint32_t init_val);
+
+/**
+ * Table based CRC32C, as used by odp_hash_crc32c() without CRC instructions
+ */
+static uint32_t bench_crc32c_table(uint32_t len, uint32_t init_val)
+{
+	return dummy_hash_crc32c(test_data, len, init_val);
+}
+
+static uint32_t bench_crc32c(uint32_t len, uint32_t init_val)
+{
+	return odp_hash_crc32c(test_data, len, init_val);
+}
+
+static uint32_t bench_crc32c_multi(uint32_t len, uint32_t init_val)
+{
+	uint32_t hash[TEST_NUM_KEYS];
+
+	odp_hash_crc32c_multi(test_key, len, init_val, hash, TEST_NUM_KEYS);
+
+	return hash[TEST_NUM_KEYS - 1];
+}
+
+static uint32_t bench_xxh64(uint32_t len, uint32_t init_val)
+{
+	return odp_hash_xxh64(test_data, len, init_val);
+}
+
+static uint32_t bench_xxh64_multi(uint32_t len, uint32_t init_val)
+{
+	uint64_t hash[TEST_NUM_KEYS];
+
+	odp_hash_xxh64_multi(test_key, len, init_val, hash, TEST_NUM_KEYS);
+
+	return hash[TEST_NUM_KEYS - 1];
+}
+
+/** Toeplitz hash is used only for flow tuple keys */
+static uint32_t bench_toeplitz(uint32_t len, uint32_t init_val)
+{
+	if (len > sizeof(toeplitz_key) - 4)
+		return init_val;
+
+	return odp_hash_toeplitz(test_data, len, toeplitz_key,
+				 sizeof(toeplitz_key)) ^ init_val;
+}
+
+/**
+ * Benchmark description
+ */
+typedef struct {
+	const char *name;
+	bench_fn_t fn;
+	/* Number of keys hashed per call */
+	uint32_t num_keys;
+} bench_info_t;
+
+static const bench_info_t bench_info[] = {
+	{"crc32c table", bench_crc32c_table, 1},
+	{"odp_hash_crc32c", bench_crc32c, 1},
+	{"crc32c_multi", bench_crc32c_multi, TEST_NUM_KEYS},
+	{"odp_hash_xxh64", bench_xxh64, 1},
+	{"xxh64_multi", bench_xxh64_multi, TEST_NUM_KEYS},
+	{"odp_hash_toeplitz", bench_toeplitz, 1},
+};
+
+#define NUM_BENCH (sizeof(bench_info) / sizeof(bench_info[0]))
+
+static void usage(char *progname)
+{
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -r 100000\n"
+	       "\n"
+	       "Microbenchmarks for hash functions\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -r, --rounds <num>  Number of rounds per test (default %i)\n"
+	       "  -h, --help          Display help and exit.\n\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname), TEST_ROUNDS);
+}
+
+static int parse_args(int argc, char *argv[], uint32_t *rounds)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"rounds", required_argument, NULL, 'r'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "r:h";
+
+	*rounds = TEST_ROUNDS;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'r':
+			*rounds = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (*rounds == 0)
+		*rounds = 1;
+
+	return 0;
+}
+
+static void run_bench(const bench_info_t *bench, uint32_t len,
+		      uint32_t rounds)
+{
+	uint64_t c1, c2, cycles, nsec;
+	odp_time_t t1, t2;
+	uint32_t i;
+	uint32_t hash = 0;
+	uint32_t num = bench->num_keys;
+
+	if (bench->fn == bench_toeplitz && len > sizeof(toeplitz_key) - 4)
+		return;
+
+	/* Long inputs and multi key calls take proportionally fewer
+	 * rounds */
+	if (len * num > 64)
+		rounds = rounds * 64 / (len * num) + 1;
+
+	/* Warm up caches */
+	hash = bench->fn(len, hash);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	/* Chain hash values, so that calls cannot overlap */
+	for (i = 0; i < rounds; i++)
+		hash = bench->fn(len, hash);
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	cycles = odp_cpu_cycles_diff(c2, c1);
+	nsec   = odp_time_to_ns(odp_time_diff(t2, t1));
+
+	if (nsec == 0)
+		nsec = 1;
+
+	/* Results are per key */
+	rounds *= num;
+
+	printf("  %-18s %6" PRIu32 " B: %9.1f ns %7.3f cycles/B %8.2f Gbps"
+	       "  (hash %08" PRIx32 ")\n", bench->name, len,
+	       (double)nsec / rounds, (double)cycles / rounds / len,
+	       (double)len * 8 * rounds / nsec, hash);
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	uint32_t rounds;
+	uint32_t i, j, len;
+	uint32_t seed = 1;
+	uint32_t crc[TEST_NUM_KEYS];
+	int ret = 0;
+
+	if (parse_args(argc, argv, &rounds))
+		exit(EXIT_FAILURE);
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < TEST_MAX_LEN; i++) {
+		seed = seed * 1103515245 + 12345;
+		test_data[i] = seed >> 16;
+	}
+
+	/* All implementations must agree on every length and alignment */
+	for (len = 0; len <= TEST_MAX_LEN; len++) {
+		uint32_t off = len % 8;
+		uint32_t ref;
+
+		if (len > 3 * 1024 && len % 509)
+			continue;
+
+		if (off + len > TEST_MAX_LEN)
+			off = 0;
+
+		ref = dummy_hash_crc32c(&test_data[off], len, seed);
+
+		if (odp_hash_crc32c(&test_data[off], len, seed) != ref) {
+			LOG_ERR("Error: odp_hash_crc32c: bad hash, len %"
+				PRIu32 "\n", len);
+			ret = -1;
+		}
+	}
+
+	/* Multi key calls must match single key calls */
+	for (len = 0; len <= 256; len++) {
+		for (i = 0; i < TEST_NUM_KEYS; i++)
+			test_key[i] = &test_data[i * 257 + i % 8];
+
+		odp_hash_crc32c_multi(test_key, len, seed, crc, TEST_NUM_KEYS);
+
+		for (i = 0; i < TEST_NUM_KEYS; i++) {
+			if (crc[i] != odp_hash_crc32c(test_key[i], len, seed)) {
+				LOG_ERR("Error: odp_hash_crc32c_multi: bad hash,"
+					" len %" PRIu32 "\n", len);
+				ret = -1;
+			}
+		}
+	}
+
+	printf("\nHash microbenchmarks, %" PRIu32 " rounds\n\n", rounds);
+
+	for (i = 0; i < NUM_LEN; i++) {
+		len = test_len[i];
+
+		/* Keys of multi key calls are spread over test data */
+		for (j = 0; j < TEST_NUM_KEYS; j++)
+			test_key[j] = &test_data[(j * len) %
+						 (TEST_MAX_LEN - len + 1)];
+
+		for (j = 0; j < NUM_BENCH; j++)
+			run_bench(&bench_info[j], test_len[i], rounds);
+
+		printf("\n");
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
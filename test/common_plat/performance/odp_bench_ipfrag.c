@@ -0,0 +1,427 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_ipfrag.c  Microbenchmarks for IP fragmentation helpers
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+/** Maximum datagram length */
+#define TEST_MAX_LEN 9000
+
+/** Maximum number of fragments per datagram */
+#define TEST_MAX_FRAGS 16
+
+/** Default number of rounds per test */
+#define TEST_ROUNDS 1000
+
+/** Default number of concurrent datagrams in the memory test */
+#define TEST_FLOWS 128
+
+/** Fragment MTU */
+#define TEST_MTU 1500
+
+/** Reassembly table name */
+#define TEST_TBL_NAME "ipfrag_bench"
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Test datagram lengths (UDP payload) */
+static const uint32_t test_len[] = {2000, 4000, 8000};
+
+#define NUM_LEN (sizeof(test_len) / sizeof(test_len[0]))
+
+/** Test arguments */
+typedef struct {
+	uint32_t rounds;
+	uint32_t flows;
+} test_args_t;
+
+static odp_pool_t pool;
+static odph_ipfrag_t tbl;
+
+/** Create an IPv4 or IPv6 UDP datagram */
+static odp_packet_t create_pkt(int ipv4, uint32_t len, uint32_t id)
+{
+	uint32_t l3_len = ipv4 ? ODPH_IPV4HDR_LEN : ODPH_IPV6HDR_LEN;
+	uint32_t l4_off = ODPH_ETHHDR_LEN + l3_len;
+	odp_packet_t pkt;
+	odph_ethhdr_t *eth;
+	odph_udphdr_t *udp;
+	uint8_t *data;
+
+	pkt = odp_packet_alloc(pool, l4_off + ODPH_UDPHDR_LEN + len);
+	if (pkt == ODP_PACKET_INVALID)
+		return pkt;
+
+	data = odp_packet_data(pkt);
+	memset(data, 0, l4_off + ODPH_UDPHDR_LEN);
+	eth = (odph_ethhdr_t *)data;
+
+	if (ipv4) {
+		odph_ipv4hdr_t *ip = (odph_ipv4hdr_t *)(data + ODPH_ETHHDR_LEN);
+
+		eth->type    = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV4);
+		ip->ver_ihl  = ODPH_IPV4 << 4 | ODPH_IPV4HDR_IHL_MIN;
+		ip->tot_len  = odp_cpu_to_be_16(l3_len + ODPH_UDPHDR_LEN + len);
+		ip->id       = odp_cpu_to_be_16(id);
+		ip->ttl      = 64;
+		ip->proto    = ODPH_IPPROTO_UDP;
+		ip->src_addr = odp_cpu_to_be_32(0x0a000001);
+		ip->dst_addr = odp_cpu_to_be_32(0x0a000002);
+		odp_packet_has_ipv4_set(pkt, 1);
+	} else {
+		odph_ipv6hdr_t *ip = (odph_ipv6hdr_t *)(data + ODPH_ETHHDR_LEN);
+
+		eth->type       = odp_cpu_to_be_16(ODPH_ETHTYPE_IPV6);
+		ip->ver_tc_flow = odp_cpu_to_be_32(ODPH_IPV6 <<
+						   ODPH_IPV6HDR_VERSION_SHIFT);
+		ip->payload_len = odp_cpu_to_be_16(ODPH_UDPHDR_LEN + len);
+		ip->next_hdr    = ODPH_IPPROTO_UDP;
+		ip->hop_limit   = 64;
+		ip->src_addr[15] = 1;
+		ip->dst_addr[15] = 2;
+		odp_packet_has_ipv6_set(pkt, 1);
+	}
+
+	udp = (odph_udphdr_t *)(data + l4_off);
+	udp->src_port = odp_cpu_to_be_16(1000);
+	udp->dst_port = odp_cpu_to_be_16(2000);
+	udp->length   = odp_cpu_to_be_16(ODPH_UDPHDR_LEN + len);
+
+	odp_packet_l2_offset_set(pkt, 0);
+	odp_packet_l3_offset_set(pkt, ODPH_ETHHDR_LEN);
+	odp_packet_l4_offset_set(pkt, l4_off);
+	odp_packet_has_eth_set(pkt, 1);
+	odp_packet_has_udp_set(pkt, 1);
+
+	if (ipv4)
+		odph_ipv4_csum_update(pkt);
+
+	return pkt;
+}
+
+/** Fragment and reassemble datagrams one at a time */
+static int bench_throughput(int ipv4, uint32_t len, uint32_t rounds)
+{
+	odp_packet_t frag[TEST_MAX_FRAGS];
+	odp_packet_t pkt, out;
+	uint64_t frag_ns = 0, reass_ns = 0;
+	uint32_t pkt_len = 0;
+	odp_time_t t1, t2, t3;
+	uint32_t i;
+	int num = 0;
+	int j, ret;
+
+	for (i = 0; i < rounds; i++) {
+		pkt = create_pkt(ipv4, len, i);
+		if (pkt == ODP_PACKET_INVALID)
+			return -1;
+
+		pkt_len = odp_packet_len(pkt);
+
+		t1  = odp_time_local();
+		num = odph_ipfrag_frag(pkt, TEST_MTU, i, frag, TEST_MAX_FRAGS);
+		t2  = odp_time_local();
+
+		if (num < 1) {
+			LOG_ERR("Error: fragmentation failed\n");
+			odp_packet_free(pkt);
+			return -1;
+		}
+
+		out = ODP_PACKET_INVALID;
+		ret = 0;
+
+		/* Last fragment first, to exercise ordering */
+		for (j = num - 1; j >= 0 && ret >= 0; j--)
+			ret = odph_ipfrag_reass(tbl, 0, frag[j], &out);
+
+		t3 = odp_time_local();
+
+		if (ret != 1 || odp_packet_len(out) != pkt_len) {
+			LOG_ERR("Error: reassembly failed\n");
+			return -1;
+		}
+
+		odp_packet_free(out);
+
+		frag_ns  += odp_time_to_ns(odp_time_diff(t2, t1));
+		reass_ns += odp_time_to_ns(odp_time_diff(t3, t2));
+	}
+
+	if (frag_ns == 0)
+		frag_ns = 1;
+
+	if (reass_ns == 0)
+		reass_ns = 1;
+
+	printf("  IPv%i %5" PRIu32 " B, %2i frags: fragment %8.1f ns %7.2f"
+	       " Gbps, reassemble %8.1f ns %7.2f Gbps\n", ipv4 ? 4 : 6, pkt_len,
+	       num,
+	       (double)frag_ns / rounds, (double)pkt_len * 8 * rounds / frag_ns,
+	       (double)reass_ns / rounds,
+	       (double)pkt_len * 8 * rounds / reass_ns);
+
+	return 0;
+}
+
+/** Interleave fragments of many datagrams and record peak table usage */
+static int bench_memory(int ipv4, uint32_t len, uint32_t flows)
+{
+	odp_packet_t (*frag)[TEST_MAX_FRAGS];
+	odph_ipfrag_stats_t stats;
+	odp_packet_t pkt, out;
+	uint64_t peak_flows = 0, peak_frags = 0;
+	uint32_t i, done = 0;
+	int num = 0;
+	int j, ret;
+
+	frag = malloc(flows * sizeof(*frag));
+	if (frag == NULL)
+		return -1;
+
+	for (i = 0; i < flows; i++) {
+		pkt = create_pkt(ipv4, len, i);
+		if (pkt == ODP_PACKET_INVALID)
+			return -1;
+
+		num = odph_ipfrag_frag(pkt, TEST_MTU, i, frag[i],
+				       TEST_MAX_FRAGS);
+		if (num < 1) {
+			LOG_ERR("Error: fragmentation failed\n");
+			odp_packet_free(pkt);
+			return -1;
+		}
+	}
+
+	for (j = 0; j < num; j++) {
+		for (i = 0; i < flows; i++) {
+			ret = odph_ipfrag_reass(tbl, 0, frag[i][j], &out);
+
+			if (ret < 0) {
+				LOG_ERR("Error: reassembly failed\n");
+				return -1;
+			}
+
+			if (ret == 1) {
+				odp_packet_free(out);
+				done++;
+			}
+		}
+
+		odph_ipfrag_stats(tbl, &stats);
+
+		if (stats.held_flows > peak_flows)
+			peak_flows = stats.held_flows;
+
+		if (stats.held_frags > peak_frags)
+			peak_frags = stats.held_frags;
+	}
+
+	free(frag);
+
+	printf("  IPv%i %5" PRIu32 " B, %2i frags: %" PRIu32 " datagrams, peak"
+	       " %" PRIu64 " datagrams and %" PRIu64 " fragments held\n",
+	       ipv4 ? 4 : 6, len, num, done, peak_flows, peak_frags);
+
+	return done == flows ? 0 : -1;
+}
+
+static void usage(char *progname)
+{
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -r 100000\n"
+	       "\n"
+	       "Microbenchmarks for IP fragmentation and reassembly helpers\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -r, --rounds <num>  Number of rounds per test (default %i)\n"
+	       "  -f, --flows <num>   Number of concurrent datagrams in memory\n"
+	       "                      test (default %i)\n"
+	       "  -h, --help          Display help and exit.\n\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname), TEST_ROUNDS,
+	       TEST_FLOWS);
+}
+
+static int parse_args(int argc, char *argv[], test_args_t *args)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"rounds", required_argument, NULL, 'r'},
+		{"flows", required_argument, NULL, 'f'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "r:f:h";
+
+	args->rounds = TEST_ROUNDS;
+	args->flows  = TEST_FLOWS;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'r':
+			args->rounds = atoi(optarg);
+			break;
+		case 'f':
+			args->flows = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (args->rounds == 0)
+		args->rounds = 1;
+
+	if (args->flows == 0)
+		args->flows = 1;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_pool_param_t params;
+	odp_timer_pool_param_t tparams;
+	odp_timer_pool_t timer_pool;
+	odph_ipfrag_param_t param;
+	odp_shm_info_t shm_info;
+	test_args_t args;
+	uint32_t i;
+	int ret = 0;
+
+	if (parse_args(argc, argv, &args))
+		exit(EXIT_FAILURE);
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_PACKET;
+	params.pkt.len = TEST_MAX_LEN;
+	params.pkt.num = args.flows * TEST_MAX_FRAGS / 2 + TEST_MAX_FRAGS;
+
+	pool = odp_pool_create("ipfrag_bench_pool", &params);
+
+	if (pool == ODP_POOL_INVALID) {
+		LOG_ERR("Error: packet pool create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	tparams.res_ns     = 10 * ODP_TIME_MSEC_IN_NS;
+	tparams.min_tmo    = 10 * ODP_TIME_MSEC_IN_NS;
+	tparams.max_tmo    = 10 * ODP_TIME_SEC_IN_NS;
+	tparams.num_timers = 1;
+	tparams.priv       = 0;
+	tparams.clk_src    = ODP_CLOCK_CPU;
+
+	timer_pool = odp_timer_pool_create("ipfrag_bench_timer", &tparams);
+
+	if (timer_pool == ODP_TIMER_POOL_INVALID) {
+		LOG_ERR("Error: timer pool create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odp_timer_pool_start();
+
+	odph_ipfrag_param_init(&param);
+	param.num_flows  = args.flows;
+	param.max_frags  = TEST_MAX_FRAGS;
+	param.timeout_ns = 5 * ODP_TIME_SEC_IN_NS;
+	param.timer_pool = timer_pool;
+
+	tbl = odph_ipfrag_create(TEST_TBL_NAME, &param);
+
+	if (tbl == NULL) {
+		LOG_ERR("Error: reassembly table create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_shm_info(odp_shm_lookup(TEST_TBL_NAME), &shm_info) == 0)
+		printf("\nReassembly table: %" PRIu32 " datagrams, %i fragments"
+		       " per datagram, %" PRIu64 " kB (%" PRIu64 " B per "
+		       "datagram)\n", args.flows, TEST_MAX_FRAGS,
+		       shm_info.size / 1024, shm_info.size / args.flows);
+
+	printf("\nThroughput, %" PRIu32 " rounds, MTU %i\n\n", args.rounds,
+	       TEST_MTU);
+
+	for (i = 0; i < NUM_LEN; i++) {
+		if (bench_throughput(1, test_len[i], args.rounds) ||
+		    bench_throughput(0, test_len[i], args.rounds))
+			ret = -1;
+	}
+
+	printf("\nMemory, %" PRIu32 " interleaved datagrams\n\n", args.flows);
+
+	for (i = 0; i < NUM_LEN; i++) {
+		if (bench_memory(1, test_len[i], args.flows) ||
+		    bench_memory(0, test_len[i], args.flows))
+			ret = -1;
+	}
+
+	printf("\n");
+
+	if (odph_ipfrag_destroy(tbl)) {
+		LOG_ERR("Error: table destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
+	odp_timer_pool_destroy(timer_pool);
+
+	if (odp_pool_destroy(pool)) {
+		LOG_ERR("Error: pool destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,465 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_random.c  Random data generation scaling benchmark
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+#include <odp/helper/odph_api.h>
+
+/** Maximum number of worker threads */
+#define MAX_WORKERS 16
+
+/** Maximum number of values in a list option */
+#define MAX_LIST 16
+
+/** Maximum data length per call */
+#define MAX_LEN 4096
+
+/** Default test duration per configuration in msec */
+#define TEST_TIME_MS 20
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Default data lengths */
+static const uint32_t default_len[] = {16, 256, 4096};
+
+/**
+ * Parsed command line application arguments
+ */
+typedef struct {
+	/* Kinds to test */
+	odp_random_kind_t kind[2];
+	int num_kind;
+	uint32_t len[MAX_LIST];
+	int num_len;
+	uint32_t threads[MAX_LIST];
+	int num_threads;
+	uint32_t time_ms;
+	/* Minimum scaling efficiency in percent, or 0 for no check */
+	uint32_t efficiency;
+} appl_args_t;
+
+/**
+ * Per thread results
+ */
+typedef struct {
+	uint64_t calls;
+	uint64_t nsec;
+	uint64_t failed;
+	uint8_t buf[MAX_LEN];
+} ODP_ALIGNED_CACHE thread_args_t;
+
+/**
+ * Grouping of all global data
+ */
+typedef struct {
+	appl_args_t appl;
+	odp_cpumask_t cpumask;
+	int num_cpu;
+	odp_barrier_t barrier;
+	/* Current configuration */
+	odp_random_kind_t kind;
+	uint32_t len;
+	thread_args_t thread[MAX_WORKERS];
+} args_t;
+
+/** Global pointer to args */
+static args_t *gbl_args;
+
+static const char *kind_name(odp_random_kind_t kind)
+{
+	return kind == ODP_RANDOM_BASIC ? "basic" : "crypto";
+}
+
+static int run_worker(void *arg)
+{
+	thread_args_t *thr = arg;
+	odp_random_kind_t kind = gbl_args->kind;
+	uint32_t len = gbl_args->len;
+	uint64_t duration = gbl_args->appl.time_ms * ODP_TIME_MSEC_IN_NS;
+	uint64_t calls = 0, failed = 0;
+	odp_time_t t1;
+	int i;
+
+	odp_barrier_wait(&gbl_args->barrier);
+
+	t1 = odp_time_local();
+
+	do {
+		/* Check time less often for short lengths */
+		for (i = 0; i < 16; i++)
+			if (odp_unlikely(odp_random_data(thr->buf, len, kind) !=
+					 (int32_t)len))
+				failed++;
+
+		calls += 16;
+		thr->nsec = odp_time_to_ns(odp_time_diff(odp_time_local(),
+							 t1));
+	} while (thr->nsec < duration);
+
+	thr->calls  = calls;
+	thr->failed = failed;
+
+	return 0;
+}
+
+/* Run one configuration. Returns throughput in MB/s, or <0 on failure. */
+static double run_bench(odp_instance_t instance, uint32_t num_thr)
+{
+	odph_odpthread_t thread_tbl[MAX_WORKERS];
+	odph_odpthread_params_t thr_params;
+	odp_cpumask_t thd_mask;
+	uint64_t calls = 0, failed = 0, nsec = 1;
+	uint32_t i;
+	int cpu;
+
+	memset(thread_tbl, 0, sizeof(thread_tbl));
+	odp_barrier_init(&gbl_args->barrier, num_thr);
+
+	memset(&thr_params, 0, sizeof(thr_params));
+	thr_params.start    = run_worker;
+	thr_params.thr_type = ODP_THREAD_WORKER;
+	thr_params.instance = instance;
+
+	/* Threads are pinned to CPUs of the worker mask round robin */
+	cpu = odp_cpumask_first(&gbl_args->cpumask);
+
+	for (i = 0; i < num_thr; i++) {
+		thr_params.arg = &gbl_args->thread[i];
+		odp_cpumask_zero(&thd_mask);
+		odp_cpumask_set(&thd_mask, cpu);
+		odph_odpthreads_create(&thread_tbl[i], &thd_mask, &thr_params);
+
+		cpu = odp_cpumask_next(&gbl_args->cpumask, cpu);
+		if (cpu < 0)
+			cpu = odp_cpumask_first(&gbl_args->cpumask);
+	}
+
+	for (i = 0; i < num_thr; i++)
+		odph_odpthreads_join(&thread_tbl[i]);
+
+	for (i = 0; i < num_thr; i++) {
+		thread_args_t *thr = &gbl_args->thread[i];
+
+		calls  += thr->calls;
+		failed += thr->failed;
+
+		if (thr->nsec > nsec)
+			nsec = thr->nsec;
+	}
+
+	if (failed) {
+		LOG_ERR("Error: %" PRIu64 " odp_random_data() calls failed\n",
+			failed);
+		return -1.0;
+	}
+
+	printf("  %-7s %5" PRIu32 " %3" PRIu32 " %9.1f %10.1f ",
+	       kind_name(gbl_args->kind), gbl_args->len, num_thr,
+	       (double)nsec * num_thr / calls,
+	       (double)calls * gbl_args->len * 1000 / nsec);
+
+	return (double)calls * gbl_args->len * 1000 / nsec;
+}
+
+/* Run all thread counts of a configuration. Returns number of scaling
+ * check failures, or <0 on error. */
+static int run_threads(odp_instance_t instance)
+{
+	appl_args_t *appl = &gbl_args->appl;
+	double single = 0.0, mbps, scaling;
+	uint32_t num_thr;
+	int i, fail = 0;
+
+	for (i = 0; i < appl->num_threads; i++) {
+		num_thr = appl->threads[i];
+
+		mbps = run_bench(instance, num_thr);
+		if (mbps < 0)
+			return -1;
+
+		if (num_thr == 1)
+			single = mbps;
+
+		if (num_thr == 1 || single <= 0.0) {
+			printf("%7s\n", "-");
+			continue;
+		}
+
+		scaling = mbps / (single * num_thr);
+		printf("%6.1f%%\n", scaling * 100);
+
+		/* Scaling is not checked with more threads than CPUs */
+		if (appl->efficiency &&
+		    num_thr <= (uint32_t)gbl_args->num_cpu &&
+		    scaling * 100 < appl->efficiency) {
+			LOG_ERR("Error: %s len %" PRIu32 ": %" PRIu32
+				" threads scale %.1f%% (min %" PRIu32 "%%)\n",
+				kind_name(gbl_args->kind), gbl_args->len,
+				num_thr, scaling * 100, appl->efficiency);
+			fail++;
+		}
+	}
+
+	return fail;
+}
+
+static int parse_list(const char *str, uint32_t list[], int max,
+		      uint32_t min_val, uint32_t max_val)
+{
+	char *end;
+	long val;
+	int num = 0;
+
+	while (*str) {
+		val = strtol(str, &end, 0);
+
+		if (end == str || val < (long)min_val || val > (long)max_val ||
+		    num == max)
+			return -1;
+
+		list[num++] = val;
+		str = end;
+
+		if (*str == ',')
+			str++;
+		else if (*str)
+			return -1;
+	}
+
+	return num;
+}
+
+static void usage(char *progname)
+{
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -t 1,2,4 -e 80\n"
+	       "\n"
+	       "odp_random_data() throughput and multi-thread scaling benchmark.\n"
+	       "Reports nsec per call (per thread) and total MB/s.\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -k, --kind <kind>       Random kind: basic or crypto (default both)\n"
+	       "  -l, --length <list>     Data lengths (default 16,256,4096, max %i)\n"
+	       "  -t, --threads <list>    Thread counts (default 1 and number of\n"
+	       "                          worker CPUs, max %i)\n"
+	       "  -T, --time <msec>       Test time per configuration (default %i)\n"
+	       "  -e, --efficiency <pct>  Fail when N threads reach less than\n"
+	       "                          <pct> percent of N times single thread\n"
+	       "                          throughput. Thread count 1 is added.\n"
+	       "  -h, --help              Display help and exit.\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname), MAX_LEN,
+	       MAX_WORKERS, TEST_TIME_MS);
+}
+
+static int parse_args(int argc, char *argv[], appl_args_t *appl)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"kind", required_argument, NULL, 'k'},
+		{"length", required_argument, NULL, 'l'},
+		{"threads", required_argument, NULL, 't'},
+		{"time", required_argument, NULL, 'T'},
+		{"efficiency", required_argument, NULL, 'e'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "+k:l:t:T:e:h";
+
+	/* let helper collect its own arguments (e.g. --odph_proc) */
+	odph_parse_options(argc, argv, shortopts, longopts);
+
+	memset(appl, 0, sizeof(*appl));
+	appl->kind[0]  = ODP_RANDOM_BASIC;
+	appl->kind[1]  = ODP_RANDOM_CRYPTO;
+	appl->num_kind = 2;
+	appl->num_len  = sizeof(default_len) / sizeof(default_len[0]);
+	memcpy(appl->len, default_len, sizeof(default_len));
+	appl->time_ms  = TEST_TIME_MS;
+
+	opterr = 0; /* do not issue errors on helper options */
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'k':
+			appl->num_kind = 1;
+			if (!strcmp(optarg, "basic")) {
+				appl->kind[0] = ODP_RANDOM_BASIC;
+			} else if (!strcmp(optarg, "crypto")) {
+				appl->kind[0] = ODP_RANDOM_CRYPTO;
+			} else {
+				printf("Unknown kind '%s'\n", optarg);
+				return -1;
+			}
+			break;
+		case 'l':
+			appl->num_len = parse_list(optarg, appl->len,
+						   MAX_LIST, 1, MAX_LEN);
+			break;
+		case 't':
+			appl->num_threads = parse_list(optarg, appl->threads,
+						       MAX_LIST, 1,
+						       MAX_WORKERS);
+			if (appl->num_threads == 0)
+				appl->num_threads = -1;
+			break;
+		case 'T':
+			appl->time_ms = atoi(optarg);
+			break;
+		case 'e':
+			appl->efficiency = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			break;
+		}
+	}
+
+	optind = 1; /* reset 'extern optind' from the getopt lib */
+
+	if (appl->num_len <= 0 || appl->num_threads < 0) {
+		printf("Bad list option\n");
+		return -1;
+	}
+
+	if (appl->time_ms == 0)
+		appl->time_ms = 1;
+
+	/* Scaling is measured against a single thread run first */
+	if (appl->efficiency && appl->num_threads &&
+	    appl->threads[0] != 1) {
+		if (appl->num_threads == MAX_LIST) {
+			printf("Too many thread counts\n");
+			return -1;
+		}
+
+		memmove(&appl->threads[1], &appl->threads[0],
+			appl->num_threads * sizeof(uint32_t));
+		appl->threads[0] = 1;
+		appl->num_threads++;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_shm_t shm;
+	appl_args_t *appl;
+	int k, l, ret;
+	int fail = 0;
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	shm = odp_shm_reserve("shm_args", sizeof(args_t),
+			      ODP_CACHE_LINE_SIZE, 0);
+	gbl_args = odp_shm_addr(shm);
+
+	if (gbl_args == NULL) {
+		LOG_ERR("Error: shared mem alloc failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	memset(gbl_args, 0, sizeof(args_t));
+	appl = &gbl_args->appl;
+
+	if (parse_args(argc, argv, appl)) {
+		usage(argv[0]);
+		exit(EXIT_FAILURE);
+	}
+
+	gbl_args->num_cpu = odp_cpumask_default_worker(&gbl_args->cpumask, 0);
+
+	/* By default, compare a single thread to all worker CPUs */
+	if (appl->num_threads == 0) {
+		appl->threads[0]  = 1;
+		appl->num_threads = 1;
+
+		if (gbl_args->num_cpu > 1) {
+			appl->threads[1] = gbl_args->num_cpu;
+			if (appl->threads[1] > MAX_WORKERS)
+				appl->threads[1] = MAX_WORKERS;
+			appl->num_threads = 2;
+		}
+	}
+
+	if (odp_random_max_kind() < ODP_RANDOM_CRYPTO &&
+	    appl->kind[appl->num_kind - 1] == ODP_RANDOM_CRYPTO)
+		appl->num_kind--;
+
+	printf("\nodp_random_data() scaling, %" PRIu32 " ms per test\n"
+	       "\n  %-7s %5s %3s %9s %10s %7s\n", appl->time_ms, "kind",
+	       "len", "thr", "ns/call", "MB/s", "scaling");
+
+	for (k = 0; k < appl->num_kind && fail >= 0; k++) {
+		gbl_args->kind = appl->kind[k];
+
+		for (l = 0; l < appl->num_len; l++) {
+			gbl_args->len = appl->len[l];
+
+			ret = run_threads(instance);
+			if (ret < 0) {
+				fail = -1;
+				break;
+			}
+
+			fail += ret;
+		}
+
+		printf("\n");
+	}
+
+	if (odp_shm_free(shm)) {
+		LOG_ERR("Error: shm free\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return fail ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_time.c  Microbenchmarks for time functions
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+
+/** Default number of rounds per test */
+#define TEST_ROUNDS (1000 * 1000)
+
+/** Number of time stamps used as input of a test */
+#define TEST_NUM_TS 64
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Input time stamps */
+static odp_time_t test_ts[TEST_NUM_TS];
+
+/** Input nanosecond values */
+static uint64_t test_ns[TEST_NUM_TS];
+
+/** Output time stamps */
+static odp_time_t test_out[TEST_NUM_TS];
+
+/** Benchmarked function. Returns a value that depends on the result. */
+typedef uint64_t (*bench_fn_t)(uint32_t i);
+
+/**
+ * System call (or vDSO) used by the clock_gettime() based implementation
+ */
+static uint64_t bench_clock_gettime(uint32_t i ODP_UNUSED)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+
+	return ts.tv_nsec;
+}
+
+static uint64_t bench_cpu_cycles(uint32_t i ODP_UNUSED)
+{
+	return odp_cpu_cycles();
+}
+
+static uint64_t bench_local(uint32_t i)
+{
+	test_out[i % TEST_NUM_TS] = odp_time_local();
+	return 0;
+}
+
+static uint64_t bench_global(uint32_t i)
+{
+	test_out[i % TEST_NUM_TS] = odp_time_global();
+	return 0;
+}
+
+static uint64_t bench_diff(uint32_t i)
+{
+	odp_time_t t2 = test_ts[(i + 1) % TEST_NUM_TS];
+	odp_time_t t1 = test_ts[i % TEST_NUM_TS];
+
+	test_out[i % TEST_NUM_TS] = odp_time_diff(t2, t1);
+	return 0;
+}
+
+static uint64_t bench_sum(uint32_t i)
+{
+	odp_time_t t2 = test_ts[(i + 1) % TEST_NUM_TS];
+	odp_time_t t1 = test_ts[i % TEST_NUM_TS];
+
+	test_out[i % TEST_NUM_TS] = odp_time_sum(t1, t2);
+	return 0;
+}
+
+static uint64_t bench_cmp(uint32_t i)
+{
+	odp_time_t t2 = test_ts[(i + 1) % TEST_NUM_TS];
+	odp_time_t t1 = test_ts[i % TEST_NUM_TS];
+
+	return odp_time_cmp(t2, t1);
+}
+
+static uint64_t bench_to_ns(uint32_t i)
+{
+	return odp_time_to_ns(test_ts[i % TEST_NUM_TS]);
+}
+
+static uint64_t bench_from_ns(uint32_t i)
+{
+	uint64_t ns = test_ns[i % TEST_NUM_TS];
+
+	test_out[i % TEST_NUM_TS] = odp_time_local_from_ns(ns);
+	return 0;
+}
+
+/** Local time stamp and elapsed time check, as in a polling loop */
+static uint64_t bench_elapsed(uint32_t i)
+{
+	odp_time_t t = odp_time_diff(odp_time_local(),
+				     test_ts[i % TEST_NUM_TS]);
+
+	return odp_time_cmp(t, test_ts[0]) > 0;
+}
+
+/**
+ * Benchmark description
+ */
+typedef struct {
+	const char *name;
+	bench_fn_t fn;
+} bench_info_t;
+
+static const bench_info_t bench_info[] = {
+	{"clock_gettime", bench_clock_gettime},
+	{"odp_cpu_cycles", bench_cpu_cycles},
+	{"odp_time_local", bench_local},
+	{"odp_time_global", bench_global},
+	{"odp_time_diff", bench_diff},
+	{"odp_time_sum", bench_sum},
+	{"odp_time_cmp", bench_cmp},
+	{"odp_time_to_ns", bench_to_ns},
+	{"odp_time_local_from_ns", bench_from_ns},
+	{"local + diff + cmp", bench_elapsed},
+};
+
+#define NUM_BENCH (sizeof(bench_info) / sizeof(bench_info[0]))
+
+static void usage(char *progname)
+{
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -r 100000\n"
+	       "\n"
+	       "Microbenchmarks for time functions\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -r, --rounds <num>  Number of rounds per test (default %i)\n"
+	       "  -h, --help          Display help and exit.\n\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname), TEST_ROUNDS);
+}
+
+static int parse_args(int argc, char *argv[], uint32_t *rounds)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"rounds", required_argument, NULL, 'r'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "r:h";
+
+	*rounds = TEST_ROUNDS;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'r':
+			*rounds = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (*rounds == 0)
+		*rounds = 1;
+
+	return 0;
+}
+
+static void run_bench(const bench_info_t *bench, uint32_t rounds)
+{
+	uint64_t c1, c2, cycles, nsec;
+	odp_time_t t1, t2;
+	uint64_t sum = 0;
+	uint32_t i;
+
+	/* Warm up caches */
+	sum += bench->fn(0);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	for (i = 0; i < rounds; i++)
+		sum += bench->fn(i);
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	cycles = odp_cpu_cycles_diff(c2, c1);
+	nsec   = odp_time_to_ns(odp_time_diff(t2, t1));
+
+	printf("  %-24s %8.1f ns %8.1f cycles  (sum %" PRIx64 ")\n",
+	       bench->name, (double)nsec / rounds, (double)cycles / rounds,
+	       sum & 0xff);
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	uint64_t res, ns, prev;
+	odp_time_t t;
+	uint32_t rounds;
+	uint32_t i;
+	int ret = 0;
+
+	if (parse_args(argc, argv, &rounds))
+		exit(EXIT_FAILURE);
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	/* Input values spread over about a second, some over a second
+	 * apart */
+	for (i = 0; i < TEST_NUM_TS; i++) {
+		test_ns[i] = i * 15485863 + (i % 7) * ODP_TIME_SEC_IN_NS;
+		test_ts[i] = odp_time_local_from_ns(test_ns[i]);
+	}
+
+	/* Sanity check conversions and monotonicity */
+	for (i = 0; i < TEST_NUM_TS; i++) {
+		ns = odp_time_to_ns(test_ts[i]);
+
+		if (ns + 1 < test_ns[i] || ns > test_ns[i] + 1) {
+			LOG_ERR("Error: %" PRIu64 " ns converted to %" PRIu64
+				" ns\n", test_ns[i], ns);
+			ret = -1;
+		}
+	}
+
+	prev = 0;
+	for (i = 0; i < 1000; i++) {
+		ns = odp_time_to_ns(odp_time_local());
+
+		if (ns < prev) {
+			LOG_ERR("Error: local time went backwards\n");
+			ret = -1;
+		}
+		prev = ns;
+	}
+
+	res = odp_time_local_res();
+	t   = odp_time_local();
+
+	printf("\nTime microbenchmarks, %" PRIu32 " rounds\n"
+	       "Local time resolution %" PRIu64 " Hz, current time %" PRIu64
+	       " ns\n\n", rounds, res, odp_time_to_ns(t));
+
+	for (i = 0; i < NUM_BENCH; i++)
+		run_bench(&bench_info[i], rounds);
+
+	printf("\n");
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
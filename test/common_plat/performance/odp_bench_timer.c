@@ -0,0 +1,446 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * @example odp_bench_timer.c  Timer pool scaling benchmark
+ *
+ * Measures timer alloc, set, reset (one by one and in bursts) and free costs,
+ * and the CPU time spent in the timer pool per tick, with an increasing
+ * number of timers. Timer pool overhead is measured as CPU time of the
+ * process minus CPU time of the benchmark thread.
+ */
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <getopt.h>
+#include <inttypes.h>
+#include <time.h>
+
+#include <test_debug.h>
+
+#include <odp_api.h>
+
+/** Default maximum number of timers */
+#define TEST_MAX_TIMERS (100 * 1000)
+
+/** Minimum number of timers */
+#define TEST_MIN_TIMERS 1000
+
+/** Default timer resolution in microseconds */
+#define TEST_RES_US 1000
+
+/** Idle measurement time in milliseconds */
+#define TEST_IDLE_MS 200
+
+/** Number of ticks over which expiring timers are spread */
+#define TEST_SPREAD 100
+
+/** Maximum number of timeout pools */
+#define TEST_MAX_TMO_POOLS 16
+
+/** Number of timers reset per odp_timer_set_rel_multi() call */
+#define TEST_BURST 32
+
+/** Get rid of path in filename - only for unix-type paths using '/' */
+#define NO_PATH(file_name) (strrchr((file_name), '/') ? \
+			    strrchr((file_name), '/') + 1 : (file_name))
+
+/** Test arguments */
+typedef struct {
+	uint32_t max_timers;
+	uint32_t res_us;
+} test_args_t;
+
+/** Timer pool measurement results in nanoseconds */
+typedef struct {
+	double alloc;
+	double set;
+	double reset;
+	double reset_multi;
+	double free;
+	double tick;
+	double expire;
+} test_result_t;
+
+static odp_pool_t tmo_pool[TEST_MAX_TMO_POOLS];
+static uint32_t tmo_per_pool;
+static odp_queue_t queue;
+static odp_timer_t *timer;
+static odp_event_t *event;
+
+static uint64_t cpu_ns(clockid_t clk)
+{
+	struct timespec ts;
+
+	clock_gettime(clk, &ts);
+
+	return (uint64_t)ts.tv_sec * ODP_TIME_SEC_IN_NS + ts.tv_nsec;
+}
+
+/** CPU time spent by threads other than the calling thread */
+static uint64_t timer_cpu_ns(void)
+{
+	return cpu_ns(CLOCK_PROCESS_CPUTIME_ID) -
+	       cpu_ns(CLOCK_THREAD_CPUTIME_ID);
+}
+
+static uint64_t elapsed_ns(odp_time_t t1)
+{
+	return odp_time_to_ns(odp_time_diff(odp_time_local(), t1));
+}
+
+static void free_events(uint32_t num)
+{
+	uint32_t i;
+
+	for (i = 0; i < num; i++)
+		if (event[i] != ODP_EVENT_INVALID)
+			odp_event_free(event[i]);
+}
+
+static int bench_timers(uint32_t num, uint32_t res_us, test_result_t *res)
+{
+	odp_timer_pool_param_t tparams;
+	odp_timer_pool_t tp;
+	odp_event_t ev;
+	odp_time_t t1;
+	struct timespec idle, wait;
+	uint64_t far_tck, min_tck, tick, cpu;
+	uint64_t rel_tck[TEST_BURST];
+	uint32_t i, j, received;
+	int ret;
+
+	tparams.res_ns     = res_us * ODP_TIME_USEC_IN_NS;
+	tparams.min_tmo    = tparams.res_ns;
+	tparams.max_tmo    = 1000 * ODP_TIME_SEC_IN_NS;
+	tparams.num_timers = num;
+	tparams.priv       = 0;
+	tparams.clk_src    = ODP_CLOCK_CPU;
+
+	tp = odp_timer_pool_create("timer_bench", &tparams);
+
+	if (tp == ODP_TIMER_POOL_INVALID) {
+		LOG_ERR("Error: timer pool create failed.\n");
+		return -1;
+	}
+
+	odp_timer_pool_start();
+
+	far_tck = odp_timer_ns_to_tick(tp, 900 * ODP_TIME_SEC_IN_NS);
+	min_tck = odp_timer_ns_to_tick(tp, tparams.min_tmo);
+
+	for (i = 0; i < num; i++) {
+		odp_timeout_t tmo;
+
+		tmo = odp_timeout_alloc(tmo_pool[i / tmo_per_pool]);
+		if (tmo == ODP_TIMEOUT_INVALID) {
+			LOG_ERR("Error: timeout alloc failed.\n");
+			free_events(i);
+			return -1;
+		}
+		event[i] = odp_timeout_to_event(tmo);
+	}
+
+	t1 = odp_time_local();
+	for (i = 0; i < num; i++) {
+		timer[i] = odp_timer_alloc(tp, queue, NULL);
+		if (timer[i] == ODP_TIMER_INVALID) {
+			LOG_ERR("Error: timer alloc failed.\n");
+			return -1;
+		}
+	}
+	res->alloc = (double)elapsed_ns(t1) / num;
+
+	/* Set all timers far into the future, spread over many ticks */
+	t1 = odp_time_local();
+	for (i = 0; i < num; i++) {
+		ret = odp_timer_set_rel(timer[i], far_tck - (i % 1000),
+					&event[i]);
+		if (ret != ODP_TIMER_SUCCESS) {
+			LOG_ERR("Error: timer set failed (%i).\n", ret);
+			return -1;
+		}
+	}
+	res->set = (double)elapsed_ns(t1) / num;
+
+	/* Timer pool CPU time while no timer expires */
+	idle.tv_sec  = 0;
+	idle.tv_nsec = TEST_IDLE_MS * ODP_TIME_MSEC_IN_NS;
+	tick = odp_timer_current_tick(tp);
+	cpu  = timer_cpu_ns();
+	nanosleep(&idle, NULL);
+	cpu  = timer_cpu_ns() - cpu;
+	tick = odp_timer_current_tick(tp) - tick;
+	res->tick = tick ? (double)cpu / tick : 0.0;
+
+	/* Reset all timers in bursts, still far into the future */
+	for (j = 0; j < TEST_BURST; j++)
+		rel_tck[j] = far_tck - 1000 - j;
+
+	t1 = odp_time_local();
+	for (i = 0; i < num; i += TEST_BURST) {
+		int burst = num - i < TEST_BURST ? num - i : TEST_BURST;
+
+		ret = odp_timer_set_rel_multi(&timer[i], rel_tck, NULL, burst);
+		if (ret != burst) {
+			LOG_ERR("Error: timer reset multi failed (%i).\n", ret);
+			return -1;
+		}
+	}
+	res->reset_multi = (double)elapsed_ns(t1) / num;
+
+	/* Reset all timers to expire over the next TEST_SPREAD ticks */
+	t1 = odp_time_local();
+	for (i = 0; i < num; i++) {
+		ev  = ODP_EVENT_INVALID;
+		ret = odp_timer_set_rel(timer[i], min_tck + (i % TEST_SPREAD),
+					&ev);
+		if (ret != ODP_TIMER_SUCCESS) {
+			LOG_ERR("Error: timer reset failed (%i).\n", ret);
+			return -1;
+		}
+	}
+	res->reset = (double)elapsed_ns(t1) / num;
+
+	/* Dequeue timeouts only after the expiration period, so that queue
+	 * lock contention with the timer thread does not disturb expiry */
+	wait.tv_sec  = 0;
+	wait.tv_nsec = tparams.res_ns;
+	cpu  = timer_cpu_ns();
+	t1   = odp_time_local();
+	tick = odp_timer_current_tick(tp) + min_tck + TEST_SPREAD;
+	received = 0;
+	while (received < num) {
+		odp_event_t evs[32];
+		int n;
+
+		if (odp_timer_current_tick(tp) <= tick) {
+			nanosleep(&wait, NULL);
+			continue;
+		}
+
+		n = odp_queue_deq_multi(queue, evs, 32);
+
+		if (n > 0) {
+			received += n;
+			while (n--)
+				odp_event_free(evs[n]);
+			continue;
+		}
+
+		if (elapsed_ns(t1) > 10 * ODP_TIME_SEC_IN_NS +
+		    TEST_SPREAD * tparams.res_ns) {
+			LOG_ERR("Error: %" PRIu32 " timeouts missing.\n",
+				num - received);
+			return -1;
+		}
+
+		nanosleep(&wait, NULL);
+	}
+	res->expire = (double)(timer_cpu_ns() - cpu) / num;
+
+	t1 = odp_time_local();
+	for (i = 0; i < num; i++) {
+		ev = odp_timer_free(timer[i]);
+		if (ev != ODP_EVENT_INVALID) {
+			LOG_ERR("Error: expired timer returned an event.\n");
+			odp_event_free(ev);
+		}
+	}
+	res->free = (double)elapsed_ns(t1) / num;
+
+	odp_timer_pool_destroy(tp);
+
+	return 0;
+}
+
+static void usage(char *progname)
+{
+	printf("\n"
+	       "Usage: %s OPTIONS\n"
+	       "  E.g. %s -m 10000000\n"
+	       "\n"
+	       "Timer pool scaling benchmark. Number of timers is increased\n"
+	       "tenfold from %i up to the maximum.\n"
+	       "\n"
+	       "Optional OPTIONS\n"
+	       "  -m, --max <num>     Maximum number of timers (default %i)\n"
+	       "  -r, --res <us>      Timer resolution in usec (default %i)\n"
+	       "  -h, --help          Display help and exit.\n\n"
+	       "\n", NO_PATH(progname), NO_PATH(progname), TEST_MIN_TIMERS,
+	       TEST_MAX_TIMERS, TEST_RES_US);
+}
+
+static int parse_args(int argc, char *argv[], test_args_t *args)
+{
+	int opt;
+	int long_index;
+	static const struct option longopts[] = {
+		{"max", required_argument, NULL, 'm'},
+		{"res", required_argument, NULL, 'r'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0}
+	};
+
+	static const char *shortopts = "m:r:h";
+
+	args->max_timers = TEST_MAX_TIMERS;
+	args->res_us     = TEST_RES_US;
+
+	while (1) {
+		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
+
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'm':
+			args->max_timers = atoi(optarg);
+			break;
+		case 'r':
+			args->res_us = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			exit(EXIT_SUCCESS);
+			break;
+		default:
+			usage(argv[0]);
+			return -1;
+		}
+	}
+
+	if (args->max_timers < TEST_MIN_TIMERS)
+		args->max_timers = TEST_MIN_TIMERS;
+
+	if (args->res_us == 0)
+		args->res_us = 1;
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	odp_instance_t instance;
+	odp_pool_capability_t capa;
+	odp_pool_param_t params;
+	odp_queue_param_t qparam;
+	test_result_t res;
+	test_args_t args;
+	uint32_t num, num_pools, i;
+	int ret = 0;
+
+	if (parse_args(argc, argv, &args))
+		exit(EXIT_FAILURE);
+
+	if (odp_init_global(&instance, NULL, NULL)) {
+		LOG_ERR("Error: ODP global init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_init_local(instance, ODP_THREAD_CONTROL)) {
+		LOG_ERR("Error: ODP local init failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_pool_capability(&capa)) {
+		LOG_ERR("Error: pool capability failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	tmo_per_pool = args.max_timers;
+	if (capa.tmo.max_num && tmo_per_pool > capa.tmo.max_num)
+		tmo_per_pool = capa.tmo.max_num;
+
+	num_pools = (args.max_timers + tmo_per_pool - 1) / tmo_per_pool;
+	if (num_pools > TEST_MAX_TMO_POOLS) {
+		num_pools = TEST_MAX_TMO_POOLS;
+		args.max_timers = num_pools * tmo_per_pool;
+	}
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_TIMEOUT;
+	params.tmo.num = tmo_per_pool;
+
+	for (i = 0; i < num_pools; i++) {
+		tmo_pool[i] = odp_pool_create("timer_bench_tmo", &params);
+
+		if (tmo_pool[i] == ODP_POOL_INVALID) {
+			LOG_ERR("Error: timeout pool create failed.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	odp_queue_param_init(&qparam);
+	qparam.type = ODP_QUEUE_TYPE_PLAIN;
+
+	queue = odp_queue_create("timer_bench_queue", &qparam);
+
+	if (queue == ODP_QUEUE_INVALID) {
+		LOG_ERR("Error: queue create failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	timer = malloc(args.max_timers * sizeof(odp_timer_t));
+	event = malloc(args.max_timers * sizeof(odp_event_t));
+
+	if (timer == NULL || event == NULL) {
+		LOG_ERR("Error: malloc failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	printf("\nTimer pool scaling, resolution %" PRIu32 " us\n"
+	       "Per timer costs and timer pool CPU time in nsec\n\n",
+	       args.res_us);
+	printf("  %10s %8s %8s %8s %8s %8s %12s %8s\n", "timers", "alloc",
+	       "set", "reset", "reset_m", "free", "idle tick", "expire");
+
+	for (num = TEST_MIN_TIMERS; num && num <= args.max_timers;
+	     num *= 10) {
+		if (bench_timers(num, args.res_us, &res)) {
+			ret = -1;
+			break;
+		}
+
+		printf("  %10" PRIu32 " %8.1f %8.1f %8.1f %8.1f %8.1f %12.1f "
+		       "%8.1f\n", num, res.alloc, res.set, res.reset,
+		       res.reset_multi, res.free, res.tick,
+		       res.expire);
+	}
+	printf("\n");
+
+	free(timer);
+	free(event);
+
+	if (odp_queue_destroy(queue)) {
+		LOG_ERR("Error: queue destroy failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	for (i = 0; i < num_pools; i++) {
+		if (odp_pool_destroy(tmo_pool[i])) {
+			LOG_ERR("Error: pool destroy failed.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	if (odp_term_local()) {
+		LOG_ERR("Error: term local failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	if (odp_term_global(instance)) {
+		LOG_ERR("Error: term global failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	return ret;
+}
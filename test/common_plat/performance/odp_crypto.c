@@ -28,8 +28,30 @@
  */
 #define POOL_NUM_PKT  64
 
+/** @def MAX_BURST
+ * Maximum number of operations per odp_crypto_operation_multi() call
+ */
+#define MAX_BURST  32
+
+/** @def MAX_TEST_SESSIONS
+ * Maximum number of sessions in session mix
+ */
+#define MAX_TEST_SESSIONS  16
+
+/** @def MAX_HASH_LEN
+ * Maximum size of hash
+ */
+#define MAX_HASH_LEN  64
+
+/** @def MAX_PACKET_LEN
+ * Maximum packet length: the largest payload and hash
+ */
+#define MAX_PACKET_LEN  (16384 + MAX_HASH_LEN)
+
 static uint8_t test_iv[8] = "01234567";
 
+static uint8_t test_iv16[16] = "0123456789abcdef";
+
 static uint8_t test_key16[16] = { 0x01, 0x02, 0x03, 0x04, 0x05,
 				  0x06, 0x07, 0x08, 0x09, 0x0a,
 				  0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
@@ -43,6 +65,21 @@ static uint8_t test_key24[24] = { 0x01, 0x02, 0x03, 0x04, 0x05,
 				  0x15, 0x16, 0x17, 0x18
 };
 
+static uint8_t test_key64[64] = { 0x01, 0x02, 0x03, 0x04, 0x05,
+				  0x06, 0x07, 0x08, 0x09, 0x0a,
+				  0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+				  0x10, 0x11, 0x12, 0x13, 0x14,
+				  0x15, 0x16, 0x17, 0x18, 0x19,
+				  0x1a, 0x1b, 0x1c, 0x1d, 0x1e,
+				  0x1f, 0x20, 0x21, 0x22, 0x23,
+				  0x24, 0x25, 0x26, 0x27, 0x28,
+				  0x29, 0x2a, 0x2b, 0x2c, 0x2d,
+				  0x2e, 0x2f, 0x30, 0x31, 0x32,
+				  0x33, 0x34, 0x35, 0x36, 0x37,
+				  0x38, 0x39, 0x3a, 0x3b, 0x3c,
+				  0x3d, 0x3e, 0x3f, 0x40
+};
+
 /**
  * Structure that holds template for session create call
  * for different algorithms supported by test
@@ -92,10 +129,19 @@ typedef struct {
 	int iteration_count;
 
 	/**
-	 * Maximum sessions. Currently is not used.
+	 * Number of sessions of the algorithm. Operations are spread over
+	 * the sessions in round robin order. Specified through -m or
+	 * --sessions option. Default is 1.
 	 */
 	int max_sessions;
 
+	/**
+	 * Number of operations per odp_crypto_operation_multi() call.
+	 * When 1, odp_crypto_operation() is used. Specified through -b or
+	 * --burst option. Default is 1.
+	 */
+	int burst;
+
 	/**
 	 * Payload size to test. If 0 set of predefined payload sizes
 	 * is tested. Specified through -p or --payload option.
@@ -225,6 +271,202 @@ static crypto_alg_config_t algs_config[] = {
 		},
 		.hash_adjust = 12
 	},
+	{
+		.name = "null-hmac-sha1-96",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_NULL,
+			.auth_alg = ODP_AUTH_ALG_SHA1_HMAC,
+			.auth_key = {
+				.data = test_key64,
+				.length = 20
+			}
+		},
+		.hash_adjust = 12
+	},
+	{
+		.name = "null-hmac-sha256-128",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_NULL,
+			.auth_alg = ODP_AUTH_ALG_SHA256_HMAC,
+			.auth_key = {
+				.data = test_key64,
+				.length = 32
+			}
+		},
+		.hash_adjust = 16
+	},
+	{
+		.name = "null-hmac-sha384-192",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_NULL,
+			.auth_alg = ODP_AUTH_ALG_SHA384_HMAC,
+			.auth_key = {
+				.data = test_key64,
+				.length = 48
+			}
+		},
+		.hash_adjust = 24
+	},
+	{
+		.name = "null-hmac-sha512-256",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_NULL,
+			.auth_alg = ODP_AUTH_ALG_SHA512_HMAC,
+			.auth_key = {
+				.data = test_key64,
+				.length = 64
+			}
+		},
+		.hash_adjust = 32
+	},
+	{
+		.name = "3des-cbc-hmac-sha1-96",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_3DES_CBC,
+			.cipher_key = {
+				.data = test_key24,
+				.length = sizeof(test_key24)
+			},
+			.iv = {
+				.data = test_iv,
+				.length = 8,
+			},
+			.auth_alg = ODP_AUTH_ALG_SHA1_HMAC,
+			.auth_key = {
+				.data = test_key64,
+				.length = 20
+			}
+		},
+		.hash_adjust = 12
+	},
+	{
+		.name = "aes128-cbc-null",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_AES_CBC,
+			.cipher_key = {
+				.data = test_key64,
+				.length = 16
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 16,
+			},
+			.auth_alg = ODP_AUTH_ALG_NULL
+		},
+	},
+	{
+		.name = "aes256-cbc-null",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_AES_CBC,
+			.cipher_key = {
+				.data = test_key64,
+				.length = 32
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 16,
+			},
+			.auth_alg = ODP_AUTH_ALG_NULL
+		},
+	},
+	{
+		.name = "aes128-ctr-null",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_AES_CTR,
+			.cipher_key = {
+				.data = test_key64,
+				.length = 16
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 16,
+			},
+			.auth_alg = ODP_AUTH_ALG_NULL
+		},
+	},
+	{
+		.name = "aes256-ctr-null",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_AES_CTR,
+			.cipher_key = {
+				.data = test_key64,
+				.length = 32
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 16,
+			},
+			.auth_alg = ODP_AUTH_ALG_NULL
+		},
+	},
+	{
+		.name = "aes128-cbc-hmac-sha1-96",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_AES_CBC,
+			.cipher_key = {
+				.data = test_key64,
+				.length = 16
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 16,
+			},
+			.auth_alg = ODP_AUTH_ALG_SHA1_HMAC,
+			.auth_key = {
+				.data = test_key64,
+				.length = 20
+			}
+		},
+		.hash_adjust = 12
+	},
+	{
+		.name = "aes128-gcm",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_AES_GCM,
+			.cipher_key = {
+				.data = test_key16,
+				.length = sizeof(test_key16)
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 12,
+			},
+			.auth_alg = ODP_AUTH_ALG_AES_GCM
+		},
+		.hash_adjust = 16
+	},
+	{
+		.name = "chacha20-poly1305",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_CHACHA20_POLY1305,
+			.cipher_key = {
+				.data = test_key64,
+				.length = 32
+			},
+			.iv = {
+				.data = test_iv16,
+				.length = 12,
+			},
+			.auth_alg = ODP_AUTH_ALG_CHACHA20_POLY1305
+		},
+		.hash_adjust = 16
+	},
+	{
+		.name = "aes128-gmac",
+		.session = {
+			.cipher_alg = ODP_CIPHER_ALG_NULL,
+			.iv = {
+				.data = test_iv16,
+				.length = 12,
+			},
+			.auth_alg = ODP_AUTH_ALG_AES_GMAC,
+			.auth_key = {
+				.data = test_key16,
+				.length = sizeof(test_key16)
+			}
+		},
+		.hash_adjust = 16
+	},
 };
 
 /**
@@ -412,6 +654,41 @@ print_mem(const char *msg,
 	printf("\n");
 }
 
+/**
+ * Print data of a packet, which may be segmented.
+ */
+static void
+print_packet(const char *msg, odp_packet_t pkt, unsigned int len)
+{
+	static unsigned char buf[MAX_PACKET_LEN];
+
+	if (len > odp_packet_len(pkt))
+		len = odp_packet_len(pkt);
+
+	odp_packet_copy_to_mem(pkt, 0, len, buf);
+	print_mem(msg, buf, len);
+}
+
+/**
+ * Fill packet payload with a constant, one segment at a time.
+ */
+static void
+fill_packet(odp_packet_t pkt, unsigned int len)
+{
+	unsigned int offset = 0;
+	uint32_t seg_len;
+	void *data;
+
+	while (offset < len) {
+		data = odp_packet_offset(pkt, offset, &seg_len, NULL);
+		if (seg_len > len - offset)
+			seg_len = len - offset;
+
+		memset(data, 1, seg_len);
+		offset += seg_len;
+	}
+}
+
 /**
  * Create ODP crypto session for given config.
  */
@@ -465,7 +742,7 @@ create_session_from_config(odp_crypto_session_t *session,
 static int
 run_measure_one(crypto_args_t *cargs,
 		crypto_alg_config_t *config,
-		odp_crypto_session_t *session,
+		odp_crypto_session_t session[],
 		unsigned int payload_length,
 		crypto_run_result_t *result)
 {
@@ -492,15 +769,13 @@ run_measure_one(crypto_args_t *cargs,
 		}
 	}
 
-	pkt = odp_packet_alloc(pkt_pool, payload_length);
+	pkt = odp_packet_alloc(pkt_pool, payload_length + config->hash_adjust);
 	if (pkt == ODP_PACKET_INVALID) {
 		app_err("failed to allocate buffer\n");
 		return -1;
 	}
 
-	void *mem = odp_packet_data(pkt);
-
-	memset(mem, 1, payload_length);
+	fill_packet(pkt, payload_length);
 
 	time_record_t start, end;
 	int packets_sent = 0;
@@ -508,7 +783,7 @@ run_measure_one(crypto_args_t *cargs,
 
 	/* Initialize parameters block */
 	memset(&params, 0, sizeof(params));
-	params.session = *session;
+	params.session = session[0];
 
 	params.cipher_range.offset = 0;
 	params.cipher_range.length = payload_length;
@@ -527,7 +802,6 @@ run_measure_one(crypto_args_t *cargs,
 
 	while ((packets_sent < cargs->iteration_count) ||
 	       (packets_received <  cargs->iteration_count)) {
-		void *mem;
 		odp_crypto_op_result_t result;
 
 		if ((packets_sent < cargs->iteration_count) &&
@@ -545,24 +819,25 @@ run_measure_one(crypto_args_t *cargs,
 				odp_packet_t newpkt;
 
 				newpkt = odp_packet_alloc(pkt_pool,
-							  payload_length);
+							  payload_length +
+							  config->hash_adjust);
 				if (newpkt == ODP_PACKET_INVALID) {
 					app_err("failed to allocate buffer\n");
 					return -1;
 				}
-				mem = odp_packet_data(newpkt);
-				memset(mem, 1, payload_length);
+				fill_packet(newpkt, payload_length);
 				params.pkt = newpkt;
 				params.out_pkt = cargs->in_place ? newpkt :
 						 ODP_PACKET_INVALID;
 			}
 
 			if (cargs->debug_packets) {
-				mem = odp_packet_data(params.pkt);
-				print_mem("Packet before encryption:",
-					  mem, payload_length);
+				print_packet("Packet before encryption:",
+					     params.pkt, payload_length);
 			}
 
+			params.session = session[packets_sent %
+						 cargs->max_sessions];
 			rc = odp_crypto_operation(&params, &posted,
 						  &result);
 			if (rc)
@@ -575,18 +850,15 @@ run_measure_one(crypto_args_t *cargs,
 		if (!posted) {
 			packets_received++;
 			if (cargs->debug_packets) {
-				mem = odp_packet_data(params.out_pkt);
-				print_mem("Immediately encrypted packet", mem,
-					  payload_length +
-					  config->hash_adjust);
+				print_packet("Immediately encrypted packet",
+					     params.out_pkt, payload_length +
+					     config->hash_adjust);
 			}
-			if (!cargs->in_place) {
-				if (cargs->reuse_packet) {
-					params.pkt = params.out_pkt;
-					params.out_pkt = ODP_PACKET_INVALID;
-				} else {
-					odp_packet_free(params.out_pkt);
-				}
+			if (!cargs->reuse_packet) {
+				odp_packet_free(params.out_pkt);
+			} else if (!cargs->in_place) {
+				params.pkt = params.out_pkt;
+				params.out_pkt = ODP_PACKET_INVALID;
 			}
 		} else {
 			odp_event_t ev;
@@ -606,13 +878,11 @@ run_measure_one(crypto_args_t *cargs,
 				odp_crypto_compl_free(compl);
 				out_pkt = result.pkt;
 
-				if (cargs->debug_packets) {
-					mem = odp_packet_data(out_pkt);
-					print_mem("Receieved encrypted packet",
-						  mem,
-						  payload_length +
-						  config->hash_adjust);
-				}
+				if (cargs->debug_packets)
+					print_packet("Receieved encrypted "
+						     "packet", out_pkt,
+						     payload_length +
+						     config->hash_adjust);
 				if (cargs->reuse_packet) {
 					params.pkt = out_pkt;
 					params.out_pkt = ODP_PACKET_INVALID;
@@ -652,6 +922,177 @@ run_measure_one(crypto_args_t *cargs,
 	return rc;
 }
 
+/**
+ * Free completion events received from 'out_queue' or the scheduler. Returns
+ * the number of events received.
+ */
+static int
+receive_compl_events(crypto_args_t *cargs, odp_queue_t out_queue)
+{
+	odp_event_t ev[MAX_BURST];
+	odp_packet_t pkt[MAX_BURST];
+	odp_crypto_compl_t compl;
+	odp_crypto_op_result_t result;
+	int i, num;
+	int received = 0;
+
+	do {
+		if (cargs->schedule)
+			num = odp_schedule_multi(NULL, ODP_SCHED_NO_WAIT, ev,
+						 MAX_BURST);
+		else
+			num = odp_queue_deq_multi(out_queue, ev, MAX_BURST);
+
+		for (i = 0; i < num; i++) {
+			compl = odp_crypto_compl_from_event(ev[i]);
+			odp_crypto_compl_result(compl, &result);
+			odp_crypto_compl_free(compl);
+			pkt[i] = result.pkt;
+		}
+
+		if (num > 0) {
+			odp_packet_free_multi(pkt, num);
+			received += num;
+		}
+	} while (num > 0);
+
+	return received;
+}
+
+/**
+ * Run measurement iterations with odp_crypto_operation_multi() calls of
+ * 'cargs->burst' operations.
+ */
+static int
+run_measure_burst(crypto_args_t *cargs,
+		  crypto_alg_config_t *config,
+		  odp_crypto_session_t session[],
+		  unsigned int payload_length,
+		  crypto_run_result_t *result)
+{
+	odp_crypto_op_param_t params[MAX_BURST];
+	odp_crypto_op_result_t op_result[MAX_BURST];
+	odp_bool_t posted[MAX_BURST];
+	odp_packet_t pkt[MAX_BURST];
+	odp_pool_t pkt_pool;
+	odp_queue_t out_queue;
+	time_record_t start, end;
+	int packets_sent = 0;
+	int packets_received = 0;
+	int max_in_flight = cargs->in_flight;
+	int i, num, num_sync, rc;
+
+	pkt_pool = odp_pool_lookup("packet_pool");
+	if (pkt_pool == ODP_POOL_INVALID) {
+		app_err("pkt_pool not found\n");
+		return -1;
+	}
+
+	out_queue = odp_queue_lookup("crypto-out");
+	if (cargs->schedule || cargs->poll) {
+		if (out_queue == ODP_QUEUE_INVALID) {
+			app_err("crypto-out queue not found\n");
+			return -1;
+		}
+	}
+
+	if (max_in_flight < cargs->burst)
+		max_in_flight = cargs->burst;
+
+	memset(params, 0, sizeof(params));
+	for (i = 0; i < cargs->burst; i++) {
+		params[i].cipher_range.length = payload_length;
+		params[i].auth_range.length = payload_length;
+		params[i].hash_result_offset = payload_length;
+	}
+
+	fill_time_record(&start);
+
+	while ((packets_sent < cargs->iteration_count) ||
+	       (packets_received < cargs->iteration_count)) {
+		num = cargs->iteration_count - packets_sent;
+		if (num > cargs->burst)
+			num = cargs->burst;
+		if (num > max_in_flight - (packets_sent - packets_received))
+			num = max_in_flight - (packets_sent - packets_received);
+
+		if (num > 0) {
+			if (odp_packet_alloc_multi(pkt_pool, payload_length +
+						   config->hash_adjust,
+						   pkt, num) != num) {
+				app_err("failed to allocate buffers\n");
+				return -1;
+			}
+
+			for (i = 0; i < num; i++) {
+				fill_packet(pkt[i], payload_length);
+
+				params[i].session =
+					session[(packets_sent + i) %
+						cargs->max_sessions];
+				params[i].pkt = pkt[i];
+				params[i].out_pkt = cargs->in_place ? pkt[i] :
+						    ODP_PACKET_INVALID;
+			}
+
+			rc = odp_crypto_operation_multi(params, posted,
+							op_result, num);
+			if (rc != num) {
+				app_err("failed odp_crypto_operation_multi: "
+					"rc = %d\n", rc);
+				return -1;
+			}
+
+			num_sync = 0;
+			for (i = 0; i < num; i++) {
+				if (posted[i])
+					continue;
+
+				pkt[num_sync] = op_result[i].pkt;
+
+				if (cargs->debug_packets)
+					print_packet("Immediately encrypted",
+						     pkt[num_sync],
+						     payload_length +
+						     config->hash_adjust);
+
+				num_sync++;
+			}
+
+			if (num_sync) {
+				odp_packet_free_multi(pkt, num_sync);
+				packets_received += num_sync;
+			}
+
+			packets_sent += num;
+		}
+
+		if (cargs->schedule || cargs->poll)
+			packets_received += receive_compl_events(cargs,
+								 out_queue);
+	}
+
+	fill_time_record(&end);
+
+	{
+		double count;
+
+		count = get_elapsed_usec(&start, &end);
+		result->elapsed = count /
+				  cargs->iteration_count;
+
+		count = get_rusage_self_diff(&start, &end);
+		result->rusage_self = count /
+				      cargs->iteration_count;
+
+		count = get_rusage_thread_diff(&start, &end);
+		result->rusage_thread = count /
+					cargs->iteration_count;
+	}
+
+	return 0;
+}
+
 /**
  * Process one algorithm. Note if paload size is specicified it is
  * only one run. Or iterate over set of predefined payloads.
@@ -661,16 +1102,28 @@ run_measure_one_config(crypto_args_t *cargs,
 		       crypto_alg_config_t *config)
 {
 	crypto_run_result_t result;
-	odp_crypto_session_t session;
+	odp_crypto_session_t session[MAX_TEST_SESSIONS];
+	int (*run_measure)(crypto_args_t *, crypto_alg_config_t *,
+			   odp_crypto_session_t [], unsigned int,
+			   crypto_run_result_t *);
+	int num_sessions;
 	int rc = 0;
 
-	if (create_session_from_config(&session, config, cargs))
-		rc = -1;
+	run_measure = cargs->burst > 1 ? run_measure_burst : run_measure_one;
+
+	for (num_sessions = 0; num_sessions < cargs->max_sessions;
+	     num_sessions++) {
+		if (create_session_from_config(&session[num_sessions], config,
+					       cargs)) {
+			rc = -1;
+			break;
+		}
+	}
 
 	if (!rc) {
 		if (cargs->payload_length) {
-			rc = run_measure_one(cargs, config, &session,
-					     cargs->payload_length, &result);
+			rc = run_measure(cargs, config, session,
+					 cargs->payload_length, &result);
 			if (!rc) {
 				print_result_header();
 				print_result(cargs, cargs->payload_length,
@@ -681,8 +1134,8 @@ run_measure_one_config(crypto_args_t *cargs,
 
 			print_result_header();
 			for (i = 0; i < num_payloads; i++) {
-				rc = run_measure_one(cargs, config, &session,
-						     payloads[i], &result);
+				rc = run_measure(cargs, config, session,
+						 payloads[i], &result);
 				if (rc)
 					break;
 				print_result(cargs, payloads[i],
@@ -691,8 +1144,8 @@ run_measure_one_config(crypto_args_t *cargs,
 		}
 	}
 
-	if (session != ODP_CRYPTO_SESSION_INVALID)
-		odp_crypto_session_destroy(session);
+	while (num_sessions--)
+		odp_crypto_session_destroy(session[num_sessions]);
 	return rc;
 }
 
@@ -724,7 +1177,7 @@ int main(int argc, char *argv[])
 	odph_odpthread_t thr[num_workers];
 	odp_instance_t instance;
 	odp_pool_capability_t capa;
-	uint32_t max_seg_len;
+	uint32_t max_seg_len, max_len, segs;
 	unsigned i;
 
 	memset(&cargs, 0, sizeof(cargs));
@@ -747,19 +1200,25 @@ int main(int argc, char *argv[])
 	}
 
 	max_seg_len = capa.pkt.max_seg_len;
+	max_len	    = capa.pkt.max_len ? capa.pkt.max_len : MAX_PACKET_LEN;
 
+	/* Payloads longer than a segment are processed in segmented
+	 * packets */
 	for (i = 0; i < sizeof(payloads) / sizeof(unsigned int); i++) {
-		if (payloads[i] > max_seg_len)
+		if (payloads[i] + MAX_HASH_LEN > max_len)
 			break;
 	}
 
 	num_payloads = i;
+	max_len = payloads[i - 1] + MAX_HASH_LEN;
+	segs	= (max_len + max_seg_len - 1) / max_seg_len;
 
-	/* Create packet pool */
+	/* Create packet pool. Reserve segments for POOL_NUM_PKT packets of
+	 * maximum length also when pool size is counted in segments. */
 	odp_pool_param_init(&params);
 	params.pkt.seg_len = max_seg_len;
-	params.pkt.len	   = max_seg_len;
-	params.pkt.num	   = POOL_NUM_PKT;
+	params.pkt.len	   = max_len;
+	params.pkt.num	   = POOL_NUM_PKT * segs;
 	params.type	   = ODP_POOL_PACKET;
 	pool = odp_pool_create("packet_pool", &params);
 
@@ -807,6 +1266,8 @@ int main(int argc, char *argv[])
 	} else {
 		printf("Run in sync mode\n");
 	}
+	printf("Burst size %d, %d session(s) per algorithm\n", cargs.burst,
+	       cargs.max_sessions);
 
 	memset(thr, 0, sizeof(thr));
 
@@ -835,6 +1296,11 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	if (out_queue != ODP_QUEUE_INVALID && odp_queue_destroy(out_queue)) {
+		app_err("Error: queue destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
 	if (odp_pool_destroy(pool)) {
 		app_err("Error: pool destroy\n");
 		exit(EXIT_FAILURE);
@@ -859,6 +1325,7 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 	int long_index;
 	static const struct option longopts[] = {
 		{"algorithm", optional_argument, NULL, 'a'},
+		{"burst", optional_argument, NULL, 'b'},
 		{"debug",  no_argument, NULL, 'd'},
 		{"flight", optional_argument, NULL, 'f'},
 		{"help", no_argument, NULL, 'h'},
@@ -872,7 +1339,7 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+a:c:df:hi:m:nl:spr";
+	static const char *shortopts = "+a:b:c:df:hi:m:nl:spr";
 
 	/* let helper collect its own arguments (e.g. --odph_proc) */
 	odph_parse_options(argc, argv, shortopts, longopts);
@@ -883,6 +1350,8 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 	cargs->iteration_count = 10000;
 	cargs->payload_length = 0;
 	cargs->alg_config = NULL;
+	cargs->max_sessions = 1;
+	cargs->burst = 1;
 	cargs->reuse_packet = 0;
 	cargs->schedule = 0;
 
@@ -904,6 +1373,9 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 				exit(-1);
 			}
 			break;
+		case 'b':
+			cargs->burst = atoi(optarg);
+			break;
 		case 'd':
 			cargs->debug_packets = 1;
 			break;
@@ -947,6 +1419,23 @@ static void parse_args(int argc, char *argv[], crypto_args_t *cargs)
 		usage(argv[0]);
 		exit(-1);
 	}
+	if (cargs->burst < 1 || cargs->burst > MAX_BURST) {
+		printf("-b (burst) must be between 1 and %d\n", MAX_BURST);
+		usage(argv[0]);
+		exit(-1);
+	}
+	if ((cargs->burst > 1) && cargs->reuse_packet) {
+		printf("-b (burst > 1) and -r (reuse packet) options are not compatible\n");
+		usage(argv[0]);
+		exit(-1);
+	}
+	if (cargs->max_sessions < 1 ||
+	    cargs->max_sessions > MAX_TEST_SESSIONS) {
+		printf("-m (sessions) must be between 1 and %d\n",
+		       MAX_TEST_SESSIONS);
+		usage(argv[0]);
+		exit(-1);
+	}
 	if (cargs->schedule && cargs->poll) {
 		printf("-s (schedule) and -p (poll) options are not compatible\n");
 		usage(argv[0]);
@@ -970,15 +1459,20 @@ static void usage(char *progname)
 	       progname, progname);
 
 	print_config_names("				      ");
-	printf("  -d, --debug	       Enable dump of processed packets.\n"
+	printf("  -b, --burst <number> Number of operations per\n"
+	       "		       odp_crypto_operation_multi() call (default 1,\n"
+	       "		       max %d). 1 uses odp_crypto_operation().\n"
+	       "  -d, --debug	       Enable dump of processed packets.\n"
 	       "  -f, --flight <number> Max number of packet processed in parallel (default 1)\n"
 	       "  -i, --iterations <number> Number of iterations.\n"
 	       "  -n, --inplace	       Encrypt on place.\n"
 	       "  -l, --payload	       Payload length.\n"
+	       "  -m, --sessions <number> Number of sessions, operations use\n"
+	       "		       them in round robin order (default 1, max %d).\n"
 	       "  -r, --reuse	       Output encrypted packet is passed as input\n"
 	       "		       to next encrypt iteration.\n"
 	       "  -s, --schedule       Use scheduler for completion events.\n"
 	       "  -p, --poll           Poll completion queue for completion events.\n"
 	       "  -h, --help	       Display help and exit.\n"
-	       "\n");
+	       "\n", MAX_BURST, MAX_TEST_SESSIONS);
 }
@@ -50,6 +50,9 @@
 /** Maximum number of pktio queues per interface */
 #define MAX_QUEUES             32
 
+/** Number of packets to prefetch ahead of processing */
+#define PREFETCH_DIST          4
+
 /** Maximum number of pktio interfaces */
 #define MAX_PKTIOS             8
 
@@ -104,6 +107,7 @@ typedef struct {
 	int src_change;		/**< Change source eth addresses */
 	int error_check;        /**< Check packet errors */
 	int sched_mode;         /**< Scheduler mode */
+	int vector_size;        /**< Packet input vector size */
 } appl_args_t;
 
 static int exit_threads;	/**< Break workers loop if set to 1 */
@@ -181,6 +185,9 @@ typedef struct {
 	 *  mode. */
 	uint8_t dst_port_from_idx[MAX_PKTIO_INDEXES];
 
+	/** Packet vector pool. This is used by the sched mode. */
+	odp_pool_t vector_pool;
+
 } args_t;
 
 /** Global pointer to args */
@@ -236,10 +243,15 @@ static inline void fill_eth_addrs(odp_packet_t pkt_tbl[],
 	if (!gbl_args->appl.dst_change && !gbl_args->appl.src_change)
 		return;
 
+	for (i = 0; i < num && i < PREFETCH_DIST; ++i)
+		odp_packet_prefetch(pkt_tbl[i], 0, ODPH_ETHHDR_LEN);
+
 	for (i = 0; i < num; ++i) {
 		pkt = pkt_tbl[i];
 
-		odp_packet_prefetch(pkt, 0, ODPH_ETHHDR_LEN);
+		if (i + PREFETCH_DIST < num)
+			odp_packet_prefetch(pkt_tbl[i + PREFETCH_DIST], 0,
+					    ODPH_ETHHDR_LEN);
 
 		eth = odp_packet_data(pkt);
 
@@ -294,9 +306,14 @@ static int run_worker_sched_mode(void *arg)
 	stats_t *stats = thr_args->stats;
 	int use_event_queue = gbl_args->appl.out_mode;
 	pktin_mode_t in_mode = gbl_args->appl.in_mode;
+	int max_events = MAX_PKT_BURST;
 
 	thr = odp_thread_id();
 
+	/* A vector carries a full burst of packets */
+	if (gbl_args->appl.vector_size)
+		max_events = 1;
+
 	num_pktio = thr_args->num_pktio;
 
 	if (num_pktio > MAX_PKTIOS) {
@@ -319,19 +336,27 @@ static int run_worker_sched_mode(void *arg)
 	/* Loop packets */
 	while (!exit_threads) {
 		odp_event_t  ev_tbl[MAX_PKT_BURST];
-		odp_packet_t pkt_tbl[MAX_PKT_BURST];
+		odp_packet_t pkt_buf[MAX_PKT_BURST];
+		odp_packet_t *pkt_tbl = pkt_buf;
+		odp_packet_vector_t pktv = ODP_PACKET_VECTOR_INVALID;
 		int sent;
 		unsigned tx_drops;
 		int src_idx;
 
 		pkts = odp_schedule_multi(NULL, ODP_SCHED_NO_WAIT, ev_tbl,
-					  MAX_PKT_BURST);
+					  max_events);
 
 		if (pkts <= 0)
 			continue;
 
-		for (i = 0; i < pkts; i++)
-			pkt_tbl[i] = odp_packet_from_event(ev_tbl[i]);
+		if (odp_event_type(ev_tbl[0]) == ODP_EVENT_PACKET_VECTOR) {
+			/* Forward packets directly from the vector table */
+			pktv = odp_packet_vector_from_event(ev_tbl[0]);
+			pkts = odp_packet_vector_tbl(pktv, &pkt_tbl);
+		} else {
+			for (i = 0; i < pkts; i++)
+				pkt_tbl[i] = odp_packet_from_event(ev_tbl[i]);
+		}
 
 		if (gbl_args->appl.error_check) {
 			int rx_drops;
@@ -341,8 +366,11 @@ static int run_worker_sched_mode(void *arg)
 
 			if (odp_unlikely(rx_drops)) {
 				stats->s.rx_drops += rx_drops;
-				if (pkts == rx_drops)
+				if (pkts == rx_drops) {
+					if (pktv != ODP_PACKET_VECTOR_INVALID)
+						odp_packet_vector_free(pktv);
 					continue;
+				}
 
 				pkts -= rx_drops;
 			}
@@ -371,6 +399,9 @@ static int run_worker_sched_mode(void *arg)
 				odp_packet_free(pkt_tbl[i]);
 		}
 
+		if (pktv != ODP_PACKET_VECTOR_INVALID)
+			odp_packet_vector_free(pktv);
+
 		stats->s.packets += pkts;
 	}
 
@@ -641,6 +672,21 @@ static int create_pktio(const char *dev, int idx, int num_rx, int num_tx,
 	mode_tx = ODP_PKTIO_OP_MT_UNSAFE;
 
 	if (gbl_args->appl.sched_mode) {
+		if (gbl_args->appl.vector_size) {
+			if (!capa.vector.supported ||
+			    capa.vector.max_size <
+			    (uint32_t)gbl_args->appl.vector_size) {
+				LOG_ERR("Error: vector size not supported %s\n",
+					dev);
+				return -1;
+			}
+
+			pktin_param.vector.enable = 1;
+			pktin_param.vector.pool   = gbl_args->vector_pool;
+			pktin_param.vector.max_size =
+				gbl_args->appl.vector_size;
+		}
+
 		if (gbl_args->appl.in_mode == SCHED_ATOMIC)
 			sync_mode = ODP_SCHED_SYNC_ATOMIC;
 		else if (gbl_args->appl.in_mode == SCHED_ORDERED)
@@ -1048,6 +1094,9 @@ static void usage(char *progname)
 	       "                    Requires also the -d flag to be set\n"
 	       "  -e, --error_check 0: Don't check packet errors (default)\n"
 	       "                    1: Check packet errors\n"
+	       "  -v, --vector <size> Receive packets in vectors of max <size>\n"
+	       "                      packets. Scheduler modes only.\n"
+	       "                      0: Packet vectors disabled (default)\n"
 	       "  -h, --help           Display help and exit.\n\n"
 	       "\n", NO_PATH(progname), NO_PATH(progname), MAX_PKTIOS
 	    );
@@ -1079,11 +1128,12 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		{"dst_change", required_argument, NULL, 'd'},
 		{"src_change", required_argument, NULL, 's'},
 		{"error_check", required_argument, NULL, 'e'},
+		{"vector", required_argument, NULL, 'v'},
 		{"help", no_argument, NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts =  "+c:+t:+a:i:m:o:r:d:s:e:h";
+	static const char *shortopts =  "+c:+t:+a:i:m:o:r:d:s:e:v:h";
 
 	/* let helper collect its own arguments (e.g. --odph_proc) */
 	odph_parse_options(argc, argv, shortopts, longopts);
@@ -1217,6 +1267,9 @@ static void parse_args(int argc, char *argv[], appl_args_t *appl_args)
 		case 'e':
 			appl_args->error_check = atoi(optarg);
 			break;
+		case 'v':
+			appl_args->vector_size = atoi(optarg);
+			break;
 		case 'h':
 			usage(argv[0]);
 			exit(EXIT_SUCCESS);
@@ -1393,6 +1446,23 @@ int main(int argc, char *argv[])
 	}
 	odp_pool_print(pool);
 
+	gbl_args->vector_pool = ODP_POOL_INVALID;
+
+	if (gbl_args->appl.vector_size && gbl_args->appl.sched_mode) {
+		odp_pool_param_init(&params);
+		params.vector.num      = SHM_PKT_POOL_SIZE;
+		params.vector.max_size = gbl_args->appl.vector_size;
+		params.type            = ODP_POOL_PACKET_VECTOR;
+
+		gbl_args->vector_pool = odp_pool_create("vector pool",
+							&params);
+
+		if (gbl_args->vector_pool == ODP_POOL_INVALID) {
+			LOG_ERR("Error: vector pool create failed.\n");
+			exit(EXIT_FAILURE);
+		}
+	}
+
 	if (odp_pktio_max_index() >= MAX_PKTIO_INDEXES)
 		LOG_DBG("Warning: max pktio index (%u) is too large\n",
 			odp_pktio_max_index());
@@ -1511,6 +1581,12 @@ int main(int argc, char *argv[])
 		exit(EXIT_FAILURE);
 	}
 
+	if (gbl_args->vector_pool != ODP_POOL_INVALID &&
+	    odp_pool_destroy(gbl_args->vector_pool)) {
+		LOG_ERR("Error: vector pool destroy\n");
+		exit(EXIT_FAILURE);
+	}
+
 	if (odp_shm_free(shm)) {
 		LOG_ERR("Error: shm free\n");
 		exit(EXIT_FAILURE);
@@ -91,6 +91,9 @@
 /** Maximum number of pktio queues per interface */
 #define MAX_QUEUES		32
 
+/** Number of packets to prefetch ahead of processing */
+#define PREFETCH_DIST		4
+
 /** Maximum number of pktio interfaces */
 #define MAX_PKTIOS		8
 
@@ -448,14 +451,21 @@ static inline void process_input(odp_event_t ev_tbl[], int num, stats_t *stats,
 	int i, j;
 	int pkts = 0;
 
+	for (i = 0; i < num && i < PREFETCH_DIST; i++)
+		odp_packet_prefetch(odp_packet_from_event(ev_tbl[i]), 0,
+				    MIN_PACKET_LEN);
+
 	for (i = 0; i < num; i++) {
 		odp_packet_t pkt;
 		packet_hdr_t hdr;
 		int  flow_idx;
 
-		pkt = odp_packet_from_event(ev_tbl[i]);
+		if (i + PREFETCH_DIST < num) {
+			pkt = odp_packet_from_event(ev_tbl[i + PREFETCH_DIST]);
+			odp_packet_prefetch(pkt, 0, MIN_PACKET_LEN);
+		}
 
-		odp_packet_prefetch(pkt, 0, MIN_PACKET_LEN);
+		pkt = odp_packet_from_event(ev_tbl[i]);
 
 		ret = packet_hdr(pkt, &hdr);
 		if (odp_unlikely(ret)) {
@@ -0,0 +1,102 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <odp_api.h>
+#include <odp_cunit_common.h>
+#include "chksum.h"
+
+#define TEST_MAX_LEN 9100
+
+/* Reference sum of 16-bit words in network byte order */
+static uint16_t ref_sum(const uint8_t *data, uint32_t len)
+{
+	uint32_t sum = 0;
+	uint32_t i;
+
+	for (i = 0; i + 1 < len; i += 2)
+		sum += (data[i] << 8) | data[i + 1];
+
+	if (len & 1)
+		sum += data[len - 1] << 8;
+
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+
+	return sum;
+}
+
+void chksum_test_ones_comp16(void)
+{
+	/* Example from RFC 1071 */
+	uint8_t data[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+	uint16_t ret;
+
+	ret = odp_chksum_ones_comp16(data, sizeof(data));
+	CU_ASSERT(odp_be_to_cpu_16(ret) == 0xddf2);
+
+	ret = odp_chksum_ones_comp16(data, 0);
+	CU_ASSERT(ret == 0);
+}
+
+/* Long lengths, short ones are all tested */
+static const uint32_t chksum_len_test[] = {
+	1000, 1501, 4096, 9000, TEST_MAX_LEN
+};
+
+static void check_len(const uint8_t *data, uint32_t len)
+{
+	uint32_t offset;
+	uint16_t ret;
+
+	/* All alignments */
+	for (offset = 0; offset < 16; offset++) {
+		ret = odp_chksum_ones_comp16(&data[offset], len);
+		CU_ASSERT(odp_be_to_cpu_16(ret) == ref_sum(&data[offset], len));
+	}
+}
+
+void chksum_test_ones_comp16_len(void)
+{
+	static uint8_t data[TEST_MAX_LEN + 16];
+	uint32_t num = sizeof(chksum_len_test) / sizeof(chksum_len_test[0]);
+	uint32_t i;
+
+	for (i = 0; i < sizeof(data); i++)
+		data[i] = (uint8_t)(i * 31 + 7);
+
+	for (i = 0; i <= 300; i++)
+		check_len(data, i);
+
+	for (i = 0; i < num; i++)
+		check_len(data, chksum_len_test[i]);
+}
+
+odp_testinfo_t chksum_suite[] = {
+	ODP_TEST_INFO(chksum_test_ones_comp16),
+	ODP_TEST_INFO(chksum_test_ones_comp16_len),
+	ODP_TEST_INFO_NULL,
+};
+
+odp_suiteinfo_t chksum_suites[] = {
+	{"Checksum", NULL, NULL, chksum_suite},
+	ODP_SUITE_INFO_NULL
+};
+
+int chksum_main(int argc, char *argv[])
+{
+	int ret;
+
+	/* parse common options: */
+	if (odp_cunit_parse_options(argc, argv))
+		return -1;
+
+	ret = odp_cunit_register(chksum_suites);
+
+	if (ret == 0)
+		ret = odp_cunit_run();
+
+	return ret;
+}
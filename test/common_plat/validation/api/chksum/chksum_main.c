@@ -0,0 +1,12 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include "chksum.h"
+
+int main(int argc, char *argv[])
+{
+	return chksum_main(argc, argv);
+}
@@ -18,12 +18,27 @@ void crypto_test_enc_alg_aes128_cbc(void);
 void crypto_test_enc_alg_aes128_cbc_ovr_iv(void);
 void crypto_test_dec_alg_aes128_cbc(void);
 void crypto_test_dec_alg_aes128_cbc_ovr_iv(void);
+void crypto_test_enc_alg_aes128_cbc_multi(void);
+void crypto_test_enc_alg_aes256_cbc(void);
+void crypto_test_dec_alg_aes256_cbc_ovr_iv(void);
+void crypto_test_enc_alg_aes128_ctr(void);
+void crypto_test_dec_alg_aes128_ctr_ovr_iv(void);
+void crypto_test_enc_alg_aes256_ctr(void);
+void crypto_test_dec_alg_aes256_ctr_ovr_iv(void);
 void crypto_test_enc_alg_aes128_gcm(void);
 void crypto_test_enc_alg_aes128_gcm_ovr_iv(void);
 void crypto_test_dec_alg_aes128_gcm(void);
 void crypto_test_dec_alg_aes128_gcm_ovr_iv(void);
+void crypto_test_enc_alg_chacha20_poly1305(void);
+void crypto_test_dec_alg_chacha20_poly1305(void);
 void crypto_test_alg_hmac_md5(void);
+void crypto_test_alg_hmac_sha1(void);
 void crypto_test_alg_hmac_sha256(void);
+void crypto_test_alg_hmac_sha384(void);
+void crypto_test_alg_hmac_sha512(void);
+void crypto_test_gen_alg_aes_gmac(void);
+void crypto_test_check_alg_aes_gmac(void);
+void crypto_test_alg_aes128_cbc_hmac_sha256_jumbo(void);
 
 /* test arrays: */
 extern odp_testinfo_t crypto_suite[];
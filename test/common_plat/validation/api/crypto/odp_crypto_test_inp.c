@@ -13,6 +13,10 @@
 
 #define MAX_ALG_CAPA 32
 
+/* Test vectors and operations of multi operation tests */
+#define MAX_MULTI_VEC 8
+#define MAX_MULTI_OPS 16
+
 struct suite_context_s {
 	odp_crypto_op_mode_t pref_mode;
 	odp_pool_t pool;
@@ -73,9 +77,15 @@ static void alg_test(odp_crypto_op_t op,
 		if (cipher_alg == ODP_CIPHER_ALG_AES_CBC &&
 		    !(capability.hw_ciphers.bit.aes_cbc))
 			rc = -1;
+		if (cipher_alg == ODP_CIPHER_ALG_AES_CTR &&
+		    !(capability.hw_ciphers.bit.aes_ctr))
+			rc = -1;
 		if (cipher_alg == ODP_CIPHER_ALG_AES_GCM &&
 		    !(capability.hw_ciphers.bit.aes_gcm))
 			rc = -1;
+		if (cipher_alg == ODP_CIPHER_ALG_CHACHA20_POLY1305 &&
+		    !(capability.hw_ciphers.bit.chacha20_poly1305))
+			rc = -1;
 	} else {
 		if (cipher_alg == ODP_CIPHER_ALG_3DES_CBC &&
 		    !(capability.ciphers.bit.trides_cbc))
@@ -83,9 +93,15 @@ static void alg_test(odp_crypto_op_t op,
 		if (cipher_alg == ODP_CIPHER_ALG_AES_CBC &&
 		    !(capability.ciphers.bit.aes_cbc))
 			rc = -1;
+		if (cipher_alg == ODP_CIPHER_ALG_AES_CTR &&
+		    !(capability.ciphers.bit.aes_ctr))
+			rc = -1;
 		if (cipher_alg == ODP_CIPHER_ALG_AES_GCM &&
 		    !(capability.ciphers.bit.aes_gcm))
 			rc = -1;
+		if (cipher_alg == ODP_CIPHER_ALG_CHACHA20_POLY1305 &&
+		    !(capability.ciphers.bit.chacha20_poly1305))
+			rc = -1;
 	}
 
 	CU_ASSERT(!rc);
@@ -94,6 +110,12 @@ static void alg_test(odp_crypto_op_t op,
 		if (auth_alg == ODP_AUTH_ALG_AES_GCM &&
 		    !(capability.hw_auths.bit.aes_gcm))
 			rc = -1;
+		if (auth_alg == ODP_AUTH_ALG_AES_GMAC &&
+		    !(capability.hw_auths.bit.aes_gmac))
+			rc = -1;
+		if (auth_alg == ODP_AUTH_ALG_CHACHA20_POLY1305 &&
+		    !(capability.hw_auths.bit.chacha20_poly1305))
+			rc = -1;
 		if (auth_alg == ODP_AUTH_ALG_NULL &&
 		    !(capability.hw_auths.bit.null))
 			rc = -1;
@@ -101,6 +123,12 @@ static void alg_test(odp_crypto_op_t op,
 		if (auth_alg == ODP_AUTH_ALG_AES_GCM &&
 		    !(capability.auths.bit.aes_gcm))
 			rc = -1;
+		if (auth_alg == ODP_AUTH_ALG_AES_GMAC &&
+		    !(capability.auths.bit.aes_gmac))
+			rc = -1;
+		if (auth_alg == ODP_AUTH_ALG_CHACHA20_POLY1305 &&
+		    !(capability.auths.bit.chacha20_poly1305))
+			rc = -1;
 		if (auth_alg == ODP_AUTH_ALG_NULL &&
 		    !(capability.auths.bit.null))
 			rc = -1;
@@ -213,6 +241,11 @@ static void alg_test(odp_crypto_op_t op,
 
 	op_params.hash_result_offset = plaintext_len;
 
+	/* Digest to be checked follows the data */
+	if (op == ODP_CRYPTO_OP_DECODE && digest)
+		memcpy(data_addr + op_params.hash_result_offset, digest,
+		       digest_len);
+
 	rc = odp_crypto_operation(&op_params, &posted, &result);
 	if (rc < 0) {
 		CU_FAIL("Failed odp_crypto_operation()");
@@ -487,7 +520,7 @@ void crypto_test_dec_alg_aes128_gcm(void)
 			 &aes128_gcm_cipher_range[i],
 			 &aes128_gcm_auth_range[i],
 			 aes128_gcm_reference_ciphertext[i],
-			 aes128_gcm_reference_length[i] + AES128_GCM_CHECK_LEN,
+			 aes128_gcm_reference_length[i],
 			 aes128_gcm_reference_plaintext[i],
 			 aes128_gcm_reference_length[i],
 			 aes128_gcm_reference_ciphertext[i] +
@@ -524,7 +557,7 @@ void crypto_test_dec_alg_aes128_gcm_ovr_iv(void)
 			 &aes128_gcm_cipher_range[i],
 			 &aes128_gcm_auth_range[i],
 			 aes128_gcm_reference_ciphertext[i],
-			 aes128_gcm_reference_length[i] + AES128_GCM_CHECK_LEN,
+			 aes128_gcm_reference_length[i],
 			 aes128_gcm_reference_plaintext[i],
 			 aes128_gcm_reference_length[i],
 			 aes128_gcm_reference_ciphertext[i] +
@@ -533,6 +566,84 @@ void crypto_test_dec_alg_aes128_gcm_ovr_iv(void)
 	}
 }
 
+/* This test verifies the correctness of encode (plaintext -> ciphertext)
+ * operation for CHACHA20_POLY1305 algorithm. IV for the operation is the
+ * session IV.
+ * */
+void crypto_test_enc_alg_chacha20_poly1305(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv;
+	unsigned int test_vec_num =
+		(sizeof(chacha20_poly1305_reference_length) /
+		 sizeof(chacha20_poly1305_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = chacha20_poly1305_reference_key[i];
+		cipher_key.length = sizeof(chacha20_poly1305_reference_key[i]);
+		iv.data = chacha20_poly1305_reference_iv[i];
+		iv.length = sizeof(chacha20_poly1305_reference_iv[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_CHACHA20_POLY1305,
+			 iv,
+			 NULL,
+			 cipher_key,
+			 ODP_AUTH_ALG_CHACHA20_POLY1305,
+			 auth_key,
+			 &chacha20_poly1305_cipher_range[i],
+			 &chacha20_poly1305_auth_range[i],
+			 chacha20_poly1305_reference_plaintext[i],
+			 chacha20_poly1305_reference_length[i],
+			 chacha20_poly1305_reference_ciphertext[i],
+			 chacha20_poly1305_reference_length[i],
+			 chacha20_poly1305_reference_ciphertext[i] +
+			 chacha20_poly1305_reference_length[i],
+			 CHACHA20_POLY1305_CHECK_LEN);
+	}
+}
+
+/* This test verifies the correctness of decode (ciphertext -> plaintext)
+ * operation for CHACHA20_POLY1305 algorithm. IV for the operation is the
+ * session IV.
+ * */
+void crypto_test_dec_alg_chacha20_poly1305(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv;
+	unsigned int test_vec_num =
+		(sizeof(chacha20_poly1305_reference_length) /
+		 sizeof(chacha20_poly1305_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = chacha20_poly1305_reference_key[i];
+		cipher_key.length = sizeof(chacha20_poly1305_reference_key[i]);
+		iv.data = chacha20_poly1305_reference_iv[i];
+		iv.length = sizeof(chacha20_poly1305_reference_iv[i]);
+
+		alg_test(ODP_CRYPTO_OP_DECODE,
+			 ODP_CIPHER_ALG_CHACHA20_POLY1305,
+			 iv,
+			 NULL,
+			 cipher_key,
+			 ODP_AUTH_ALG_CHACHA20_POLY1305,
+			 auth_key,
+			 &chacha20_poly1305_cipher_range[i],
+			 &chacha20_poly1305_auth_range[i],
+			 chacha20_poly1305_reference_ciphertext[i],
+			 chacha20_poly1305_reference_length[i],
+			 chacha20_poly1305_reference_plaintext[i],
+			 chacha20_poly1305_reference_length[i],
+			 chacha20_poly1305_reference_ciphertext[i] +
+			 chacha20_poly1305_reference_length[i],
+			 CHACHA20_POLY1305_CHECK_LEN);
+	}
+}
+
 /* This test verifies the correctness of encode (plaintext -> ciphertext)
  * operation for AES128_CBC algorithm. IV for the operation is the session IV.
  * In addition the test verifies if the implementation can use the
@@ -666,6 +777,319 @@ void crypto_test_dec_alg_aes128_cbc_ovr_iv(void)
 	}
 }
 
+/* This test verifies the correctness of encode (plaintext -> ciphertext)
+ * operations for AES128_CBC algorithm, when the operations are issued with
+ * a single odp_crypto_operation_multi() call. Operations of all test vectors
+ * (each with its own session) are interleaved, and repeated several times.
+ * */
+void crypto_test_enc_alg_aes128_cbc_multi(void)
+{
+	odp_crypto_session_param_t ses_params;
+	odp_crypto_ses_create_err_t status;
+	odp_crypto_session_t session[MAX_MULTI_VEC];
+	odp_crypto_op_param_t op_params[MAX_MULTI_OPS];
+	odp_crypto_op_result_t result[MAX_MULTI_OPS];
+	odp_bool_t posted[MAX_MULTI_OPS];
+	odp_crypto_op_result_t compl_result;
+	odp_crypto_compl_t compl_event;
+	odp_event_t event;
+	uint8_t *data_addr;
+	unsigned int test_vec_num = (sizeof(aes128_cbc_reference_length) /
+				     sizeof(aes128_cbc_reference_length[0]));
+	int num_ops = MAX_MULTI_OPS;
+	int num_compl = 0;
+	int i, v, rc;
+
+	CU_ASSERT_FATAL(test_vec_num <= MAX_MULTI_VEC);
+
+	for (v = 0; v < (int)test_vec_num; v++) {
+		odp_crypto_session_param_init(&ses_params);
+		ses_params.op = ODP_CRYPTO_OP_ENCODE;
+		ses_params.pref_mode = suite_context.pref_mode;
+		ses_params.cipher_alg = ODP_CIPHER_ALG_AES_CBC;
+		ses_params.auth_alg = ODP_AUTH_ALG_NULL;
+		ses_params.compl_queue = suite_context.queue;
+		ses_params.output_pool = suite_context.pool;
+		ses_params.cipher_key.data = aes128_cbc_reference_key[v];
+		ses_params.cipher_key.length =
+			sizeof(aes128_cbc_reference_key[v]);
+		ses_params.iv.data = aes128_cbc_reference_iv[v];
+		ses_params.iv.length = sizeof(aes128_cbc_reference_iv[v]);
+
+		rc = odp_crypto_session_create(&ses_params, &session[v],
+					       &status);
+		CU_ASSERT_FATAL(!rc);
+		CU_ASSERT(status == ODP_CRYPTO_SES_CREATE_ERR_NONE);
+	}
+
+	memset(op_params, 0, sizeof(op_params));
+
+	for (i = 0; i < num_ops; i++) {
+		v = i % test_vec_num;
+
+		op_params[i].session = session[v];
+		op_params[i].ctx = (void *)(uintptr_t)i;
+		op_params[i].pkt = odp_packet_alloc(suite_context.pool,
+				aes128_cbc_reference_length[v]);
+		CU_ASSERT_FATAL(op_params[i].pkt != ODP_PACKET_INVALID);
+		op_params[i].out_pkt = op_params[i].pkt;
+		op_params[i].cipher_range.length =
+			aes128_cbc_reference_length[v];
+		op_params[i].hash_result_offset =
+			aes128_cbc_reference_length[v];
+
+		memcpy(odp_packet_data(op_params[i].pkt),
+		       aes128_cbc_reference_plaintext[v],
+		       aes128_cbc_reference_length[v]);
+	}
+
+	rc = odp_crypto_operation_multi(op_params, posted, result, num_ops);
+	CU_ASSERT(rc == num_ops);
+
+	if (rc < 0)
+		num_ops = 0;
+	else
+		num_ops = rc;
+
+	for (i = 0; i < num_ops; i++) {
+		if (posted[i]) {
+			num_compl++;
+			continue;
+		}
+
+		v = i % test_vec_num;
+		CU_ASSERT(result[i].ok);
+		CU_ASSERT(result[i].pkt == op_params[i].pkt);
+		CU_ASSERT(result[i].ctx == (void *)(uintptr_t)i);
+
+		data_addr = odp_packet_data(result[i].pkt);
+		CU_ASSERT(!memcmp(data_addr, aes128_cbc_reference_ciphertext[v],
+				  aes128_cbc_reference_length[v]));
+		odp_packet_free(result[i].pkt);
+	}
+
+	/* Completion events of a session arrive in operation order */
+	while (num_compl) {
+		event = odp_queue_deq(suite_context.queue);
+		if (event == ODP_EVENT_INVALID)
+			continue;
+
+		compl_event = odp_crypto_compl_from_event(event);
+		odp_crypto_compl_result(compl_event, &compl_result);
+		odp_crypto_compl_free(compl_event);
+
+		i = (uintptr_t)compl_result.ctx;
+		CU_ASSERT_FATAL(i >= 0 && i < num_ops);
+		v = i % test_vec_num;
+		CU_ASSERT(compl_result.ok);
+		CU_ASSERT(compl_result.pkt == op_params[i].pkt);
+
+		data_addr = odp_packet_data(compl_result.pkt);
+		CU_ASSERT(!memcmp(data_addr, aes128_cbc_reference_ciphertext[v],
+				  aes128_cbc_reference_length[v]));
+		odp_packet_free(compl_result.pkt);
+		num_compl--;
+	}
+
+	for (i = num_ops; i < MAX_MULTI_OPS; i++)
+		odp_packet_free(op_params[i].pkt);
+
+	for (v = 0; v < (int)test_vec_num; v++)
+		CU_ASSERT(!odp_crypto_session_destroy(session[v]));
+}
+
+/* This test verifies the correctness of encode (plaintext -> ciphertext)
+ * operation for AES256_CBC algorithm. IV for the operation is the session IV.
+ * */
+void crypto_test_enc_alg_aes256_cbc(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv;
+	unsigned int test_vec_num = (sizeof(aes256_cbc_reference_length) /
+				     sizeof(aes256_cbc_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = aes256_cbc_reference_key[i];
+		cipher_key.length = sizeof(aes256_cbc_reference_key[i]);
+		iv.data = aes256_cbc_reference_iv[i];
+		iv.length = sizeof(aes256_cbc_reference_iv[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_AES_CBC,
+			 iv,
+			 NULL,
+			 cipher_key,
+			 ODP_AUTH_ALG_NULL,
+			 auth_key,
+			 NULL, NULL,
+			 aes256_cbc_reference_plaintext[i],
+			 aes256_cbc_reference_length[i],
+			 aes256_cbc_reference_ciphertext[i],
+			 aes256_cbc_reference_length[i], NULL, 0);
+	}
+}
+
+/* This test verifies the correctness of decode (ciphertext -> plaintext)
+ * operation for AES256_CBC algorithm. IV for the operation is the operation IV.
+ * */
+void crypto_test_dec_alg_aes256_cbc_ovr_iv(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv = { .data = NULL, .length = AES256_CBC_IV_LEN };
+	unsigned int test_vec_num = (sizeof(aes256_cbc_reference_length) /
+				     sizeof(aes256_cbc_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = aes256_cbc_reference_key[i];
+		cipher_key.length = sizeof(aes256_cbc_reference_key[i]);
+
+		alg_test(ODP_CRYPTO_OP_DECODE,
+			 ODP_CIPHER_ALG_AES_CBC,
+			 iv,
+			 aes256_cbc_reference_iv[i],
+			 cipher_key,
+			 ODP_AUTH_ALG_NULL,
+			 auth_key,
+			 NULL, NULL,
+			 aes256_cbc_reference_ciphertext[i],
+			 aes256_cbc_reference_length[i],
+			 aes256_cbc_reference_plaintext[i],
+			 aes256_cbc_reference_length[i], NULL, 0);
+	}
+}
+
+/* This test verifies the correctness of encode (plaintext -> ciphertext)
+ * operation for AES128_CTR algorithm. IV for the operation is the session IV.
+ * */
+void crypto_test_enc_alg_aes128_ctr(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv;
+	unsigned int test_vec_num = (sizeof(aes128_ctr_reference_length) /
+				     sizeof(aes128_ctr_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = aes128_ctr_reference_key[i];
+		cipher_key.length = sizeof(aes128_ctr_reference_key[i]);
+		iv.data = aes128_ctr_reference_iv[i];
+		iv.length = sizeof(aes128_ctr_reference_iv[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_AES_CTR,
+			 iv,
+			 NULL,
+			 cipher_key,
+			 ODP_AUTH_ALG_NULL,
+			 auth_key,
+			 NULL, NULL,
+			 aes128_ctr_reference_plaintext[i],
+			 aes128_ctr_reference_length[i],
+			 aes128_ctr_reference_ciphertext[i],
+			 aes128_ctr_reference_length[i], NULL, 0);
+	}
+}
+
+/* This test verifies the correctness of decode (ciphertext -> plaintext)
+ * operation for AES128_CTR algorithm. IV for the operation is the operation IV.
+ * */
+void crypto_test_dec_alg_aes128_ctr_ovr_iv(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv = { .data = NULL, .length = AES128_CTR_IV_LEN };
+	unsigned int test_vec_num = (sizeof(aes128_ctr_reference_length) /
+				     sizeof(aes128_ctr_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = aes128_ctr_reference_key[i];
+		cipher_key.length = sizeof(aes128_ctr_reference_key[i]);
+
+		alg_test(ODP_CRYPTO_OP_DECODE,
+			 ODP_CIPHER_ALG_AES_CTR,
+			 iv,
+			 aes128_ctr_reference_iv[i],
+			 cipher_key,
+			 ODP_AUTH_ALG_NULL,
+			 auth_key,
+			 NULL, NULL,
+			 aes128_ctr_reference_ciphertext[i],
+			 aes128_ctr_reference_length[i],
+			 aes128_ctr_reference_plaintext[i],
+			 aes128_ctr_reference_length[i], NULL, 0);
+	}
+}
+
+/* This test verifies the correctness of encode (plaintext -> ciphertext)
+ * operation for AES256_CTR algorithm. IV for the operation is the session IV.
+ * */
+void crypto_test_enc_alg_aes256_ctr(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv;
+	unsigned int test_vec_num = (sizeof(aes256_ctr_reference_length) /
+				     sizeof(aes256_ctr_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = aes256_ctr_reference_key[i];
+		cipher_key.length = sizeof(aes256_ctr_reference_key[i]);
+		iv.data = aes256_ctr_reference_iv[i];
+		iv.length = sizeof(aes256_ctr_reference_iv[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_AES_CTR,
+			 iv,
+			 NULL,
+			 cipher_key,
+			 ODP_AUTH_ALG_NULL,
+			 auth_key,
+			 NULL, NULL,
+			 aes256_ctr_reference_plaintext[i],
+			 aes256_ctr_reference_length[i],
+			 aes256_ctr_reference_ciphertext[i],
+			 aes256_ctr_reference_length[i], NULL, 0);
+	}
+}
+
+/* This test verifies the correctness of decode (ciphertext -> plaintext)
+ * operation for AES256_CTR algorithm. IV for the operation is the operation IV.
+ * */
+void crypto_test_dec_alg_aes256_ctr_ovr_iv(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv = { .data = NULL, .length = AES256_CTR_IV_LEN };
+	unsigned int test_vec_num = (sizeof(aes256_ctr_reference_length) /
+				     sizeof(aes256_ctr_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		cipher_key.data = aes256_ctr_reference_key[i];
+		cipher_key.length = sizeof(aes256_ctr_reference_key[i]);
+
+		alg_test(ODP_CRYPTO_OP_DECODE,
+			 ODP_CIPHER_ALG_AES_CTR,
+			 iv,
+			 aes256_ctr_reference_iv[i],
+			 cipher_key,
+			 ODP_AUTH_ALG_NULL,
+			 auth_key,
+			 NULL, NULL,
+			 aes256_ctr_reference_ciphertext[i],
+			 aes256_ctr_reference_length[i],
+			 aes256_ctr_reference_plaintext[i],
+			 aes256_ctr_reference_length[i], NULL, 0);
+	}
+}
+
 /* This test verifies the correctness of HMAC_MD5 digest operation.
  * The output check length is truncated to 12 bytes (96 bits) as
  * returned by the crypto operation API call.
@@ -741,6 +1165,290 @@ void crypto_test_alg_hmac_sha256(void)
 	}
 }
 
+/* This test verifies the correctness of HMAC_SHA1 digest operation.
+ * The output check length is truncated to 12 bytes (96 bits) as
+ * returned by the crypto operation API call.
+ * Note that hash digest is a one-way operation.
+ * */
+void crypto_test_alg_hmac_sha1(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv = { .data = NULL, .length = 0 };
+
+	unsigned int test_vec_num = (sizeof(hmac_sha1_reference_length) /
+				     sizeof(hmac_sha1_reference_length[0]));
+
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		auth_key.data = hmac_sha1_reference_key[i];
+		auth_key.length = sizeof(hmac_sha1_reference_key[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_NULL,
+			 iv,
+			 iv.data,
+			 cipher_key,
+			 ODP_AUTH_ALG_SHA1_HMAC,
+			 auth_key,
+			 NULL, NULL,
+			 hmac_sha1_reference_plaintext[i],
+			 hmac_sha1_reference_length[i],
+			 NULL, 0,
+			 hmac_sha1_reference_digest[i],
+			 HMAC_SHA1_96_CHECK_LEN);
+	}
+}
+
+/* This test verifies the correctness of HMAC_SHA384 digest operation.
+ * The output check length is truncated to 24 bytes (192 bits) as
+ * returned by the crypto operation API call.
+ * Note that hash digest is a one-way operation.
+ * */
+void crypto_test_alg_hmac_sha384(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv = { .data = NULL, .length = 0 };
+
+	unsigned int test_vec_num = (sizeof(hmac_sha384_reference_length) /
+				     sizeof(hmac_sha384_reference_length[0]));
+
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		auth_key.data = hmac_sha384_reference_key[i];
+		auth_key.length = sizeof(hmac_sha384_reference_key[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_NULL,
+			 iv,
+			 iv.data,
+			 cipher_key,
+			 ODP_AUTH_ALG_SHA384_HMAC,
+			 auth_key,
+			 NULL, NULL,
+			 hmac_sha384_reference_plaintext[i],
+			 hmac_sha384_reference_length[i],
+			 NULL, 0,
+			 hmac_sha384_reference_digest[i],
+			 HMAC_SHA384_192_CHECK_LEN);
+	}
+}
+
+/* This test verifies the correctness of HMAC_SHA512 digest operation.
+ * The output check length is truncated to 32 bytes (256 bits) as
+ * returned by the crypto operation API call.
+ * Note that hash digest is a one-way operation.
+ * */
+void crypto_test_alg_hmac_sha512(void)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv = { .data = NULL, .length = 0 };
+
+	unsigned int test_vec_num = (sizeof(hmac_sha512_reference_length) /
+				     sizeof(hmac_sha512_reference_length[0]));
+
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		auth_key.data = hmac_sha512_reference_key[i];
+		auth_key.length = sizeof(hmac_sha512_reference_key[i]);
+
+		alg_test(ODP_CRYPTO_OP_ENCODE,
+			 ODP_CIPHER_ALG_NULL,
+			 iv,
+			 iv.data,
+			 cipher_key,
+			 ODP_AUTH_ALG_SHA512_HMAC,
+			 auth_key,
+			 NULL, NULL,
+			 hmac_sha512_reference_plaintext[i],
+			 hmac_sha512_reference_length[i],
+			 NULL, 0,
+			 hmac_sha512_reference_digest[i],
+			 HMAC_SHA512_256_CHECK_LEN);
+	}
+}
+
+/* AES_GMAC digest generation (op ODP_CRYPTO_OP_ENCODE) and check (op
+ * ODP_CRYPTO_OP_DECODE) of all test vectors */
+static void aes_gmac_test(odp_crypto_op_t op)
+{
+	odp_crypto_key_t cipher_key = { .data = NULL, .length = 0 },
+			 auth_key   = { .data = NULL, .length = 0 };
+	odp_crypto_iv_t iv;
+	unsigned int test_vec_num = (sizeof(aes_gmac_reference_length) /
+				     sizeof(aes_gmac_reference_length[0]));
+	unsigned int i;
+
+	for (i = 0; i < test_vec_num; i++) {
+		auth_key.data = aes_gmac_reference_key[i];
+		auth_key.length = aes_gmac_reference_key_len[i];
+		iv.data = aes_gmac_reference_iv[i];
+		iv.length = sizeof(aes_gmac_reference_iv[i]);
+
+		alg_test(op,
+			 ODP_CIPHER_ALG_NULL,
+			 iv,
+			 NULL,
+			 cipher_key,
+			 ODP_AUTH_ALG_AES_GMAC,
+			 auth_key,
+			 NULL, NULL,
+			 aes_gmac_reference_plaintext[i],
+			 aes_gmac_reference_length[i],
+			 NULL, 0,
+			 aes_gmac_reference_digest[i],
+			 AES_GMAC_CHECK_LEN);
+	}
+}
+
+/* This test verifies the correctness of AES_GMAC digest generation with
+ * 128 and 256 bit keys. IV for the operation is the session IV.
+ * */
+void crypto_test_gen_alg_aes_gmac(void)
+{
+	aes_gmac_test(ODP_CRYPTO_OP_ENCODE);
+}
+
+/* This test verifies the correctness of AES_GMAC digest check.
+ * */
+void crypto_test_check_alg_aes_gmac(void)
+{
+	aes_gmac_test(ODP_CRYPTO_OP_DECODE);
+}
+
+/* Run an operation and wait for its result */
+static int crypto_op_wait(odp_crypto_op_param_t *op_params,
+			  odp_crypto_op_result_t *result)
+{
+	odp_crypto_compl_t compl_event;
+	odp_event_t event;
+	odp_bool_t posted;
+
+	if (odp_crypto_operation(op_params, &posted, result) < 0)
+		return -1;
+
+	if (posted) {
+		/* Poll completion queue for results */
+		do {
+			event = odp_queue_deq(suite_context.queue);
+		} while (event == ODP_EVENT_INVALID);
+
+		compl_event = odp_crypto_compl_from_event(event);
+		odp_crypto_compl_result(compl_event, result);
+		odp_crypto_compl_free(compl_event);
+	}
+
+	return 0;
+}
+
+/* This test verifies encode and decode operations on a jumbo packet, which
+ * is longer than the maximum segment length of many implementations. Cipher
+ * blocks may straddle segment boundaries. The packet is encrypted with
+ * AES128_CBC and authenticated with HMAC_SHA256, then decoded back to the
+ * plaintext.
+ * */
+void crypto_test_alg_aes128_cbc_hmac_sha256_jumbo(void)
+{
+	odp_crypto_session_param_t ses_params;
+	odp_crypto_ses_create_err_t status;
+	odp_crypto_session_t enc_session, dec_session;
+	odp_crypto_op_param_t op_params;
+	odp_crypto_op_result_t result;
+	odp_pool_capability_t pool_capa;
+	static uint8_t plaintext[JUMBO_DATA_LEN];
+	static uint8_t data[JUMBO_DATA_LEN];
+	uint8_t digest[HMAC_SHA256_128_CHECK_LEN];
+	uint32_t len = JUMBO_DATA_LEN;
+	odp_packet_t pkt;
+	uint32_t i;
+	int rc;
+
+	CU_ASSERT_FATAL(!odp_pool_capability(&pool_capa));
+
+	if (pool_capa.pkt.max_len &&
+	    pool_capa.pkt.max_len < len + sizeof(digest))
+		return;
+
+	for (i = 0; i < len; i++)
+		plaintext[i] = i * 7 + (i >> 8);
+
+	odp_crypto_session_param_init(&ses_params);
+	ses_params.op = ODP_CRYPTO_OP_ENCODE;
+	ses_params.auth_cipher_text = true;
+	ses_params.pref_mode = suite_context.pref_mode;
+	ses_params.cipher_alg = ODP_CIPHER_ALG_AES_CBC;
+	ses_params.auth_alg = ODP_AUTH_ALG_SHA256_HMAC;
+	ses_params.compl_queue = suite_context.queue;
+	ses_params.output_pool = suite_context.pool;
+	ses_params.cipher_key.data = aes128_cbc_reference_key[0];
+	ses_params.cipher_key.length = sizeof(aes128_cbc_reference_key[0]);
+	ses_params.iv.data = aes128_cbc_reference_iv[0];
+	ses_params.iv.length = sizeof(aes128_cbc_reference_iv[0]);
+	ses_params.auth_key.data = hmac_sha256_reference_key[0];
+	ses_params.auth_key.length = sizeof(hmac_sha256_reference_key[0]);
+
+	rc = odp_crypto_session_create(&ses_params, &enc_session, &status);
+	CU_ASSERT_FATAL(!rc);
+	CU_ASSERT(status == ODP_CRYPTO_SES_CREATE_ERR_NONE);
+
+	ses_params.op = ODP_CRYPTO_OP_DECODE;
+	rc = odp_crypto_session_create(&ses_params, &dec_session, &status);
+	CU_ASSERT_FATAL(!rc);
+	CU_ASSERT(status == ODP_CRYPTO_SES_CREATE_ERR_NONE);
+
+	pkt = odp_packet_alloc(suite_context.pool, len + sizeof(digest));
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(!odp_packet_copy_from_mem(pkt, 0, len, plaintext));
+
+	memset(&op_params, 0, sizeof(op_params));
+	op_params.session = enc_session;
+	op_params.pkt = pkt;
+	op_params.out_pkt = pkt;
+	op_params.cipher_range.length = len;
+	op_params.auth_range.length = len;
+	op_params.hash_result_offset = len;
+
+	rc = crypto_op_wait(&op_params, &result);
+	CU_ASSERT(!rc);
+
+	if (!rc) {
+		CU_ASSERT(result.ok);
+		CU_ASSERT(result.pkt == pkt);
+
+		odp_packet_copy_to_mem(pkt, 0, len, data);
+		odp_packet_copy_to_mem(pkt, len, sizeof(digest), digest);
+
+		/* Last CBC block depends on all preceding data */
+		CU_ASSERT(!memcmp(&data[len - AES128_CBC_IV_LEN],
+				  jumbo_reference_last_block,
+				  AES128_CBC_IV_LEN));
+		CU_ASSERT(!memcmp(digest, jumbo_reference_digest,
+				  sizeof(digest)));
+
+		op_params.session = dec_session;
+		rc = crypto_op_wait(&op_params, &result);
+		CU_ASSERT(!rc);
+	}
+
+	if (!rc) {
+		CU_ASSERT(result.ok);
+		CU_ASSERT(result.pkt == pkt);
+
+		odp_packet_copy_to_mem(pkt, 0, len, data);
+		CU_ASSERT(!memcmp(data, plaintext, len));
+	}
+
+	odp_packet_free(pkt);
+
+	CU_ASSERT(!odp_crypto_session_destroy(enc_session));
+	CU_ASSERT(!odp_crypto_session_destroy(dec_session));
+}
+
 int crypto_suite_sync_init(void)
 {
 	suite_context.pool = odp_pool_lookup("packet_pool");
@@ -774,11 +1482,26 @@ odp_testinfo_t crypto_suite[] = {
 	ODP_TEST_INFO(crypto_test_dec_alg_aes128_cbc),
 	ODP_TEST_INFO(crypto_test_enc_alg_aes128_cbc_ovr_iv),
 	ODP_TEST_INFO(crypto_test_dec_alg_aes128_cbc_ovr_iv),
+	ODP_TEST_INFO(crypto_test_enc_alg_aes128_cbc_multi),
+	ODP_TEST_INFO(crypto_test_enc_alg_aes256_cbc),
+	ODP_TEST_INFO(crypto_test_dec_alg_aes256_cbc_ovr_iv),
+	ODP_TEST_INFO(crypto_test_enc_alg_aes128_ctr),
+	ODP_TEST_INFO(crypto_test_dec_alg_aes128_ctr_ovr_iv),
+	ODP_TEST_INFO(crypto_test_enc_alg_aes256_ctr),
+	ODP_TEST_INFO(crypto_test_dec_alg_aes256_ctr_ovr_iv),
 	ODP_TEST_INFO(crypto_test_enc_alg_aes128_gcm),
 	ODP_TEST_INFO(crypto_test_enc_alg_aes128_gcm_ovr_iv),
 	ODP_TEST_INFO(crypto_test_dec_alg_aes128_gcm),
 	ODP_TEST_INFO(crypto_test_dec_alg_aes128_gcm_ovr_iv),
+	ODP_TEST_INFO(crypto_test_enc_alg_chacha20_poly1305),
+	ODP_TEST_INFO(crypto_test_dec_alg_chacha20_poly1305),
 	ODP_TEST_INFO(crypto_test_alg_hmac_md5),
+	ODP_TEST_INFO(crypto_test_alg_hmac_sha1),
 	ODP_TEST_INFO(crypto_test_alg_hmac_sha256),
+	ODP_TEST_INFO(crypto_test_alg_hmac_sha384),
+	ODP_TEST_INFO(crypto_test_alg_hmac_sha512),
+	ODP_TEST_INFO(crypto_test_gen_alg_aes_gmac),
+	ODP_TEST_INFO(crypto_test_check_alg_aes_gmac),
+	ODP_TEST_INFO(crypto_test_alg_aes128_cbc_hmac_sha256_jumbo),
 	ODP_TEST_INFO_NULL,
 };
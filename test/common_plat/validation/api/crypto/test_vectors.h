@@ -112,6 +112,161 @@ aes128_cbc_reference_ciphertext[][AES128_CBC_MAX_DATA_LEN] = {
 	  0x49, 0xa5, 0x3e, 0x87, 0xf4, 0xc3, 0xda, 0x55 }
 };
 
+/* AES256-CBC test vectors from NIST SP 800-38A, F.2.5 */
+static uint8_t aes256_cbc_reference_key[][AES256_CBC_KEY_LEN] = {
+	{ 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+	  0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+	  0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+	  0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 },
+	{ 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+	  0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+	  0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+	  0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 }
+};
+
+static uint8_t aes256_cbc_reference_iv[][AES256_CBC_IV_LEN] = {
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f }
+};
+
+/** length in bytes */
+static uint32_t aes256_cbc_reference_length[] = { 16, 64 };
+
+static uint8_t
+aes256_cbc_reference_plaintext[][AES256_CBC_MAX_DATA_LEN] = {
+	{ 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+	  0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a },
+	{ 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+	  0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	  0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+	  0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	  0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+	  0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	  0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+	  0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 }
+};
+
+static uint8_t
+aes256_cbc_reference_ciphertext[][AES256_CBC_MAX_DATA_LEN] = {
+	{ 0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba,
+	  0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6 },
+	{ 0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba,
+	  0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+	  0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d,
+	  0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+	  0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf,
+	  0xa5, 0x30, 0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+	  0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9, 0xfc,
+	  0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b }
+};
+
+/* AES128-CTR test vectors from RFC 3686 (test vectors #2 and #3) and
+ * NIST SP 800-38A, F.5.1 */
+static uint8_t aes128_ctr_reference_key[][AES128_CTR_KEY_LEN] = {
+	{ 0x7e, 0x24, 0x06, 0x78, 0x17, 0xfa, 0xe0, 0xd7,
+	  0x43, 0xd6, 0xce, 0x1f, 0x32, 0x53, 0x91, 0x63 },
+	{ 0x76, 0x91, 0xbe, 0x03, 0x5e, 0x50, 0x20, 0xa8,
+	  0xac, 0x6e, 0x61, 0x85, 0x29, 0xf9, 0xa0, 0xdc },
+	{ 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+	  0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c }
+};
+
+static uint8_t aes128_ctr_reference_iv[][AES128_CTR_IV_LEN] = {
+	{ 0x00, 0x6c, 0xb6, 0xdb, 0xc0, 0x54, 0x3b, 0x59,
+	  0xda, 0x48, 0xd9, 0x0b, 0x00, 0x00, 0x00, 0x01 },
+	{ 0x00, 0xe0, 0x01, 0x7b, 0x27, 0x77, 0x7f, 0x3f,
+	  0x4a, 0x17, 0x86, 0xf0, 0x00, 0x00, 0x00, 0x01 },
+	{ 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+	  0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff }
+};
+
+/** length in bytes */
+static uint32_t aes128_ctr_reference_length[] = { 32, 36, 64 };
+
+static uint8_t
+aes128_ctr_reference_plaintext[][AES128_CTR_MAX_DATA_LEN] = {
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	  0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f },
+	{ 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	  0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	  0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	  0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+	  0x20, 0x21, 0x22, 0x23 },
+	{ 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+	  0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	  0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+	  0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	  0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+	  0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	  0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+	  0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 }
+};
+
+static uint8_t
+aes128_ctr_reference_ciphertext[][AES128_CTR_MAX_DATA_LEN] = {
+	{ 0x51, 0x04, 0xa1, 0x06, 0x16, 0x8a, 0x72, 0xd9,
+	  0x79, 0x0d, 0x41, 0xee, 0x8e, 0xda, 0xd3, 0x88,
+	  0xeb, 0x2e, 0x1e, 0xfc, 0x46, 0xda, 0x57, 0xc8,
+	  0xfc, 0xe6, 0x30, 0xdf, 0x91, 0x41, 0xbe, 0x28 },
+	{ 0xc1, 0xcf, 0x48, 0xa8, 0x9f, 0x2f, 0xfd, 0xd9,
+	  0xcf, 0x46, 0x52, 0xe9, 0xef, 0xdb, 0x72, 0xd7,
+	  0x45, 0x40, 0xa4, 0x2b, 0xde, 0x6d, 0x78, 0x36,
+	  0xd5, 0x9a, 0x5c, 0xea, 0xae, 0xf3, 0x10, 0x53,
+	  0x25, 0xb2, 0x07, 0x2f },
+	{ 0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26,
+	  0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+	  0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff,
+	  0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+	  0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e,
+	  0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+	  0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1,
+	  0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee }
+};
+
+/* AES256-CTR test vector from NIST SP 800-38A, F.5.5 */
+static uint8_t aes256_ctr_reference_key[][AES256_CTR_KEY_LEN] = {
+	{ 0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe,
+	  0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+	  0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7,
+	  0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 }
+};
+
+static uint8_t aes256_ctr_reference_iv[][AES256_CTR_IV_LEN] = {
+	{ 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+	  0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff }
+};
+
+/** length in bytes */
+static uint32_t aes256_ctr_reference_length[] = { 64 };
+
+static uint8_t
+aes256_ctr_reference_plaintext[][AES256_CTR_MAX_DATA_LEN] = {
+	{ 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+	  0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	  0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c,
+	  0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	  0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11,
+	  0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	  0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17,
+	  0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 }
+};
+
+static uint8_t
+aes256_ctr_reference_ciphertext[][AES256_CTR_MAX_DATA_LEN] = {
+	{ 0x60, 0x1e, 0xc3, 0x13, 0x77, 0x57, 0x89, 0xa5,
+	  0xb7, 0xa7, 0xf5, 0x04, 0xbb, 0xf3, 0xd2, 0x28,
+	  0xf4, 0x43, 0xe3, 0xca, 0x4d, 0x62, 0xb5, 0x9a,
+	  0xca, 0x84, 0xe9, 0x90, 0xca, 0xca, 0xf5, 0xc5,
+	  0x2b, 0x09, 0x30, 0xda, 0xa2, 0x3d, 0xe9, 0x4c,
+	  0xe8, 0x70, 0x17, 0xba, 0x2d, 0x84, 0x98, 0x8d,
+	  0xdf, 0xc9, 0xc5, 0x8d, 0xb6, 0x7a, 0xad, 0xa6,
+	  0x13, 0xc2, 0xdd, 0x08, 0x45, 0x79, 0x41, 0xa6 }
+};
+
 /* AES-GCM test vectors extracted from
  * https://tools.ietf.org/html/draft-mcgrew-gcm-test-01#section-2
  */
@@ -264,6 +419,129 @@ aes128_gcm_reference_ciphertext[][AES128_GCM_MAX_DATA_LEN] = {
 	  0x95, 0xf1, 0x12, 0xe4, 0xe7, 0xd0, 0x5d, 0x35 }
 };
 
+/* RFC 7539 section 2.8.2 */
+static uint8_t chacha20_poly1305_reference_key[][CHACHA20_POLY1305_KEY_LEN] = {
+	{ 0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+	  0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f,
+	  0x90, 0x91, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97,
+	  0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f }
+};
+
+static uint8_t chacha20_poly1305_reference_iv[][CHACHA20_POLY1305_IV_LEN] = {
+	{ 0x07, 0x00, 0x00, 0x00, 0x40, 0x41, 0x42, 0x43,
+	  0x44, 0x45, 0x46, 0x47 }
+};
+
+static uint32_t chacha20_poly1305_reference_length[] = { 126 };
+
+static odp_crypto_data_range_t chacha20_poly1305_cipher_range[] = {
+	{ .offset = 12, .length = 114 },
+};
+
+static odp_crypto_data_range_t chacha20_poly1305_auth_range[] = {
+	{ .offset = 0, .length = 126 },
+};
+
+static uint8_t
+chacha20_poly1305_reference_plaintext[][CHACHA20_POLY1305_MAX_DATA_LEN] = {
+	{ /* Aad */
+	  0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3,
+	  0xc4, 0xc5, 0xc6, 0xc7,
+	  /* Plain */
+	  0x4c, 0x61, 0x64, 0x69, 0x65, 0x73, 0x20, 0x61,
+	  0x6e, 0x64, 0x20, 0x47, 0x65, 0x6e, 0x74, 0x6c,
+	  0x65, 0x6d, 0x65, 0x6e, 0x20, 0x6f, 0x66, 0x20,
+	  0x74, 0x68, 0x65, 0x20, 0x63, 0x6c, 0x61, 0x73,
+	  0x73, 0x20, 0x6f, 0x66, 0x20, 0x27, 0x39, 0x39,
+	  0x3a, 0x20, 0x49, 0x66, 0x20, 0x49, 0x20, 0x63,
+	  0x6f, 0x75, 0x6c, 0x64, 0x20, 0x6f, 0x66, 0x66,
+	  0x65, 0x72, 0x20, 0x79, 0x6f, 0x75, 0x20, 0x6f,
+	  0x6e, 0x6c, 0x79, 0x20, 0x6f, 0x6e, 0x65, 0x20,
+	  0x74, 0x69, 0x70, 0x20, 0x66, 0x6f, 0x72, 0x20,
+	  0x74, 0x68, 0x65, 0x20, 0x66, 0x75, 0x74, 0x75,
+	  0x72, 0x65, 0x2c, 0x20, 0x73, 0x75, 0x6e, 0x73,
+	  0x63, 0x72, 0x65, 0x65, 0x6e, 0x20, 0x77, 0x6f,
+	  0x75, 0x6c, 0x64, 0x20, 0x62, 0x65, 0x20, 0x69,
+	  0x74, 0x2e }
+};
+
+static uint8_t
+chacha20_poly1305_reference_ciphertext[][CHACHA20_POLY1305_MAX_DATA_LEN] = {
+	{ /* Aad */
+	  0x50, 0x51, 0x52, 0x53, 0xc0, 0xc1, 0xc2, 0xc3,
+	  0xc4, 0xc5, 0xc6, 0xc7,
+	  /* Cipher */
+	  0xd3, 0x1a, 0x8d, 0x34, 0x64, 0x8e, 0x60, 0xdb,
+	  0x7b, 0x86, 0xaf, 0xbc, 0x53, 0xef, 0x7e, 0xc2,
+	  0xa4, 0xad, 0xed, 0x51, 0x29, 0x6e, 0x08, 0xfe,
+	  0xa9, 0xe2, 0xb5, 0xa7, 0x36, 0xee, 0x62, 0xd6,
+	  0x3d, 0xbe, 0xa4, 0x5e, 0x8c, 0xa9, 0x67, 0x12,
+	  0x82, 0xfa, 0xfb, 0x69, 0xda, 0x92, 0x72, 0x8b,
+	  0x1a, 0x71, 0xde, 0x0a, 0x9e, 0x06, 0x0b, 0x29,
+	  0x05, 0xd6, 0xa5, 0xb6, 0x7e, 0xcd, 0x3b, 0x36,
+	  0x92, 0xdd, 0xbd, 0x7f, 0x2d, 0x77, 0x8b, 0x8c,
+	  0x98, 0x03, 0xae, 0xe3, 0x28, 0x09, 0x1b, 0x58,
+	  0xfa, 0xb3, 0x24, 0xe4, 0xfa, 0xd6, 0x75, 0x94,
+	  0x55, 0x85, 0x80, 0x8b, 0x48, 0x31, 0xd7, 0xbc,
+	  0x3f, 0xf4, 0xde, 0xf0, 0x8e, 0x4b, 0x7a, 0x9d,
+	  0xe5, 0x76, 0xd2, 0x65, 0x86, 0xce, 0xc6, 0x4b,
+	  0x61, 0x16,
+	  /* Digest */
+	  0x1a, 0xe1, 0x0b, 0x59, 0x4f, 0x09, 0xe2, 0x6a,
+	  0x7e, 0x90, 0x2e, 0xcb, 0xd0, 0x60, 0x06, 0x91 }
+};
+
+/* IEEE 802.1AE-2006 annex C, 54-byte packet authentication using GCM-AES-128
+ * and GCM-AES-256 */
+static uint8_t aes_gmac_reference_key[][AES_GMAC_MAX_KEY_LEN] = {
+	{ 0xad, 0x7a, 0x2b, 0xd0, 0x3e, 0xac, 0x83, 0x5a,
+	  0x6f, 0x62, 0x0f, 0xdc, 0xb5, 0x06, 0xb3, 0x45 },
+	{ 0xe3, 0xc0, 0x8a, 0x8f, 0x06, 0xc6, 0xe3, 0xad,
+	  0x95, 0xa7, 0x05, 0x57, 0xb2, 0x3f, 0x75, 0x48,
+	  0x3c, 0xe3, 0x30, 0x21, 0xa9, 0xc7, 0x2b, 0x70,
+	  0x25, 0x66, 0x62, 0x04, 0xc6, 0x9c, 0x0b, 0x72 }
+};
+
+static uint32_t aes_gmac_reference_key_len[] = { 16, 32 };
+
+static uint8_t aes_gmac_reference_iv[][AES_GMAC_IV_LEN] = {
+	{ 0x12, 0x15, 0x35, 0x24, 0xc0, 0x89, 0x5e, 0x81,
+	  0xb2, 0xc2, 0x84, 0x65 },
+	{ 0x12, 0x15, 0x35, 0x24, 0xc0, 0x89, 0x5e, 0x81,
+	  0xb2, 0xc2, 0x84, 0x65 }
+};
+
+static uint32_t aes_gmac_reference_length[] = { 70, 70 };
+
+static uint8_t
+aes_gmac_reference_plaintext[][AES_GMAC_MAX_DATA_LEN] = {
+	{ 0xd6, 0x09, 0xb1, 0xf0, 0x56, 0x63, 0x7a, 0x0d,
+	  0x46, 0xdf, 0x99, 0x8d, 0x88, 0xe5, 0x22, 0x2a,
+	  0xb2, 0xc2, 0x84, 0x65, 0x12, 0x15, 0x35, 0x24,
+	  0xc0, 0x89, 0x5e, 0x81, 0x08, 0x00, 0x0f, 0x10,
+	  0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+	  0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+	  0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	  0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+	  0x31, 0x32, 0x33, 0x34, 0x00, 0x01 },
+	{ 0xd6, 0x09, 0xb1, 0xf0, 0x56, 0x63, 0x7a, 0x0d,
+	  0x46, 0xdf, 0x99, 0x8d, 0x88, 0xe5, 0x22, 0x2a,
+	  0xb2, 0xc2, 0x84, 0x65, 0x12, 0x15, 0x35, 0x24,
+	  0xc0, 0x89, 0x5e, 0x81, 0x08, 0x00, 0x0f, 0x10,
+	  0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18,
+	  0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20,
+	  0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+	  0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f, 0x30,
+	  0x31, 0x32, 0x33, 0x34, 0x00, 0x01 }
+};
+
+static uint8_t aes_gmac_reference_digest[][AES_GMAC_CHECK_LEN] = {
+	{ 0xf0, 0x94, 0x78, 0xa9, 0xb0, 0x90, 0x07, 0xd0,
+	  0x6f, 0x46, 0xe9, 0xb6, 0xa1, 0xda, 0x25, 0xdd },
+	{ 0x2f, 0x0b, 0xc5, 0xaf, 0x40, 0x9e, 0x06, 0xd6,
+	  0x09, 0xea, 0x8b, 0x7d, 0x0f, 0xa5, 0xea, 0x50 }
+};
+
 static uint8_t hmac_md5_reference_key[][HMAC_MD5_KEY_LEN] = {
 	{ 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
 	  0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b },
@@ -350,4 +628,159 @@ static uint8_t hmac_sha256_reference_digest[][HMAC_SHA256_DIGEST_LEN] = {
 	  0x85, 0x4d, 0xb8, 0xeb, 0xd0, 0x91, 0x81, 0xa7 }
 };
 
+/* Segmented packet test: plaintext byte i is (i * 7 + (i >> 8)) & 0xff. Data is
+ * encrypted with AES128_CBC using aes128_cbc_reference_key[0] and
+ * aes128_cbc_reference_iv[0], and the ciphertext is authenticated with
+ * HMAC_SHA256_128 using hmac_sha256_reference_key[0]. */
+static uint8_t jumbo_reference_last_block[AES128_CBC_IV_LEN] = {
+	0x1b, 0xcc, 0x8b, 0x07, 0x62, 0x2c, 0xa2, 0x8e,
+	0x4e, 0x12, 0xc2, 0x45, 0x7b, 0x7a, 0xc1, 0x7e
+};
+
+static uint8_t jumbo_reference_digest[HMAC_SHA256_128_CHECK_LEN] = {
+	0xcc, 0x90, 0xc1, 0x49, 0xe0, 0xb5, 0x24, 0x96,
+	0x7c, 0x18, 0x62, 0x45, 0xc1, 0xf0, 0xb1, 0xd4
+};
+
+static uint8_t hmac_sha1_reference_key[][HMAC_SHA1_KEY_LEN] = {
+	{ 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+	  0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+	  0x0b, 0x0b, 0x0b, 0x0b },
+
+	/* "Jefe" */
+	{ 0x4a, 0x65, 0x66, 0x65 },
+
+	{ 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+	  0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+	  0xaa, 0xaa, 0xaa, 0xaa }
+};
+
+static uint32_t hmac_sha1_reference_length[] = { 8, 28, 50 };
+
+static uint8_t
+hmac_sha1_reference_plaintext[][HMAC_SHA1_MAX_DATA_LEN] = {
+	/* "Hi There" */
+	{ 0x48, 0x69, 0x20, 0x54, 0x68, 0x65, 0x72, 0x65 },
+
+	/* what do ya want for nothing?*/
+	{ 0x77, 0x68, 0x61, 0x74, 0x20, 0x64, 0x6f, 0x20,
+	  0x79, 0x61, 0x20, 0x77, 0x61, 0x6e, 0x74, 0x20,
+	  0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x74, 0x68,
+	  0x69, 0x6e, 0x67, 0x3f },
+
+	{ 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd }
+};
+
+static uint8_t hmac_sha1_reference_digest[][HMAC_SHA1_DIGEST_LEN] = {
+	{ 0xb6, 0x17, 0x31, 0x86, 0x55, 0x05, 0x72, 0x64,
+	  0xe2, 0x8b, 0xc0, 0xb6 },
+
+	{ 0xef, 0xfc, 0xdf, 0x6a, 0xe5, 0xeb, 0x2f, 0xa2,
+	  0xd2, 0x74, 0x16, 0xd5 },
+
+	{ 0x12, 0x5d, 0x73, 0x42, 0xb9, 0xac, 0x11, 0xcd,
+	  0x91, 0xa3, 0x9a, 0xf4 }
+};
+
+static uint8_t hmac_sha384_reference_key[][HMAC_SHA384_KEY_LEN] = {
+	{ 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+	  0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+	  0x0b, 0x0b, 0x0b, 0x0b },
+
+	/* "Jefe" */
+	{ 0x4a, 0x65, 0x66, 0x65 },
+
+	{ 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+	  0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+	  0xaa, 0xaa, 0xaa, 0xaa }
+};
+
+static uint32_t hmac_sha384_reference_length[] = { 8, 28, 50 };
+
+static uint8_t
+hmac_sha384_reference_plaintext[][HMAC_SHA384_MAX_DATA_LEN] = {
+	/* "Hi There" */
+	{ 0x48, 0x69, 0x20, 0x54, 0x68, 0x65, 0x72, 0x65 },
+
+	/* what do ya want for nothing?*/
+	{ 0x77, 0x68, 0x61, 0x74, 0x20, 0x64, 0x6f, 0x20,
+	  0x79, 0x61, 0x20, 0x77, 0x61, 0x6e, 0x74, 0x20,
+	  0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x74, 0x68,
+	  0x69, 0x6e, 0x67, 0x3f },
+
+	{ 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd }
+};
+
+static uint8_t hmac_sha384_reference_digest[][HMAC_SHA384_DIGEST_LEN] = {
+	{ 0xaf, 0xd0, 0x39, 0x44, 0xd8, 0x48, 0x95, 0x62,
+	  0x6b, 0x08, 0x25, 0xf4, 0xab, 0x46, 0x90, 0x7f,
+	  0x15, 0xf9, 0xda, 0xdb, 0xe4, 0x10, 0x1e, 0xc6 },
+
+	{ 0xaf, 0x45, 0xd2, 0xe3, 0x76, 0x48, 0x40, 0x31,
+	  0x61, 0x7f, 0x78, 0xd2, 0xb5, 0x8a, 0x6b, 0x1b,
+	  0x9c, 0x7e, 0xf4, 0x64, 0xf5, 0xa0, 0x1b, 0x47 },
+
+	{ 0x88, 0x06, 0x26, 0x08, 0xd3, 0xe6, 0xad, 0x8a,
+	  0x0a, 0xa2, 0xac, 0xe0, 0x14, 0xc8, 0xa8, 0x6f,
+	  0x0a, 0xa6, 0x35, 0xd9, 0x47, 0xac, 0x9f, 0xeb }
+};
+
+static uint8_t hmac_sha512_reference_key[][HMAC_SHA512_KEY_LEN] = {
+	{ 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+	  0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b, 0x0b,
+	  0x0b, 0x0b, 0x0b, 0x0b },
+
+	/* "Jefe" */
+	{ 0x4a, 0x65, 0x66, 0x65 },
+
+	{ 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+	  0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
+	  0xaa, 0xaa, 0xaa, 0xaa }
+};
+
+static uint32_t hmac_sha512_reference_length[] = { 8, 28, 50 };
+
+static uint8_t
+hmac_sha512_reference_plaintext[][HMAC_SHA512_MAX_DATA_LEN] = {
+	/* "Hi There" */
+	{ 0x48, 0x69, 0x20, 0x54, 0x68, 0x65, 0x72, 0x65 },
+
+	/* what do ya want for nothing?*/
+	{ 0x77, 0x68, 0x61, 0x74, 0x20, 0x64, 0x6f, 0x20,
+	  0x79, 0x61, 0x20, 0x77, 0x61, 0x6e, 0x74, 0x20,
+	  0x66, 0x6f, 0x72, 0x20, 0x6e, 0x6f, 0x74, 0x68,
+	  0x69, 0x6e, 0x67, 0x3f },
+
+	{ 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd,
+	  0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd }
+};
+
+static uint8_t hmac_sha512_reference_digest[][HMAC_SHA512_DIGEST_LEN] = {
+	{ 0x87, 0xaa, 0x7c, 0xde, 0xa5, 0xef, 0x61, 0x9d,
+	  0x4f, 0xf0, 0xb4, 0x24, 0x1a, 0x1d, 0x6c, 0xb0,
+	  0x23, 0x79, 0xf4, 0xe2, 0xce, 0x4e, 0xc2, 0x78,
+	  0x7a, 0xd0, 0xb3, 0x05, 0x45, 0xe1, 0x7c, 0xde },
+
+	{ 0x16, 0x4b, 0x7a, 0x7b, 0xfc, 0xf8, 0x19, 0xe2,
+	  0xe3, 0x95, 0xfb, 0xe7, 0x3b, 0x56, 0xe0, 0xa3,
+	  0x87, 0xbd, 0x64, 0x22, 0x2e, 0x83, 0x1f, 0xd6,
+	  0x10, 0x27, 0x0c, 0xd7, 0xea, 0x25, 0x05, 0x54 },
+
+	{ 0xfa, 0x73, 0xb0, 0x08, 0x9d, 0x56, 0xa2, 0x84,
+	  0xef, 0xb0, 0xf0, 0x75, 0x6c, 0x89, 0x0b, 0xe9,
+	  0xb1, 0xb5, 0xdb, 0xdd, 0x8e, 0xe8, 0x1a, 0x36,
+	  0x55, 0xf8, 0x3e, 0x33, 0xb2, 0x27, 0x9d, 0x39 }
+};
+
 #endif
@@ -16,13 +16,40 @@
 #define AES128_CBC_IV_LEN         16
 #define AES128_CBC_MAX_DATA_LEN   64
 
-/* AES128-CBC */
+/* AES256-CBC */
+#define AES256_CBC_KEY_LEN        32
+#define AES256_CBC_IV_LEN         16
+#define AES256_CBC_MAX_DATA_LEN   64
+
+/* AES128-CTR */
+#define AES128_CTR_KEY_LEN        16
+#define AES128_CTR_IV_LEN         16
+#define AES128_CTR_MAX_DATA_LEN   64
+
+/* AES256-CTR */
+#define AES256_CTR_KEY_LEN        32
+#define AES256_CTR_IV_LEN         16
+#define AES256_CTR_MAX_DATA_LEN   64
+
+/* AES128-GCM */
 #define AES128_GCM_KEY_LEN        16
 #define AES128_GCM_IV_LEN         12
 #define AES128_GCM_MAX_DATA_LEN   106
 #define AES128_GCM_DIGEST_LEN     16
 #define AES128_GCM_CHECK_LEN      16
 
+/* ChaCha20-Poly1305 */
+#define CHACHA20_POLY1305_KEY_LEN       32
+#define CHACHA20_POLY1305_IV_LEN        12
+#define CHACHA20_POLY1305_MAX_DATA_LEN  142
+#define CHACHA20_POLY1305_CHECK_LEN     16
+
+/* AES-GMAC */
+#define AES_GMAC_MAX_KEY_LEN      32
+#define AES_GMAC_IV_LEN           12
+#define AES_GMAC_MAX_DATA_LEN     70
+#define AES_GMAC_CHECK_LEN        16
+
 /* HMAC-MD5 */
 #define HMAC_MD5_KEY_LEN        16
 #define HMAC_MD5_MAX_DATA_LEN   128
@@ -35,4 +62,25 @@
 #define HMAC_SHA256_DIGEST_LEN     32
 #define HMAC_SHA256_128_CHECK_LEN  16
 
+/* Segmented packet test */
+#define JUMBO_DATA_LEN             9216
+
+/* HMAC-SHA1 */
+#define HMAC_SHA1_KEY_LEN        20
+#define HMAC_SHA1_MAX_DATA_LEN   128
+#define HMAC_SHA1_DIGEST_LEN     12
+#define HMAC_SHA1_96_CHECK_LEN  12
+
+/* HMAC-SHA384 */
+#define HMAC_SHA384_KEY_LEN        48
+#define HMAC_SHA384_MAX_DATA_LEN   128
+#define HMAC_SHA384_DIGEST_LEN     24
+#define HMAC_SHA384_192_CHECK_LEN  24
+
+/* HMAC-SHA512 */
+#define HMAC_SHA512_KEY_LEN        64
+#define HMAC_SHA512_MAX_DATA_LEN   128
+#define HMAC_SHA512_DIGEST_LEN     32
+#define HMAC_SHA512_256_CHECK_LEN  32
+
 #endif
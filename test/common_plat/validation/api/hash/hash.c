@@ -27,8 +27,141 @@ void hash_test_crc32c(void)
 	CU_ASSERT(ret == 0xe6e910b0);
 }
 
+#define TEST_MAX_LEN 25000
+
+/* Lengths cover all tail sizes, flow tuple keys and long inputs */
+static const struct {
+	uint32_t len;
+	uint32_t crc;
+} crc32c_len_test[] = {
+	{1, 0xe374eefe},
+	{3, 0x71bedc52},
+	{5, 0x57515125},
+	{7, 0x652b2bf5},
+	{13, 0xe01572f3},
+	{37, 0x1c2ecaba},
+	{1000, 0x1b238b65},
+	{TEST_MAX_LEN, 0x28f8f024}
+};
+
+void hash_test_crc32c_len(void)
+{
+	static uint8_t data[TEST_MAX_LEN];
+	uint32_t num = sizeof(crc32c_len_test) / sizeof(crc32c_len_test[0]);
+	uint32_t i, ret;
+
+	for (i = 0; i < TEST_MAX_LEN; i++)
+		data[i] = (uint8_t)(i * 31 + 7);
+
+	for (i = 0; i < num; i++) {
+		ret = odp_hash_crc32c(data, crc32c_len_test[i].len,
+				      0x12345678);
+		CU_ASSERT(ret == crc32c_len_test[i].crc);
+	}
+}
+
+/* Lengths cover the tails and 32 byte stripes of the algorithm */
+static const struct {
+	uint32_t len;
+	uint64_t hash;
+} xxh64_len_test[] = {
+	{0, 0x51e24c0e9077a48c},
+	{1, 0x63f3595cc59f5425},
+	{3, 0x2dd3de03d79b780f},
+	{4, 0x881a72a2895ded30},
+	{7, 0xc8f1700a6fafeb9e},
+	{8, 0x1727919cb64b240f},
+	{13, 0x482bb2d0a9429170},
+	{31, 0x7930c60020465077},
+	{32, 0x815b5d25513b13b8},
+	{37, 0xaa47f06b2d64c366},
+	{64, 0xd5e6b36d0a907eff},
+	{100, 0x71b1b6ea709b5c4a},
+	{255, 0x3f8049102c289731}
+};
+
+void hash_test_xxh64(void)
+{
+	uint8_t data[256];
+	uint32_t num = sizeof(xxh64_len_test) / sizeof(xxh64_len_test[0]);
+	uint32_t i;
+	uint64_t ret;
+
+	ret = odp_hash_xxh64(NULL, 0, 0);
+	CU_ASSERT(ret == 0xef46db3751d8e999);
+
+	for (i = 0; i < sizeof(data); i++)
+		data[i] = (uint8_t)(i * 31 + 7);
+
+	for (i = 0; i < num; i++) {
+		ret = odp_hash_xxh64(data, xxh64_len_test[i].len,
+				     0x123456789abcdef);
+		CU_ASSERT(ret == xxh64_len_test[i].hash);
+	}
+}
+
+/* Verification suite of Microsoft RSS specification, with the default key */
+static const uint8_t toeplitz_key[40] = {
+	0x6d, 0x5a, 0x56, 0xda, 0x25, 0x5b, 0x0e, 0xc2,
+	0x41, 0x67, 0x25, 0x3d, 0x43, 0xa3, 0x8f, 0xb0,
+	0xd0, 0xca, 0x2b, 0xcb, 0xae, 0x7b, 0x30, 0xb4,
+	0x77, 0xcb, 0x2d, 0xa3, 0x80, 0x30, 0xf2, 0x0c,
+	0x6a, 0x42, 0xb7, 0x3b, 0xbe, 0xac, 0x01, 0xfa
+};
+
+void hash_test_toeplitz(void)
+{
+	/* Source 66.9.149.187:2794, destination 161.142.100.80:1766 */
+	const uint8_t tuple[] = {66, 9, 149, 187, 161, 142, 100, 80,
+				 0x0a, 0xea, 0x06, 0xe6};
+	uint32_t ret;
+
+	ret = odp_hash_toeplitz(tuple, 8, toeplitz_key, sizeof(toeplitz_key));
+	CU_ASSERT(ret == 0x323e8fc2);
+
+	ret = odp_hash_toeplitz(tuple, 12, toeplitz_key, sizeof(toeplitz_key));
+	CU_ASSERT(ret == 0x51ccc178);
+
+	/* Key bits beyond the key are zero */
+	ret = odp_hash_toeplitz(tuple, 12, toeplitz_key, 4);
+	CU_ASSERT(ret == odp_hash_toeplitz(tuple, 4, toeplitz_key, 4));
+}
+
+#define TEST_NUM_KEYS 11
+
+void hash_test_multi(void)
+{
+	uint8_t data[TEST_NUM_KEYS][64];
+	const void *key[TEST_NUM_KEYS];
+	uint32_t crc[TEST_NUM_KEYS];
+	uint64_t xxh[TEST_NUM_KEYS];
+	uint32_t len, i, j;
+
+	for (i = 0; i < TEST_NUM_KEYS; i++) {
+		for (j = 0; j < sizeof(data[i]); j++)
+			data[i][j] = (uint8_t)(i * 131 + j * 31 + 7);
+		key[i] = data[i];
+	}
+
+	for (len = 0; len <= sizeof(data[0]); len++) {
+		odp_hash_crc32c_multi(key, len, 0x12345678, crc,
+				      TEST_NUM_KEYS);
+		odp_hash_xxh64_multi(key, len, len, xxh, TEST_NUM_KEYS);
+
+		for (i = 0; i < TEST_NUM_KEYS; i++) {
+			CU_ASSERT(crc[i] == odp_hash_crc32c(key[i], len,
+							    0x12345678));
+			CU_ASSERT(xxh[i] == odp_hash_xxh64(key[i], len, len));
+		}
+	}
+}
+
 odp_testinfo_t hash_suite[] = {
 	ODP_TEST_INFO(hash_test_crc32c),
+	ODP_TEST_INFO(hash_test_crc32c_len),
+	ODP_TEST_INFO(hash_test_xxh64),
+	ODP_TEST_INFO(hash_test_toeplitz),
+	ODP_TEST_INFO(hash_test_multi),
 	ODP_TEST_INFO_NULL,
 };
 
@@ -11,6 +11,10 @@
 
 /* test functions: */
 void hash_test_crc32c(void);
+void hash_test_crc32c_len(void);
+void hash_test_xxh64(void);
+void hash_test_toeplitz(void);
+void hash_test_multi(void);
 
 /* test arrays: */
 extern odp_testinfo_t hash_suite[];
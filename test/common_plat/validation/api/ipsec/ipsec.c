@@ -0,0 +1,770 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <odp_api.h>
+#include <odp_cunit_common.h>
+#include <string.h>
+#include "ipsec.h"
+
+#define PKT_POOL_NUM  64
+#define PKT_POOL_LEN  (2 * 1024)
+
+#define L2_LEN        14
+#define IPV4_LEN      20
+#define IPV6_LEN      40
+#define UDP_LEN       8
+#define ESP_HDR_LEN   8
+#define PROTO_UDP     17
+#define PROTO_ESP     50
+
+#define TEST_SPI      0x1000
+#define TEST_SRC_ADDR 0xc0a80001
+#define TEST_DST_ADDR 0xc0a80002
+
+static odp_pool_t pool;
+static odp_queue_t queue;
+
+static const uint8_t test_key[64] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0xa0, 0xa1, 0xa2, 0xa3, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f,
+	0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27,
+	0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+	0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37,
+	0x38, 0x39, 0x3a, 0x3b, 0x3c, 0x3d, 0x3e, 0x3f
+};
+
+typedef struct {
+	odp_cipher_alg_t cipher;
+	uint32_t cipher_key_len;
+	odp_auth_alg_t auth;
+	uint32_t auth_key_len;
+} alg_test_t;
+
+/* Key lengths include the four byte salt where needed */
+static const alg_test_t alg_test[] = {
+	{ODP_CIPHER_ALG_NULL, 0, ODP_AUTH_ALG_SHA1_HMAC, 20},
+	{ODP_CIPHER_ALG_AES_CBC, 16, ODP_AUTH_ALG_SHA1_HMAC, 20},
+	{ODP_CIPHER_ALG_AES_CBC, 32, ODP_AUTH_ALG_SHA256_HMAC, 32},
+	{ODP_CIPHER_ALG_AES_CBC, 24, ODP_AUTH_ALG_SHA512_HMAC, 64},
+	{ODP_CIPHER_ALG_3DES_CBC, 24, ODP_AUTH_ALG_MD5_HMAC, 16},
+	{ODP_CIPHER_ALG_AES_CTR, 20, ODP_AUTH_ALG_SHA1_HMAC, 20},
+	{ODP_CIPHER_ALG_AES_GCM, 20, ODP_AUTH_ALG_AES_GCM, 0},
+	{ODP_CIPHER_ALG_AES_GCM, 36, ODP_AUTH_ALG_AES_GCM, 0},
+	{ODP_CIPHER_ALG_CHACHA20_POLY1305, 36,
+	 ODP_AUTH_ALG_CHACHA20_POLY1305, 0},
+	{ODP_CIPHER_ALG_NULL, 0, ODP_AUTH_ALG_AES_GMAC, 20}
+};
+
+#define NUM_ALG_TEST (sizeof(alg_test) / sizeof(alg_test[0]))
+
+/* RFC 4106 AES-GCM transport mode packet: SPI 0x1000, sequence number 1,
+ * IV 0102030405060708, key 000102...0f and salt a0a1a2a3 */
+static const uint8_t esp_gcm_pkt[] = {
+	0x45, 0x00, 0x00, 0x58, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x32, 0xf9, 0x20, 0xc0, 0xa8, 0x00, 0x01,
+	0xc0, 0xa8, 0x00, 0x02, 0x00, 0x00, 0x10, 0x00,
+	0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x04,
+	0x05, 0x06, 0x07, 0x08, 0x2c, 0x04, 0xab, 0xf3,
+	0x3b, 0xe8, 0x9c, 0xc4, 0x86, 0xb6, 0xd5, 0x33,
+	0x5c, 0x51, 0x50, 0x78, 0x35, 0xae, 0x29, 0xe9,
+	0x65, 0xc0, 0x98, 0xe3, 0x6b, 0x14, 0x47, 0x9d,
+	0xc1, 0xf0, 0xd1, 0x2d, 0x19, 0xc1, 0x99, 0x43,
+	0x04, 0x0b, 0x71, 0xa7, 0xd9, 0x11, 0x26, 0xad,
+	0x69, 0x3d, 0x64, 0x38, 0xf2, 0x20, 0x2b, 0x1e
+};
+
+static const uint8_t esp_gcm_plain[] = {
+	0x45, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x11, 0xf9, 0x65, 0xc0, 0xa8, 0x00, 0x01,
+	0xc0, 0xa8, 0x00, 0x02, 0x30, 0x39, 0x30, 0x39,
+	0x00, 0x20, 0x00, 0x00, 0x00, 0x11, 0x22, 0x33,
+	0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb,
+	0xcc, 0xdd, 0xee, 0xff, 0x00, 0x11, 0x22, 0x33,
+	0x44, 0x55, 0x66, 0x77
+};
+
+static uint16_t ipv4_chksum(const uint8_t *hdr)
+{
+	uint32_t sum = 0;
+	int i;
+
+	for (i = 0; i < IPV4_LEN; i += 2)
+		sum += (hdr[i] << 8) | hdr[i + 1];
+
+	while (sum >> 16)
+		sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum & 0xffff;
+}
+
+/* Ethernet, IPv4 or IPv6, UDP and payload */
+static odp_packet_t test_packet(uint32_t payload, int ipv6)
+{
+	uint32_t ip_len = ipv6 ? IPV6_LEN : IPV4_LEN;
+	uint32_t len = L2_LEN + ip_len + UDP_LEN + payload;
+	uint8_t data[PKT_POOL_LEN];
+	uint8_t *ip = &data[L2_LEN];
+	uint8_t *udp = &ip[ip_len];
+	odp_packet_t pkt;
+	uint32_t i;
+	uint16_t sum;
+
+	memset(data, 0, sizeof(data));
+
+	for (i = 0; i < 12; i++)
+		data[i] = i + 1;
+
+	if (ipv6) {
+		data[12] = 0x86;
+		data[13] = 0xdd;
+		ip[0] = 0x60;
+		ip[4] = (UDP_LEN + payload) >> 8;
+		ip[5] = (UDP_LEN + payload) & 0xff;
+		ip[6] = PROTO_UDP;
+		ip[7] = 64;
+		ip[8] = 0xfe;
+		ip[9] = 0x80;
+		ip[23] = 1;
+		ip[24] = 0xfe;
+		ip[25] = 0x80;
+		ip[39] = 2;
+	} else {
+		data[12] = 0x08;
+		data[13] = 0x00;
+		ip[0] = 0x45;
+		ip[1] = 0x01;
+		ip[2] = (ip_len + UDP_LEN + payload) >> 8;
+		ip[3] = (ip_len + UDP_LEN + payload) & 0xff;
+		ip[6] = 0x40;
+		ip[8] = 64;
+		ip[9] = PROTO_UDP;
+		ip[12] = 10;
+		ip[15] = 1;
+		ip[16] = 10;
+		ip[19] = 2;
+		sum = ipv4_chksum(ip);
+		ip[10] = sum >> 8;
+		ip[11] = sum & 0xff;
+	}
+
+	udp[1] = 100;
+	udp[3] = 200;
+	udp[4] = (UDP_LEN + payload) >> 8;
+	udp[5] = (UDP_LEN + payload) & 0xff;
+
+	for (i = 0; i < payload; i++)
+		udp[UDP_LEN + i] = i;
+
+	pkt = odp_packet_alloc(pool, len);
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	CU_ASSERT(odp_packet_copy_from_mem(pkt, 0, len, data) == 0);
+	odp_packet_l3_offset_set(pkt, L2_LEN);
+
+	return pkt;
+}
+
+static int packet_equal(odp_packet_t pkt, const uint8_t *data, uint32_t len,
+			uint32_t offset)
+{
+	uint8_t buf[PKT_POOL_LEN];
+
+	if (odp_packet_len(pkt) != len + offset)
+		return 0;
+
+	odp_packet_copy_to_mem(pkt, offset, len, buf);
+
+	return memcmp(buf, data, len) == 0;
+}
+
+static int alg_supported(const odp_ipsec_capability_t *capa,
+			 const alg_test_t *alg)
+{
+	switch (alg->cipher) {
+	case ODP_CIPHER_ALG_NULL:
+		if (!capa->ciphers.bit.null)
+			return 0;
+		break;
+	case ODP_CIPHER_ALG_3DES_CBC:
+		if (!capa->ciphers.bit.trides_cbc)
+			return 0;
+		break;
+	case ODP_CIPHER_ALG_AES_CBC:
+		if (!capa->ciphers.bit.aes_cbc)
+			return 0;
+		break;
+	case ODP_CIPHER_ALG_AES_CTR:
+		if (!capa->ciphers.bit.aes_ctr)
+			return 0;
+		break;
+	case ODP_CIPHER_ALG_AES_GCM:
+		if (!capa->ciphers.bit.aes_gcm)
+			return 0;
+		break;
+	case ODP_CIPHER_ALG_CHACHA20_POLY1305:
+		if (!capa->ciphers.bit.chacha20_poly1305)
+			return 0;
+		break;
+	default:
+		return 0;
+	}
+
+	switch (alg->auth) {
+	case ODP_AUTH_ALG_MD5_HMAC:
+		return capa->auths.bit.md5_hmac;
+	case ODP_AUTH_ALG_SHA1_HMAC:
+		return capa->auths.bit.sha1_hmac;
+	case ODP_AUTH_ALG_SHA256_HMAC:
+		return capa->auths.bit.sha256_hmac;
+	case ODP_AUTH_ALG_SHA512_HMAC:
+		return capa->auths.bit.sha512_hmac;
+	case ODP_AUTH_ALG_AES_GCM:
+		return capa->auths.bit.aes_gcm;
+	case ODP_AUTH_ALG_AES_GMAC:
+		return capa->auths.bit.aes_gmac;
+	case ODP_AUTH_ALG_CHACHA20_POLY1305:
+		return capa->auths.bit.chacha20_poly1305;
+	default:
+		return 0;
+	}
+}
+
+static odp_ipsec_sa_t sa_create(odp_ipsec_dir_t dir, odp_ipsec_mode_t mode,
+				const alg_test_t *alg, uint32_t spi)
+{
+	odp_ipsec_sa_param_t param;
+
+	odp_ipsec_sa_param_init(&param);
+	param.dir  = dir;
+	param.proto = ODP_IPSEC_ESP;
+	param.mode = mode;
+	param.spi  = spi;
+	param.crypto.cipher_alg = alg->cipher;
+	param.crypto.cipher_key.data   = (uint8_t *)(uintptr_t)test_key;
+	param.crypto.cipher_key.length = alg->cipher_key_len;
+	param.crypto.auth_alg = alg->auth;
+	param.crypto.auth_key.data   = (uint8_t *)(uintptr_t)&test_key[16];
+	param.crypto.auth_key.length = alg->auth_key_len;
+	param.tunnel.src_addr = odp_cpu_to_be_32(TEST_SRC_ADDR);
+	param.tunnel.dst_addr = odp_cpu_to_be_32(TEST_DST_ADDR);
+	param.tunnel.dscp = 10;
+	param.dest_queue  = queue;
+
+	return odp_ipsec_sa_create(&param);
+}
+
+static odp_packet_t ipsec_out_one(odp_packet_t pkt, odp_ipsec_sa_t sa,
+				  odp_ipsec_packet_result_t *res)
+{
+	odp_ipsec_out_param_t param;
+	odp_packet_t out = ODP_PACKET_INVALID;
+	int num_out = 1;
+
+	param.num_sa = 1;
+	param.sa = &sa;
+
+	CU_ASSERT_FATAL(odp_ipsec_out(&pkt, 1, &out, &num_out, &param) == 1);
+	CU_ASSERT_FATAL(num_out == 1);
+	CU_ASSERT_FATAL(odp_ipsec_result(res, out) == 0);
+
+	return out;
+}
+
+static odp_packet_t ipsec_in_one(odp_packet_t pkt, odp_ipsec_sa_t sa,
+				 odp_ipsec_packet_result_t *res)
+{
+	odp_ipsec_in_param_t param;
+	odp_packet_t out = ODP_PACKET_INVALID;
+	int num_out = 1;
+
+	param.num_sa = sa == ODP_IPSEC_SA_INVALID ? 0 : 1;
+	param.sa = &sa;
+
+	CU_ASSERT_FATAL(odp_ipsec_in(&pkt, 1, &out, &num_out, &param) == 1);
+	CU_ASSERT_FATAL(num_out == 1);
+	CU_ASSERT_FATAL(odp_ipsec_result(res, out) == 0);
+
+	return out;
+}
+
+/* Encapsulate and decapsulate packets of various lengths with every
+ * supported algorithm. Inbound SA is found by SPI lookup. */
+static void test_out_in(odp_ipsec_mode_t mode, int ipv6)
+{
+	odp_ipsec_capability_t capa;
+	odp_ipsec_packet_result_t res;
+	odp_ipsec_sa_t sa_out, sa_in;
+	odp_packet_t pkt, orig;
+	uint8_t ref[PKT_POOL_LEN];
+	uint8_t ip[IPV4_LEN];
+	uint32_t i, len, payload, seq;
+
+	CU_ASSERT_FATAL(odp_ipsec_capability(&capa) == 0);
+
+	for (i = 0; i < NUM_ALG_TEST; i++) {
+		if (!alg_supported(&capa, &alg_test[i]))
+			continue;
+
+		sa_out = sa_create(ODP_IPSEC_DIR_OUTBOUND, mode, &alg_test[i],
+				   TEST_SPI + i);
+		sa_in  = sa_create(ODP_IPSEC_DIR_INBOUND, mode, &alg_test[i],
+				   TEST_SPI + i);
+		CU_ASSERT_FATAL(sa_out != ODP_IPSEC_SA_INVALID);
+		CU_ASSERT_FATAL(sa_in != ODP_IPSEC_SA_INVALID);
+
+		seq = 0;
+
+		for (payload = 0; payload < 1200; payload += 97) {
+			orig = test_packet(payload, ipv6);
+			len  = odp_packet_len(orig);
+			odp_packet_copy_to_mem(orig, 0, len, ref);
+
+			pkt = ipsec_out_one(orig, sa_out, &res);
+			CU_ASSERT(res.error.all == 0);
+			CU_ASSERT(res.sa == sa_out);
+			CU_ASSERT(res.seq == ++seq);
+			CU_ASSERT(odp_packet_len(pkt) > len + ESP_HDR_LEN);
+			CU_ASSERT(odp_packet_l3_offset(pkt) == L2_LEN);
+			CU_ASSERT(odp_packet_has_ipsec(pkt));
+
+			/* Link layer header is kept, outer header is valid */
+			odp_packet_copy_to_mem(pkt, 0, L2_LEN, ip);
+			CU_ASSERT(memcmp(ip, ref, L2_LEN) == 0);
+			odp_packet_copy_to_mem(pkt, L2_LEN, IPV4_LEN, ip);
+			CU_ASSERT(ip[0] == 0x45);
+			CU_ASSERT(ip[9] == PROTO_ESP);
+			CU_ASSERT(ipv4_chksum(ip) == 0);
+			CU_ASSERT(((ip[2] << 8) | ip[3]) + L2_LEN ==
+				  odp_packet_len(pkt));
+
+			if (mode == ODP_IPSEC_MODE_TUNNEL) {
+				/* DSCP from SA, ECN from inner IPv4 */
+				CU_ASSERT(ip[1] == (ipv6 ? 10 << 2 :
+						    (10 << 2) | 1));
+				CU_ASSERT(ip[16] == 0xc0 && ip[19] == 2);
+			} else {
+				CU_ASSERT(ip[12] == 10 && ip[19] == 2);
+			}
+
+			pkt = ipsec_in_one(pkt, ODP_IPSEC_SA_INVALID, &res);
+			CU_ASSERT(res.error.all == 0);
+			CU_ASSERT(res.sa == sa_in);
+			CU_ASSERT(res.seq == seq);
+			CU_ASSERT(packet_equal(pkt, ref, len, 0));
+			CU_ASSERT(odp_packet_l3_offset(pkt) == L2_LEN);
+			CU_ASSERT(odp_packet_l4_offset(pkt) == L2_LEN +
+				  (ipv6 ? IPV6_LEN : IPV4_LEN));
+
+			odp_packet_free(pkt);
+		}
+
+		CU_ASSERT(odp_ipsec_sa_destroy(sa_out) == 0);
+		CU_ASSERT(odp_ipsec_sa_destroy(sa_in) == 0);
+	}
+}
+
+void ipsec_test_capability(void)
+{
+	odp_ipsec_capability_t capa;
+
+	CU_ASSERT_FATAL(odp_ipsec_capability(&capa) == 0);
+	CU_ASSERT(capa.max_num_sa > 0);
+	CU_ASSERT(capa.ciphers.bit.null);
+	CU_ASSERT(capa.auths.bit.null);
+}
+
+void ipsec_test_sa_create(void)
+{
+	odp_ipsec_capability_t capa;
+	odp_ipsec_sa_param_t param;
+	odp_ipsec_sa_t sa, sa2;
+	int ctx;
+
+	CU_ASSERT_FATAL(odp_ipsec_capability(&capa) == 0);
+
+	odp_ipsec_sa_param_init(&param);
+	CU_ASSERT(param.lookup);
+	CU_ASSERT(param.tunnel.ttl == 64);
+	CU_ASSERT(param.dest_queue == ODP_QUEUE_INVALID);
+
+	param.spi = TEST_SPI;
+	param.crypto.cipher_alg = ODP_CIPHER_ALG_NULL;
+	param.crypto.auth_alg   = ODP_AUTH_ALG_NULL;
+	param.context = &ctx;
+
+	sa = odp_ipsec_sa_create(&param);
+	CU_ASSERT_FATAL(sa != ODP_IPSEC_SA_INVALID);
+	CU_ASSERT(odp_ipsec_sa_context(sa) == &ctx);
+	CU_ASSERT(odp_ipsec_sa_to_u64(sa) !=
+		  odp_ipsec_sa_to_u64(ODP_IPSEC_SA_INVALID));
+
+	/* Inbound SPI must be unique */
+	sa2 = odp_ipsec_sa_create(&param);
+	CU_ASSERT(sa2 == ODP_IPSEC_SA_INVALID);
+
+	param.lookup = 0;
+	sa2 = odp_ipsec_sa_create(&param);
+	CU_ASSERT(sa2 != ODP_IPSEC_SA_INVALID);
+	CU_ASSERT(sa2 != sa);
+
+	CU_ASSERT(odp_ipsec_sa_destroy(sa) == 0);
+	CU_ASSERT(odp_ipsec_sa_destroy(sa2) == 0);
+
+	/* SPI is free again */
+	param.lookup = 1;
+	sa = odp_ipsec_sa_create(&param);
+	CU_ASSERT(sa != ODP_IPSEC_SA_INVALID);
+	CU_ASSERT(odp_ipsec_sa_destroy(sa) == 0);
+
+	/* Anti-replay window size is limited */
+	param.antireplay_ws = capa.max_antireplay_ws + 1;
+	CU_ASSERT(odp_ipsec_sa_create(&param) == ODP_IPSEC_SA_INVALID);
+}
+
+void ipsec_test_tunnel(void)
+{
+	test_out_in(ODP_IPSEC_MODE_TUNNEL, 0);
+}
+
+void ipsec_test_tunnel_ipv6(void)
+{
+	test_out_in(ODP_IPSEC_MODE_TUNNEL, 1);
+}
+
+void ipsec_test_transport(void)
+{
+	test_out_in(ODP_IPSEC_MODE_TRANSPORT, 0);
+}
+
+void ipsec_test_in_known(void)
+{
+	const alg_test_t alg = {ODP_CIPHER_ALG_AES_GCM, 20,
+				ODP_AUTH_ALG_AES_GCM, 0};
+	odp_ipsec_capability_t capa;
+	odp_ipsec_packet_result_t res;
+	odp_ipsec_sa_t sa;
+	odp_packet_t pkt;
+
+	CU_ASSERT_FATAL(odp_ipsec_capability(&capa) == 0);
+
+	if (!alg_supported(&capa, &alg))
+		return;
+
+	sa = sa_create(ODP_IPSEC_DIR_INBOUND, ODP_IPSEC_MODE_TRANSPORT, &alg,
+		       TEST_SPI);
+	CU_ASSERT_FATAL(sa != ODP_IPSEC_SA_INVALID);
+
+	/* Without L3 offset, processing starts from the packet start */
+	pkt = odp_packet_alloc(pool, sizeof(esp_gcm_pkt));
+	CU_ASSERT_FATAL(pkt != ODP_PACKET_INVALID);
+	odp_packet_copy_from_mem(pkt, 0, sizeof(esp_gcm_pkt), esp_gcm_pkt);
+
+	pkt = ipsec_in_one(pkt, sa, &res);
+	CU_ASSERT(res.error.all == 0);
+	CU_ASSERT(res.seq == 1);
+	CU_ASSERT(packet_equal(pkt, esp_gcm_plain, sizeof(esp_gcm_plain), 0));
+	CU_ASSERT(odp_packet_has_ipv4(pkt));
+
+	odp_packet_free(pkt);
+	CU_ASSERT(odp_ipsec_sa_destroy(sa) == 0);
+}
+
+void ipsec_test_antireplay(void)
+{
+	const alg_test_t *alg = &alg_test[1];
+	odp_ipsec_packet_result_t res;
+	odp_ipsec_sa_t sa_out, sa_in;
+	odp_packet_t pkt[3], copy, bad;
+	uint32_t len;
+	uint8_t byte;
+	int i;
+
+	sa_out = sa_create(ODP_IPSEC_DIR_OUTBOUND, ODP_IPSEC_MODE_TUNNEL, alg,
+			   TEST_SPI);
+	sa_in  = sa_create(ODP_IPSEC_DIR_INBOUND, ODP_IPSEC_MODE_TUNNEL, alg,
+			   TEST_SPI);
+	CU_ASSERT_FATAL(sa_out != ODP_IPSEC_SA_INVALID);
+	CU_ASSERT_FATAL(sa_in != ODP_IPSEC_SA_INVALID);
+
+	for (i = 0; i < 3; i++) {
+		pkt[i] = ipsec_out_one(test_packet(64, 0), sa_out, &res);
+		CU_ASSERT(res.error.all == 0);
+	}
+
+	/* Out of order within the window is accepted */
+	copy = odp_packet_copy(pkt[2], pool);
+	CU_ASSERT_FATAL(copy != ODP_PACKET_INVALID);
+	bad = odp_packet_copy(pkt[1], pool);
+	CU_ASSERT_FATAL(bad != ODP_PACKET_INVALID);
+
+	for (i = 2; i >= 0; i--) {
+		pkt[i] = ipsec_in_one(pkt[i], sa_in, &res);
+		CU_ASSERT(res.error.all == 0);
+		CU_ASSERT(res.seq == (uint32_t)i + 1);
+		odp_packet_free(pkt[i]);
+	}
+
+	/* Replayed packet is rejected */
+	copy = ipsec_in_one(copy, sa_in, &res);
+	CU_ASSERT(res.error.bit.antireplay);
+	CU_ASSERT(res.error.bit.auth == 0);
+	CU_ASSERT(res.seq == 3);
+	odp_packet_free(copy);
+
+	/* Replayed packet is rejected before the ICV check */
+	len = odp_packet_len(bad);
+	CU_ASSERT(odp_packet_copy_to_mem(bad, len - 1, 1, &byte) == 0);
+	byte ^= 0x01;
+	CU_ASSERT(odp_packet_copy_from_mem(bad, len - 1, 1, &byte) == 0);
+
+	bad = ipsec_in_one(bad, sa_in, &res);
+	CU_ASSERT(res.error.bit.antireplay);
+	CU_ASSERT(res.error.bit.auth == 0);
+	CU_ASSERT(res.seq == 2);
+	odp_packet_free(bad);
+
+	CU_ASSERT(odp_ipsec_sa_destroy(sa_out) == 0);
+	CU_ASSERT(odp_ipsec_sa_destroy(sa_in) == 0);
+}
+
+void ipsec_test_icv_error(void)
+{
+	odp_ipsec_capability_t capa;
+	odp_ipsec_packet_result_t res;
+	odp_ipsec_sa_t sa_out, sa_in;
+	odp_packet_t pkt;
+	uint8_t byte;
+	uint32_t i, len;
+
+	CU_ASSERT_FATAL(odp_ipsec_capability(&capa) == 0);
+
+	for (i = 0; i < NUM_ALG_TEST; i++) {
+		if (!alg_supported(&capa, &alg_test[i]))
+			continue;
+
+		sa_out = sa_create(ODP_IPSEC_DIR_OUTBOUND,
+				   ODP_IPSEC_MODE_TUNNEL, &alg_test[i],
+				   TEST_SPI);
+		sa_in  = sa_create(ODP_IPSEC_DIR_INBOUND, ODP_IPSEC_MODE_TUNNEL,
+				   &alg_test[i], TEST_SPI);
+		CU_ASSERT_FATAL(sa_out != ODP_IPSEC_SA_INVALID);
+		CU_ASSERT_FATAL(sa_in != ODP_IPSEC_SA_INVALID);
+
+		pkt = ipsec_out_one(test_packet(100, 0), sa_out, &res);
+		CU_ASSERT(res.error.all == 0);
+
+		/* Corrupt the last byte of the payload before ICV */
+		len = odp_packet_len(pkt);
+		odp_packet_copy_to_mem(pkt, len - 20, 1, &byte);
+		byte ^= 0x80;
+		odp_packet_copy_from_mem(pkt, len - 20, 1, &byte);
+
+		pkt = ipsec_in_one(pkt, sa_in, &res);
+		CU_ASSERT(res.error.bit.auth);
+		CU_ASSERT(res.sa == sa_in);
+		CU_ASSERT(odp_packet_len(pkt) == len);
+		odp_packet_free(pkt);
+
+		CU_ASSERT(odp_ipsec_sa_destroy(sa_out) == 0);
+		CU_ASSERT(odp_ipsec_sa_destroy(sa_in) == 0);
+	}
+}
+
+void ipsec_test_lookup_error(void)
+{
+	const alg_test_t *alg = &alg_test[1];
+	odp_ipsec_packet_result_t res;
+	odp_ipsec_sa_t sa_out;
+	odp_packet_t pkt;
+
+	sa_out = sa_create(ODP_IPSEC_DIR_OUTBOUND, ODP_IPSEC_MODE_TUNNEL, alg,
+			   TEST_SPI);
+	CU_ASSERT_FATAL(sa_out != ODP_IPSEC_SA_INVALID);
+
+	pkt = ipsec_out_one(test_packet(100, 0), sa_out, &res);
+	CU_ASSERT(res.error.all == 0);
+
+	pkt = ipsec_in_one(pkt, ODP_IPSEC_SA_INVALID, &res);
+	CU_ASSERT(res.error.bit.sa_lookup);
+	CU_ASSERT(res.sa == ODP_IPSEC_SA_INVALID);
+	odp_packet_free(pkt);
+
+	/* Plain IP packet is not ESP */
+	pkt = ipsec_in_one(test_packet(100, 0), ODP_IPSEC_SA_INVALID, &res);
+	CU_ASSERT(res.error.bit.proto);
+	odp_packet_free(pkt);
+
+	CU_ASSERT(odp_ipsec_sa_destroy(sa_out) == 0);
+}
+
+void ipsec_test_enq(void)
+{
+	const alg_test_t *alg = &alg_test[1];
+	odp_ipsec_packet_result_t res;
+	odp_ipsec_out_param_t out_param;
+	odp_ipsec_in_param_t in_param;
+	odp_ipsec_sa_t sa_out, sa_in;
+	odp_packet_t pkt[4];
+	uint8_t ref[PKT_POOL_LEN];
+	odp_event_t ev;
+	uint32_t len;
+	int i;
+
+	sa_out = sa_create(ODP_IPSEC_DIR_OUTBOUND, ODP_IPSEC_MODE_TUNNEL, alg,
+			   TEST_SPI);
+	sa_in  = sa_create(ODP_IPSEC_DIR_INBOUND, ODP_IPSEC_MODE_TUNNEL, alg,
+			   TEST_SPI);
+	CU_ASSERT_FATAL(sa_out != ODP_IPSEC_SA_INVALID);
+	CU_ASSERT_FATAL(sa_in != ODP_IPSEC_SA_INVALID);
+
+	for (i = 0; i < 4; i++)
+		pkt[i] = test_packet(200, 0);
+
+	len = odp_packet_len(pkt[0]);
+	odp_packet_copy_to_mem(pkt[0], 0, len, ref);
+
+	out_param.num_sa = 1;
+	out_param.sa = &sa_out;
+	CU_ASSERT_FATAL(odp_ipsec_out_enq(pkt, 4, &out_param) == 4);
+
+	for (i = 0; i < 4; i++) {
+		ev = odp_queue_deq(queue);
+		CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+		CU_ASSERT(odp_event_type(ev) == ODP_EVENT_IPSEC_RESULT);
+
+		pkt[i] = odp_ipsec_packet_from_event(ev);
+		CU_ASSERT(odp_event_type(ev) == ODP_EVENT_PACKET);
+		CU_ASSERT(odp_ipsec_result(&res, pkt[i]) == 0);
+		CU_ASSERT(res.error.all == 0);
+		CU_ASSERT(res.seq == (uint32_t)i + 1);
+	}
+
+	in_param.num_sa = 0;
+	in_param.sa = NULL;
+	CU_ASSERT_FATAL(odp_ipsec_in_enq(pkt, 4, &in_param) == 4);
+
+	for (i = 0; i < 4; i++) {
+		ev = odp_queue_deq(queue);
+		CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+		CU_ASSERT(odp_event_type(ev) == ODP_EVENT_IPSEC_RESULT);
+
+		pkt[i] = odp_ipsec_packet_from_event(ev);
+		CU_ASSERT(odp_ipsec_result(&res, pkt[i]) == 0);
+		CU_ASSERT(res.error.all == 0);
+		CU_ASSERT(res.sa == sa_in);
+		CU_ASSERT(packet_equal(pkt[i], ref, len, 0));
+		odp_packet_free(pkt[i]);
+	}
+
+	CU_ASSERT(odp_queue_deq(queue) == ODP_EVENT_INVALID);
+
+	CU_ASSERT(odp_ipsec_sa_destroy(sa_out) == 0);
+	CU_ASSERT(odp_ipsec_sa_destroy(sa_in) == 0);
+}
+
+static int ipsec_init(odp_instance_t *inst)
+{
+	odp_pool_param_t params;
+	odp_ipsec_config_t config;
+
+	if (0 != odp_init_global(inst, NULL, NULL)) {
+		fprintf(stderr, "error: odp_init_global() failed.\n");
+		return -1;
+	}
+
+	if (0 != odp_init_local(*inst, ODP_THREAD_CONTROL)) {
+		fprintf(stderr, "error: odp_init_local() failed.\n");
+		return -1;
+	}
+
+	odp_pool_param_init(&params);
+	params.pkt.seg_len = PKT_POOL_LEN;
+	params.pkt.len     = PKT_POOL_LEN;
+	params.pkt.num     = PKT_POOL_NUM;
+	params.type        = ODP_POOL_PACKET;
+
+	pool = odp_pool_create("packet_pool", &params);
+	if (ODP_POOL_INVALID == pool) {
+		fprintf(stderr, "Packet pool creation failed.\n");
+		return -1;
+	}
+
+	queue = odp_queue_create("ipsec-out", NULL);
+	if (ODP_QUEUE_INVALID == queue) {
+		fprintf(stderr, "IPSEC queue creation failed.\n");
+		return -1;
+	}
+
+	odp_ipsec_config_init(&config);
+	config.inbound_default_queue = queue;
+
+	if (odp_ipsec_config(&config)) {
+		fprintf(stderr, "IPSEC config failed.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int ipsec_term(odp_instance_t inst)
+{
+	if (odp_queue_destroy(queue))
+		fprintf(stderr, "IPSEC queue destroy failed.\n");
+
+	if (odp_pool_destroy(pool))
+		fprintf(stderr, "Packet pool destroy failed.\n");
+
+	if (0 != odp_term_local()) {
+		fprintf(stderr, "error: odp_term_local() failed.\n");
+		return -1;
+	}
+
+	if (0 != odp_term_global(inst)) {
+		fprintf(stderr, "error: odp_term_global() failed.\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+odp_testinfo_t ipsec_suite[] = {
+	ODP_TEST_INFO(ipsec_test_capability),
+	ODP_TEST_INFO(ipsec_test_sa_create),
+	ODP_TEST_INFO(ipsec_test_tunnel),
+	ODP_TEST_INFO(ipsec_test_tunnel_ipv6),
+	ODP_TEST_INFO(ipsec_test_transport),
+	ODP_TEST_INFO(ipsec_test_in_known),
+	ODP_TEST_INFO(ipsec_test_antireplay),
+	ODP_TEST_INFO(ipsec_test_icv_error),
+	ODP_TEST_INFO(ipsec_test_lookup_error),
+	ODP_TEST_INFO(ipsec_test_enq),
+	ODP_TEST_INFO_NULL,
+};
+
+odp_suiteinfo_t ipsec_suites[] = {
+	{"IPsec", NULL, NULL, ipsec_suite},
+	ODP_SUITE_INFO_NULL
+};
+
+int ipsec_main(int argc, char *argv[])
+{
+	int ret;
+
+	/* parse common options: */
+	if (odp_cunit_parse_options(argc, argv))
+		return -1;
+
+	odp_cunit_register_global_init(ipsec_init);
+	odp_cunit_register_global_term(ipsec_term);
+
+	ret = odp_cunit_register(ipsec_suites);
+
+	if (ret == 0)
+		ret = odp_cunit_run();
+
+	return ret;
+}
@@ -0,0 +1,33 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#ifndef _ODP_TEST_IPSEC_H_
+#define _ODP_TEST_IPSEC_H_
+
+#include <odp_cunit_common.h>
+
+/* test functions: */
+void ipsec_test_capability(void);
+void ipsec_test_sa_create(void);
+void ipsec_test_tunnel(void);
+void ipsec_test_tunnel_ipv6(void);
+void ipsec_test_transport(void);
+void ipsec_test_in_known(void);
+void ipsec_test_antireplay(void);
+void ipsec_test_icv_error(void);
+void ipsec_test_lookup_error(void);
+void ipsec_test_enq(void);
+
+/* test arrays: */
+extern odp_testinfo_t ipsec_suite[];
+
+/* test registry: */
+extern odp_suiteinfo_t ipsec_suites[];
+
+/* main test program: */
+int ipsec_main(int argc, char *argv[]);
+
+#endif
@@ -1939,6 +1939,69 @@ void packet_test_offset(void)
 	CU_ASSERT_PTR_NOT_NULL(ptr);
 }
 
+void packet_test_vector(void)
+{
+	odp_pool_capability_t capa;
+	odp_pool_param_t params;
+	odp_pool_t pool;
+	odp_packet_vector_t pktv;
+	odp_packet_t pkt[2];
+	odp_packet_t *pkt_tbl;
+	odp_event_t ev;
+	uint32_t max_size = 8;
+
+	CU_ASSERT_FATAL(odp_pool_capability(&capa) == 0);
+
+	if (capa.vector.max_size < max_size)
+		max_size = capa.vector.max_size;
+
+	odp_pool_param_init(&params);
+	params.type            = ODP_POOL_PACKET_VECTOR;
+	params.vector.num      = 4;
+	params.vector.max_size = max_size;
+
+	pool = odp_pool_create("packet_vector_pool", &params);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	pktv = odp_packet_vector_alloc(pool);
+	CU_ASSERT_FATAL(pktv != ODP_PACKET_VECTOR_INVALID);
+	CU_ASSERT(odp_packet_vector_pool(pktv) == pool);
+	CU_ASSERT(odp_packet_vector_size(pktv) == 0);
+
+	ev = odp_packet_vector_to_event(pktv);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	CU_ASSERT(odp_event_type(ev) == ODP_EVENT_PACKET_VECTOR);
+	CU_ASSERT(odp_packet_vector_from_event(ev) == pktv);
+
+	pkt[0] = odp_packet_alloc(packet_pool, packet_len);
+	pkt[1] = odp_packet_alloc(packet_pool, packet_len);
+	CU_ASSERT_FATAL(pkt[0] != ODP_PACKET_INVALID);
+	CU_ASSERT_FATAL(pkt[1] != ODP_PACKET_INVALID);
+
+	CU_ASSERT(odp_packet_vector_tbl(pktv, &pkt_tbl) == 0);
+	CU_ASSERT_FATAL(pkt_tbl != NULL);
+	pkt_tbl[0] = pkt[0];
+	pkt_tbl[1] = pkt[1];
+	odp_packet_vector_size_set(pktv, 2);
+
+	CU_ASSERT(odp_packet_vector_size(pktv) == 2);
+	pkt_tbl = NULL;
+	CU_ASSERT(odp_packet_vector_tbl(pktv, &pkt_tbl) == 2);
+	CU_ASSERT_FATAL(pkt_tbl != NULL);
+	CU_ASSERT(pkt_tbl[0] == pkt[0]);
+	CU_ASSERT(pkt_tbl[1] == pkt[1]);
+
+	/* Frees both the vector and the packets */
+	odp_event_free(ev);
+
+	pktv = odp_packet_vector_alloc(pool);
+	CU_ASSERT_FATAL(pktv != ODP_PACKET_VECTOR_INVALID);
+	CU_ASSERT(odp_packet_vector_size(pktv) == 0);
+	odp_packet_vector_free(pktv);
+
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 odp_testinfo_t packet_suite[] = {
 	ODP_TEST_INFO(packet_test_alloc_free),
 	ODP_TEST_INFO(packet_test_alloc_free_multi),
@@ -1967,6 +2030,7 @@ odp_testinfo_t packet_suite[] = {
 	ODP_TEST_INFO(packet_test_extend_mix),
 	ODP_TEST_INFO(packet_test_align),
 	ODP_TEST_INFO(packet_test_offset),
+	ODP_TEST_INFO(packet_test_vector),
 	ODP_TEST_INFO_NULL,
 };
 
@@ -37,6 +37,7 @@ void packet_test_extend_large(void);
 void packet_test_extend_mix(void);
 void packet_test_align(void);
 void packet_test_offset(void);
+void packet_test_vector(void);
 
 /* test arrays: */
 extern odp_testinfo_t packet_suite[];
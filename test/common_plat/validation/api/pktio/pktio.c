@@ -2019,6 +2019,413 @@ void pktio_test_pktin_ts(void)
 	}
 }
 
+int pktio_check_chksum(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 ||
+	    !capa.config.pktin.bit.ipv4_chksum ||
+	    !capa.config.pktin.bit.udp_chksum ||
+	    !capa.config.pktout.bit.ipv4_chksum ||
+	    !capa.config.pktout.bit.udp_chksum)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+void pktio_test_chksum(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	pktio_info_t pktio_rx_info;
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_packet_t pkt_tbl[TX_BATCH_LEN];
+	uint32_t pkt_seq[TX_BATCH_LEN];
+	odph_ipv4hdr_t *ip;
+	odph_udphdr_t *udp;
+	uint32_t len;
+	int num_rx;
+	int ret;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktio_config_init(&config);
+		config.pktin.bit.ipv4_chksum  = 1;
+		config.pktin.bit.udp_chksum   = 1;
+		config.pktout.bit.ipv4_chksum = 1;
+		config.pktout.bit.udp_chksum  = 1;
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+	pktio_rx_info.id   = pktio_rx;
+	pktio_rx_info.inq  = ODP_QUEUE_INVALID;
+	pktio_rx_info.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	ret = create_packets(pkt_tbl, pkt_seq, TX_BATCH_LEN, pktio_tx,
+			     pktio_rx);
+	CU_ASSERT_FATAL(ret == TX_BATCH_LEN);
+
+	/* Clear checksums. Those are inserted on packet output according to
+	 * packet protocol flags and offsets. */
+	for (i = 0; i < TX_BATCH_LEN; i++) {
+		ip  = (odph_ipv4hdr_t *)odp_packet_l3_ptr(pkt_tbl[i], &len);
+		udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt_tbl[i], &len);
+		CU_ASSERT_FATAL(ip != NULL && udp != NULL);
+
+		ip->chksum  = 0;
+		udp->chksum = 0;
+		odp_packet_has_ipv4_set(pkt_tbl[i], 1);
+		odp_packet_has_udp_set(pkt_tbl[i], 1);
+	}
+
+	/* First packet is sent with a bad IPv4 header checksum */
+	odp_packet_l3_chksum_insert(pkt_tbl[0], 0);
+
+	ret = odp_pktout_queue(pktio_tx, &pktout_queue, 1);
+	CU_ASSERT_FATAL(ret > 0);
+
+	send_packets(pktout_queue, pkt_tbl, TX_BATCH_LEN);
+
+	num_rx = wait_for_packets(&pktio_rx_info, pkt_tbl, pkt_seq,
+				  TX_BATCH_LEN, TXRX_MODE_MULTI,
+				  ODP_TIME_SEC_IN_NS);
+	CU_ASSERT(num_rx == TX_BATCH_LEN);
+
+	for (i = 0; i < num_rx; i++) {
+		if (i == 0) {
+			CU_ASSERT(odp_packet_has_l3_error(pkt_tbl[i]));
+		} else {
+			CU_ASSERT(!odp_packet_has_error(pkt_tbl[i]));
+			CU_ASSERT(odph_ipv4_csum_valid(pkt_tbl[i]));
+			CU_ASSERT(odph_udp_chksum_verify(pkt_tbl[i]) == 0);
+		}
+
+		odp_packet_free(pkt_tbl[i]);
+	}
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+int pktio_check_gso(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.config.pktout.bit.udp_gso)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+void pktio_test_gso(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	pktio_info_t pktio_rx_info;
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_packet_t pkt_tbl[TX_BATCH_LEN];
+	odp_packet_t pkt;
+	odp_time_t wait, end;
+	uint32_t pkt_seq;
+	uint32_t hdr_len, payload_len, gso_size, len;
+	uint32_t ip_id = 0;
+	uint32_t rx_len = 0;
+	odph_ipv4hdr_t *ip;
+	odph_udphdr_t *udp;
+	int num_rx = 0;
+	int ret;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktio_config_init(&config);
+		config.pktout.bit.udp_gso = 1;
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+	pktio_rx_info.id   = pktio_rx;
+	pktio_rx_info.inq  = ODP_QUEUE_INVALID;
+	pktio_rx_info.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	ret = create_packets(&pkt, &pkt_seq, 1, pktio_tx, pktio_rx);
+	CU_ASSERT_FATAL(ret == 1);
+
+	/* UDP payload is split into TX_BATCH_LEN datagrams */
+	hdr_len = ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN;
+	payload_len = odp_packet_len(pkt) - hdr_len;
+	gso_size = (payload_len + TX_BATCH_LEN - 1) / TX_BATCH_LEN;
+
+	odp_packet_has_ipv4_set(pkt, 1);
+	odp_packet_has_udp_set(pkt, 1);
+	/* Helper calculates UDP checksum only when UDP flag is set */
+	CU_ASSERT_FATAL(pktio_fixup_checksums(pkt) == 0);
+	odp_packet_gso_size_set(pkt, gso_size);
+	CU_ASSERT(odp_packet_gso_size(pkt) == gso_size);
+
+	ret = odp_pktout_queue(pktio_tx, &pktout_queue, 1);
+	CU_ASSERT_FATAL(ret > 0);
+
+	send_packets(pktout_queue, &pkt, 1);
+
+	/* Receive segments in order. Other packets are dropped. */
+	wait = odp_time_local_from_ns(ODP_TIME_SEC_IN_NS);
+	end  = odp_time_sum(odp_time_local(), wait);
+
+	while (num_rx < TX_BATCH_LEN &&
+	       odp_time_cmp(end, odp_time_local()) > 0) {
+		ret = get_packets(&pktio_rx_info, &pkt, 1, TXRX_MODE_SINGLE);
+		if (ret != 1)
+			continue;
+
+		ip  = (odph_ipv4hdr_t *)odp_packet_l3_ptr(pkt, &len);
+		udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, &len);
+
+		if (!odp_packet_has_udp(pkt) || ip == NULL || udp == NULL ||
+		    odp_be_to_cpu_16(udp->dst_port) != 12050) {
+			odp_packet_free(pkt);
+			continue;
+		}
+
+		pkt_tbl[num_rx++] = pkt;
+	}
+
+	CU_ASSERT(num_rx == TX_BATCH_LEN);
+
+	for (i = 0; i < num_rx; i++) {
+		ip  = (odph_ipv4hdr_t *)odp_packet_l3_ptr(pkt_tbl[i], &len);
+		udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt_tbl[i], &len);
+		len = odp_packet_len(pkt_tbl[i]) - hdr_len;
+
+		if (i == 0)
+			ip_id = odp_be_to_cpu_16(ip->id);
+
+		CU_ASSERT(len <= gso_size);
+		CU_ASSERT(odp_be_to_cpu_16(ip->id) == ((ip_id + i) & 0xffff));
+		CU_ASSERT(odp_be_to_cpu_16(ip->tot_len) ==
+			  len + ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN);
+		CU_ASSERT(odp_be_to_cpu_16(udp->length) ==
+			  len + ODPH_UDPHDR_LEN);
+		CU_ASSERT(odph_ipv4_csum_valid(pkt_tbl[i]));
+		CU_ASSERT(odph_udp_chksum_verify(pkt_tbl[i]) == 0);
+
+		rx_len += len;
+		odp_packet_free(pkt_tbl[i]);
+	}
+
+	CU_ASSERT(num_rx != TX_BATCH_LEN || rx_len == payload_len);
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
+int pktio_check_gro(void)
+{
+	odp_pktio_t pktio;
+	odp_pktio_capability_t capa;
+	odp_pktio_param_t pktio_param;
+	int ret;
+
+	odp_pktio_param_init(&pktio_param);
+	pktio_param.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	pktio = odp_pktio_open(iface_name[0], pool[0], &pktio_param);
+	if (pktio == ODP_PKTIO_INVALID)
+		return ODP_TEST_INACTIVE;
+
+	ret = odp_pktio_capability(pktio, &capa);
+	(void)odp_pktio_close(pktio);
+
+	if (ret < 0 || !capa.config.pktout.bit.udp_gso ||
+	    !capa.config.pktin.bit.udp_gro)
+		return ODP_TEST_INACTIVE;
+
+	return ODP_TEST_ACTIVE;
+}
+
+void pktio_test_gro(void)
+{
+	odp_pktio_t pktio_tx, pktio_rx;
+	odp_pktio_t pktio[MAX_NUM_IFACES];
+	pktio_info_t pktio_rx_info;
+	odp_pktio_config_t config;
+	odp_pktout_queue_t pktout_queue;
+	odp_pktio_stats_t stats;
+	odp_packet_t pkt_tbl[TX_BATCH_LEN];
+	odp_packet_t pkt;
+	odp_time_t wait, end;
+	uint32_t pkt_seq;
+	uint32_t hdr_len, payload_len, gso_size, len;
+	uint32_t rx_len = 0;
+	odph_ipv4hdr_t *ip;
+	odph_udphdr_t *udp;
+	int num_rx = 0;
+	int num_gro = 0;
+	int num, ret;
+	int i;
+
+	CU_ASSERT_FATAL(num_ifaces >= 1);
+
+	/* Open and configure interfaces */
+	for (i = 0; i < num_ifaces; ++i) {
+		pktio[i] = create_pktio(i, ODP_PKTIN_MODE_DIRECT,
+					ODP_PKTOUT_MODE_DIRECT);
+		CU_ASSERT_FATAL(pktio[i] != ODP_PKTIO_INVALID);
+
+		odp_pktio_config_init(&config);
+		config.pktout.bit.udp_gso = 1;
+		config.pktin.bit.udp_gro  = 1;
+		config.gro.flush_ns       = ODP_TIME_MSEC_IN_NS;
+		CU_ASSERT_FATAL(odp_pktio_config(pktio[i], &config) == 0);
+
+		CU_ASSERT_FATAL(odp_pktio_start(pktio[i]) == 0);
+	}
+
+	for (i = 0; i < num_ifaces; i++)
+		_pktio_wait_linkup(pktio[i]);
+
+	pktio_tx = pktio[0];
+	pktio_rx = (num_ifaces > 1) ? pktio[1] : pktio_tx;
+	pktio_rx_info.id   = pktio_rx;
+	pktio_rx_info.inq  = ODP_QUEUE_INVALID;
+	pktio_rx_info.in_mode = ODP_PKTIN_MODE_DIRECT;
+
+	(void)odp_pktio_stats_reset(pktio_rx);
+
+	ret = create_packets(&pkt, &pkt_seq, 1, pktio_tx, pktio_rx);
+	CU_ASSERT_FATAL(ret == 1);
+
+	/* UDP payload is split into TX_BATCH_LEN datagrams on output, which
+	 * are coalesced back on input */
+	hdr_len = ODPH_ETHHDR_LEN + ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN;
+	payload_len = odp_packet_len(pkt) - hdr_len;
+	gso_size = (payload_len + TX_BATCH_LEN - 1) / TX_BATCH_LEN;
+
+	odp_packet_has_ipv4_set(pkt, 1);
+	odp_packet_has_udp_set(pkt, 1);
+	/* Helper calculates UDP checksum only when UDP flag is set */
+	CU_ASSERT_FATAL(pktio_fixup_checksums(pkt) == 0);
+	odp_packet_gso_size_set(pkt, gso_size);
+
+	ret = odp_pktout_queue(pktio_tx, &pktout_queue, 1);
+	CU_ASSERT_FATAL(ret > 0);
+
+	send_packets(pktout_queue, &pkt, 1);
+
+	/* Receive packets in order. Other packets are dropped. */
+	wait = odp_time_local_from_ns(ODP_TIME_SEC_IN_NS);
+	end  = odp_time_sum(odp_time_local(), wait);
+
+	while (rx_len < payload_len && num_rx < TX_BATCH_LEN &&
+	       odp_time_cmp(end, odp_time_local()) > 0) {
+		num = get_packets(&pktio_rx_info, pkt_tbl, 1, TXRX_MODE_MULTI);
+		if (num != 1)
+			continue;
+
+		pkt = pkt_tbl[0];
+		ip  = (odph_ipv4hdr_t *)odp_packet_l3_ptr(pkt, &len);
+		udp = (odph_udphdr_t *)odp_packet_l4_ptr(pkt, &len);
+
+		if (!odp_packet_has_udp(pkt) || ip == NULL || udp == NULL ||
+		    odp_be_to_cpu_16(udp->dst_port) != 12050) {
+			odp_packet_free(pkt);
+			continue;
+		}
+
+		len = odp_packet_len(pkt) - hdr_len;
+
+		/* Coalesced packet has the segmentation size set */
+		if (len > gso_size) {
+			CU_ASSERT(odp_packet_gso_size(pkt) == gso_size);
+			num_gro++;
+		}
+
+		CU_ASSERT(odp_be_to_cpu_16(ip->tot_len) ==
+			  len + ODPH_IPV4HDR_LEN + ODPH_UDPHDR_LEN);
+		CU_ASSERT(odp_be_to_cpu_16(udp->length) ==
+			  len + ODPH_UDPHDR_LEN);
+		CU_ASSERT(odph_ipv4_csum_valid(pkt));
+		CU_ASSERT(odph_udp_chksum_verify(pkt) == 0);
+
+		rx_len += len;
+		num_rx++;
+		odp_packet_free(pkt);
+	}
+
+	CU_ASSERT(rx_len == payload_len);
+
+	/* Segments arrive back to back, and are held for coalescing */
+	CU_ASSERT(num_gro > 0);
+
+	if (odp_pktio_stats(pktio_rx, &stats) == 0) {
+		CU_ASSERT(stats.in_gro_pkts >= (uint64_t)num_gro);
+		CU_ASSERT(stats.in_gro_segs > stats.in_gro_pkts);
+	}
+
+	for (i = 0; i < num_ifaces; i++) {
+		CU_ASSERT_FATAL(odp_pktio_stop(pktio[i]) == 0);
+		CU_ASSERT_FATAL(odp_pktio_close(pktio[i]) == 0);
+	}
+}
+
 static int create_pool(const char *iface, int num)
 {
 	char pool_name[ODP_POOL_NAME_LEN];
@@ -2161,6 +2568,12 @@ odp_testinfo_t pktio_suite_unsegmented[] = {
 				  pktio_check_statistics_counters),
 	ODP_TEST_INFO_CONDITIONAL(pktio_test_pktin_ts,
 				  pktio_check_pktin_ts),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_chksum,
+				  pktio_check_chksum),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_gso,
+				  pktio_check_gso),
+	ODP_TEST_INFO_CONDITIONAL(pktio_test_gro,
+				  pktio_check_gro),
 	ODP_TEST_INFO_NULL
 };
 
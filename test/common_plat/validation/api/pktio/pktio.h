@@ -46,6 +46,12 @@ int pktio_check_statistics_counters(void);
 void pktio_test_statistics_counters(void);
 int pktio_check_pktin_ts(void);
 void pktio_test_pktin_ts(void);
+int pktio_check_chksum(void);
+void pktio_test_chksum(void);
+int pktio_check_gso(void);
+void pktio_test_gso(void);
+int pktio_check_gro(void);
+void pktio_test_gro(void);
 
 /* test arrays: */
 extern odp_testinfo_t pktio_suite[];
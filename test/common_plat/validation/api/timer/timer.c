@@ -216,6 +216,233 @@ void timer_test_odp_timer_cancel(void)
 		CU_FAIL_FATAL("Failed to destroy pool");
 }
 
+/* @private Wait for an event on a plain queue for up to 'ms' milliseconds */
+static odp_event_t wait_event(odp_queue_t queue, uint32_t ms)
+{
+	struct timespec ts = {0, ODP_TIME_MSEC_IN_NS};
+	odp_event_t ev;
+
+	while ((ev = odp_queue_deq(queue)) == ODP_EVENT_INVALID && ms--)
+		nanosleep(&ts, NULL);
+
+	return ev;
+}
+
+#define MULTI_NUM 8
+
+void timer_test_odp_timer_multi(void)
+{
+	odp_pool_t pool;
+	odp_pool_param_t params;
+	odp_timer_pool_param_t tparam;
+	odp_timer_pool_t tp;
+	odp_queue_t queue;
+	odp_timer_t tim[MULTI_NUM];
+	odp_event_t ev[MULTI_NUM];
+	odp_event_t ev2[MULTI_NUM];
+	uint64_t tick[MULTI_NUM];
+	uint64_t cur_tick;
+	int i, num;
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_TIMEOUT;
+	params.tmo.num = MULTI_NUM;
+
+	pool = odp_pool_create("tmo_pool_for_multi", &params);
+	if (pool == ODP_POOL_INVALID)
+		CU_FAIL_FATAL("Timeout pool create failed");
+
+	tparam.res_ns     = 10  * ODP_TIME_MSEC_IN_NS;
+	tparam.min_tmo    = 10  * ODP_TIME_MSEC_IN_NS;
+	tparam.max_tmo    = 10  * ODP_TIME_SEC_IN_NS;
+	tparam.num_timers = MULTI_NUM;
+	tparam.priv       = 0;
+	tparam.clk_src    = ODP_CLOCK_CPU;
+	tp = odp_timer_pool_create("timer_pool_multi", &tparam);
+	if (tp == ODP_TIMER_POOL_INVALID)
+		CU_FAIL_FATAL("Timer pool create failed");
+
+	odp_timer_pool_start();
+
+	queue = odp_queue_create("timer_queue_multi", NULL);
+	if (queue == ODP_QUEUE_INVALID)
+		CU_FAIL_FATAL("Queue create failed");
+
+	for (i = 0; i < MULTI_NUM; i++) {
+		tim[i] = odp_timer_alloc(tp, queue, NULL);
+		CU_ASSERT_FATAL(tim[i] != ODP_TIMER_INVALID);
+		ev[i] = odp_timeout_to_event(odp_timeout_alloc(pool));
+		CU_ASSERT_FATAL(ev[i] != ODP_EVENT_INVALID);
+		tick[i] = odp_timer_ns_to_tick(tp, 2 * ODP_TIME_SEC_IN_NS) + i;
+	}
+
+	/* Set with new timeout events */
+	num = odp_timer_set_rel_multi(tim, tick, ev, MULTI_NUM);
+	CU_ASSERT_FATAL(num == MULTI_NUM);
+	for (i = 0; i < MULTI_NUM; i++)
+		CU_ASSERT(ev[i] == ODP_EVENT_INVALID);
+
+	/* Reset with the existing timeout events */
+	cur_tick = odp_timer_current_tick(tp);
+	for (i = 0; i < MULTI_NUM; i++)
+		tick[i] += cur_tick;
+	num = odp_timer_set_abs_multi(tim, tick, NULL, MULTI_NUM);
+	CU_ASSERT(num == MULTI_NUM);
+
+	/* Setting stops at the first timer with too early expiration time */
+	for (i = 0; i < MULTI_NUM; i++)
+		tick[i] = odp_timer_ns_to_tick(tp, 2 * ODP_TIME_SEC_IN_NS);
+	tick[MULTI_NUM / 2] = 0;
+	num = odp_timer_set_rel_multi(tim, tick, NULL, MULTI_NUM);
+	CU_ASSERT(num == MULTI_NUM / 2);
+
+	/* Cancel returns the timeout events */
+	num = odp_timer_cancel_multi(tim, ev, MULTI_NUM);
+	CU_ASSERT(num == MULTI_NUM);
+	for (i = 0; i < MULTI_NUM; i++) {
+		CU_ASSERT_FATAL(ev[i] != ODP_EVENT_INVALID);
+		CU_ASSERT(odp_timeout_timer(odp_timeout_from_event(ev[i])) ==
+			  tim[i]);
+	}
+
+	/* Inactive timers cannot be cancelled or reset without an event */
+	num = odp_timer_cancel_multi(tim, ev2, MULTI_NUM);
+	CU_ASSERT(num == 0);
+	for (i = 0; i < MULTI_NUM; i++)
+		CU_ASSERT(ev2[i] == ODP_EVENT_INVALID);
+	num = odp_timer_set_rel_multi(tim, tick, NULL, MULTI_NUM);
+	CU_ASSERT(num == 0);
+
+	/* All timeouts are delivered */
+	for (i = 0; i < MULTI_NUM; i++)
+		tick[i] = 1 + i % 2;
+	num = odp_timer_set_rel_multi(tim, tick, ev, MULTI_NUM);
+	CU_ASSERT_FATAL(num == MULTI_NUM);
+
+	for (i = 0; i < MULTI_NUM; i++) {
+		ev[i] = wait_event(queue, 1000);
+		CU_ASSERT_FATAL(ev[i] != ODP_EVENT_INVALID);
+	}
+
+	for (i = 0; i < MULTI_NUM; i++) {
+		odp_event_free(ev[i]);
+		CU_ASSERT(odp_timer_free(tim[i]) == ODP_EVENT_INVALID);
+	}
+
+	odp_timer_pool_destroy(tp);
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
+#define PERIODIC_NUM 5
+
+void timer_test_odp_timer_periodic(void)
+{
+	odp_pool_t pool;
+	odp_pool_param_t params;
+	odp_timer_pool_param_t tparam;
+	odp_timer_pool_t tp;
+	odp_queue_t queue;
+	odp_timer_t tim;
+	odp_event_t ev;
+	odp_timeout_t tmo;
+	uint64_t period, first, tick;
+	int i;
+
+	odp_pool_param_init(&params);
+	params.type    = ODP_POOL_TIMEOUT;
+	params.tmo.num = 1;
+
+	pool = odp_pool_create("tmo_pool_for_periodic", &params);
+	if (pool == ODP_POOL_INVALID)
+		CU_FAIL_FATAL("Timeout pool create failed");
+
+	tparam.res_ns     = 10  * ODP_TIME_MSEC_IN_NS;
+	tparam.min_tmo    = 10  * ODP_TIME_MSEC_IN_NS;
+	tparam.max_tmo    = 10  * ODP_TIME_SEC_IN_NS;
+	tparam.num_timers = 1;
+	tparam.priv       = 0;
+	tparam.clk_src    = ODP_CLOCK_CPU;
+	tp = odp_timer_pool_create("timer_pool_periodic", &tparam);
+	if (tp == ODP_TIMER_POOL_INVALID)
+		CU_FAIL_FATAL("Timer pool create failed");
+
+	odp_timer_pool_start();
+
+	queue = odp_queue_create("timer_queue_periodic", NULL);
+	if (queue == ODP_QUEUE_INVALID)
+		CU_FAIL_FATAL("Queue create failed");
+
+	tim = odp_timer_alloc(tp, queue, USER_PTR);
+	CU_ASSERT_FATAL(tim != ODP_TIMER_INVALID);
+
+	/* Timeout event is mandatory */
+	period = odp_timer_ns_to_tick(tp, 50 * ODP_TIME_MSEC_IN_NS);
+	first = odp_timer_current_tick(tp) + period;
+	CU_ASSERT(odp_timer_periodic_start(tim, first, period, NULL) ==
+		  ODP_TIMER_NOEVENT);
+
+	ev = odp_timeout_to_event(odp_timeout_alloc(pool));
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	CU_ASSERT(odp_timer_periodic_start(tim, first, 0, &ev) ==
+		  ODP_TIMER_TOOEARLY);
+
+	CU_ASSERT_FATAL(odp_timer_periodic_start(tim, first, period, &ev) ==
+			ODP_TIMER_SUCCESS);
+	CU_ASSERT(ev == ODP_EVENT_INVALID);
+
+	/* The same timeout is delivered once per period */
+	tick = first;
+	for (i = 0; i < PERIODIC_NUM; i++) {
+		ev = wait_event(queue, 1000);
+		CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+		tmo = odp_timeout_from_event(ev);
+		CU_ASSERT(odp_timeout_timer(tmo) == tim);
+		CU_ASSERT(odp_timeout_user_ptr(tmo) == USER_PTR);
+		CU_ASSERT(odp_timeout_tick(tmo) >= tick);
+		CU_ASSERT((odp_timeout_tick(tmo) - first) % period == 0);
+		tick = odp_timeout_tick(tmo) + period;
+
+		if (i < PERIODIC_NUM - 1)
+			CU_ASSERT(odp_timer_periodic_ack(tim, ev) == 0);
+	}
+
+	/* Cancel fails while the application holds the timeout. The timer is
+	 * stopped and does not take the event back. */
+	CU_ASSERT(odp_timer_cancel(tim, &ev) < 0);
+	CU_ASSERT(odp_timer_periodic_ack(tim, ev) == 1);
+
+	/* Restart and cancel while the timer holds the timeout */
+	first = odp_timer_current_tick(tp) + 10 * period;
+	CU_ASSERT_FATAL(odp_timer_periodic_start(tim, first, period, &ev) ==
+			ODP_TIMER_SUCCESS);
+	CU_ASSERT(odp_timer_cancel(tim, &ev) == 0);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+
+	/* Cancelled periodic timer is a one-shot timer when set again */
+	CU_ASSERT_FATAL(odp_timer_set_rel(tim, period, &ev) ==
+			ODP_TIMER_SUCCESS);
+	ev = wait_event(queue, 1000);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	CU_ASSERT(wait_event(queue, 3 * 50) == ODP_EVENT_INVALID);
+
+	/* Running periodic timer is a one-shot timer when set again */
+	first = odp_timer_current_tick(tp) + 10 * period;
+	CU_ASSERT_FATAL(odp_timer_periodic_start(tim, first, period, &ev) ==
+			ODP_TIMER_SUCCESS);
+	CU_ASSERT_FATAL(odp_timer_set_rel(tim, period, NULL) ==
+			ODP_TIMER_SUCCESS);
+	ev = wait_event(queue, 1000);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	CU_ASSERT_FATAL(odp_timer_periodic_ack(tim, ev) == 1);
+
+	odp_event_free(ev);
+	CU_ASSERT(odp_timer_free(tim) == ODP_EVENT_INVALID);
+	odp_timer_pool_destroy(tp);
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 /* @private Handle a received (timeout) event */
 static void handle_tmo(odp_event_t ev, bool stale, uint64_t prev_tick)
 {
@@ -581,6 +808,8 @@ odp_testinfo_t timer_suite[] = {
 	ODP_TEST_INFO(timer_test_timeout_pool_alloc),
 	ODP_TEST_INFO(timer_test_timeout_pool_free),
 	ODP_TEST_INFO(timer_test_odp_timer_cancel),
+	ODP_TEST_INFO(timer_test_odp_timer_multi),
+	ODP_TEST_INFO(timer_test_odp_timer_periodic),
 	ODP_TEST_INFO(timer_test_odp_timer_all),
 	ODP_TEST_INFO_NULL,
 };
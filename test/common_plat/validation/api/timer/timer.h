@@ -13,6 +13,8 @@
 void timer_test_timeout_pool_alloc(void);
 void timer_test_timeout_pool_free(void);
 void timer_test_odp_timer_cancel(void);
+void timer_test_odp_timer_multi(void);
+void timer_test_odp_timer_periodic(void);
 void timer_test_odp_timer_all(void);
 
 /* test arrays: */
@@ -0,0 +1,189 @@
+/* Copyright (c) 2017, Linaro Limited
+ * All rights reserved.
+ *
+ * SPDX-License-Identifier:     BSD-3-Clause
+ */
+
+#include <odp_api.h>
+#include <odp_cunit_common.h>
+#include <odp_queue_internal.h>
+
+#define PKT_NUM  32
+#define PKT_LEN  64
+#define DATA_LEN 32
+#define NUM_OPS  8
+
+static uint8_t key[16];
+static uint8_t iv[16];
+
+/* Enqueue functions of a full queue. Plain queues are not limited in size,
+ * so these replace the enqueue functions of the completion queue. */
+static int enq_full(queue_entry_t *queue ODP_UNUSED,
+		    odp_buffer_hdr_t *buf_hdr ODP_UNUSED)
+{
+	return -1;
+}
+
+static int enq_multi_full(queue_entry_t *queue ODP_UNUSED,
+			  odp_buffer_hdr_t *buf_hdr[] ODP_UNUSED,
+			  int num ODP_UNUSED)
+{
+	return 0;
+}
+
+/* Number of packets that can be allocated from the pool, at most
+ * PKT_NUM + 1 */
+static int pool_num_free(odp_pool_t pool)
+{
+	odp_packet_t pkt[PKT_NUM + 1];
+	int i, num;
+
+	for (num = 0; num < PKT_NUM + 1; num++) {
+		pkt[num] = odp_packet_alloc(pool, PKT_LEN);
+		if (pkt[num] == ODP_PACKET_INVALID)
+			break;
+	}
+
+	for (i = 0; i < num; i++)
+		odp_packet_free(pkt[i]);
+
+	return num;
+}
+
+static odp_crypto_session_t session_create(odp_pool_t pool,
+					   odp_queue_t queue)
+{
+	odp_crypto_session_param_t param;
+	odp_crypto_ses_create_err_t status;
+	odp_crypto_session_t session;
+
+	odp_crypto_session_param_init(&param);
+	param.op = ODP_CRYPTO_OP_ENCODE;
+	param.pref_mode = queue == ODP_QUEUE_INVALID ? ODP_CRYPTO_SYNC :
+						     ODP_CRYPTO_ASYNC;
+	param.cipher_alg = ODP_CIPHER_ALG_AES_CBC;
+	param.cipher_key.data = key;
+	param.cipher_key.length = sizeof(key);
+	param.iv.data = iv;
+	param.iv.length = sizeof(iv);
+	param.auth_alg = ODP_AUTH_ALG_NULL;
+	param.compl_queue = queue;
+	param.output_pool = pool;
+
+	CU_ASSERT_FATAL(!odp_crypto_session_create(&param, &session, &status));
+
+	return session;
+}
+
+/* Operations of a burst, whose completion events cannot be enqueued.
+ * Packets of failed operations, which were processed by the caller and
+ * not delivered, are freed by the implementation. Packets of failed
+ * synchronous operations are left to the application. Operations started
+ * by crypto workers are all reported as started, workers drop their
+ * completion events. No packet is freed twice. */
+static void crypto_test_compl_enq_fail(void)
+{
+	odp_pool_param_t pool_param;
+	odp_pool_t pool;
+	odp_queue_t queue;
+	queue_entry_t *qentry;
+	enq_func_t enq;
+	enq_multi_func_t enq_multi;
+	odp_crypto_session_t ses_async, ses_sync;
+	odp_crypto_op_param_t param[NUM_OPS];
+	odp_crypto_op_result_t result[NUM_OPS];
+	odp_bool_t posted[NUM_OPS];
+	odp_bool_t async[NUM_OPS];
+	odp_time_t wait;
+	int i, ret, num;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type = ODP_POOL_PACKET;
+	pool_param.pkt.num = PKT_NUM;
+	pool_param.pkt.len = PKT_LEN;
+	pool = odp_pool_create("crypto_compl", &pool_param);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	queue = odp_queue_create("crypto_compl", NULL);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	ses_async = session_create(pool, queue);
+	ses_sync = session_create(pool, ODP_QUEUE_INVALID);
+
+	/* Completion events cannot be enqueued anymore */
+	qentry = queue_to_qentry(queue);
+	enq = qentry->s.enqueue;
+	enq_multi = qentry->s.enqueue_multi;
+	qentry->s.enqueue = enq_full;
+	qentry->s.enqueue_multi = enq_multi_full;
+
+	memset(param, 0, sizeof(param));
+
+	for (i = 0; i < NUM_OPS; i++) {
+		async[i] = (i % 4) != 2;
+		param[i].session = async[i] ? ses_async : ses_sync;
+		param[i].pkt = odp_packet_alloc(pool, DATA_LEN);
+		CU_ASSERT_FATAL(param[i].pkt != ODP_PACKET_INVALID);
+		param[i].out_pkt = param[i].pkt;
+		param[i].cipher_range.length = DATA_LEN;
+		param[i].hash_result_offset = DATA_LEN;
+	}
+
+	ret = odp_crypto_operation_multi(param, posted, result, NUM_OPS);
+	CU_ASSERT(ret <= NUM_OPS);
+	if (ret < 0)
+		ret = 0;
+
+	for (i = 0; i < NUM_OPS; i++) {
+		if (async[i])
+			continue;
+
+		if (i < ret) {
+			CU_ASSERT(!posted[i]);
+			CU_ASSERT(result[i].ok);
+			CU_ASSERT(result[i].pkt == param[i].pkt);
+		}
+
+		odp_packet_free(param[i].pkt);
+	}
+
+	/* Crypto workers exit after the last session using them has been
+	 * freed, and return their cached packets to the pool */
+	CU_ASSERT(!odp_crypto_session_destroy(ses_async));
+	CU_ASSERT(!odp_crypto_session_destroy(ses_sync));
+
+	qentry->s.enqueue = enq;
+	qentry->s.enqueue_multi = enq_multi;
+	CU_ASSERT(odp_queue_deq(queue) == ODP_EVENT_INVALID);
+	CU_ASSERT(!odp_queue_destroy(queue));
+
+	wait = odp_time_sum(odp_time_local(),
+			    odp_time_local_from_ns(ODP_TIME_SEC_IN_NS));
+	do {
+		num = pool_num_free(pool);
+	} while (num < PKT_NUM && odp_time_cmp(wait, odp_time_local()) > 0);
+
+	/* More than PKT_NUM means that a packet was freed twice */
+	CU_ASSERT(num == PKT_NUM);
+	CU_ASSERT(!odp_pool_destroy(pool));
+}
+
+odp_testinfo_t crypto_compl_suite[] = {
+	ODP_TEST_INFO(crypto_test_compl_enq_fail),
+	ODP_TEST_INFO_NULL,
+};
+
+odp_suiteinfo_t crypto_compl_suites[] = {
+	{"Crypto completion", NULL, NULL, crypto_compl_suite},
+	ODP_SUITE_INFO_NULL,
+};
+
+int main(void)
+{
+	int ret = odp_cunit_register(crypto_compl_suites);
+
+	if (ret == 0)
+		ret = odp_cunit_run();
+
+	return ret;
+}
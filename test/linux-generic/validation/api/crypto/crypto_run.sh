@@ -0,0 +1,24 @@
+#!/bin/sh
+#
+# Copyright (c) 2017, Linaro Limited
+# All rights reserved.
+#
+# SPDX-License-Identifier:	BSD-3-Clause
+#
+
+# Run crypto completion tests with operations processed by the caller and
+# by crypto worker threads.
+PATH=$(dirname $0):$PATH
+PATH=.:$PATH
+
+ret=0
+
+for workers in 0 1; do
+	echo "ODP_CRYPTO_WORKERS=${workers}"
+	ODP_CRYPTO_WORKERS=${workers} crypto_compl_main${EXEEXT}
+	if [ $? -ne 0 ]; then
+		ret=1
+	fi
+done
+
+exit $ret